@@ -37,6 +37,7 @@
 #include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/marshalls.h"
+#include "core/math/batch_math.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/geometry_3d.h"
 #include "core/os/keyboard.h"
@@ -1073,6 +1074,32 @@ Vector<int32_t> Geometry3D::tetrahedralize_delaunay(const Vector<Vector3> &p_poi
 	return ::Geometry3D::tetrahedralize_delaunay(p_points);
 }
 
+static Vector<float> _real_to_float32(const Vector<real_t> &p_values) {
+#ifdef REAL_T_IS_DOUBLE
+	Vector<float> ret;
+	ret.resize(p_values.size());
+	float *w = ret.ptrw();
+	for (int i = 0; i < p_values.size(); i++) {
+		w[i] = p_values[i];
+	}
+	return ret;
+#else
+	return p_values;
+#endif
+}
+
+Vector<Vector3> Geometry3D::transform_points(const Transform3D &p_transform, const Vector<Vector3> &p_points) {
+	return BatchMath::xform_points(p_transform, p_points);
+}
+
+Vector<float> Geometry3D::get_dot_products(const Vector<Vector3> &p_a, const Vector<Vector3> &p_b) {
+	return _real_to_float32(BatchMath::dot(p_a, p_b));
+}
+
+Vector<float> Geometry3D::get_distances_to_plane(const Plane &p_plane, const Vector<Vector3> &p_points) {
+	return _real_to_float32(BatchMath::distances_to_plane(p_plane, p_points));
+}
+
 void Geometry3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("compute_convex_mesh_points", "planes"), &Geometry3D::compute_convex_mesh_points);
 	ClassDB::bind_method(D_METHOD("build_box_planes", "extents"), &Geometry3D::build_box_planes);
@@ -1095,6 +1122,10 @@ void Geometry3D::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("clip_polygon", "points", "plane"), &Geometry3D::clip_polygon);
 	ClassDB::bind_method(D_METHOD("tetrahedralize_delaunay", "points"), &Geometry3D::tetrahedralize_delaunay);
+
+	ClassDB::bind_method(D_METHOD("transform_points", "transform", "points"), &Geometry3D::transform_points);
+	ClassDB::bind_method(D_METHOD("get_dot_products", "a", "b"), &Geometry3D::get_dot_products);
+	ClassDB::bind_method(D_METHOD("get_distances_to_plane", "plane", "points"), &Geometry3D::get_distances_to_plane);
 }
 
 ////// Marshalls //////
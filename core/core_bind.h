@@ -346,6 +346,10 @@ public:
 	Vector<Vector3> clip_polygon(const Vector<Vector3> &p_points, const Plane &p_plane);
 	Vector<int32_t> tetrahedralize_delaunay(const Vector<Vector3> &p_points);
 
+	Vector<Vector3> transform_points(const Transform3D &p_transform, const Vector<Vector3> &p_points);
+	Vector<float> get_dot_products(const Vector<Vector3> &p_a, const Vector<Vector3> &p_b);
+	Vector<float> get_distances_to_plane(const Plane &p_plane, const Vector<Vector3> &p_points);
+
 	Geometry3D() { singleton = this; }
 };
 
@@ -150,6 +150,14 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	/**
+	 * Returns a read-only pointer to the next p_length bytes and advances the
+	 * position past them, without copying. Returns nullptr (and does not move)
+	 * when the backend can't expose its data in place or fewer bytes are left;
+	 * callers then fall back to get_buffer(). The memory stays valid while the
+	 * file is open.
+	 */
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const { return nullptr; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -118,11 +118,64 @@ void PackedData::_free_packed_dirs(PackedDir *p_dir) {
 	memdelete(p_dir);
 }
 
+const uint8_t *PackedData::get_pack_mapping(const String &p_pack, uint64_t p_offset, uint64_t p_size) {
+	MutexLock lock(pack_mappings_mutex);
+
+	HashMap<String, PackMapping>::Iterator E = pack_mappings.find(p_pack);
+	if (!E) {
+		PackMapping mapping;
+		mapping.file = FileAccess::open(p_pack, FileAccess::READ);
+		if (mapping.file.is_valid()) {
+			mapping.size = mapping.file->get_length();
+			mapping.data = mapping.file->get_buffer_view(mapping.size);
+		}
+		if (!mapping.data) {
+			// Not mappable on this platform, remember it so the pack isn't reopened each time.
+			mapping.file.unref();
+			mapping.size = 0;
+		}
+		E = pack_mappings.insert(p_pack, mapping);
+	}
+
+	// Files that the pack's directory places past its end (e.g. a truncated
+	// download) are left to the bounded reads of the regular path.
+	PackMapping &mapping = E->value;
+	if (!mapping.data) {
+		return nullptr;
+	}
+	if (p_offset > mapping.size || p_size > mapping.size - p_offset) {
+		if (mapping.users == 0) {
+			// Just mapped for this file, don't keep it mapped with nobody using it.
+			pack_mappings.remove(E);
+		}
+		return nullptr;
+	}
+	mapping.users++;
+	return mapping.data + p_offset;
+}
+
+void PackedData::release_pack_mapping(const String &p_pack) {
+	MutexLock lock(pack_mappings_mutex);
+
+	HashMap<String, PackMapping>::Iterator E = pack_mappings.find(p_pack);
+	ERR_FAIL_COND(!E || E->value.users == 0);
+	E->value.users--;
+	if (E->value.users == 0) {
+		// Unmap it, so a pack that changes on disk between loads is mapped again
+		// with its new size rather than read past its end.
+		pack_mappings.remove(E);
+	}
+}
+
 PackedData::~PackedData() {
+	pack_mappings.clear();
 	for (int i = 0; i < sources.size(); i++) {
 		memdelete(sources[i]);
 	}
 	_free_packed_dirs(root);
+	if (singleton == this) {
+		singleton = nullptr;
+	}
 }
 
 //////////////////////////////////////////////////////////////////
@@ -273,7 +326,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (data) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -281,7 +336,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -289,7 +344,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid()) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -310,18 +367,21 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint8_t FileAccessPack::get_8() const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), 0, "File must be opened before use.");
 	if (pos >= pf.size) {
 		eof = true;
 		return 0;
 	}
 
+	if (data) {
+		return data[pos++];
+	}
 	pos++;
 	return f->get_8();
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -334,21 +394,47 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
-	pos += to_read;
-
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+
+	if (data) {
+		memcpy(p_dst, data + pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
+	pos += to_read;
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!data && f.is_null(), nullptr, "File must be opened before use.");
+
+	if (eof || pos > pf.size || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	const uint8_t *view = nullptr;
+	if (data) {
+		view = data + pos;
+	} else {
+		view = f->get_buffer_view(p_length);
+		if (!view) {
+			return nullptr;
+		}
+	}
+	pos += p_length;
+	return view;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(!data && f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -375,16 +461,34 @@ bool FileAccessPack::file_exists(const String &p_name) {
 }
 
 void FileAccessPack::close() {
+	if (data) {
+		if (PackedData::get_singleton()) {
+			PackedData::get_singleton()->release_pack_mapping(pf.pack);
+		}
+		data = nullptr;
+	}
 	f = Ref<FileAccess>();
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
+		pf(p_file) {
+	pos = 0;
+	eof = false;
+	off = pf.offset;
+
+	if (!pf.encrypted) {
+		// Read straight from the mapped pack when possible, which saves opening
+		// the pack again and a syscall for every read.
+		data = PackedData::get_singleton()->get_pack_mapping(pf.pack, pf.offset, pf.size);
+		if (data) {
+			return;
+		}
+	}
+
+	f = FileAccess::open(pf.pack, FileAccess::READ);
 	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
 
 	f->seek(pf.offset);
-	off = pf.offset;
 
 	if (pf.encrypted) {
 		Ref<FileAccessEncrypted> fae;
@@ -402,8 +506,10 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		f = fae;
 		off = 0;
 	}
-	pos = 0;
-	eof = false;
+}
+
+FileAccessPack::~FileAccessPack() {
+	close();
 }
 
 //////////////////////////////////////////////////////////////////////////////////
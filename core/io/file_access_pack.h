@@ -33,6 +33,7 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -101,6 +102,19 @@ private:
 
 	Vector<PackSource *> sources;
 
+	// Packs mapped in memory, shared by all the files read from them, and
+	// unmapped when the last of them is closed.
+	// Truncating a pack while files are read from it faults, like it does for
+	// any other mapped file.
+	struct PackMapping {
+		Ref<FileAccess> file;
+		const uint8_t *data = nullptr;
+		uint64_t size = 0;
+		uint32_t users = 0;
+	};
+	HashMap<String, PackMapping> pack_mappings;
+	Mutex pack_mappings_mutex;
+
 	PackedDir *root = nullptr;
 
 	static PackedData *singleton;
@@ -117,6 +131,8 @@ public:
 
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
+	const uint8_t *get_pack_mapping(const String &p_pack, uint64_t p_offset, uint64_t p_size);
+	void release_pack_mapping(const String &p_pack);
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
@@ -148,6 +164,8 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 	uint64_t off;
 
+	// Set when the pack is mapped in memory, f is not used in that case.
+	const uint8_t *data = nullptr;
 	Ref<FileAccess> f;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
@@ -172,6 +190,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -188,6 +207,7 @@ public:
 	virtual void close() override;
 
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	~FileAccessPack();
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -0,0 +1,883 @@
+/**************************************************************************/
+/*  json_stream.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_stream.h"
+
+#include "core/string/char_utils.h"
+
+/* JSONReader */
+
+bool JSONReader::_refill() {
+	if (file.is_null()) {
+		return false;
+	}
+	chunk.resize(READ_CHUNK_SIZE);
+	buf = chunk.ptr();
+	buf_len = file->get_buffer(chunk.ptr(), READ_CHUNK_SIZE);
+	pos = 0;
+	return buf_len > 0;
+}
+
+int JSONReader::_skip_whitespace() {
+	while (true) {
+		int c = _peek();
+		if (c == '\n') {
+			line++;
+		} else if (c < 0 || c > 32) {
+			return c;
+		}
+		pos++;
+	}
+}
+
+JSONReader::Event JSONReader::_set_error(const String &p_message) {
+	err_str = p_message;
+	err_line = line;
+	event = EVENT_ERROR;
+	return event;
+}
+
+void JSONReader::_value_done() {
+	if (stack.is_empty()) {
+		state = STATE_DONE;
+	} else {
+		state = stack[stack.size() - 1] ? STATE_OBJECT_NEXT : STATE_ARRAY_NEXT;
+	}
+}
+
+JSONReader::Event JSONReader::_begin(bool p_object) {
+	if (stack.size() >= (uint32_t)Variant::MAX_RECURSION_DEPTH) {
+		return _set_error("JSON structure is too deep. Bailing.");
+	}
+	pos++;
+	stack.push_back(p_object);
+	state = p_object ? STATE_OBJECT_FIRST : STATE_ARRAY_FIRST;
+	event = p_object ? EVENT_OBJECT_BEGIN : EVENT_ARRAY_BEGIN;
+	return event;
+}
+
+JSONReader::Event JSONReader::_end(bool p_object) {
+	pos++;
+	stack.resize(stack.size() - 1);
+	_value_done();
+	event = p_object ? EVENT_OBJECT_END : EVENT_ARRAY_END;
+	return event;
+}
+
+JSONReader::Event JSONReader::_read_value(int p_char) {
+	switch (p_char) {
+		case '{': {
+			return _begin(true);
+		}
+		case '[': {
+			return _begin(false);
+		}
+		case '"': {
+			pos++;
+			if (_read_string(EVENT_STRING) == EVENT_ERROR) {
+				return event;
+			}
+			_value_done();
+			return event;
+		}
+		case -1: {
+			return _set_error("Unexpected end of file.");
+		}
+		default: {
+			if (p_char == '-' || is_digit(p_char)) {
+				return _read_number();
+			}
+			if (is_ascii_alphabet_char(p_char)) {
+				return _read_literal();
+			}
+			return _set_error("Unexpected character.");
+		}
+	}
+}
+
+static _FORCE_INLINE_ int _hex_value(int p_char) {
+	if (is_digit(p_char)) {
+		return p_char - '0';
+	} else if (p_char >= 'a' && p_char <= 'f') {
+		return p_char - 'a' + 10;
+	} else if (p_char >= 'A' && p_char <= 'F') {
+		return p_char - 'A' + 10;
+	}
+	return -1;
+}
+
+JSONReader::Event JSONReader::_read_string(Event p_event) {
+	string_buffer.clear();
+
+	while (true) {
+		if (pos >= buf_len && !_refill()) {
+			return _set_error("Unterminated String");
+		}
+
+		// Copy runs of plain characters in one go.
+		const uint64_t start = pos;
+		while (pos < buf_len) {
+			const uint8_t c = buf[pos];
+			if (c == '"' || c == '\\' || c == '\n') {
+				break;
+			}
+			pos++;
+		}
+		if (pos > start) {
+			const uint32_t size = string_buffer.size();
+			string_buffer.resize(size + (pos - start));
+			memcpy(string_buffer.ptr() + size, buf + start, pos - start);
+		}
+		if (pos >= buf_len) {
+			continue;
+		}
+
+		const uint8_t c = buf[pos++];
+		if (c == '"') {
+			break;
+		}
+		if (c == '\n') {
+			line++;
+			string_buffer.push_back('\n');
+			continue;
+		}
+
+		// Escape sequence.
+		const int next = _peek();
+		if (next < 0) {
+			return _set_error("Unterminated String");
+		}
+		pos++;
+
+		switch (next) {
+			case 'b': {
+				string_buffer.push_back('\b');
+			} break;
+			case 't': {
+				string_buffer.push_back('\t');
+			} break;
+			case 'n': {
+				string_buffer.push_back('\n');
+			} break;
+			case 'f': {
+				string_buffer.push_back('\f');
+			} break;
+			case 'r': {
+				string_buffer.push_back('\r');
+			} break;
+			case '"':
+			case '\\':
+			case '/': {
+				string_buffer.push_back(next);
+			} break;
+			case 'u': {
+				char32_t res = 0;
+				for (int surrogate = 0; surrogate < 2; surrogate++) {
+					char32_t unit = 0;
+					for (int j = 0; j < 4; j++) {
+						const int h = _peek();
+						if (h < 0) {
+							return _set_error("Unterminated String");
+						}
+						const int v = _hex_value(h);
+						if (v < 0) {
+							return _set_error("Malformed hex constant in string");
+						}
+						unit = (unit << 4) | v;
+						pos++;
+					}
+
+					if (surrogate == 0) {
+						res = unit;
+						if (unit == 0) {
+							// Would end the string early once converted.
+							return _set_error("Invalid null character in string");
+						}
+						if ((unit & 0xfffffc00) == 0xdc00) {
+							return _set_error("Invalid UTF-16 sequence in string, unpaired trail surrogate");
+						}
+						if ((unit & 0xfffffc00) != 0xd800) {
+							break;
+						}
+						// Lead surrogate, a "\u" trail surrogate must follow.
+						if (_peek() != '\\') {
+							return _set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+						}
+						pos++;
+						if (_peek() != 'u') {
+							return _set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+						}
+						pos++;
+					} else {
+						if ((unit & 0xfffffc00) != 0xdc00) {
+							return _set_error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+						}
+						res = (res << 10UL) + unit - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+					}
+				}
+
+				// Encode as UTF-8.
+				if (res < 0x80) {
+					string_buffer.push_back(res);
+				} else if (res < 0x800) {
+					string_buffer.push_back(0xc0 | (res >> 6));
+					string_buffer.push_back(0x80 | (res & 0x3f));
+				} else if (res < 0x10000) {
+					string_buffer.push_back(0xe0 | (res >> 12));
+					string_buffer.push_back(0x80 | ((res >> 6) & 0x3f));
+					string_buffer.push_back(0x80 | (res & 0x3f));
+				} else {
+					string_buffer.push_back(0xf0 | (res >> 18));
+					string_buffer.push_back(0x80 | ((res >> 12) & 0x3f));
+					string_buffer.push_back(0x80 | ((res >> 6) & 0x3f));
+					string_buffer.push_back(0x80 | (res & 0x3f));
+				}
+			} break;
+			default: {
+				return _set_error("Invalid escape sequence.");
+			}
+		}
+	}
+
+	string_buffer.push_back(0);
+	event = p_event;
+	return event;
+}
+
+uint32_t JSONReader::_read_digits() {
+	uint32_t count = 0;
+	while (is_digit(_peek())) {
+		string_buffer.push_back(buf[pos++]);
+		count++;
+	}
+	return count;
+}
+
+JSONReader::Event JSONReader::_read_number() {
+	// -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+	string_buffer.clear();
+	if (_peek() == '-') {
+		string_buffer.push_back(buf[pos++]);
+	}
+	bool valid = true;
+	if (_peek() == '0') {
+		string_buffer.push_back(buf[pos++]);
+	} else {
+		valid = _read_digits() > 0;
+	}
+	if (valid && _peek() == '.') {
+		string_buffer.push_back(buf[pos++]);
+		valid = _read_digits() > 0;
+	}
+	if (valid && (_peek() == 'e' || _peek() == 'E')) {
+		string_buffer.push_back(buf[pos++]);
+		if (_peek() == '+' || _peek() == '-') {
+			string_buffer.push_back(buf[pos++]);
+		}
+		valid = _read_digits() > 0;
+	}
+	if (valid) {
+		// Catches leading zeros, and garbage such as "1.2.3" or "1-2".
+		const int next = _peek();
+		valid = !is_digit(next) && next != '.' && next != '-' && next != '+' && next != 'e' && next != 'E';
+	}
+	string_buffer.push_back(0);
+
+	if (!valid) {
+		return _set_error("Malformed number.");
+	}
+	number = String::to_float(string_buffer.ptr());
+	_value_done();
+	event = EVENT_NUMBER;
+	return event;
+}
+
+JSONReader::Event JSONReader::_read_literal() {
+	string_buffer.clear();
+	while (is_ascii_alphabet_char(_peek()) && string_buffer.size() < 16) {
+		string_buffer.push_back(buf[pos++]);
+	}
+	string_buffer.push_back(0);
+
+	if (string_equals("true") || string_equals("false")) {
+		boolean = string_buffer[0] == 't';
+		event = EVENT_BOOL;
+	} else if (string_equals("null")) {
+		event = EVENT_NULL;
+	} else {
+		return _set_error("Expected 'true','false' or 'null', got '" + get_string() + "'.");
+	}
+	_value_done();
+	return event;
+}
+
+JSONReader::Event JSONReader::read() {
+	if (event == EVENT_ERROR || event == EVENT_END) {
+		return event;
+	}
+
+	int c = _skip_whitespace();
+	switch (state) {
+		case STATE_ROOT: {
+			// Skip the UTF-8 BOM, if any.
+			if (c == 0xef && pos + 2 < buf_len && buf[pos + 1] == 0xbb && buf[pos + 2] == 0xbf) {
+				pos += 3;
+				c = _skip_whitespace();
+			}
+			return _read_value(c);
+		}
+		case STATE_DONE: {
+			if (c >= 0) {
+				return _set_error("Expected 'EOF'");
+			}
+			event = EVENT_END;
+			return event;
+		}
+		case STATE_ARRAY_FIRST: {
+			if (c == ']') {
+				return _end(false);
+			}
+			return _read_value(c);
+		}
+		case STATE_ARRAY_VALUE: {
+			return _read_value(c);
+		}
+		case STATE_ARRAY_NEXT: {
+			if (c == ']') {
+				return _end(false);
+			}
+			if (c != ',') {
+				return _set_error("Expected ','");
+			}
+			pos++;
+			state = STATE_ARRAY_VALUE;
+			return read();
+		}
+		case STATE_OBJECT_FIRST: {
+			if (c == '}') {
+				return _end(true);
+			}
+			[[fallthrough]];
+		}
+		case STATE_OBJECT_KEY: {
+			if (c != '"') {
+				return _set_error("Expected key");
+			}
+			pos++;
+			if (_read_string(EVENT_KEY) == EVENT_ERROR) {
+				return event;
+			}
+			if (_skip_whitespace() != ':') {
+				return _set_error("Expected ':'");
+			}
+			pos++;
+			state = STATE_OBJECT_VALUE;
+			return event;
+		}
+		case STATE_OBJECT_VALUE: {
+			return _read_value(c);
+		}
+		case STATE_OBJECT_NEXT: {
+			if (c == '}') {
+				return _end(true);
+			}
+			if (c != ',') {
+				return _set_error("Expected '}' or ','");
+			}
+			pos++;
+			state = STATE_OBJECT_KEY;
+			return read();
+		}
+	}
+
+	return EVENT_ERROR;
+}
+
+String JSONReader::get_string() const {
+	return String::utf8(string_buffer.ptr(), string_buffer.size() - 1);
+}
+
+Error JSONReader::skip() {
+	if (event == EVENT_KEY) {
+		read();
+		if (event == EVENT_ERROR) {
+			return ERR_PARSE_ERROR;
+		}
+	}
+	if (event != EVENT_OBJECT_BEGIN && event != EVENT_ARRAY_BEGIN) {
+		return OK;
+	}
+
+	const uint32_t target = stack.size() - 1;
+	while (stack.size() > target) {
+		if (read() == EVENT_ERROR) {
+			return ERR_PARSE_ERROR;
+		}
+	}
+	return OK;
+}
+
+Error JSONReader::_parse_value(Variant &r_value) {
+	switch (event) {
+		case EVENT_OBJECT_BEGIN: {
+			Dictionary d;
+			while (read() != EVENT_OBJECT_END) {
+				if (event != EVENT_KEY) {
+					return ERR_PARSE_ERROR;
+				}
+				const String key = get_string();
+				read();
+				Variant v;
+				Error err = _parse_value(v);
+				if (err) {
+					return err;
+				}
+				d[key] = v;
+			}
+			r_value = d;
+		} break;
+		case EVENT_ARRAY_BEGIN: {
+			Array a;
+			while (read() != EVENT_ARRAY_END) {
+				Variant v;
+				Error err = _parse_value(v);
+				if (err) {
+					return err;
+				}
+				a.push_back(v);
+			}
+			r_value = a;
+		} break;
+		case EVENT_STRING: {
+			r_value = get_string();
+		} break;
+		case EVENT_NUMBER: {
+			r_value = number;
+		} break;
+		case EVENT_BOOL: {
+			r_value = boolean;
+		} break;
+		case EVENT_NULL: {
+			r_value = Variant();
+		} break;
+		case EVENT_ERROR: {
+			return ERR_PARSE_ERROR;
+		}
+		default: {
+			_set_error("Expected value");
+			return ERR_PARSE_ERROR;
+		}
+	}
+	return OK;
+}
+
+Error JSONReader::read_variant(Variant &r_value) {
+	read();
+	return _parse_value(r_value);
+}
+
+Error JSONReader::open(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Cannot open file '" + p_path + "'.");
+	return open_file(f);
+}
+
+Error JSONReader::open_file(const Ref<FileAccess> &p_file) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	close();
+	file = p_file;
+	state = STATE_ROOT;
+	return OK;
+}
+
+Error JSONReader::open_buffer(const Vector<uint8_t> &p_buffer) {
+	close();
+	source = p_buffer;
+	buf = source.ptr();
+	buf_len = source.size();
+	state = STATE_ROOT;
+	return OK;
+}
+
+void JSONReader::close() {
+	source.clear();
+	file.unref();
+	chunk.reset();
+	buf = nullptr;
+	buf_len = 0;
+	pos = 0;
+	state = STATE_DONE;
+	stack.clear();
+	event = EVENT_NONE;
+	string_buffer.clear();
+	string_buffer.push_back(0);
+	number = 0.0;
+	boolean = false;
+	err_str = String();
+	err_line = 0;
+	line = 1;
+}
+
+JSONReader::JSONReader() {
+	string_buffer.push_back(0);
+}
+
+/* JSONWriter */
+
+void JSONWriter::_put(const char *p_str, uint32_t p_len) {
+	const uint32_t size = buffer.size();
+	buffer.resize(size + p_len);
+	memcpy(buffer.ptr() + size, p_str, p_len);
+}
+
+void JSONWriter::_put_ascii(const String &p_str) {
+	const char32_t *str = p_str.ptr();
+	const int len = p_str.length();
+	for (int i = 0; i < len; i++) {
+		_put(str[i]);
+	}
+}
+
+void JSONWriter::_put_escaped(const String &p_str) {
+	static const char hex[] = "0123456789abcdef";
+
+	const char32_t *str = p_str.ptr();
+	const int len = p_str.length();
+	buffer.reserve(buffer.size() + len + 2);
+
+	_put('"');
+	for (int i = 0; i < len; i++) {
+		const char32_t c = str[i];
+		switch (c) {
+			case '"': {
+				_put("\\\"", 2);
+			} break;
+			case '\\': {
+				_put("\\\\", 2);
+			} break;
+			case '\b': {
+				_put("\\b", 2);
+			} break;
+			case '\f': {
+				_put("\\f", 2);
+			} break;
+			case '\n': {
+				_put("\\n", 2);
+			} break;
+			case '\r': {
+				_put("\\r", 2);
+			} break;
+			case '\t': {
+				_put("\\t", 2);
+			} break;
+			default: {
+				if (c < 0x20) {
+					const char esc[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf] };
+					_put(esc, 6);
+				} else if (c < 0x80) {
+					_put(c);
+				} else if (c < 0x800) {
+					_put(0xc0 | (c >> 6));
+					_put(0x80 | (c & 0x3f));
+				} else if (c < 0x10000) {
+					_put(0xe0 | (c >> 12));
+					_put(0x80 | ((c >> 6) & 0x3f));
+					_put(0x80 | (c & 0x3f));
+				} else {
+					_put(0xf0 | (c >> 18));
+					_put(0x80 | ((c >> 12) & 0x3f));
+					_put(0x80 | ((c >> 6) & 0x3f));
+					_put(0x80 | (c & 0x3f));
+				}
+			} break;
+		}
+	}
+	_put('"');
+}
+
+void JSONWriter::_newline(uint32_t p_depth) {
+	_put('\n');
+	for (uint32_t i = 0; i < p_depth; i++) {
+		_put(indent.get_data(), indent.length());
+	}
+}
+
+void JSONWriter::_before_value() {
+	if (after_key) {
+		after_key = false;
+		return;
+	}
+	if (stack.is_empty()) {
+		return;
+	}
+
+	Level &level = stack[stack.size() - 1];
+	ERR_FAIL_COND_MSG(level.object, "A key must be written before each value of a JSON object.");
+	if (!level.empty) {
+		_put(',');
+	}
+	level.empty = false;
+	if (indent.length()) {
+		_newline(stack.size());
+	}
+}
+
+void JSONWriter::_after_value() {
+	if (buffer.size() >= FLUSH_THRESHOLD && (file.is_valid() || peer.is_valid())) {
+		flush();
+	}
+}
+
+void JSONWriter::begin_object() {
+	_before_value();
+	_put('{');
+	stack.push_back({ true, true });
+}
+
+void JSONWriter::end_object() {
+	ERR_FAIL_COND_MSG(stack.is_empty() || !stack[stack.size() - 1].object || after_key, "Mismatched JSON object end.");
+	const bool empty = stack[stack.size() - 1].empty;
+	stack.resize(stack.size() - 1);
+	if (!empty && indent.length()) {
+		_newline(stack.size());
+	}
+	_put('}');
+	_after_value();
+}
+
+void JSONWriter::begin_array() {
+	_before_value();
+	_put('[');
+	stack.push_back({ false, true });
+}
+
+void JSONWriter::end_array() {
+	ERR_FAIL_COND_MSG(stack.is_empty() || stack[stack.size() - 1].object, "Mismatched JSON array end.");
+	const bool empty = stack[stack.size() - 1].empty;
+	stack.resize(stack.size() - 1);
+	if (!empty && indent.length()) {
+		_newline(stack.size());
+	}
+	_put(']');
+	_after_value();
+}
+
+void JSONWriter::write_key(const String &p_key) {
+	ERR_FAIL_COND_MSG(stack.is_empty() || !stack[stack.size() - 1].object || after_key, "JSON keys can only be written inside an object, before a value.");
+
+	Level &level = stack[stack.size() - 1];
+	if (!level.empty) {
+		_put(',');
+	}
+	level.empty = false;
+	if (indent.length()) {
+		_newline(stack.size());
+	}
+	_put_escaped(p_key);
+	if (indent.length()) {
+		_put(": ", 2);
+	} else {
+		_put(':');
+	}
+	after_key = true;
+}
+
+void JSONWriter::write_string(const String &p_string) {
+	_before_value();
+	_put_escaped(p_string);
+	_after_value();
+}
+
+void JSONWriter::write_int(int64_t p_value) {
+	_before_value();
+	char digits[20];
+	int count = 0;
+	uint64_t value = p_value < 0 ? uint64_t(0) - uint64_t(p_value) : uint64_t(p_value);
+	do {
+		digits[count++] = '0' + value % 10;
+		value /= 10;
+	} while (value);
+	if (p_value < 0) {
+		_put('-');
+	}
+	while (count) {
+		_put(digits[--count]);
+	}
+	_after_value();
+}
+
+void JSONWriter::write_float(double p_value) {
+	_before_value();
+	// Same precision rules as JSON::stringify().
+	if (full_precision) {
+		_put_ascii(String::num(p_value, 17 - (int)floor(log10(p_value))));
+	} else {
+		_put_ascii(String::num(p_value, 14 - (int)floor(log10(p_value))));
+	}
+	_after_value();
+}
+
+void JSONWriter::write_bool(bool p_value) {
+	_before_value();
+	if (p_value) {
+		_put("true", 4);
+	} else {
+		_put("false", 5);
+	}
+	_after_value();
+}
+
+void JSONWriter::write_null() {
+	_before_value();
+	_put("null", 4);
+	_after_value();
+}
+
+void JSONWriter::_write_variant(const Variant &p_var, HashSet<const void *> &p_markers) {
+	switch (p_var.get_type()) {
+		case Variant::NIL: {
+			write_null();
+		} break;
+		case Variant::BOOL: {
+			write_bool(p_var);
+		} break;
+		case Variant::INT: {
+			write_int(p_var);
+		} break;
+		case Variant::FLOAT: {
+			write_float(p_var);
+		} break;
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_STRING_ARRAY:
+		case Variant::ARRAY: {
+			Array a = p_var;
+			if (unlikely(p_markers.has(a.id()))) {
+				write_string("[...]");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+			p_markers.insert(a.id());
+
+			begin_array();
+			for (const Variant &var : a) {
+				_write_variant(var, p_markers);
+			}
+			end_array();
+
+			p_markers.erase(a.id());
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_var;
+			if (unlikely(p_markers.has(d.id()))) {
+				write_string("{...}");
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+			p_markers.insert(d.id());
+
+			List<Variant> keys;
+			d.get_key_list(&keys);
+			if (sort_keys) {
+				keys.sort();
+			}
+
+			begin_object();
+			for (const Variant &E : keys) {
+				write_key(E);
+				_write_variant(d[E], p_markers);
+			}
+			end_object();
+
+			p_markers.erase(d.id());
+		} break;
+		default: {
+			write_string(p_var);
+		} break;
+	}
+}
+
+void JSONWriter::write_variant(const Variant &p_var) {
+	HashSet<const void *> markers;
+	_write_variant(p_var, markers);
+}
+
+Error JSONWriter::flush() {
+	if (buffer.is_empty() || error != OK) {
+		return error;
+	}
+
+	if (file.is_valid()) {
+		file->store_buffer(buffer.ptr(), buffer.size());
+		error = file->get_error();
+	} else if (peer.is_valid()) {
+		error = peer->put_data(buffer.ptr(), buffer.size());
+	} else {
+		// Nothing to flush to, keep the data for get_data().
+		return OK;
+	}
+	buffer.clear();
+	return error;
+}
+
+Vector<uint8_t> JSONWriter::get_data() const {
+	Vector<uint8_t> ret;
+	ret.resize(buffer.size());
+	if (!buffer.is_empty()) {
+		memcpy(ret.ptrw(), buffer.ptr(), buffer.size());
+	}
+	return ret;
+}
+
+void JSONWriter::open_file(const Ref<FileAccess> &p_file) {
+	flush();
+	clear();
+	file = p_file;
+	peer.unref();
+}
+
+void JSONWriter::open_stream(const Ref<StreamPeer> &p_peer) {
+	flush();
+	clear();
+	peer = p_peer;
+	file.unref();
+}
+
+void JSONWriter::clear() {
+	buffer.clear();
+	stack.clear();
+	after_key = false;
+	error = OK;
+}
+
+JSONWriter::~JSONWriter() {
+	flush();
+}
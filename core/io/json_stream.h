@@ -0,0 +1,214 @@
+/**************************************************************************/
+/*  json_stream.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef JSON_STREAM_H
+#define JSON_STREAM_H
+
+#include "core/io/file_access.h"
+#include "core/io/stream_peer.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Pull parser reading UTF-8 JSON straight from a byte buffer or a file,
+// without building a UTF-32 String of the whole document first.
+// Each call to read() advances to the next event. Keys and strings are
+// decoded into a reused scratch buffer, so walking a document does not
+// allocate unless the caller asks for a String or a Variant.
+class JSONReader {
+public:
+	enum Event {
+		EVENT_NONE,
+		EVENT_OBJECT_BEGIN,
+		EVENT_OBJECT_END,
+		EVENT_ARRAY_BEGIN,
+		EVENT_ARRAY_END,
+		EVENT_KEY,
+		EVENT_STRING,
+		EVENT_NUMBER,
+		EVENT_BOOL,
+		EVENT_NULL,
+		EVENT_END, // The document has been fully read.
+		EVENT_ERROR,
+	};
+
+private:
+	enum {
+		READ_CHUNK_SIZE = 65536,
+	};
+
+	enum State {
+		STATE_ROOT,
+		STATE_DONE,
+		STATE_ARRAY_FIRST,
+		STATE_ARRAY_VALUE,
+		STATE_ARRAY_NEXT,
+		STATE_OBJECT_FIRST,
+		STATE_OBJECT_KEY,
+		STATE_OBJECT_VALUE,
+		STATE_OBJECT_NEXT,
+	};
+
+	// Source. Memory buffers are read in place, files through a reused chunk.
+	Vector<uint8_t> source;
+	Ref<FileAccess> file;
+	LocalVector<uint8_t> chunk;
+	const uint8_t *buf = nullptr;
+	uint64_t buf_len = 0;
+	uint64_t pos = 0;
+
+	State state = STATE_DONE;
+	LocalVector<bool> stack; // true for objects.
+	Event event = EVENT_NONE;
+	LocalVector<char> string_buffer; // Always null-terminated.
+	double number = 0.0;
+	bool boolean = false;
+
+	String err_str;
+	int err_line = 0;
+	int line = 1;
+
+	bool _refill();
+
+	_FORCE_INLINE_ int _peek() {
+		if (unlikely(pos >= buf_len) && !_refill()) {
+			return -1;
+		}
+		return buf[pos];
+	}
+
+	int _skip_whitespace();
+	Event _set_error(const String &p_message);
+	Event _read_value(int p_char);
+	Event _read_string(Event p_event);
+	uint32_t _read_digits();
+	Event _read_number();
+	Event _read_literal();
+	Event _begin(bool p_object);
+	Event _end(bool p_object);
+	void _value_done();
+	Error _parse_value(Variant &r_value);
+
+public:
+	Error open(const String &p_path);
+	Error open_file(const Ref<FileAccess> &p_file);
+	Error open_buffer(const Vector<uint8_t> &p_buffer);
+	void close();
+
+	Event read();
+	Event get_event() const { return event; }
+	int get_depth() const { return stack.size(); }
+
+	// Valid after EVENT_KEY and EVENT_STRING.
+	String get_string() const;
+	const char *get_string_utf8() const { return string_buffer.ptr(); }
+	int get_string_utf8_length() const { return string_buffer.size() - 1; }
+	bool string_equals(const char *p_utf8) const { return strcmp(string_buffer.ptr(), p_utf8) == 0; }
+
+	double get_number() const { return number; }
+	bool get_bool() const { return boolean; }
+
+	// Skips the value the current EVENT_OBJECT_BEGIN, EVENT_ARRAY_BEGIN or
+	// EVENT_KEY refers to, leaving the reader on its last event.
+	Error skip();
+	// Reads the next value as a Variant, with the same types JSON::parse()
+	// produces. After EVENT_KEY, this reads the value of that key.
+	Error read_variant(Variant &r_value);
+
+	String get_error_message() const { return err_str; }
+	int get_error_line() const { return err_line; }
+
+	JSONReader();
+};
+
+// Writes UTF-8 JSON incrementally into a FileAccess, a StreamPeer or an
+// internal byte buffer. Output is buffered and flushed in chunks, so large
+// documents never exist as a single String.
+class JSONWriter {
+	enum {
+		FLUSH_THRESHOLD = 65536,
+	};
+
+	struct Level {
+		bool object = false;
+		bool empty = true;
+	};
+
+	Ref<FileAccess> file;
+	Ref<StreamPeer> peer;
+	LocalVector<uint8_t> buffer;
+	LocalVector<Level> stack;
+	CharString indent;
+	bool after_key = false;
+	bool sort_keys = true;
+	bool full_precision = false;
+	Error error = OK;
+
+	_FORCE_INLINE_ void _put(char p_char) { buffer.push_back(p_char); }
+	void _put(const char *p_str, uint32_t p_len);
+	void _put_ascii(const String &p_str);
+	void _put_escaped(const String &p_str);
+	void _newline(uint32_t p_depth);
+	void _before_value();
+	void _after_value();
+	void _write_variant(const Variant &p_var, HashSet<const void *> &p_markers);
+
+public:
+	void open_file(const Ref<FileAccess> &p_file);
+	void open_stream(const Ref<StreamPeer> &p_peer);
+
+	void set_indent(const String &p_indent) { indent = p_indent.utf8(); }
+	void set_sort_keys(bool p_enable) { sort_keys = p_enable; }
+	void set_full_precision(bool p_enable) { full_precision = p_enable; }
+
+	void begin_object();
+	void end_object();
+	void begin_array();
+	void end_array();
+	void write_key(const String &p_key);
+	void write_string(const String &p_string);
+	void write_int(int64_t p_value);
+	void write_float(double p_value);
+	void write_bool(bool p_value);
+	void write_null();
+	// Writes a whole Variant the way JSON::stringify() does.
+	void write_variant(const Variant &p_var);
+
+	Error flush();
+	Error get_error() const { return error; }
+	// Bytes written so far when no file or stream is attached.
+	Vector<uint8_t> get_data() const;
+	void clear();
+
+	~JSONWriter();
+};
+
+#endif // JSON_STREAM_H
@@ -328,6 +328,12 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 		set_current_thread_safe_for_nodes(true);
 	}
 
+	// Keeps the prefetched dependencies alive until this resource has claimed them.
+	LocalVector<Ref<LoadToken>> prefetch_tokens;
+	if (load_task.prefetch_dependencies) {
+		_prefetch_dependencies(load_task, prefetch_tokens);
+	}
+
 	Ref<Resource> res = _load(load_task.remapped_path, load_task.remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_task.error, load_task.use_sub_threads, &load_task.progress);
 	if (mq_override_present) {
 		MessageQueue::get_singleton()->flush();
@@ -418,6 +424,94 @@ static String _validate_local_path(const String &p_path) {
 	}
 }
 
+void ResourceLoader::_get_prefetch_dependencies(const String &p_path, Vector<Pair<String, String>> &r_dependencies) {
+	List<String> deps;
+	get_dependencies(p_path, &deps, true);
+
+	for (const String &E : deps) {
+		// Entries are "path::type", or "uid::type::fallback_path".
+		Vector<String> parts = E.split("::");
+		String path = parts[0];
+		const String type = parts.size() > 1 ? parts[1] : String();
+
+		ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(path);
+		if (uid != ResourceUID::INVALID_ID) {
+			if (ResourceUID::get_singleton()->has_id(uid)) {
+				path = ResourceUID::get_singleton()->get_id_path(uid);
+			} else if (parts.size() > 2) {
+				path = parts[2];
+			} else {
+				continue;
+			}
+		}
+		if (path.is_empty()) {
+			continue;
+		}
+		if (!path.contains("://") && path.is_relative_path()) {
+			// Relative to the file that depends on it.
+			path = p_path.get_base_dir().path_join(path).simplify_path();
+		}
+
+		r_dependencies.push_back(Pair<String, String>(_validate_local_path(path), type));
+	}
+}
+
+// Walks the dependency headers below p_load_task and starts loading every
+// dependency on the worker pool, deepest first. Loaders then find them already
+// in flight, so independent leaves load concurrently instead of being
+// discovered one level at a time as their dependents get parsed.
+void ResourceLoader::_prefetch_dependencies(ThreadLoadTask &p_load_task, LocalVector<Ref<LoadToken>> &r_tokens) {
+	struct Frame {
+		String path;
+		String type;
+		Vector<Pair<String, String>> dependencies;
+		int next = 0;
+	};
+
+	HashSet<String> visited;
+	visited.insert(p_load_task.local_path);
+
+	LocalVector<Frame> stack;
+	stack.push_back(Frame());
+	stack[0].path = p_load_task.local_path;
+	_get_prefetch_dependencies(p_load_task.local_path, stack[0].dependencies);
+
+	while (!stack.is_empty()) {
+		Frame &frame = stack[stack.size() - 1];
+
+		if (frame.next < frame.dependencies.size()) {
+			const Pair<String, String> dep = frame.dependencies[frame.next++];
+			if (visited.has(dep.first) || ResourceCache::has(dep.first)) {
+				continue;
+			}
+			visited.insert(dep.first);
+
+			Frame child;
+			child.path = dep.first;
+			child.type = dep.second;
+			// Scripts resolve their own dependencies when compiled, don't parse them twice.
+			if (child.type.is_empty() || !ClassDB::is_parent_class(child.type, "Script")) {
+				_get_prefetch_dependencies(child.path, child.dependencies);
+			}
+			stack.push_back(child);
+			continue;
+		}
+
+		if (stack.size() > 1) {
+			// All the dependencies of this one are started, start it too.
+			Ref<LoadToken> token = _load_start(frame.path, frame.type, LOAD_THREAD_DISTRIBUTE, ResourceFormatLoader::CACHE_MODE_REUSE);
+			if (token.is_valid()) {
+				r_tokens.push_back(token);
+
+				// Report progress over the whole graph.
+				MutexLock thread_load_lock(thread_load_mutex);
+				p_load_task.sub_tasks.insert(frame.path);
+			}
+		}
+		stack.resize(stack.size() - 1);
+	}
+}
+
 Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode) {
 	thread_load_mutex.lock();
 	if (user_load_tokens.has(p_path)) {
@@ -429,7 +523,7 @@ Error ResourceLoader::load_threaded_request(const String &p_path, const String &
 	user_load_tokens[p_path] = nullptr;
 	thread_load_mutex.unlock();
 
-	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode);
+	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, p_use_sub_threads);
 	if (token.is_valid()) {
 		thread_load_mutex.lock();
 		token->user_path = p_path;
@@ -460,7 +554,7 @@ Ref<Resource> ResourceLoader::load(const String &p_path, const String &p_type_hi
 	return res;
 }
 
-Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode) {
+Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_prefetch_dependencies) {
 	String local_path = _validate_local_path(p_path);
 
 	Ref<LoadToken> load_token;
@@ -497,6 +591,7 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
 			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			load_task.prefetch_dependencies = p_prefetch_dependencies && p_thread_mode == LOAD_THREAD_DISTRIBUTE && p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE;
 			if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
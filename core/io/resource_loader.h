@@ -36,6 +36,8 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
 
 class ConditionVariable;
 
@@ -130,7 +132,7 @@ public:
 
 	static const int BINARY_MUTEX_TAG = 1;
 
-	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode);
+	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_prefetch_dependencies = false);
 	static Ref<Resource> _load_complete(LoadToken &p_load_token, Error *r_error);
 
 private:
@@ -180,10 +182,13 @@ private:
 		Ref<Resource> resource;
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
+		bool prefetch_dependencies = false; // Start the whole dependency graph upfront, see _prefetch_dependencies().
 		HashSet<String> sub_tasks;
 	};
 
 	static void _thread_load_function(void *p_userdata);
+	static void _get_prefetch_dependencies(const String &p_path, Vector<Pair<String, String>> &r_dependencies);
+	static void _prefetch_dependencies(ThreadLoadTask &p_load_task, LocalVector<Ref<LoadToken>> &r_tokens);
 
 	static thread_local int load_nesting;
 	static thread_local WorkerThreadPool::TaskID caller_task_id;
@@ -0,0 +1,632 @@
+/**************************************************************************/
+/*  batch_math.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "batch_math.h"
+
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BATCH_MATH_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+// AVX2 is not part of the baseline, so it's compiled per function and only used after a runtime check.
+#define BATCH_MATH_AVX2
+#include <immintrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BATCH_MATH_NEON
+#include <arm_neon.h>
+#endif
+#endif // REAL_T_IS_DOUBLE
+
+#if defined(BATCH_MATH_SSE2) || defined(BATCH_MATH_NEON)
+static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be tightly packed for the SIMD kernels.");
+static_assert(sizeof(AABB) == sizeof(Vector3) * 2, "AABB must be tightly packed for the SIMD kernels.");
+#endif
+
+/* Scalar */
+
+static void _xform_points_scalar(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+static void _xform_aabbs_scalar(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_xform.xform(p_src[i]);
+	}
+}
+
+static void _cull_aabbs_scalar(const AABB *p_aabbs, uint32_t p_count, const Plane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Vector3 half_extents = p_aabbs[i].size * 0.5f;
+		const Vector3 center = p_aabbs[i].position + half_extents;
+		uint8_t inside = 1;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const Plane &p = p_planes[j];
+			// Distance of the AABB corner that goes the furthest against the plane normal.
+			real_t extent = Math::abs(p.normal.x) * half_extents.x + Math::abs(p.normal.y) * half_extents.y + Math::abs(p.normal.z) * half_extents.z;
+			if (p.normal.x * center.x + p.normal.y * center.y + p.normal.z * center.z - p.d - extent > 0) {
+				inside = 0;
+				break;
+			}
+		}
+		r_inside[i] = inside;
+	}
+}
+
+static void _dot_scalar(const Vector3 *p_a, const Vector3 *p_b, real_t *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_a[i].dot(p_b[i]);
+	}
+}
+
+static void _distances_to_plane_scalar(const Plane &p_plane, const Vector3 *p_points, real_t *r_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_dst[i] = p_plane.distance_to(p_points[i]);
+	}
+}
+
+static void _bounds_scalar(const Vector3 *p_points, uint32_t p_count, Vector3 &r_min, Vector3 &r_max) {
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_min = r_min.min(p_points[i]);
+		r_max = r_max.max(p_points[i]);
+	}
+}
+
+static const BatchMath::Kernels scalar_kernels = {
+	_xform_points_scalar,
+	_xform_aabbs_scalar,
+	_cull_aabbs_scalar,
+	_dot_scalar,
+	_distances_to_plane_scalar,
+	_bounds_scalar,
+};
+
+/* SSE2 */
+
+#ifdef BATCH_MATH_SSE2
+
+// Loads/stores 3 floats without touching the memory past them.
+static _FORCE_INLINE_ __m128 _load3_sse2(const float *p_src) {
+	return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd((const double *)p_src)), _mm_load_ss(p_src + 2));
+}
+
+static _FORCE_INLINE_ void _store3_sse2(float *r_dst, __m128 p_v) {
+	_mm_store_sd((double *)r_dst, _mm_castps_pd(p_v));
+	_mm_store_ss(r_dst + 2, _mm_movehl_ps(p_v, p_v));
+}
+
+// Turns 4 packed Vector3 (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) into one register per axis.
+static _FORCE_INLINE_ void _deinterleave_sse2(__m128 p_a, __m128 p_b, __m128 p_c, __m128 &r_x, __m128 &r_y, __m128 &r_z) {
+	r_x = _mm_shuffle_ps(_mm_shuffle_ps(p_a, p_a, _MM_SHUFFLE(3, 3, 0, 0)), _mm_shuffle_ps(p_b, p_c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_y = _mm_shuffle_ps(_mm_shuffle_ps(p_a, p_b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(p_b, p_c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_z = _mm_shuffle_ps(_mm_shuffle_ps(p_a, p_b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(p_c, p_c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+// Inverse of _deinterleave_sse2().
+static _FORCE_INLINE_ void _interleave_sse2(__m128 p_x, __m128 p_y, __m128 p_z, __m128 &r_a, __m128 &r_b, __m128 &r_c) {
+	r_a = _mm_shuffle_ps(_mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_b = _mm_shuffle_ps(_mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_c = _mm_shuffle_ps(_mm_shuffle_ps(p_z, p_x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(p_y, p_z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static void _xform_points_sse2(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_xform.basis;
+	const __m128 m00 = _mm_set1_ps(b.rows[0].x), m01 = _mm_set1_ps(b.rows[0].y), m02 = _mm_set1_ps(b.rows[0].z);
+	const __m128 m10 = _mm_set1_ps(b.rows[1].x), m11 = _mm_set1_ps(b.rows[1].y), m12 = _mm_set1_ps(b.rows[1].z);
+	const __m128 m20 = _mm_set1_ps(b.rows[2].x), m21 = _mm_set1_ps(b.rows[2].y), m22 = _mm_set1_ps(b.rows[2].z);
+	const __m128 ox = _mm_set1_ps(p_xform.origin.x), oy = _mm_set1_ps(p_xform.origin.y), oz = _mm_set1_ps(p_xform.origin.z);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float *src = &p_src[i].x;
+		__m128 x, y, z;
+		_deinterleave_sse2(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_mul_ps(m02, z)), ox);
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m12, z)), oy);
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_mul_ps(m22, z)), oz);
+		__m128 a, c, d;
+		_interleave_sse2(rx, ry, rz, a, c, d);
+		float *dst = &r_dst[i].x;
+		_mm_storeu_ps(dst, a);
+		_mm_storeu_ps(dst + 4, c);
+		_mm_storeu_ps(dst + 8, d);
+	}
+	_xform_points_scalar(p_xform, p_src + i, r_dst + i, p_count - i);
+}
+
+static void _xform_aabbs_sse2(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+	const Basis &b = p_xform.basis;
+	const __m128 col0 = _mm_setr_ps(b.rows[0].x, b.rows[1].x, b.rows[2].x, 0);
+	const __m128 col1 = _mm_setr_ps(b.rows[0].y, b.rows[1].y, b.rows[2].y, 0);
+	const __m128 col2 = _mm_setr_ps(b.rows[0].z, b.rows[1].z, b.rows[2].z, 0);
+	const __m128 origin = _mm_setr_ps(p_xform.origin.x, p_xform.origin.y, p_xform.origin.z, 0);
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		const float *src = &p_src[i].position.x;
+		const __m128 min = _load3_sse2(src);
+		const __m128 max = _mm_add_ps(min, _load3_sse2(src + 3));
+		__m128 tmin = origin;
+		__m128 tmax = origin;
+
+		__m128 e = _mm_mul_ps(col0, _mm_shuffle_ps(min, min, _MM_SHUFFLE(0, 0, 0, 0)));
+		__m128 f = _mm_mul_ps(col0, _mm_shuffle_ps(max, max, _MM_SHUFFLE(0, 0, 0, 0)));
+		tmin = _mm_add_ps(tmin, _mm_min_ps(e, f));
+		tmax = _mm_add_ps(tmax, _mm_max_ps(e, f));
+		e = _mm_mul_ps(col1, _mm_shuffle_ps(min, min, _MM_SHUFFLE(1, 1, 1, 1)));
+		f = _mm_mul_ps(col1, _mm_shuffle_ps(max, max, _MM_SHUFFLE(1, 1, 1, 1)));
+		tmin = _mm_add_ps(tmin, _mm_min_ps(e, f));
+		tmax = _mm_add_ps(tmax, _mm_max_ps(e, f));
+		e = _mm_mul_ps(col2, _mm_shuffle_ps(min, min, _MM_SHUFFLE(2, 2, 2, 2)));
+		f = _mm_mul_ps(col2, _mm_shuffle_ps(max, max, _MM_SHUFFLE(2, 2, 2, 2)));
+		tmin = _mm_add_ps(tmin, _mm_min_ps(e, f));
+		tmax = _mm_add_ps(tmax, _mm_max_ps(e, f));
+
+		float *dst = &r_dst[i].position.x;
+		_store3_sse2(dst, tmin);
+		_store3_sse2(dst + 3, _mm_sub_ps(tmax, tmin));
+	}
+}
+
+static void _cull_aabbs_sse2(const AABB *p_aabbs, uint32_t p_count, const Plane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const AABB *aabbs = p_aabbs + i;
+		const __m128 hx = _mm_mul_ps(_mm_setr_ps(aabbs[0].size.x, aabbs[1].size.x, aabbs[2].size.x, aabbs[3].size.x), half);
+		const __m128 hy = _mm_mul_ps(_mm_setr_ps(aabbs[0].size.y, aabbs[1].size.y, aabbs[2].size.y, aabbs[3].size.y), half);
+		const __m128 hz = _mm_mul_ps(_mm_setr_ps(aabbs[0].size.z, aabbs[1].size.z, aabbs[2].size.z, aabbs[3].size.z), half);
+		const __m128 cx = _mm_add_ps(_mm_setr_ps(aabbs[0].position.x, aabbs[1].position.x, aabbs[2].position.x, aabbs[3].position.x), hx);
+		const __m128 cy = _mm_add_ps(_mm_setr_ps(aabbs[0].position.y, aabbs[1].position.y, aabbs[2].position.y, aabbs[3].position.y), hy);
+		const __m128 cz = _mm_add_ps(_mm_setr_ps(aabbs[0].position.z, aabbs[1].position.z, aabbs[2].position.z, aabbs[3].position.z), hz);
+
+		__m128 outside = zero;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const __m128 nx = _mm_set1_ps(p_planes[j].normal.x);
+			const __m128 ny = _mm_set1_ps(p_planes[j].normal.y);
+			const __m128 nz = _mm_set1_ps(p_planes[j].normal.z);
+			const __m128 extent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_and_ps(nx, abs_mask), hx), _mm_mul_ps(_mm_and_ps(ny, abs_mask), hy)), _mm_mul_ps(_mm_and_ps(nz, abs_mask), hz));
+			const __m128 dist = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_mul_ps(nz, cz)), _mm_set1_ps(p_planes[j].d)), extent);
+			outside = _mm_or_ps(outside, _mm_cmpgt_ps(dist, zero));
+			if (_mm_movemask_ps(outside) == 0xf) {
+				break;
+			}
+		}
+		const int mask = _mm_movemask_ps(outside);
+		r_inside[i + 0] = (mask & 1) ? 0 : 1;
+		r_inside[i + 1] = (mask & 2) ? 0 : 1;
+		r_inside[i + 2] = (mask & 4) ? 0 : 1;
+		r_inside[i + 3] = (mask & 8) ? 0 : 1;
+	}
+	_cull_aabbs_scalar(p_aabbs + i, p_count - i, p_planes, p_plane_count, r_inside + i);
+}
+
+static void _dot_sse2(const Vector3 *p_a, const Vector3 *p_b, real_t *r_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float *a = &p_a[i].x;
+		const float *b = &p_b[i].x;
+		__m128 ax, ay, az, bx, by, bz;
+		_deinterleave_sse2(_mm_loadu_ps(a), _mm_loadu_ps(a + 4), _mm_loadu_ps(a + 8), ax, ay, az);
+		_deinterleave_sse2(_mm_loadu_ps(b), _mm_loadu_ps(b + 4), _mm_loadu_ps(b + 8), bx, by, bz);
+		_mm_storeu_ps(r_dst + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)));
+	}
+	_dot_scalar(p_a + i, p_b + i, r_dst + i, p_count - i);
+}
+
+static void _distances_to_plane_sse2(const Plane &p_plane, const Vector3 *p_points, real_t *r_dst, uint32_t p_count) {
+	const __m128 nx = _mm_set1_ps(p_plane.normal.x), ny = _mm_set1_ps(p_plane.normal.y), nz = _mm_set1_ps(p_plane.normal.z);
+	const __m128 d = _mm_set1_ps(p_plane.d);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float *src = &p_points[i].x;
+		__m128 x, y, z;
+		_deinterleave_sse2(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+		_mm_storeu_ps(r_dst + i, _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, x), _mm_mul_ps(ny, y)), _mm_mul_ps(nz, z)), d));
+	}
+	_distances_to_plane_scalar(p_plane, p_points + i, r_dst + i, p_count - i);
+}
+
+static void _bounds_sse2(const Vector3 *p_points, uint32_t p_count, Vector3 &r_min, Vector3 &r_max) {
+	__m128 min = _load3_sse2(&r_min.x);
+	__m128 max = _load3_sse2(&r_max.x);
+	for (uint32_t i = 0; i < p_count; i++) {
+		const __m128 p = _load3_sse2(&p_points[i].x);
+		min = _mm_min_ps(min, p);
+		max = _mm_max_ps(max, p);
+	}
+	_store3_sse2(&r_min.x, min);
+	_store3_sse2(&r_max.x, max);
+}
+
+static const BatchMath::Kernels sse2_kernels = {
+	_xform_points_sse2,
+	_xform_aabbs_sse2,
+	_cull_aabbs_sse2,
+	_dot_sse2,
+	_distances_to_plane_sse2,
+	_bounds_sse2,
+};
+
+#endif // BATCH_MATH_SSE2
+
+/* AVX2 */
+
+#ifdef BATCH_MATH_AVX2
+
+// FMA is left out on purpose: fused multiply-adds round differently than the scalar
+// math, and results have to match Transform3D and Vector3 bit for bit.
+#define BATCH_MATH_AVX2_TARGET __attribute__((target("avx2")))
+
+// Loads 8 packed Vector3 as two blocks of 4, one per 128-bit lane. Since shuffles
+// work per lane, the SSE2 (de)interleaving pattern applies unchanged.
+BATCH_MATH_AVX2_TARGET static _FORCE_INLINE_ __m256 _load_lanes_avx2(const float *p_src) {
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p_src)), _mm_loadu_ps(p_src + 12), 1);
+}
+
+BATCH_MATH_AVX2_TARGET static _FORCE_INLINE_ void _store_lanes_avx2(float *r_dst, __m256 p_v) {
+	_mm_storeu_ps(r_dst, _mm256_castps256_ps128(p_v));
+	_mm_storeu_ps(r_dst + 12, _mm256_extractf128_ps(p_v, 1));
+}
+
+BATCH_MATH_AVX2_TARGET static _FORCE_INLINE_ void _load_deinterleave_avx2(const float *p_src, __m256 &r_x, __m256 &r_y, __m256 &r_z) {
+	const __m256 a = _load_lanes_avx2(p_src);
+	const __m256 b = _load_lanes_avx2(p_src + 4);
+	const __m256 c = _load_lanes_avx2(p_src + 8);
+	r_x = _mm256_shuffle_ps(_mm256_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 0, 0)), _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	r_z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+BATCH_MATH_AVX2_TARGET static _FORCE_INLINE_ void _interleave_store_avx2(float *r_dst, __m256 p_x, __m256 p_y, __m256 p_z) {
+	_store_lanes_avx2(r_dst, _mm256_shuffle_ps(_mm256_shuffle_ps(p_x, p_y, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_shuffle_ps(p_z, p_x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_store_lanes_avx2(r_dst + 4, _mm256_shuffle_ps(_mm256_shuffle_ps(p_y, p_z, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_shuffle_ps(p_x, p_y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_store_lanes_avx2(r_dst + 8, _mm256_shuffle_ps(_mm256_shuffle_ps(p_z, p_x, _MM_SHUFFLE(3, 3, 2, 2)), _mm256_shuffle_ps(p_y, p_z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+BATCH_MATH_AVX2_TARGET static void _xform_points_avx2(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_xform.basis;
+	const __m256 m00 = _mm256_set1_ps(b.rows[0].x), m01 = _mm256_set1_ps(b.rows[0].y), m02 = _mm256_set1_ps(b.rows[0].z);
+	const __m256 m10 = _mm256_set1_ps(b.rows[1].x), m11 = _mm256_set1_ps(b.rows[1].y), m12 = _mm256_set1_ps(b.rows[1].z);
+	const __m256 m20 = _mm256_set1_ps(b.rows[2].x), m21 = _mm256_set1_ps(b.rows[2].y), m22 = _mm256_set1_ps(b.rows[2].z);
+	const __m256 ox = _mm256_set1_ps(p_xform.origin.x), oy = _mm256_set1_ps(p_xform.origin.y), oz = _mm256_set1_ps(p_xform.origin.z);
+
+	uint32_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		__m256 x, y, z;
+		_load_deinterleave_avx2(&p_src[i].x, x, y, z);
+		const __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_mul_ps(m02, z)), ox);
+		const __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_mul_ps(m12, z)), oy);
+		const __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_mul_ps(m22, z)), oz);
+		_interleave_store_avx2(&r_dst[i].x, rx, ry, rz);
+	}
+	_xform_points_sse2(p_xform, p_src + i, r_dst + i, p_count - i);
+}
+
+BATCH_MATH_AVX2_TARGET static void _cull_aabbs_avx2(const AABB *p_aabbs, uint32_t p_count, const Plane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+
+	uint32_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		const AABB *a = p_aabbs + i;
+#define GATHER8(m_field) _mm256_setr_ps(a[0].m_field, a[1].m_field, a[2].m_field, a[3].m_field, a[4].m_field, a[5].m_field, a[6].m_field, a[7].m_field)
+		const __m256 hx = _mm256_mul_ps(GATHER8(size.x), half);
+		const __m256 hy = _mm256_mul_ps(GATHER8(size.y), half);
+		const __m256 hz = _mm256_mul_ps(GATHER8(size.z), half);
+		const __m256 cx = _mm256_add_ps(GATHER8(position.x), hx);
+		const __m256 cy = _mm256_add_ps(GATHER8(position.y), hy);
+		const __m256 cz = _mm256_add_ps(GATHER8(position.z), hz);
+#undef GATHER8
+
+		__m256 outside = zero;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const __m256 nx = _mm256_set1_ps(p_planes[j].normal.x);
+			const __m256 ny = _mm256_set1_ps(p_planes[j].normal.y);
+			const __m256 nz = _mm256_set1_ps(p_planes[j].normal.z);
+			const __m256 extent = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_and_ps(nx, abs_mask), hx), _mm256_mul_ps(_mm256_and_ps(ny, abs_mask), hy)), _mm256_mul_ps(_mm256_and_ps(nz, abs_mask), hz));
+			const __m256 dist = _mm256_sub_ps(_mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)), _mm256_mul_ps(nz, cz)), _mm256_set1_ps(p_planes[j].d)), extent);
+			outside = _mm256_or_ps(outside, _mm256_cmp_ps(dist, zero, _CMP_GT_OQ));
+			if (_mm256_movemask_ps(outside) == 0xff) {
+				break;
+			}
+		}
+		const int mask = _mm256_movemask_ps(outside);
+		for (int k = 0; k < 8; k++) {
+			r_inside[i + k] = (mask & (1 << k)) ? 0 : 1;
+		}
+	}
+	_cull_aabbs_sse2(p_aabbs + i, p_count - i, p_planes, p_plane_count, r_inside + i);
+}
+
+BATCH_MATH_AVX2_TARGET static void _dot_avx2(const Vector3 *p_a, const Vector3 *p_b, real_t *r_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		__m256 ax, ay, az, bx, by, bz;
+		_load_deinterleave_avx2(&p_a[i].x, ax, ay, az);
+		_load_deinterleave_avx2(&p_b[i].x, bx, by, bz);
+		// Lane 0 holds elements 0-3 and lane 1 holds elements 4-7, so a plain store keeps the order.
+		_mm256_storeu_ps(r_dst + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz)));
+	}
+	_dot_sse2(p_a + i, p_b + i, r_dst + i, p_count - i);
+}
+
+BATCH_MATH_AVX2_TARGET static void _distances_to_plane_avx2(const Plane &p_plane, const Vector3 *p_points, real_t *r_dst, uint32_t p_count) {
+	const __m256 nx = _mm256_set1_ps(p_plane.normal.x), ny = _mm256_set1_ps(p_plane.normal.y), nz = _mm256_set1_ps(p_plane.normal.z);
+	const __m256 d = _mm256_set1_ps(p_plane.d);
+
+	uint32_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		__m256 x, y, z;
+		_load_deinterleave_avx2(&p_points[i].x, x, y, z);
+		_mm256_storeu_ps(r_dst + i, _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, x), _mm256_mul_ps(ny, y)), _mm256_mul_ps(nz, z)), d));
+	}
+	_distances_to_plane_sse2(p_plane, p_points + i, r_dst + i, p_count - i);
+}
+
+static const BatchMath::Kernels avx2_kernels = {
+	_xform_points_avx2,
+	_xform_aabbs_sse2, // One AABB per iteration, wider registers don't help.
+	_cull_aabbs_avx2,
+	_dot_avx2,
+	_distances_to_plane_avx2,
+	_bounds_sse2,
+};
+
+#undef BATCH_MATH_AVX2_TARGET
+
+#endif // BATCH_MATH_AVX2
+
+/* NEON */
+
+#ifdef BATCH_MATH_NEON
+
+static void _xform_points_neon(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+	const Basis &b = p_xform.basis;
+	const float32x4_t ox = vdupq_n_f32(p_xform.origin.x), oy = vdupq_n_f32(p_xform.origin.y), oz = vdupq_n_f32(p_xform.origin.z);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		// vld3q/vst3q (de)interleave the packed Vector3 by themselves.
+		const float32x4x3_t v = vld3q_f32(&p_src[i].x);
+		float32x4x3_t r;
+		r.val[0] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], b.rows[0].x), vmulq_n_f32(v.val[1], b.rows[0].y)), vmulq_n_f32(v.val[2], b.rows[0].z)), ox);
+		r.val[1] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], b.rows[1].x), vmulq_n_f32(v.val[1], b.rows[1].y)), vmulq_n_f32(v.val[2], b.rows[1].z)), oy);
+		r.val[2] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], b.rows[2].x), vmulq_n_f32(v.val[1], b.rows[2].y)), vmulq_n_f32(v.val[2], b.rows[2].z)), oz);
+		vst3q_f32(&r_dst[i].x, r);
+	}
+	_xform_points_scalar(p_xform, p_src + i, r_dst + i, p_count - i);
+}
+
+static void _cull_aabbs_neon(const AABB *p_aabbs, uint32_t p_count, const Plane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		// Each AABB is 6 floats, so the first 3 of vld3q's 6 lanes are position, the rest size.
+		const float32x4x3_t lo = vld3q_f32(&p_aabbs[i].position.x);
+		const float32x4x3_t hi = vld3q_f32(&p_aabbs[i + 2].position.x);
+		// lo.val[0] = (pos.x0, size.x0, pos.x1, size.x1), and so on; split into positions and sizes.
+		float32x4_t px = vuzp1q_f32(lo.val[0], hi.val[0]);
+		float32x4_t sx = vuzp2q_f32(lo.val[0], hi.val[0]);
+		float32x4_t py = vuzp1q_f32(lo.val[1], hi.val[1]);
+		float32x4_t sy = vuzp2q_f32(lo.val[1], hi.val[1]);
+		float32x4_t pz = vuzp1q_f32(lo.val[2], hi.val[2]);
+		float32x4_t sz = vuzp2q_f32(lo.val[2], hi.val[2]);
+		const float32x4_t hx = vmulq_n_f32(sx, 0.5f), hy = vmulq_n_f32(sy, 0.5f), hz = vmulq_n_f32(sz, 0.5f);
+		const float32x4_t cx = vaddq_f32(px, hx), cy = vaddq_f32(py, hy), cz = vaddq_f32(pz, hz);
+
+		uint32x4_t outside = vdupq_n_u32(0);
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const Plane &p = p_planes[j];
+			const float32x4_t extent = vaddq_f32(vaddq_f32(vmulq_n_f32(hx, Math::abs(p.normal.x)), vmulq_n_f32(hy, Math::abs(p.normal.y))), vmulq_n_f32(hz, Math::abs(p.normal.z)));
+			const float32x4_t dist = vsubq_f32(vsubq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(cx, p.normal.x), vmulq_n_f32(cy, p.normal.y)), vmulq_n_f32(cz, p.normal.z)), vdupq_n_f32(p.d)), extent);
+			outside = vorrq_u32(outside, vcgtq_f32(dist, vdupq_n_f32(0)));
+			if (vminvq_u32(outside)) {
+				break;
+			}
+		}
+		r_inside[i + 0] = vgetq_lane_u32(outside, 0) ? 0 : 1;
+		r_inside[i + 1] = vgetq_lane_u32(outside, 1) ? 0 : 1;
+		r_inside[i + 2] = vgetq_lane_u32(outside, 2) ? 0 : 1;
+		r_inside[i + 3] = vgetq_lane_u32(outside, 3) ? 0 : 1;
+	}
+	_cull_aabbs_scalar(p_aabbs + i, p_count - i, p_planes, p_plane_count, r_inside + i);
+}
+
+static void _dot_neon(const Vector3 *p_a, const Vector3 *p_b, real_t *r_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x3_t a = vld3q_f32(&p_a[i].x);
+		const float32x4x3_t b = vld3q_f32(&p_b[i].x);
+		vst1q_f32(r_dst + i, vaddq_f32(vaddq_f32(vmulq_f32(a.val[0], b.val[0]), vmulq_f32(a.val[1], b.val[1])), vmulq_f32(a.val[2], b.val[2])));
+	}
+	_dot_scalar(p_a + i, p_b + i, r_dst + i, p_count - i);
+}
+
+static void _distances_to_plane_neon(const Plane &p_plane, const Vector3 *p_points, real_t *r_dst, uint32_t p_count) {
+	const float32x4_t d = vdupq_n_f32(p_plane.d);
+
+	uint32_t i = 0;
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x3_t v = vld3q_f32(&p_points[i].x);
+		vst1q_f32(r_dst + i, vsubq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(v.val[0], p_plane.normal.x), vmulq_n_f32(v.val[1], p_plane.normal.y)), vmulq_n_f32(v.val[2], p_plane.normal.z)), d));
+	}
+	_distances_to_plane_scalar(p_plane, p_points + i, r_dst + i, p_count - i);
+}
+
+static const BatchMath::Kernels neon_kernels = {
+	_xform_points_neon,
+	_xform_aabbs_scalar,
+	_cull_aabbs_neon,
+	_dot_neon,
+	_distances_to_plane_neon,
+	_bounds_scalar,
+};
+
+#endif // BATCH_MATH_NEON
+
+/* Dispatch */
+
+const BatchMath::Kernels *BatchMath::kernels_override = nullptr;
+
+bool BatchMath::is_implementation_supported(Implementation p_implementation) {
+	switch (p_implementation) {
+		case IMPLEMENTATION_SCALAR:
+			return true;
+		case IMPLEMENTATION_SSE2:
+#ifdef BATCH_MATH_SSE2
+			return true;
+#else
+			return false;
+#endif
+		case IMPLEMENTATION_AVX2:
+#ifdef BATCH_MATH_AVX2
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2");
+#else
+			return false;
+#endif
+		case IMPLEMENTATION_NEON:
+#ifdef BATCH_MATH_NEON
+			return true;
+#else
+			return false;
+#endif
+		default:
+			return false;
+	}
+}
+
+const BatchMath::Kernels *BatchMath::_get_kernels(Implementation p_implementation) {
+	switch (p_implementation) {
+#ifdef BATCH_MATH_SSE2
+		case IMPLEMENTATION_SSE2:
+			return &sse2_kernels;
+#endif
+#ifdef BATCH_MATH_AVX2
+		case IMPLEMENTATION_AVX2:
+			return &avx2_kernels;
+#endif
+#ifdef BATCH_MATH_NEON
+		case IMPLEMENTATION_NEON:
+			return &neon_kernels;
+#endif
+		default:
+			return &scalar_kernels;
+	}
+}
+
+const BatchMath::Kernels *BatchMath::_get_best_kernels() {
+	static const Kernels *best = []() {
+		const Implementation preferred[] = { IMPLEMENTATION_AVX2, IMPLEMENTATION_SSE2, IMPLEMENTATION_NEON };
+		for (Implementation implementation : preferred) {
+			if (is_implementation_supported(implementation)) {
+				return _get_kernels(implementation);
+			}
+		}
+		return _get_kernels(IMPLEMENTATION_SCALAR);
+	}();
+	return best;
+}
+
+BatchMath::Implementation BatchMath::get_implementation() {
+	const Kernels *current = _kernels();
+	for (int i = 0; i < IMPLEMENTATION_MAX; i++) {
+		if (is_implementation_supported(Implementation(i)) && _get_kernels(Implementation(i)) == current) {
+			return Implementation(i);
+		}
+	}
+	return IMPLEMENTATION_SCALAR;
+}
+
+bool BatchMath::set_implementation(Implementation p_implementation) {
+	ERR_FAIL_INDEX_V(p_implementation, IMPLEMENTATION_MAX, false);
+	ERR_FAIL_COND_V_MSG(!is_implementation_supported(p_implementation), false, "Batch math implementation " + String(get_implementation_name(p_implementation)) + " is not supported by this CPU or build.");
+	kernels_override = _get_kernels(p_implementation);
+	return true;
+}
+
+const char *BatchMath::get_implementation_name(Implementation p_implementation) {
+	static const char *names[IMPLEMENTATION_MAX] = { "Scalar", "SSE2", "AVX2", "NEON" };
+	ERR_FAIL_INDEX_V(p_implementation, IMPLEMENTATION_MAX, "");
+	return names[p_implementation];
+}
+
+/* Helpers */
+
+AABB BatchMath::compute_aabb(const Vector3 *p_points, uint32_t p_count) {
+	if (p_count == 0) {
+		return AABB();
+	}
+	Vector3 min = p_points[0];
+	Vector3 max = p_points[0];
+	_kernels()->bounds(p_points + 1, p_count - 1, min, max);
+	return AABB(min, max - min);
+}
+
+AABB BatchMath::merge_aabbs(const AABB *p_aabbs, uint32_t p_count) {
+	if (p_count == 0) {
+		return AABB();
+	}
+	Vector3 min = p_aabbs[0].position;
+	Vector3 max = p_aabbs[0].position + p_aabbs[0].size;
+	for (uint32_t i = 1; i < p_count; i++) {
+		min = min.min(p_aabbs[i].position);
+		max = max.max(p_aabbs[i].position + p_aabbs[i].size);
+	}
+	return AABB(min, max - min);
+}
+
+Vector<Vector3> BatchMath::xform_points(const Transform3D &p_xform, const Vector<Vector3> &p_points) {
+	Vector<Vector3> ret;
+	ret.resize(p_points.size());
+	xform_points(p_xform, p_points.ptr(), ret.ptrw(), p_points.size());
+	return ret;
+}
+
+Vector<real_t> BatchMath::dot(const Vector<Vector3> &p_a, const Vector<Vector3> &p_b) {
+	ERR_FAIL_COND_V_MSG(p_a.size() != p_b.size(), Vector<real_t>(), "Both arrays must have the same size.");
+	Vector<real_t> ret;
+	ret.resize(p_a.size());
+	dot(p_a.ptr(), p_b.ptr(), ret.ptrw(), p_a.size());
+	return ret;
+}
+
+Vector<real_t> BatchMath::distances_to_plane(const Plane &p_plane, const Vector<Vector3> &p_points) {
+	Vector<real_t> ret;
+	ret.resize(p_points.size());
+	distances_to_plane(p_plane, p_points.ptr(), ret.ptrw(), p_points.size());
+	return ret;
+}
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  batch_math.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef BATCH_MATH_H
+#define BATCH_MATH_H
+
+#include "core/math/aabb.h"
+#include "core/math/plane.h"
+#include "core/math/transform_3d.h"
+#include "core/math/vector3.h"
+#include "core/templates/vector.h"
+
+// Kernels operating on whole arrays of math types at once.
+// A SIMD implementation (SSE2, AVX2 or NEON) is picked at runtime depending on
+// what the CPU supports, with a scalar fallback. Double precision builds always
+// use the scalar implementation.
+// Source and destination arrays may be the same, but must not partially overlap.
+class BatchMath {
+public:
+	enum Implementation {
+		IMPLEMENTATION_SCALAR,
+		IMPLEMENTATION_SSE2,
+		IMPLEMENTATION_AVX2,
+		IMPLEMENTATION_NEON,
+		IMPLEMENTATION_MAX,
+	};
+
+	struct Kernels {
+		void (*xform_points)(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) = nullptr;
+		void (*xform_aabbs)(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) = nullptr;
+		void (*cull_aabbs)(const AABB *p_aabbs, uint32_t p_count, const Plane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) = nullptr;
+		void (*dot)(const Vector3 *p_a, const Vector3 *p_b, real_t *r_dst, uint32_t p_count) = nullptr;
+		void (*distances_to_plane)(const Plane &p_plane, const Vector3 *p_points, real_t *r_dst, uint32_t p_count) = nullptr;
+		void (*bounds)(const Vector3 *p_points, uint32_t p_count, Vector3 &r_min, Vector3 &r_max) = nullptr;
+	};
+
+private:
+	static const Kernels *kernels_override;
+	static const Kernels *_get_kernels(Implementation p_implementation);
+	static const Kernels *_get_best_kernels();
+
+	_FORCE_INLINE_ static const Kernels *_kernels() {
+		return unlikely(kernels_override) ? kernels_override : _get_best_kernels();
+	}
+
+public:
+	// Transforms every point by p_xform.
+	_FORCE_INLINE_ static void xform_points(const Transform3D &p_xform, const Vector3 *p_src, Vector3 *r_dst, uint32_t p_count) {
+		_kernels()->xform_points(p_xform, p_src, r_dst, p_count);
+	}
+	// Transforms every AABB by p_xform, same as Transform3D::xform(const AABB &).
+	_FORCE_INLINE_ static void xform_aabbs(const Transform3D &p_xform, const AABB *p_src, AABB *r_dst, uint32_t p_count) {
+		_kernels()->xform_aabbs(p_xform, p_src, r_dst, p_count);
+	}
+	// Tests every AABB against a convex volume made of outward facing planes (such as a camera frustum).
+	// r_inside is set to 1 for AABBs that may be inside, 0 for those fully outside of any plane.
+	_FORCE_INLINE_ static void cull_aabbs(const AABB *p_aabbs, uint32_t p_count, const Plane *p_planes, uint32_t p_plane_count, uint8_t *r_inside) {
+		_kernels()->cull_aabbs(p_aabbs, p_count, p_planes, p_plane_count, r_inside);
+	}
+	// r_dst[i] = p_a[i].dot(p_b[i]).
+	_FORCE_INLINE_ static void dot(const Vector3 *p_a, const Vector3 *p_b, real_t *r_dst, uint32_t p_count) {
+		_kernels()->dot(p_a, p_b, r_dst, p_count);
+	}
+	// r_dst[i] = p_plane.distance_to(p_points[i]).
+	_FORCE_INLINE_ static void distances_to_plane(const Plane &p_plane, const Vector3 *p_points, real_t *r_dst, uint32_t p_count) {
+		_kernels()->distances_to_plane(p_plane, p_points, r_dst, p_count);
+	}
+	// Smallest AABB enclosing all the points.
+	static AABB compute_aabb(const Vector3 *p_points, uint32_t p_count);
+	// Smallest AABB enclosing all the AABBs, same as merging them one by one.
+	static AABB merge_aabbs(const AABB *p_aabbs, uint32_t p_count);
+
+	// Convenience versions for packed arrays.
+	static Vector<Vector3> xform_points(const Transform3D &p_xform, const Vector<Vector3> &p_points);
+	static Vector<real_t> dot(const Vector<Vector3> &p_a, const Vector<Vector3> &p_b);
+	static Vector<real_t> distances_to_plane(const Plane &p_plane, const Vector<Vector3> &p_points);
+
+	// Mostly meant for testing and benchmarking the different code paths.
+	static Implementation get_implementation();
+	static bool is_implementation_supported(Implementation p_implementation);
+	static bool set_implementation(Implementation p_implementation);
+	static const char *get_implementation_name(Implementation p_implementation);
+};
+
+#endif // BATCH_MATH_H
@@ -30,6 +30,7 @@
 
 #include "transform_3d.h"
 
+#include "core/math/batch_math.h"
 #include "core/math/math_funcs.h"
 #include "core/string/ustring.h"
 
@@ -186,6 +187,10 @@ bool Transform3D::operator!=(const Transform3D &p_transform) const {
 	return (basis != p_transform.basis || origin != p_transform.origin);
 }
 
+Vector<Vector3> Transform3D::xform(const Vector<Vector3> &p_array) const {
+	return BatchMath::xform_points(*this, p_array);
+}
+
 void Transform3D::operator*=(const Transform3D &p_transform) {
 	origin = xform(p_transform.origin);
 	basis *= p_transform.basis;
@@ -44,18 +44,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	Object *obj;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj = p_obj;
-		obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		obj->_lock_index.unref();
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1422,6 +1410,11 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
 
+	_signal_connections_changed();
+	if (target_object) {
+		target_object->_signal_connections_changed();
+	}
+
 	return OK;
 }
 
@@ -1470,11 +1463,9 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 		}
 	}
 
-	if (slot->cE) {
-		Object *target_object = p_callable.get_object();
-		if (target_object) {
-			target_object->connections.erase(slot->cE);
-		}
+	Object *target_object = p_callable.get_object();
+	if (slot->cE && target_object) {
+		target_object->connections.erase(slot->cE);
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
@@ -1484,6 +1475,11 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 		signal_map.erase(p_signal);
 	}
 
+	_signal_connections_changed();
+	if (target_object) {
+		target_object->_signal_connections_changed();
+	}
+
 	return true;
 }
 
@@ -696,6 +696,13 @@ protected:
 	friend class GDExtensionMethodBind;
 	_ALWAYS_INLINE_ const ObjectGDExtension *_get_extension() const { return _extension; }
 	_ALWAYS_INLINE_ GDExtensionClassInstancePtr _get_extension_instance() const { return _extension_instance; }
+
+	// Set by classes overriding callp() to resolve methods that aren't in ClassDB, so callers never cache their method lookups.
+	bool _custom_callp = false;
+
+	// Called on both ends whenever a connection from a signal of one object to another is made or removed.
+	virtual void _signal_connections_changed() {}
+
 	virtual void _initialize_classv() { initialize_class(); }
 	virtual bool _setv(const StringName &p_name, const Variant &p_property) { return false; };
 	virtual bool _getv(const StringName &p_name, Variant &r_property) const { return false; };
@@ -943,6 +950,24 @@ public:
 	MTVIRTUAL void get_all_signal_connections(List<Connection> *p_connections) const;
 	MTVIRTUAL int get_persistent_signal_connection_count() const;
 	MTVIRTUAL void get_signals_connected_to_this(List<Connection> *p_connections) const;
+	// Calls `p_callback` with the object on the other end of each connection from or to this one, until it returns false.
+	// Unlike the methods above, this doesn't copy the connections.
+	template <typename F>
+	bool for_each_connected_object(F p_callback) const {
+		for (const KeyValue<StringName, SignalData> &E : signal_map) {
+			for (const KeyValue<Callable, SignalData::Slot> &slot_kv : E.value.slot_map) {
+				if (!p_callback(slot_kv.value.conn.callable.get_object())) {
+					return false;
+				}
+			}
+		}
+		for (const Connection &E : connections) {
+			if (!p_callback(E.signal.get_object())) {
+				return false;
+			}
+		}
+		return true;
+	}
 
 	MTVIRTUAL Error connect(const StringName &p_signal, const Callable &p_callable, uint32_t p_flags = 0);
 	MTVIRTUAL void disconnect(const StringName &p_signal, const Callable &p_callable);
@@ -968,6 +993,8 @@ public:
 	bool _is_queued_for_deletion = false; // Set to true by SceneTree::queue_delete().
 	bool is_queued_for_deletion() const;
 
+	_FORCE_INLINE_ bool has_custom_callp() const { return _custom_callp; }
+
 	_FORCE_INLINE_ void set_message_translation(bool p_enable) { _can_translate = p_enable; }
 	_FORCE_INLINE_ bool can_translate_messages() const { return _can_translate; }
 
@@ -1003,6 +1030,22 @@ public:
 	virtual ~Object();
 };
 
+#ifdef DEBUG_ENABLED
+// Keeps an object from being freed while one of its methods is being called.
+// Code that calls methods without going through Object::callp() must take it too.
+struct _ObjectDebugLock {
+	Object *obj;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj = p_obj;
+		obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		obj->_lock_index.unref();
+	}
+};
+#endif
+
 bool predelete_handler(Object *p_object);
 void postinitialize_handler(Object *p_object);
 
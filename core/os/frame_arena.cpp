@@ -0,0 +1,216 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include <string.h>
+
+thread_local FrameArena FrameArena::thread_arena;
+thread_local FrameArena::Counter *FrameArena::current_counter = nullptr;
+
+SafeNumeric<uint64_t> FrameArena::frame;
+FrameArena::Counter *FrameArena::first_counter = nullptr;
+FrameArena::Counter FrameArena::unattributed_counter("Unattributed");
+
+FrameArena::Counter::Counter(const char *p_name) {
+	// Counters are static objects, so this runs before any thread is started.
+	name = p_name;
+	next = first_counter;
+	first_counter = this;
+}
+
+void FrameArena::_add_block(size_t p_min_size) {
+	// Grow geometrically, so a frame with a large working set only needs a
+	// handful of blocks before the next rewind coalesces them.
+	size_t size = MAX(MAX(MIN_BLOCK_SIZE, total_size), p_min_size);
+	Block *block = (Block *)Memory::alloc_static(BLOCK_HEADER_SIZE + size, false);
+	CRASH_COND_MSG(!block, "Out of memory");
+	block->prev = current;
+	block->size = size;
+	block->used = 0;
+	current = block;
+	total_size += size;
+}
+
+void FrameArena::_free_blocks() {
+	while (current) {
+		Block *prev = current->prev;
+		Memory::free_static(current, false);
+		current = prev;
+	}
+	total_size = 0;
+}
+
+void FrameArena::_rewind() {
+	last_allocation = nullptr;
+	generation_frame = frame.get();
+
+	if (!current) {
+		return;
+	}
+
+	if (current->prev) {
+		// The previous generation spilled over several blocks; replace them
+		// with a single one that fits it all.
+		size_t size = total_size;
+		_free_blocks();
+		_add_block(size);
+	} else {
+		current->used = 0;
+	}
+}
+
+bool FrameArena::_owns(void *p_ptr) const {
+	for (Block *block = current; block; block = block->prev) {
+		uint8_t *data = _block_data(block);
+		if ((uint8_t *)p_ptr >= data && (uint8_t *)p_ptr < data + block->size) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void *FrameArena::_alloc(size_t p_bytes) {
+	if (live_allocations == 0) {
+		_rewind();
+	}
+
+#ifdef DEBUG_ENABLED
+	if (frame.get() > generation_frame + 2) {
+		WARN_PRINT_ONCE("Frame arena allocations are being kept alive across frames; the arena can't be rewound and will keep growing.");
+		generation_frame = frame.get();
+	}
+#endif
+
+	const size_t size = _align(p_bytes);
+	const size_t needed = ALLOC_HEADER_SIZE + size;
+	if (!current || current->used + needed > current->size) {
+		_add_block(needed);
+	}
+
+	uint8_t *mem = _block_data(current) + current->used + ALLOC_HEADER_SIZE;
+	current->used += needed;
+	_allocation_size(mem) = size;
+	live_allocations++;
+	last_allocation = mem;
+	return mem;
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+	_count(p_bytes);
+	return thread_arena._alloc(p_bytes);
+}
+
+void *FrameArena::realloc(void *p_ptr, size_t p_bytes) {
+	if (!p_ptr) {
+		return alloc(p_bytes);
+	}
+
+	FrameArena &arena = thread_arena;
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_V_MSG(!arena._owns(p_ptr), nullptr, "Frame arena memory can only be reallocated on the thread that allocated it.");
+#endif
+
+	_count(p_bytes);
+
+	const size_t old_size = _allocation_size(p_ptr);
+	const size_t size = _align(p_bytes);
+
+	if (p_ptr == arena.last_allocation) {
+		// Most recent allocation, which is the common case for a growing
+		// vector; resize it in place if the block has room.
+		const size_t offset = (uint8_t *)p_ptr - _block_data(arena.current);
+		if (offset + size <= arena.current->size) {
+			arena.current->used = offset + size;
+			_allocation_size(p_ptr) = size;
+			return p_ptr;
+		}
+	} else if (size <= old_size) {
+		return p_ptr;
+	}
+
+	void *mem = arena._alloc(p_bytes);
+	memcpy(mem, p_ptr, MIN(old_size, size));
+	arena.live_allocations--; // The old allocation is dead now.
+	return mem;
+}
+
+void FrameArena::free(void *p_ptr) {
+	if (!p_ptr) {
+		return;
+	}
+
+	FrameArena &arena = thread_arena;
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_MSG(!arena._owns(p_ptr), "Frame arena memory can only be freed on the thread that allocated it.");
+#endif
+
+	if (p_ptr == arena.last_allocation) {
+		// Stack-like release; let the space be reused right away.
+		arena.current->used = (uint8_t *)p_ptr - ALLOC_HEADER_SIZE - _block_data(arena.current);
+		arena.last_allocation = nullptr;
+	}
+
+	arena.live_allocations--;
+}
+
+void FrameArena::begin_frame() {
+	frame.increment();
+
+	for (Counter *counter = first_counter; counter; counter = counter->next) {
+		const uint64_t allocations = counter->allocations.get();
+		const uint64_t bytes = counter->bytes.get();
+		counter->allocations.sub(allocations);
+		counter->bytes.sub(bytes);
+		counter->last_frame_allocations.set(allocations);
+		counter->last_frame_bytes.set(bytes);
+		counter->total_allocations.add(allocations);
+	}
+}
+
+size_t FrameArena::get_thread_capacity() {
+	return thread_arena.total_size;
+}
+
+size_t FrameArena::get_thread_used() {
+	size_t used = 0;
+	for (Block *block = thread_arena.current; block; block = block->prev) {
+		used += block->used;
+	}
+	return used;
+}
+
+uint32_t FrameArena::get_thread_live_allocations() {
+	return thread_arena.live_allocations;
+}
+
+FrameArena::~FrameArena() {
+	_free_blocks();
+}
@@ -0,0 +1,167 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/os/memory.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// Per-thread bump allocator for short-lived, frame-local scratch memory.
+//
+// Allocations are served by bumping a pointer inside a chain of blocks owned
+// by the calling thread, so they never take a lock nor call into the system
+// allocator once the arena has warmed up. Freeing is (almost) free: the arena
+// only keeps track of how many allocations are alive, and rewinds in bulk as
+// soon as that number drops to zero. When that happens and the arena had to
+// grow during the previous generation, the blocks are coalesced into a single
+// one big enough to serve the whole working set next time.
+//
+// Memory obtained from the arena must be freed on the thread that allocated
+// it, and must not be kept around past the end of the frame. Use it through
+// `FrameLocalVector` for temporary arrays that are built and discarded within
+// the same function.
+class FrameArena {
+public:
+	// Per-subsystem statistics. Declare one as a static variable and use a
+	// `CounterScope` around the code that should be accounted to it.
+	class Counter {
+		friend class FrameArena;
+
+		const char *name = nullptr;
+		Counter *next = nullptr;
+
+		SafeNumeric<uint64_t> allocations;
+		SafeNumeric<uint64_t> bytes;
+		SafeNumeric<uint64_t> last_frame_allocations;
+		SafeNumeric<uint64_t> last_frame_bytes;
+		SafeNumeric<uint64_t> total_allocations;
+
+	public:
+		const char *get_name() const { return name; }
+		Counter *get_next() const { return next; }
+
+		// Number of allocations served by the arena during the last complete
+		// frame, that is, calls that would otherwise have hit the system allocator.
+		uint64_t get_last_frame_allocations() const { return last_frame_allocations.get(); }
+		uint64_t get_last_frame_bytes() const { return last_frame_bytes.get(); }
+		uint64_t get_total_allocations() const { return total_allocations.get(); }
+
+		Counter(const char *p_name);
+	};
+
+	class CounterScope {
+		Counter *prev = nullptr;
+
+	public:
+		_FORCE_INLINE_ CounterScope(Counter &p_counter) {
+			prev = current_counter;
+			current_counter = &p_counter;
+		}
+		_FORCE_INLINE_ ~CounterScope() {
+			current_counter = prev;
+		}
+	};
+
+private:
+	struct Block {
+		Block *prev = nullptr;
+		size_t size = 0;
+		size_t used = 0;
+	};
+
+	static constexpr size_t ALIGNMENT = 16;
+	static constexpr size_t BLOCK_HEADER_SIZE = (sizeof(Block) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	// Each allocation is preceded by its (aligned) size, so it can be resized.
+	static constexpr size_t ALLOC_HEADER_SIZE = ALIGNMENT;
+	static constexpr size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+	Block *current = nullptr;
+	size_t total_size = 0;
+	uint32_t live_allocations = 0;
+	uint8_t *last_allocation = nullptr;
+	uint64_t generation_frame = 0;
+
+	static thread_local FrameArena thread_arena;
+	static thread_local Counter *current_counter;
+
+	static SafeNumeric<uint64_t> frame;
+	static Counter *first_counter;
+	static Counter unattributed_counter;
+
+	_FORCE_INLINE_ static size_t _align(size_t p_bytes) { return (p_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+	_FORCE_INLINE_ static uint8_t *_block_data(Block *p_block) { return (uint8_t *)p_block + BLOCK_HEADER_SIZE; }
+	_FORCE_INLINE_ static uint64_t &_allocation_size(void *p_ptr) { return *(uint64_t *)((uint8_t *)p_ptr - ALLOC_HEADER_SIZE); }
+
+	_FORCE_INLINE_ static void _count(size_t p_bytes) {
+		Counter *counter = current_counter ? current_counter : &unattributed_counter;
+		counter->allocations.increment();
+		counter->bytes.add(p_bytes);
+	}
+
+	void *_alloc(size_t p_bytes);
+	void _add_block(size_t p_min_size);
+	void _rewind();
+	bool _owns(void *p_ptr) const;
+	void _free_blocks();
+
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_ptr, size_t p_bytes);
+	static void free(void *p_ptr);
+
+	// Marks a frame boundary. Called once per iteration from the main loop.
+	// Rolls over the per-subsystem counters; arenas themselves rewind on
+	// their own as soon as their allocations are released.
+	static void begin_frame();
+	static uint64_t get_frame() { return frame.get(); }
+
+	static Counter *get_first_counter() { return first_counter; }
+
+	// Statistics for the calling thread's arena.
+	static size_t get_thread_capacity();
+	static size_t get_thread_used();
+	static uint32_t get_thread_live_allocations();
+
+	~FrameArena();
+};
+
+class FrameAllocator {
+public:
+	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return FrameArena::alloc(p_memory); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return FrameArena::realloc(p_ptr, p_memory); }
+	_FORCE_INLINE_ static void free(void *p_ptr) { FrameArena::free(p_ptr); }
+};
+
+template <typename T, typename U = uint32_t, bool force_trivial = false, bool tight = false>
+using FrameLocalVector = LocalVector<T, U, force_trivial, tight, FrameAllocator>;
+
+#endif // FRAME_ARENA_H
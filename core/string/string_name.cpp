@@ -32,6 +32,7 @@
 
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 
 StaticCString StaticCString::create(const char *p_ptr) {
 	StaticCString scs;
@@ -39,7 +40,134 @@ StaticCString StaticCString::create(const char *p_ptr) {
 	return scs;
 }
 
-StringName::_Data *StringName::_table[STRING_TABLE_LEN];
+/*
+ * The table is split in shards, each with its own lock and its own bucket
+ * array, which grows with the number of names it holds.
+ *
+ * Lookups don't lock: they follow the (atomic) bucket chains, and only fall
+ * back to locking the shard when a name is not found, in order to create it
+ * or when the shard was being rehashed meanwhile. Names found this way are
+ * only used if their reference count can still be increased, so entries that
+ * are being released are never handed out.
+ *
+ * Memory that a lock-free reader may still be looking at (released entries,
+ * old bucket arrays) is retired instead of freed, tagged with the epoch it
+ * was unlinked in. Readers publish the epoch they started in, each in a slot
+ * of its own thread, so reading doesn't write to shared cache lines. Retired
+ * memory is freed once every active reader started in a later epoch, by the
+ * next writer or by a reader that finds the shard unlocked.
+ */
+
+struct alignas(64) StringNameReaderSlot {
+	std::atomic<uint64_t> epoch{ 0 }; // 0 while not reading.
+	std::atomic<bool> used{ false };
+};
+
+static constexpr uint32_t STRING_NAME_READER_SLOTS = 256;
+static StringNameReaderSlot reader_slots[STRING_NAME_READER_SLOTS];
+static std::atomic<uint32_t> reader_slots_used{ 0 }; // Highest slot ever claimed, plus one.
+static std::atomic<uint64_t> reader_epoch{ 1 };
+// Readers without a slot (more threads than slots, or exiting threads) hold
+// off reclaiming completely.
+static std::atomic<uint32_t> slotless_readers{ 0 };
+
+static thread_local StringNameReaderSlot *thread_reader_slot = nullptr;
+static thread_local bool thread_reader_slot_unavailable = false;
+
+struct StringNameReaderSlotRelease {
+	~StringNameReaderSlotRelease() {
+		thread_reader_slot->used.store(false);
+		thread_reader_slot = nullptr;
+		thread_reader_slot_unavailable = true;
+	}
+};
+
+static StringNameReaderSlot *_claim_reader_slot() {
+	if (thread_reader_slot_unavailable) {
+		return nullptr;
+	}
+	for (uint32_t i = 0; i < STRING_NAME_READER_SLOTS; i++) {
+		bool expected = false;
+		if (reader_slots[i].used.load(std::memory_order_relaxed) || !reader_slots[i].used.compare_exchange_strong(expected, true)) {
+			continue;
+		}
+		uint32_t used = reader_slots_used.load();
+		while (used < i + 1 && !reader_slots_used.compare_exchange_weak(used, i + 1)) {
+		}
+		thread_reader_slot = &reader_slots[i];
+		// Gives the slot back when the thread exits.
+		static thread_local StringNameReaderSlotRelease release;
+		return thread_reader_slot;
+	}
+	thread_reader_slot_unavailable = true;
+	return nullptr;
+}
+
+static _FORCE_INLINE_ StringNameReaderSlot *_reader_enter() {
+	StringNameReaderSlot *slot = thread_reader_slot;
+	if (unlikely(!slot)) {
+		slot = _claim_reader_slot();
+		if (!slot) {
+			slotless_readers.fetch_add(1);
+			return nullptr;
+		}
+	}
+	// Sequentially consistent, like unlinking and retiring: either a writer
+	// sees this epoch, or the reader starts after the unlink and can't reach
+	// what was retired.
+	slot->epoch.store(reader_epoch.load());
+	return slot;
+}
+
+static _FORCE_INLINE_ void _reader_exit(StringNameReaderSlot *p_slot) {
+	if (likely(p_slot)) {
+		p_slot->epoch.store(0, std::memory_order_release);
+	} else {
+		slotless_readers.fetch_sub(1);
+	}
+}
+
+// Memory retired before this epoch can't be reached by any reader anymore.
+static uint64_t _oldest_reader_epoch() {
+	if (slotless_readers.load() != 0) {
+		return 0;
+	}
+	uint64_t oldest = UINT64_MAX;
+	const uint32_t used = reader_slots_used.load();
+	for (uint32_t i = 0; i < used; i++) {
+		const uint64_t epoch = reader_slots[i].epoch.load();
+		if (epoch != 0 && epoch < oldest) {
+			oldest = epoch;
+		}
+	}
+	return oldest;
+}
+
+template <typename T>
+struct StringNameRetired {
+	T *ptr = nullptr;
+	uint64_t epoch = 0;
+};
+
+struct StringName::Table {
+	uint32_t mask = 0;
+	std::atomic<_Data *> *buckets = nullptr;
+};
+
+struct alignas(64) StringName::Shard {
+	Mutex mutex;
+	std::atomic<Table *> table{ nullptr };
+	// Odd while rehashing, so lock-free misses can be trusted otherwise.
+	std::atomic<uint32_t> version{ 0 };
+	// Lets readers check for memory to reclaim without locking.
+	std::atomic<uint32_t> retired_count{ 0 };
+	uint32_t count = 0;
+
+	LocalVector<StringNameRetired<_Data>> retired_data;
+	LocalVector<StringNameRetired<Table>> retired_tables;
+};
+
+StringName::Shard StringName::shards[STRING_TABLE_SHARDS];
 
 StringName _scs_create(const char *p_chr, bool p_static) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
@@ -52,10 +180,44 @@ Mutex StringName::mutex;
 bool StringName::debug_stringname = false;
 #endif
 
+// Compare without building a String out of static C strings.
+static _FORCE_INLINE_ bool _name_equals(const char *p_cname, const String &p_name, const char *p_other) {
+	return p_cname ? strcmp(p_cname, p_other) == 0 : p_name == p_other;
+}
+
+static _FORCE_INLINE_ bool _name_equals(const char *p_cname, const String &p_name, const char32_t *p_other) {
+	return p_cname ? String(p_cname) == p_other : p_name == p_other;
+}
+
+static _FORCE_INLINE_ bool _name_equals(const char *p_cname, const String &p_name, const String &p_other) {
+	return p_cname ? p_other == p_cname : p_name == p_other;
+}
+
+_FORCE_INLINE_ StringName::Shard &StringName::_get_shard(uint32_t p_hash) {
+	// Buckets use the low bits, so pick the shard with the high ones, mixed so
+	// that short names (with small hashes) are spread too.
+	return shards[(p_hash * 0x9E3779B1u) >> (32 - STRING_TABLE_SHARD_BITS)];
+}
+
+StringName::Table *StringName::_table_create(uint32_t p_size) {
+	Table *table = memnew(Table);
+	table->mask = p_size - 1;
+	table->buckets = memnew_arr(std::atomic<_Data *>, p_size);
+	for (uint32_t i = 0; i < p_size; i++) {
+		table->buckets[i].store(nullptr, std::memory_order_relaxed);
+	}
+	return table;
+}
+
+void StringName::_table_free(Table *p_table) {
+	memdelete_arr(p_table->buckets);
+	memdelete(p_table);
+}
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
+	for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+		shards[i].table.store(_table_create(STRING_TABLE_MIN_BUCKETS));
 	}
 	configured = true;
 }
@@ -66,11 +228,14 @@ void StringName::cleanup() {
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
-			while (d) {
-				data.push_back(d);
-				d = d->next;
+		for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+			Table *table = shards[i].table.load();
+			for (uint32_t j = 0; j <= table->mask; j++) {
+				_Data *d = table->buckets[j].load();
+				while (d) {
+					data.push_back(d);
+					d = d->next.load();
+				}
 			}
 		}
 
@@ -80,10 +245,10 @@ void StringName::cleanup() {
 		int unreferenced_stringnames = 0;
 		int rarely_referenced_stringnames = 0;
 		for (int i = 0; i < data.size(); i++) {
-			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references));
-			if (data[i]->debug_references == 0) {
+			print_line(itos(i + 1) + ": " + data[i]->get_name() + " - " + itos(data[i]->debug_references.get()));
+			if (data[i]->debug_references.get() == 0) {
 				unreferenced_stringnames += 1;
-			} else if (data[i]->debug_references < 5) {
+			} else if (data[i]->debug_references.get() < 5) {
 				rarely_referenced_stringnames += 1;
 			}
 		}
@@ -93,22 +258,44 @@ void StringName::cleanup() {
 	}
 #endif
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
-			if (d->static_count.get() != d->refcount.get()) {
-				lost_strings++;
+	for (int i = 0; i < STRING_TABLE_SHARDS; i++) {
+		Shard &shard = shards[i];
+		MutexLock shard_lock(shard.mutex);
+
+		Table *table = shard.table.load();
+		for (uint32_t j = 0; j <= table->mask; j++) {
+			_Data *d = table->buckets[j].load();
+			while (d) {
+				if (d->static_count.get() != d->refcount.get()) {
+					lost_strings++;
 
-				if (OS::get_singleton()->is_stdout_verbose()) {
-					String dname = String(d->cname ? d->cname : d->name);
+					if (OS::get_singleton()->is_stdout_verbose()) {
+						String dname = String(d->cname ? d->cname : d->name);
 
-					print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", dname, d->static_count.get(), d->refcount.get()));
+						print_line(vformat("Orphan StringName: %s (static: %d, total: %d)", dname, d->static_count.get(), d->refcount.get()));
+					}
 				}
+
+				_Data *next = d->next.load();
+				memdelete(d);
+				d = next;
 			}
+		}
+
+		_table_free(table);
+		shard.table.store(nullptr);
+		shard.count = 0;
 
-			_table[i] = _table[i]->next;
-			memdelete(d);
+		// No reader can be left at this point.
+		for (const StringNameRetired<_Data> &retired : shard.retired_data) {
+			memdelete(retired.ptr);
+		}
+		shard.retired_data.reset();
+		for (const StringNameRetired<Table> &retired : shard.retired_tables) {
+			_table_free(retired.ptr);
 		}
+		shard.retired_tables.reset();
+		shard.retired_count.store(0);
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
@@ -116,11 +303,210 @@ void StringName::cleanup() {
 	configured = false;
 }
 
+void StringName::_reclaim(Shard &p_shard) {
+	if (p_shard.retired_data.is_empty() && p_shard.retired_tables.is_empty()) {
+		return;
+	}
+
+	const uint64_t oldest_epoch = _oldest_reader_epoch();
+
+	uint32_t kept = 0;
+	for (uint32_t i = 0; i < p_shard.retired_data.size(); i++) {
+		if (p_shard.retired_data[i].epoch < oldest_epoch) {
+			memdelete(p_shard.retired_data[i].ptr);
+		} else {
+			p_shard.retired_data[kept++] = p_shard.retired_data[i];
+		}
+	}
+	p_shard.retired_data.resize(kept);
+
+	kept = 0;
+	for (uint32_t i = 0; i < p_shard.retired_tables.size(); i++) {
+		if (p_shard.retired_tables[i].epoch < oldest_epoch) {
+			_table_free(p_shard.retired_tables[i].ptr);
+		} else {
+			p_shard.retired_tables[kept++] = p_shard.retired_tables[i];
+		}
+	}
+	p_shard.retired_tables.resize(kept);
+
+	p_shard.retired_count.store(p_shard.retired_data.size() + p_shard.retired_tables.size(), std::memory_order_relaxed);
+}
+
+// Readers that start after these get a later epoch, and can't reach the memory anymore.
+
+void StringName::_retire_data(Shard &p_shard, _Data *p_data) {
+	p_shard.retired_data.push_back({ p_data, reader_epoch.fetch_add(1) });
+	_reclaim(p_shard);
+}
+
+void StringName::_retire_table(Shard &p_shard, Table *p_table) {
+	p_shard.retired_tables.push_back({ p_table, reader_epoch.fetch_add(1) });
+	_reclaim(p_shard);
+}
+
+void StringName::_grow(Shard &p_shard) {
+	Table *old_table = p_shard.table.load(std::memory_order_relaxed);
+	Table *table = _table_create((old_table->mask + 1) * 2);
+
+	p_shard.version.fetch_add(1);
+
+	// Relink the entries in place. A concurrent reader may be sent to another
+	// chain and miss its entry, but never loops nor sees freed memory, and the
+	// version change makes it retry with the lock.
+	for (uint32_t i = 0; i <= old_table->mask; i++) {
+		_Data *d = old_table->buckets[i].load(std::memory_order_relaxed);
+		while (d) {
+			_Data *next = d->next.load(std::memory_order_relaxed);
+			std::atomic<_Data *> &bucket = table->buckets[d->hash & table->mask];
+			_Data *head = bucket.load(std::memory_order_relaxed);
+			d->prev = nullptr;
+			d->next.store(head);
+			if (head) {
+				head->prev = d;
+			}
+			bucket.store(d);
+			d = next;
+		}
+	}
+
+	p_shard.table.store(table);
+	p_shard.version.fetch_add(1);
+
+	_retire_table(p_shard, old_table);
+}
+
+template <typename T>
+StringName::_Data *StringName::_find_locked(Shard &p_shard, uint32_t p_hash, const T &p_name) {
+	Table *table = p_shard.table.load(std::memory_order_relaxed);
+	_Data *d = table->buckets[p_hash & table->mask].load(std::memory_order_relaxed);
+
+	while (d) {
+		// compare hash first
+		if (d->hash == p_hash && _name_equals(d->cname, d->name, p_name) && d->refcount.ref()) {
+			return d;
+		}
+		d = d->next.load(std::memory_order_relaxed);
+	}
+
+	return nullptr;
+}
+
+template <typename T>
+StringName::_Data *StringName::_find_lock_free(Shard &p_shard, uint32_t p_hash, const T &p_name, bool &r_certain) {
+	StringNameReaderSlot *slot = _reader_enter();
+
+	const uint32_t version = p_shard.version.load();
+	Table *table = p_shard.table.load();
+	_Data *d = table->buckets[p_hash & table->mask].load();
+
+	while (d) {
+		// compare hash first
+		if (d->hash == p_hash && _name_equals(d->cname, d->name, p_name) && d->refcount.ref()) {
+			break;
+		}
+		d = d->next.load();
+	}
+
+	// A miss is only certain if no rehash happened meanwhile.
+	r_certain = d != nullptr || ((version & 1) == 0 && p_shard.version.load() == version);
+
+	_reader_exit(slot);
+
+	// Writers reclaim too, but names may not be created or released in this
+	// shard again for a while.
+	if (unlikely(p_shard.retired_count.load(std::memory_order_relaxed) != 0) && p_shard.mutex.try_lock()) {
+		_reclaim(p_shard);
+		p_shard.mutex.unlock();
+	}
+	return d;
+}
+
+template <typename T>
+StringName::_Data *StringName::_find(uint32_t p_hash, const T &p_name) {
+	Shard &shard = _get_shard(p_hash);
+
+	bool certain = false;
+	_Data *d = _find_lock_free(shard, p_hash, p_name, certain);
+	if (certain) {
+		return d;
+	}
+
+	MutexLock lock(shard.mutex);
+	return _find_locked(shard, p_hash, p_name);
+}
+
+template <typename T>
+StringName::_Data *StringName::_find_or_create(uint32_t p_hash, const T &p_name, const char *p_cname, bool p_static) {
+	Shard &shard = _get_shard(p_hash);
+
+	bool certain = false;
+	_Data *d = _find_lock_free(shard, p_hash, p_name, certain);
+
+	if (!d) {
+		MutexLock lock(shard.mutex);
+
+		// Someone else may have added it in the meantime.
+		d = _find_locked(shard, p_hash, p_name);
+
+		if (!d) {
+			d = memnew(_Data);
+			if (p_cname) {
+				d->cname = p_cname;
+			} else {
+				d->name = p_name;
+			}
+			d->refcount.init();
+			d->static_count.set(p_static ? 1 : 0);
+			d->hash = p_hash;
+			d->prev = nullptr;
+
+#ifdef DEBUG_ENABLED
+			if (unlikely(debug_stringname)) {
+				// Keep in memory, force static.
+				d->refcount.ref();
+				d->static_count.increment();
+			}
+#endif
+
+			Table *table = shard.table.load(std::memory_order_relaxed);
+			std::atomic<_Data *> &bucket = table->buckets[p_hash & table->mask];
+			_Data *head = bucket.load(std::memory_order_relaxed);
+			d->next.store(head, std::memory_order_relaxed);
+			if (head) {
+				head->prev = d;
+			}
+			// Publish the fully built entry.
+			bucket.store(d);
+
+			shard.count++;
+			if (shard.count > (table->mask + 1) * 2) {
+				_grow(shard);
+			} else {
+				_reclaim(shard);
+			}
+			return d;
+		}
+	}
+
+	// exists
+	if (p_static) {
+		d->static_count.increment();
+	}
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		d->debug_references.increment();
+	}
+#endif
+	return d;
+}
+
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(mutex);
+		Shard &shard = _get_shard(_data->hash);
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			if (_data->cname) {
@@ -129,19 +515,26 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
+
+		_Data *next = _data->next.load(std::memory_order_relaxed);
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.store(next);
 		} else {
-			if (_table[_data->idx] != _data) {
+			Table *table = shard.table.load(std::memory_order_relaxed);
+			std::atomic<_Data *> &bucket = table->buckets[_data->hash & table->mask];
+			if (bucket.load(std::memory_order_relaxed) != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			bucket.store(next);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = _data->prev;
 		}
-		memdelete(_data);
+
+		// Lock-free readers may still be looking at it.
+		shard.count--;
+		_retire_data(shard, _data);
 	}
 
 	_data = nullptr;
@@ -216,56 +609,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _find_or_create(String::hash(p_name), p_name, nullptr, p_static);
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -275,55 +619,7 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_static_string.ptr);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_static_string.ptr) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _find_or_create(String::hash(p_static_string.ptr), p_static_string.ptr, p_static_string.ptr, p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -335,54 +631,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_data = _table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
+	_data = _find_or_create(p_name.hash(), p_name, nullptr, p_static);
 }
 
 StringName StringName::search(const char *p_name) {
@@ -393,25 +642,12 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_Data *_data = _find(String::hash(p_name), p_name);
 
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			_data->debug_references.increment();
 		}
 #endif
 
@@ -429,23 +665,9 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = String::hash(p_name);
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->get_name() == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_Data *_data = _find(String::hash(p_name), p_name);
 
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 		return StringName(_data);
 	}
 
@@ -455,26 +677,12 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
-	uint32_t hash = p_name.hash();
-
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && p_name == _data->get_name()) {
-			break;
-		}
-		_data = _data->next;
-	}
+	_Data *_data = _find(p_name.hash(), p_name);
 
-	if (_data && _data->refcount.ref()) {
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
+			_data->debug_references.increment();
 		}
 #endif
 		return StringName(_data);
@@ -46,9 +46,9 @@ struct StaticCString {
 
 class StringName {
 	enum {
-		STRING_TABLE_BITS = 16,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_SHARD_BITS = 6,
+		STRING_TABLE_SHARDS = 1 << STRING_TABLE_SHARD_BITS,
+		STRING_TABLE_MIN_BUCKETS = 64, // Per shard, grows with the number of names.
 	};
 
 	struct _Data {
@@ -57,20 +57,39 @@ class StringName {
 		const char *cname = nullptr;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
-		int idx = 0;
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		_Data *prev = nullptr; // Only used with the shard locked.
+		std::atomic<_Data *> next{ nullptr }; // Also followed by lock-free lookups.
 		_Data() {}
 	};
 
-	static _Data *_table[STRING_TABLE_LEN];
+	struct Table;
+	struct Shard;
+
+	static Shard shards[STRING_TABLE_SHARDS];
 
 	_Data *_data = nullptr;
 
+	static Shard &_get_shard(uint32_t p_hash);
+
+	template <typename T>
+	static _Data *_find_locked(Shard &p_shard, uint32_t p_hash, const T &p_name);
+	template <typename T>
+	static _Data *_find_lock_free(Shard &p_shard, uint32_t p_hash, const T &p_name, bool &r_certain);
+	template <typename T>
+	static _Data *_find(uint32_t p_hash, const T &p_name);
+	template <typename T>
+	static _Data *_find_or_create(uint32_t p_hash, const T &p_name, const char *p_cname, bool p_static);
+	static Table *_table_create(uint32_t p_size);
+	static void _table_free(Table *p_table);
+	static void _grow(Shard &p_shard);
+	static void _reclaim(Shard &p_shard);
+	static void _retire_data(Shard &p_shard, _Data *p_data);
+	static void _retire_table(Shard &p_shard, Table *p_table);
+
 	void unref();
 	friend void register_core_types();
 	friend void unregister_core_types();
@@ -82,7 +101,7 @@ class StringName {
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
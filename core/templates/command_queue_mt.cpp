@@ -42,7 +42,8 @@ void CommandQueueMT::unlock() {
 }
 
 CommandQueueMT::CommandQueueMT() {
-	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	command_mem[0].reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	command_mem[1].reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
 }
 
 CommandQueueMT::~CommandQueueMT() {
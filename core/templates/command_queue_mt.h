@@ -35,8 +35,10 @@
 #include "core/os/condition_variable.h"
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
@@ -328,22 +330,31 @@ class CommandQueueMT {
 	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
 
 	BinaryMutex mutex;
-	LocalVector<uint8_t> command_mem;
+	// Double-buffered: producers push into one buffer while the other one is being flushed,
+	// so the mutex is only held to append or swap, never while commands are running.
+	LocalVector<uint8_t> command_mem[2];
+	uint32_t push_mem_index = 0;
 	ConditionVariable sync_cond_var;
 	uint32_t sync_head = 0;
 	uint32_t sync_tail = 0;
 	uint32_t sync_awaiters = 0;
 	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
-	uint64_t flush_read_ptr = 0;
+	// Set on push, cleared when the buffers are swapped. Lets flush_if_pending() check without the lock.
+	SafeFlag commands_pending;
+	// Thread running the commands, if any. Read without the lock to detect re-entrant flushes.
+	SafeNumeric<Thread::ID> flushing_thread_id;
+	ConditionVariable flush_cond_var;
 
 	template <typename T>
 	T *allocate() {
 		// alloc size is size+T+safeguard
+		LocalVector<uint8_t> &push_mem = command_mem[push_mem_index];
 		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + 8);
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		T *cmd = memnew_placement(&command_mem[size + 8], T);
+		uint64_t size = push_mem.size();
+		push_mem.resize(size + alloc_size + 8);
+		*(uint64_t *)&push_mem[size] = alloc_size;
+		T *cmd = memnew_placement(&push_mem[size + 8], T);
+		commands_pending.set();
 		return cmd;
 	}
 
@@ -357,40 +368,53 @@ class CommandQueueMT {
 	}
 
 	void _flush() {
-		if (unlikely(flush_read_ptr)) {
+		const Thread::ID caller_id = Thread::get_caller_id();
+		if (unlikely(flushing_thread_id.get() == caller_id)) {
 			// Re-entrant call.
 			return;
 		}
 
-		lock();
+		MutexLock mlock(mutex);
 
-		WorkerThreadPool::thread_enter_command_queue_mt_flush(this);
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			cmd->call();
-			if (unlikely(cmd->sync)) {
-				sync_head++;
-				unlock(); // Give an opportunity to awaiters right away.
-				sync_cond_var.notify_all();
-				lock();
+		// Another thread is running the commands. Wait for it as if it held the lock for the
+		// whole flush, so that this call still returns only once the commands pushed before it ran.
+		while (flushing_thread_id.get() != Thread::UNASSIGNED_ID) {
+			flush_cond_var.wait(mlock);
+		}
+		flushing_thread_id.set(caller_id);
+
+		while (command_mem[push_mem_index].size()) {
+			// Take the pending commands; anything pushed from now on goes to the other buffer
+			// and is picked up in the next iteration, so the overall order is kept.
+			LocalVector<uint8_t> &flush_mem = command_mem[push_mem_index];
+			push_mem_index ^= 1;
+			commands_pending.clear();
+			unlock();
+
+			uint64_t read_ptr = 0;
+			while (read_ptr < flush_mem.size()) {
+				uint64_t size = *(uint64_t *)&flush_mem[read_ptr];
+				read_ptr += 8;
+				CommandBase *cmd = reinterpret_cast<CommandBase *>(&flush_mem[read_ptr]);
+				cmd->call();
+				if (unlikely(cmd->sync)) {
+					lock();
+					sync_head++;
+					unlock();
+					sync_cond_var.notify_all();
+				}
+				cmd->~CommandBase();
+
+				read_ptr += size;
 			}
+			flush_mem.clear();
 
-			// If the command involved reallocating the buffer, the address may have changed.
-			cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-			cmd->~CommandBase();
-
-			flush_read_ptr += size;
+			lock();
 		}
-		WorkerThreadPool::thread_exit_command_queue_mt_flush();
-
-		command_mem.clear();
-		flush_read_ptr = 0;
 
+		flushing_thread_id.set(Thread::UNASSIGNED_ID);
 		_prevent_sync_wraparound();
-
-		unlock();
+		flush_cond_var.notify_all();
 	}
 
 	_FORCE_INLINE_ void _wait_for_sync(MutexLock<BinaryMutex> &p_lock) {
@@ -422,7 +446,7 @@ public:
 	SPACE_SEP_LIST(DECL_PUSH_AND_SYNC, 15)
 
 	_FORCE_INLINE_ void flush_if_pending() {
-		if (unlikely(command_mem.size() > 0)) {
+		if (unlikely(commands_pending.is_set())) {
 			_flush();
 		}
 	}
@@ -164,6 +164,7 @@ private:
 	void _ref(const CowData *p_from);
 	void _ref(const CowData &p_from);
 	USize _copy_on_write();
+	void _copy_to_unique(USize p_alloc_elements, USize p_copy_elements);
 
 public:
 	void operator=(const CowData<T> &p_from) { _ref(p_from); }
@@ -268,6 +269,31 @@ void CowData<T>::_unref(void *p_data) {
 	Memory::free_static(((uint8_t *)p_data) - DATA_OFFSET, false);
 }
 
+template <typename T>
+void CowData<T>::_copy_to_unique(USize p_alloc_elements, USize p_copy_elements) {
+	uint8_t *mem_new = (uint8_t *)Memory::alloc_static(_get_alloc_size(p_alloc_elements) + DATA_OFFSET, false);
+	ERR_FAIL_NULL(mem_new);
+
+	SafeNumeric<USize> *_refc_ptr = _get_refcount_ptr(mem_new);
+	USize *_size_ptr = _get_size_ptr(mem_new);
+	T *_data_ptr = _get_data_ptr(mem_new);
+
+	new (_refc_ptr) SafeNumeric<USize>(1); //refcount
+	*(_size_ptr) = p_copy_elements; //size
+
+	// initialize new elements
+	if constexpr (std::is_trivially_copyable_v<T>) {
+		memcpy((uint8_t *)_data_ptr, _ptr, p_copy_elements * sizeof(T));
+	} else {
+		for (USize i = 0; i < p_copy_elements; i++) {
+			memnew_placement(&_data_ptr[i], T(_ptr[i]));
+		}
+	}
+
+	_unref(_ptr);
+	_ptr = _data_ptr;
+}
+
 template <typename T>
 typename CowData<T>::USize CowData<T>::_copy_on_write() {
 	if (!_ptr) {
@@ -280,29 +306,12 @@ typename CowData<T>::USize CowData<T>::_copy_on_write() {
 	if (unlikely(rc > 1)) {
 		/* in use by more than me */
 		USize current_size = *_get_size();
-
-		uint8_t *mem_new = (uint8_t *)Memory::alloc_static(_get_alloc_size(current_size) + DATA_OFFSET, false);
-		ERR_FAIL_NULL_V(mem_new, 0);
-
-		SafeNumeric<USize> *_refc_ptr = _get_refcount_ptr(mem_new);
-		USize *_size_ptr = _get_size_ptr(mem_new);
-		T *_data_ptr = _get_data_ptr(mem_new);
-
-		new (_refc_ptr) SafeNumeric<USize>(1); //refcount
-		*(_size_ptr) = current_size; //size
-
-		// initialize new elements
-		if constexpr (std::is_trivially_copyable_v<T>) {
-			memcpy((uint8_t *)_data_ptr, _ptr, current_size * sizeof(T));
-		} else {
-			for (USize i = 0; i < current_size; i++) {
-				memnew_placement(&_data_ptr[i], T(_ptr[i]));
-			}
+		T *old_ptr = _ptr;
+		_copy_to_unique(current_size, current_size);
+		if (unlikely(_ptr == old_ptr)) {
+			return 0; // allocation failed, still shared
 		}
 
-		_unref(_ptr);
-		_ptr = _data_ptr;
-
 		rc = 1;
 	}
 	return rc;
@@ -326,13 +335,22 @@ Error CowData<T>::resize(Size p_size) {
 		return OK;
 	}
 
-	// possibly changing size, copy on write
-	USize rc = _copy_on_write();
-
 	USize current_alloc_size = _get_alloc_size(current_size);
 	USize alloc_size;
 	ERR_FAIL_COND_V(!_get_alloc_size_checked(p_size, &alloc_size), ERR_OUT_OF_MEMORY);
 
+	// possibly changing size, copy on write
+	USize rc = _ptr ? _get_refcount()->get() : 0;
+	if (unlikely(rc > 1)) {
+		// Shared: copy straight into a buffer of the target size, instead of
+		// duplicating at the current size and reallocating right after.
+		T *old_ptr = _ptr;
+		_copy_to_unique(p_size, MIN(current_size, p_size));
+		ERR_FAIL_COND_V(_ptr == old_ptr, ERR_OUT_OF_MEMORY);
+		current_alloc_size = alloc_size;
+		rc = 1;
+	}
+
 	if (p_size > current_size) {
 		if (alloc_size != current_alloc_size) {
 			if (current_size == 0) {
@@ -0,0 +1,681 @@
+/**************************************************************************/
+/*  flat_hash_map.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FLAT_HASH_MAP_H
+#define FLAT_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FLAT_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define FLAT_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// A group of control bytes, probed all at once.
+// Each control byte is either EMPTY, DELETED, or holds the 7 lowest bits of
+// the hash of the entry stored in the matching slot.
+struct FlatHashMapGroup {
+	static constexpr uint32_t SIZE = 16;
+	static constexpr int8_t EMPTY = -128;
+	static constexpr int8_t DELETED = -2;
+
+#ifdef FLAT_HASH_MAP_NEON
+	// There is no movemask on NEON; narrow each byte to a nibble instead, and
+	// keep a single bit per nibble.
+	static constexpr uint32_t MASK_SHIFT = 2;
+
+	int8x16_t ctrl;
+
+	static _FORCE_INLINE_ uint64_t _to_mask(uint8x16_t p_match) {
+		const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(p_match), 4);
+		return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull;
+	}
+
+	_FORCE_INLINE_ explicit FlatHashMapGroup(const int8_t *p_ctrl) { ctrl = vld1q_s8(p_ctrl); }
+	_FORCE_INLINE_ uint64_t match(int8_t p_h2) const { return _to_mask(vceqq_s8(ctrl, vdupq_n_s8(p_h2))); }
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const { return _to_mask(vcltzq_s8(ctrl)); }
+#elif defined(FLAT_HASH_MAP_SSE2)
+	static constexpr uint32_t MASK_SHIFT = 0;
+
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit FlatHashMapGroup(const int8_t *p_ctrl) { ctrl = _mm_loadu_si128((const __m128i *)p_ctrl); }
+	_FORCE_INLINE_ uint64_t match(int8_t p_h2) const { return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(p_h2))); }
+	// EMPTY and DELETED are the only negative values.
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const { return (uint32_t)_mm_movemask_epi8(ctrl); }
+#else
+	static constexpr uint32_t MASK_SHIFT = 0;
+
+	const int8_t *ctrl = nullptr;
+
+	_FORCE_INLINE_ explicit FlatHashMapGroup(const int8_t *p_ctrl) { ctrl = p_ctrl; }
+	_FORCE_INLINE_ uint64_t match(int8_t p_h2) const {
+		uint64_t mask = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			mask |= uint64_t(ctrl[i] == p_h2) << i;
+		}
+		return mask;
+	}
+	_FORCE_INLINE_ uint64_t match_empty_or_deleted() const {
+		uint64_t mask = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			mask |= uint64_t(ctrl[i] < 0) << i;
+		}
+		return mask;
+	}
+#endif
+
+	_FORCE_INLINE_ uint64_t match_empty() const { return match(EMPTY); }
+
+	// Index of the first slot set in a non-zero mask.
+	static _FORCE_INLINE_ uint32_t lowest(uint64_t p_mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long index;
+		if ((uint32_t)p_mask != 0) {
+			_BitScanForward(&index, (uint32_t)p_mask);
+		} else {
+			_BitScanForward(&index, (uint32_t)(p_mask >> 32));
+			index += 32;
+		}
+		return uint32_t(index) >> MASK_SHIFT;
+#else
+		return uint32_t(__builtin_ctzll(p_mask)) >> MASK_SHIFT;
+#endif
+	}
+};
+
+/**
+ * A flat hash map based on the "Swiss table" design: open addressing over
+ * groups of 16 slots, with one control byte per slot holding 7 bits of the
+ * hash. A whole group is checked with a couple of SIMD instructions, so most
+ * lookups touch a single cache line of metadata and compare a single key.
+ *
+ * Keys and values are stored contiguously in a dense array, not in separately
+ * allocated nodes, so inserting does not allocate (unless growing) and
+ * iterating is a linear walk. The flip side is that, unlike HashMap, pointers
+ * and iterators to entries are invalidated when the map grows, and by erase.
+ *
+ * By default, erase moves the last entry into the erased one, which does not
+ * preserve ordering. When `ordered` is true, entries are always iterated in
+ * insertion order instead; erased entries leave a hole that is reclaimed on
+ * the next rehash.
+ *
+ * The assignment operator copy the pairs from one map to the other.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>,
+		bool ordered = false>
+class FlatHashMap {
+public:
+	static constexpr uint32_t GROUP_SIZE = FlatHashMapGroup::SIZE;
+	static constexpr uint32_t EMPTY_HASH = 0;
+
+private:
+	typedef KeyValue<TKey, TValue> Entry;
+
+	int8_t *ctrl = nullptr;
+	// Entry index for each slot.
+	uint32_t *slots = nullptr;
+
+	// Dense entry storage. An EMPTY_HASH marks a hole left by erase, which can
+	// only happen in ordered mode.
+	KeyValue<TKey, TValue> *entries = nullptr;
+	uint32_t *hashes = nullptr;
+	uint32_t *entry_slots = nullptr;
+
+	uint32_t num_groups = 0;
+	uint32_t num_elements = 0;
+	uint32_t num_entries = 0;
+	uint32_t growth_left = 0;
+
+	static _FORCE_INLINE_ uint32_t _max_load(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	_FORCE_INLINE_ uint32_t _hash(const TKey &p_key) const {
+		// The low bits go to the control bytes, the high ones select the group;
+		// mix so both are usable even with weak hashes.
+		uint32_t hash = hash_fmix32(Hasher::hash(p_key));
+
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	static _FORCE_INLINE_ int8_t _h2(uint32_t p_hash) {
+		return int8_t(p_hash & 0x7F);
+	}
+
+	bool _lookup_index(const TKey &p_key, uint32_t &r_index) const {
+		if (num_elements == 0) {
+			return false; // Failed lookups, no elements
+		}
+
+		const uint32_t hash = _hash(p_key);
+		const int8_t h2 = _h2(hash);
+		const uint32_t group_mask = num_groups - 1;
+		uint32_t group = (hash >> 7) & group_mask;
+
+		// Triangular probing visits every group once with a power of two count.
+		for (uint32_t step = 1;; step++) {
+			const FlatHashMapGroup g(ctrl + group * GROUP_SIZE);
+			for (uint64_t match = g.match(h2); match != 0; match &= match - 1) {
+				const uint32_t index = slots[group * GROUP_SIZE + FlatHashMapGroup::lowest(match)];
+				if (hashes[index] == hash && Comparator::compare(entries[index].key, p_key)) {
+					r_index = index;
+					return true;
+				}
+			}
+
+			if (g.match_empty() != 0) {
+				return false;
+			}
+
+			group = (group + step) & group_mask;
+		}
+	}
+
+	uint32_t _find_free_slot(uint32_t p_hash) const {
+		const uint32_t group_mask = num_groups - 1;
+		uint32_t group = (p_hash >> 7) & group_mask;
+
+		for (uint32_t step = 1;; step++) {
+			const uint64_t mask = FlatHashMapGroup(ctrl + group * GROUP_SIZE).match_empty_or_deleted();
+			if (mask != 0) {
+				return group * GROUP_SIZE + FlatHashMapGroup::lowest(mask);
+			}
+
+			group = (group + step) & group_mask;
+		}
+	}
+
+	void _set_slot(uint32_t p_slot, uint32_t p_hash, uint32_t p_index) {
+		if (ctrl[p_slot] == FlatHashMapGroup::EMPTY) {
+			growth_left--;
+		}
+		ctrl[p_slot] = _h2(p_hash);
+		slots[p_slot] = p_index;
+		entry_slots[p_index] = p_slot;
+	}
+
+	void _clear_slot(uint32_t p_slot) {
+		// If the group still has an empty slot, no probe sequence ever went past
+		// it, so the slot can be marked as empty rather than deleted.
+		const uint32_t group = p_slot / GROUP_SIZE;
+		if (FlatHashMapGroup(ctrl + group * GROUP_SIZE).match_empty() != 0) {
+			ctrl[p_slot] = FlatHashMapGroup::EMPTY;
+			growth_left++;
+		} else {
+			ctrl[p_slot] = FlatHashMapGroup::DELETED;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_num_groups) {
+		const uint32_t capacity = p_new_num_groups * GROUP_SIZE;
+		const uint32_t entry_capacity = _max_load(capacity);
+
+		int8_t *new_ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(sizeof(int8_t) * capacity));
+		uint32_t *new_slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		KeyValue<TKey, TValue> *new_entries = reinterpret_cast<KeyValue<TKey, TValue> *>(Memory::alloc_static(sizeof(KeyValue<TKey, TValue>) * entry_capacity));
+		uint32_t *new_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * entry_capacity));
+		uint32_t *new_entry_slots = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * entry_capacity));
+
+		memset(new_ctrl, FlatHashMapGroup::EMPTY, capacity);
+
+		KeyValue<TKey, TValue> *old_entries = entries;
+		uint32_t *old_hashes = hashes;
+		const uint32_t old_num_entries = num_entries;
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+			Memory::free_static(entry_slots);
+		}
+
+		ctrl = new_ctrl;
+		slots = new_slots;
+		entries = new_entries;
+		hashes = new_hashes;
+		entry_slots = new_entry_slots;
+		num_groups = p_new_num_groups;
+		growth_left = entry_capacity;
+		num_entries = 0;
+
+		if (old_entries == nullptr) {
+			return;
+		}
+
+		// Copying in order also squeezes out the holes of ordered mode.
+		for (uint32_t i = 0; i < old_num_entries; i++) {
+			if (old_hashes[i] == EMPTY_HASH) {
+				continue;
+			}
+
+			memnew_placement(&entries[num_entries], Entry(old_entries[i]));
+			old_entries[i].~KeyValue<TKey, TValue>();
+			hashes[num_entries] = old_hashes[i];
+			_set_slot(_find_free_slot(old_hashes[i]), old_hashes[i], num_entries);
+			num_entries++;
+		}
+
+		Memory::free_static(old_entries);
+		Memory::free_static(old_hashes);
+	}
+
+	uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t index = 0;
+		if (_lookup_index(p_key, index)) {
+			entries[index].value = p_value;
+			return index;
+		}
+
+		if (unlikely(growth_left == 0 || num_entries == _max_load(num_groups * GROUP_SIZE))) {
+			uint32_t new_num_groups = MAX(num_groups, 1u);
+			// Grow if the map is actually getting full; otherwise, rehashing in
+			// place is enough to reclaim deleted slots and holes.
+			if (num_groups == 0 || (num_elements + 1) * 2 > _max_load(num_groups * GROUP_SIZE)) {
+				ERR_FAIL_COND_V_MSG(num_groups > 0 && num_groups * GROUP_SIZE * 2 > (1u << 30), UINT32_MAX, "Hash table maximum capacity reached, aborting insertion.");
+				new_num_groups = num_groups == 0 ? new_num_groups : num_groups * 2;
+			}
+			// The arguments may point into this map, e.g. `map.insert(a, map[b])`, and
+			// rehashing moves every entry, so copy them first.
+			const TKey key = p_key;
+			const TValue value = p_value;
+			_resize_and_rehash(new_num_groups);
+			return _insert_new(key, value);
+		}
+
+		return _insert_new(p_key, p_value);
+	}
+
+	// Only call with room for one more entry and a key that isn't in the map.
+	uint32_t _insert_new(const TKey &p_key, const TValue &p_value) {
+		const uint32_t hash = _hash(p_key);
+		const uint32_t index = num_entries;
+		memnew_placement(&entries[index], Entry(p_key, p_value));
+		hashes[index] = hash;
+		_set_slot(_find_free_slot(hash), hash, index);
+		num_entries++;
+		num_elements++;
+		return index;
+	}
+
+	void _erase_index(uint32_t p_index) {
+		_clear_slot(entry_slots[p_index]);
+		entries[p_index].~KeyValue<TKey, TValue>();
+		num_elements--;
+
+		if constexpr (ordered) {
+			hashes[p_index] = EMPTY_HASH;
+			// Trailing holes can be reclaimed right away.
+			while (num_entries > 0 && hashes[num_entries - 1] == EMPTY_HASH) {
+				num_entries--;
+			}
+		} else {
+			const uint32_t last = num_entries - 1;
+			if (p_index != last) {
+				memnew_placement(&entries[p_index], Entry(entries[last]));
+				entries[last].~KeyValue<TKey, TValue>();
+				hashes[p_index] = hashes[last];
+				entry_slots[p_index] = entry_slots[last];
+				slots[entry_slots[p_index]] = p_index;
+			}
+			num_entries--;
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t _next_index(uint32_t p_index) const {
+		if constexpr (ordered) {
+			while (p_index < num_entries && hashes[p_index] == EMPTY_HASH) {
+				p_index++;
+			}
+		}
+		return p_index;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return num_groups * GROUP_SIZE; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr || num_entries == 0) {
+			return;
+		}
+
+		for (uint32_t i = 0; i < num_entries; i++) {
+			if (hashes[i] != EMPTY_HASH) {
+				entries[i].~KeyValue<TKey, TValue>();
+			}
+		}
+
+		memset(ctrl, FlatHashMapGroup::EMPTY, get_capacity());
+		growth_left = _max_load(get_capacity());
+		num_entries = 0;
+		num_elements = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t index = 0;
+		bool exists = _lookup_index(p_key, index);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return entries[index].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t index = 0;
+		bool exists = _lookup_index(p_key, index);
+		CRASH_COND_MSG(!exists, "FlatHashMap key not found.");
+		return entries[index].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t index = 0;
+		if (_lookup_index(p_key, index)) {
+			return &entries[index].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t index = 0;
+		if (_lookup_index(p_key, index)) {
+			return &entries[index].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _index = 0;
+		return _lookup_index(p_key, _index);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t index = 0;
+		if (!_lookup_index(p_key, index)) {
+			return false;
+		}
+
+		_erase_index(index);
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_num_groups = MAX(num_groups, 1u);
+		while (_max_load(new_num_groups * GROUP_SIZE) < p_new_capacity) {
+			ERR_FAIL_COND_MSG(new_num_groups * GROUP_SIZE * 2 > (1u << 30), "Hash table maximum capacity reached.");
+			new_num_groups *= 2;
+		}
+
+		if (new_num_groups == num_groups) {
+			return;
+		}
+
+		_resize_and_rehash(new_num_groups);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return map->entries[index];
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return &map->entries[index]; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (map) {
+				index = map->_next_index(index + 1);
+				if (index >= map->num_entries) {
+					map = nullptr;
+					index = 0;
+				}
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return map == b.map && index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return map != b.map || index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const FlatHashMap *p_map, uint32_t p_index) {
+			map = p_map;
+			index = p_index;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			map = p_it.map;
+			index = p_it.index;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			map = p_it.map;
+			index = p_it.index;
+		}
+
+	private:
+		const FlatHashMap *map = nullptr;
+		uint32_t index = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return map->entries[index];
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return &map->entries[index]; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (map) {
+				index = map->_next_index(index + 1);
+				if (index >= map->num_entries) {
+					map = nullptr;
+					index = 0;
+				}
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return map == b.map && index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return map != b.map || index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr;
+		}
+
+		_FORCE_INLINE_ Iterator(FlatHashMap *p_map, uint32_t p_index) {
+			map = p_map;
+			index = p_index;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			map = p_it.map;
+			index = p_it.index;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			map = p_it.map;
+			index = p_it.index;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, index);
+		}
+
+	private:
+		FlatHashMap *map = nullptr;
+		uint32_t index = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		if (num_elements == 0) {
+			return end();
+		}
+		return Iterator(this, _next_index(0));
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(nullptr, 0);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		if (num_elements == 0) {
+			return end();
+		}
+		// Trailing holes are always reclaimed, so the last entry is alive.
+		return Iterator(this, num_entries - 1);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t index = 0;
+		if (!_lookup_index(p_key, index)) {
+			return end();
+		}
+		return Iterator(this, index);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		if (num_elements == 0) {
+			return end();
+		}
+		return ConstIterator(this, _next_index(0));
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(nullptr, 0);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		if (num_elements == 0) {
+			return end();
+		}
+		return ConstIterator(this, num_entries - 1);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t index = 0;
+		if (!_lookup_index(p_key, index)) {
+			return end();
+		}
+		return ConstIterator(this, index);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t index = 0;
+		bool exists = _lookup_index(p_key, index);
+		CRASH_COND(!exists);
+		return entries[index].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t index = 0;
+		if (!_lookup_index(p_key, index)) {
+			index = _insert(p_key, TValue());
+			CRASH_COND(index == UINT32_MAX);
+		}
+		return entries[index].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		const uint32_t index = _insert(p_key, p_value);
+		if (index == UINT32_MAX) {
+			return end();
+		}
+		return Iterator(this, index);
+	}
+
+	/* Constructors */
+
+	FlatHashMap(const FlatHashMap &p_other) {
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const FlatHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	FlatHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	FlatHashMap() {}
+
+	~FlatHashMap() {
+		clear();
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+			Memory::free_static(entries);
+			Memory::free_static(hashes);
+			Memory::free_static(entry_slots);
+		}
+	}
+};
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+using OrderedFlatHashMap = FlatHashMap<TKey, TValue, Hasher, Comparator, true>;
+
+#endif // FLAT_HASH_MAP_H
@@ -40,6 +40,7 @@
 #include "core/variant/callable.h"
 #include "core/variant/dictionary.h"
 #include "core/variant/variant.h"
+#include "core/variant/variant_internal.h"
 
 class ArrayPrivate {
 public:
@@ -47,8 +48,101 @@ public:
 	Vector<Variant> array;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
 	ContainerTypeValidate typed;
+
+	// While `is_packed` is set, elements are stored in `packed` with `packed_stride` bytes each, and `array` is empty.
+	// Only write paths unpack the array, const methods read the packed elements as they are.
+	bool is_packed = false;
+	uint32_t packed_stride = 0;
+	Vector<uint8_t> packed;
 };
 
+static uint32_t _get_packed_stride(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::INT:
+			return sizeof(int64_t);
+		case Variant::FLOAT:
+			return sizeof(double);
+		case Variant::VECTOR2:
+			return sizeof(Vector2);
+		case Variant::VECTOR2I:
+			return sizeof(Vector2i);
+		case Variant::VECTOR3:
+			return sizeof(Vector3);
+		case Variant::VECTOR3I:
+			return sizeof(Vector3i);
+		case Variant::VECTOR4:
+			return sizeof(Vector4);
+		case Variant::VECTOR4I:
+			return sizeof(Vector4i);
+		case Variant::COLOR:
+			return sizeof(Color);
+		case Variant::QUATERNION:
+			return sizeof(Quaternion);
+		default:
+			return 0;
+	}
+}
+
+// Starts packing if the element type allows it, for arrays that were just typed or emptied.
+static void _init_packed(ArrayPrivate *p_array) {
+	p_array->packed_stride = _get_packed_stride(p_array->typed.type);
+	if (p_array->packed_stride > 0 && p_array->array.is_empty()) {
+		p_array->packed.clear();
+		p_array->is_packed = true;
+	}
+}
+
+_FORCE_INLINE_ static int _get_packed_size(const ArrayPrivate *p_array) {
+	return p_array->packed.size() / p_array->packed_stride;
+}
+
+_FORCE_INLINE_ static void _read_packed(const ArrayPrivate *p_array, int p_idx, Variant &r_value) {
+	VariantInternal::initialize(&r_value, p_array->typed.type);
+	memcpy(VariantInternal::get_opaque_pointer(&r_value), p_array->packed.ptr() + p_idx * p_array->packed_stride, p_array->packed_stride);
+}
+
+// The value must already be validated, so it has the element type.
+_FORCE_INLINE_ static void _write_packed(ArrayPrivate *p_array, int p_idx, const Variant &p_value) {
+	memcpy(p_array->packed.ptrw() + p_idx * p_array->packed_stride, VariantInternal::get_opaque_pointer(&p_value), p_array->packed_stride);
+}
+
+static Vector<Variant> _get_variants(const ArrayPrivate *p_array) {
+	if (!p_array->is_packed) {
+		return p_array->array;
+	}
+	Vector<Variant> variants;
+	variants.resize(_get_packed_size(p_array));
+	Variant *w = variants.ptrw();
+	for (int i = 0; i < variants.size(); i++) {
+		_read_packed(p_array, i, w[i]);
+	}
+	return variants;
+}
+
+// The values must already be validated.
+static void _set_variants(ArrayPrivate *p_array, const Vector<Variant> &p_variants) {
+	if (p_array->packed_stride == 0) {
+		p_array->array = p_variants;
+		return;
+	}
+	// Packs again arrays that were unpacked, since their contents are replaced anyway.
+	p_array->array.clear();
+	p_array->packed.resize(p_variants.size() * p_array->packed_stride);
+	for (int i = 0; i < p_variants.size(); i++) {
+		_write_packed(p_array, i, p_variants[i]);
+	}
+	p_array->is_packed = true;
+}
+
+void Array::_unpack() const {
+	if (likely(!_p->is_packed)) {
+		return;
+	}
+	_p->array = _get_variants(_p);
+	_p->packed.clear();
+	_p->is_packed = false;
+}
+
 void Array::_ref(const Array &p_from) const {
 	ArrayPrivate *_fp = p_from._p;
 
@@ -82,48 +176,83 @@ void Array::_unref() const {
 }
 
 Array::Iterator Array::begin() {
+	_unpack();
 	return Iterator(_p->array.ptrw(), _p->read_only);
 }
 
 Array::Iterator Array::end() {
+	_unpack();
 	return Iterator(_p->array.ptrw() + _p->array.size(), _p->read_only);
 }
 
 Array::ConstIterator Array::begin() const {
+	if (_p->is_packed) {
+		return ConstIterator(this, 0);
+	}
 	return ConstIterator(_p->array.ptr(), _p->read_only);
 }
 
 Array::ConstIterator Array::end() const {
+	if (_p->is_packed) {
+		return ConstIterator(this, _get_packed_size(_p));
+	}
 	return ConstIterator(_p->array.ptr() + _p->array.size(), _p->read_only);
 }
 
 Variant &Array::operator[](int p_idx) {
 	if (unlikely(_p->read_only)) {
-		*_p->read_only = _p->array[p_idx];
+		*_p->read_only = get_value(p_idx);
 		return *_p->read_only;
 	}
+	_unpack();
 	return _p->array.write[p_idx];
 }
 
+// Const references to packed elements point to one of these, since the array may be read by other
+// threads and can't be unpacked. A reference stays valid until this thread has read as many other
+// packed elements through const references.
+static constexpr uint32_t PACKED_READ_VALUE_COUNT = 16;
+static thread_local Variant packed_read_values[PACKED_READ_VALUE_COUNT];
+static thread_local uint32_t packed_read_value_index = 0;
+
 const Variant &Array::operator[](int p_idx) const {
 	if (unlikely(_p->read_only)) {
-		*_p->read_only = _p->array[p_idx];
+		*_p->read_only = get_value(p_idx);
 		return *_p->read_only;
 	}
+	if (_p->is_packed) {
+		Variant &value = packed_read_values[packed_read_value_index++ % PACKED_READ_VALUE_COUNT];
+		value = get_value(p_idx);
+		return value;
+	}
+	return _p->array[p_idx];
+}
+
+Variant Array::get_value(int p_idx) const {
+	if (_p->is_packed) {
+		CRASH_BAD_INDEX(p_idx, _get_packed_size(_p));
+		Variant value;
+		_read_packed(_p, p_idx, value);
+		return value;
+	}
 	return _p->array[p_idx];
 }
 
 int Array::size() const {
+	if (_p->is_packed) {
+		return _get_packed_size(_p);
+	}
 	return _p->array.size();
 }
 
 bool Array::is_empty() const {
-	return _p->array.is_empty();
+	return size() == 0;
 }
 
 void Array::clear() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	_p->array.clear();
+	_init_packed(_p);
 }
 
 bool Array::operator==(const Array &p_array) const {
@@ -139,10 +268,8 @@ bool Array::recursive_equal(const Array &p_array, int recursion_count) const {
 	if (_p == p_array._p) {
 		return true;
 	}
-	const Vector<Variant> &a1 = _p->array;
-	const Vector<Variant> &a2 = p_array._p->array;
-	const int size = a1.size();
-	if (size != a2.size()) {
+	const int size = this->size();
+	if (size != p_array.size()) {
 		return false;
 	}
 
@@ -152,6 +279,17 @@ bool Array::recursive_equal(const Array &p_array, int recursion_count) const {
 		return true;
 	}
 	recursion_count++;
+	if (_p->is_packed || p_array._p->is_packed) {
+		for (int i = 0; i < size; i++) {
+			if (!get_value(i).hash_compare(p_array.get_value(i), recursion_count, false)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	const Vector<Variant> &a1 = _p->array;
+	const Vector<Variant> &a2 = p_array._p->array;
 	for (int i = 0; i < size; i++) {
 		if (!a1[i].hash_compare(a2[i], recursion_count, false)) {
 			return false;
@@ -168,9 +306,11 @@ bool Array::operator<(const Array &p_array) const {
 	int min_cmp = MIN(a_len, b_len);
 
 	for (int i = 0; i < min_cmp; i++) {
-		if (operator[](i) < p_array[i]) {
+		const Variant a = get_value(i);
+		const Variant b = p_array.get_value(i);
+		if (a < b) {
 			return true;
-		} else if (p_array[i] < operator[](i)) {
+		} else if (b < a) {
 			return false;
 		}
 	}
@@ -201,8 +341,8 @@ uint32_t Array::recursive_hash(int recursion_count) const {
 	uint32_t h = hash_murmur3_one_32(Variant::ARRAY);
 
 	recursion_count++;
-	for (int i = 0; i < _p->array.size(); i++) {
-		h = hash_murmur3_one_32(_p->array[i].recursive_hash(recursion_count), h);
+	for (int i = 0; i < size(); i++) {
+		h = hash_murmur3_one_32(get_value(i).recursive_hash(recursion_count), h);
 	}
 	return hash_fmix32(h);
 }
@@ -218,16 +358,26 @@ void Array::assign(const Array &p_array) {
 	const ContainerTypeValidate &typed = _p->typed;
 	const ContainerTypeValidate &source_typed = p_array._p->typed;
 
+	if (typed == source_typed && p_array._p->is_packed && _p->packed_stride > 0) {
+		// Shares the packed elements.
+		_p->array.clear();
+		_p->packed = p_array._p->packed;
+		_p->is_packed = true;
+		return;
+	}
+
+	const Vector<Variant> source_array = _get_variants(p_array._p);
+
 	if (typed == source_typed || typed.type == Variant::NIL || (source_typed.type == Variant::OBJECT && typed.can_reference(source_typed))) {
 		// from same to same or
 		// from anything to variants or
 		// from subclasses to base classes
-		_p->array = p_array._p->array;
+		_set_variants(_p, source_array);
 		return;
 	}
 
-	const Variant *source = p_array._p->array.ptr();
-	int size = p_array._p->array.size();
+	const Variant *source = source_array.ptr();
+	int size = source_array.size();
 
 	if ((source_typed.type == Variant::NIL && typed.type == Variant::OBJECT) || (source_typed.type == Variant::OBJECT && source_typed.can_reference(typed))) {
 		// from variants to objects or
@@ -238,7 +388,7 @@ void Array::assign(const Array &p_array) {
 				ERR_FAIL_MSG(vformat(R"(Unable to convert array index %i from "%s" to "%s".)", i, Variant::get_type_name(element.get_type()), Variant::get_type_name(typed.type)));
 			}
 		}
-		_p->array = p_array._p->array;
+		_p->array = source_array;
 		return;
 	}
 	if (typed.type == Variant::OBJECT || source_typed.type == Variant::OBJECT) {
@@ -276,30 +426,66 @@ void Array::assign(const Array &p_array) {
 		ERR_FAIL_MSG(vformat(R"(Cannot assign contents of "Array[%s]" to "Array[%s]".)", Variant::get_type_name(source_typed.type), Variant::get_type_name(typed.type)));
 	}
 
-	_p->array = array;
+	_set_variants(_p, array);
 }
 
 void Array::push_back(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "push_back"));
+	if (_p->is_packed) {
+		int size = _get_packed_size(_p);
+		_p->packed.resize((size + 1) * _p->packed_stride);
+		_write_packed(_p, size, value);
+		return;
+	}
+	_unpack();
 	_p->array.push_back(value);
 }
 
 void Array::append_array(const Array &p_array) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 
-	Vector<Variant> validated_array = p_array._p->array;
+	if (_p->is_packed && p_array._p->is_packed && _p->typed.type == p_array._p->typed.type) {
+		_p->packed.append_array(p_array._p->packed);
+		return;
+	}
+
+	Vector<Variant> validated_array = _get_variants(p_array._p);
 	for (int i = 0; i < validated_array.size(); ++i) {
 		ERR_FAIL_COND(!_p->typed.validate(validated_array.write[i], "append_array"));
 	}
 
+	if (_p->is_packed) {
+		int size = _get_packed_size(_p);
+		_p->packed.resize((size + validated_array.size()) * _p->packed_stride);
+		for (int i = 0; i < validated_array.size(); i++) {
+			_write_packed(_p, size + i, validated_array[i]);
+		}
+		return;
+	}
+	_unpack();
 	_p->array.append_array(validated_array);
 }
 
 Error Array::resize(int p_new_size) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, ERR_LOCKED, "Array is in read-only state.");
 	Variant::Type &variant_type = _p->typed.type;
+	if (_p->is_packed) {
+		ERR_FAIL_COND_V(p_new_size < 0, ERR_INVALID_PARAMETER);
+		int old_size = _get_packed_size(_p);
+		Error err = _p->packed.resize(p_new_size * _p->packed_stride);
+		if (!err && p_new_size > old_size) {
+			// Not all default values are zeroes, like the alpha of `Color()`.
+			Variant default_value;
+			VariantInternal::initialize(&default_value, variant_type);
+			for (int i = old_size; i < p_new_size; i++) {
+				_write_packed(_p, i, default_value);
+			}
+		}
+		return err;
+	}
+	_unpack();
 	int old_size = _p->array.size();
 	Error err = _p->array.resize_zeroed(p_new_size);
 	if (!err && variant_type != Variant::NIL && variant_type != Variant::OBJECT) {
@@ -314,6 +500,16 @@ Error Array::insert(int p_pos, const Variant &p_value) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, ERR_LOCKED, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "insert"), ERR_INVALID_PARAMETER);
+	if (_p->is_packed) {
+		int size = _get_packed_size(_p);
+		ERR_FAIL_INDEX_V(p_pos, size + 1, ERR_INVALID_PARAMETER);
+		_p->packed.resize((size + 1) * _p->packed_stride);
+		uint8_t *data = _p->packed.ptrw();
+		memmove(data + (p_pos + 1) * _p->packed_stride, data + p_pos * _p->packed_stride, (size - p_pos) * _p->packed_stride);
+		_write_packed(_p, p_pos, value);
+		return OK;
+	}
+	_unpack();
 	return _p->array.insert(p_pos, value);
 }
 
@@ -321,6 +517,13 @@ void Array::fill(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "fill"));
+	if (_p->is_packed) {
+		for (int i = 0; i < _get_packed_size(_p); i++) {
+			_write_packed(_p, i, value);
+		}
+		return;
+	}
+	_unpack();
 	_p->array.fill(value);
 }
 
@@ -328,26 +531,36 @@ void Array::erase(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "erase"));
+	if (_p->is_packed) {
+		for (int i = 0; i < _get_packed_size(_p); i++) {
+			if (get_value(i) == value) {
+				remove_at(i);
+				return;
+			}
+		}
+		return;
+	}
+	_unpack();
 	_p->array.erase(value);
 }
 
 Variant Array::front() const {
-	ERR_FAIL_COND_V_MSG(_p->array.is_empty(), Variant(), "Can't take value from empty array.");
-	return operator[](0);
+	ERR_FAIL_COND_V_MSG(is_empty(), Variant(), "Can't take value from empty array.");
+	return get_value(0);
 }
 
 Variant Array::back() const {
-	ERR_FAIL_COND_V_MSG(_p->array.is_empty(), Variant(), "Can't take value from empty array.");
-	return operator[](_p->array.size() - 1);
+	ERR_FAIL_COND_V_MSG(is_empty(), Variant(), "Can't take value from empty array.");
+	return get_value(size() - 1);
 }
 
 Variant Array::pick_random() const {
-	ERR_FAIL_COND_V_MSG(_p->array.is_empty(), Variant(), "Can't take value from empty array.");
-	return operator[](Math::rand() % _p->array.size());
+	ERR_FAIL_COND_V_MSG(is_empty(), Variant(), "Can't take value from empty array.");
+	return get_value(Math::rand() % size());
 }
 
 int Array::find(const Variant &p_value, int p_from) const {
-	if (_p->array.size() == 0) {
+	if (size() == 0) {
 		return -1;
 	}
 	Variant value = p_value;
@@ -360,7 +573,7 @@ int Array::find(const Variant &p_value, int p_from) const {
 	}
 
 	for (int i = p_from; i < size(); i++) {
-		if (StringLikeVariantComparator::compare(_p->array[i], value)) {
+		if (StringLikeVariantComparator::compare(get_value(i), value)) {
 			ret = i;
 			break;
 		}
@@ -370,7 +583,8 @@ int Array::find(const Variant &p_value, int p_from) const {
 }
 
 int Array::rfind(const Variant &p_value, int p_from) const {
-	if (_p->array.size() == 0) {
+	const int size = this->size();
+	if (size == 0) {
 		return -1;
 	}
 	Variant value = p_value;
@@ -378,15 +592,15 @@ int Array::rfind(const Variant &p_value, int p_from) const {
 
 	if (p_from < 0) {
 		// Relative offset from the end
-		p_from = _p->array.size() + p_from;
+		p_from = size + p_from;
 	}
-	if (p_from < 0 || p_from >= _p->array.size()) {
+	if (p_from < 0 || p_from >= size) {
 		// Limit to array boundaries
-		p_from = _p->array.size() - 1;
+		p_from = size - 1;
 	}
 
 	for (int i = p_from; i >= 0; i--) {
-		if (StringLikeVariantComparator::compare(_p->array[i], value)) {
+		if (StringLikeVariantComparator::compare(get_value(i), value)) {
 			return i;
 		}
 	}
@@ -397,13 +611,14 @@ int Array::rfind(const Variant &p_value, int p_from) const {
 int Array::count(const Variant &p_value) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "count"), 0);
-	if (_p->array.size() == 0) {
+	const int size = this->size();
+	if (size == 0) {
 		return 0;
 	}
 
 	int amount = 0;
-	for (int i = 0; i < _p->array.size(); i++) {
-		if (StringLikeVariantComparator::compare(_p->array[i], value)) {
+	for (int i = 0; i < size; i++) {
+		if (StringLikeVariantComparator::compare(get_value(i), value)) {
 			amount++;
 		}
 	}
@@ -420,6 +635,15 @@ bool Array::has(const Variant &p_value) const {
 
 void Array::remove_at(int p_pos) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_packed) {
+		int size = _get_packed_size(_p);
+		ERR_FAIL_INDEX(p_pos, size);
+		uint8_t *data = _p->packed.ptrw();
+		memmove(data + p_pos * _p->packed_stride, data + (p_pos + 1) * _p->packed_stride, (size - p_pos - 1) * _p->packed_stride);
+		_p->packed.resize((size - 1) * _p->packed_stride);
+		return;
+	}
+	_unpack();
 	_p->array.remove_at(p_pos);
 }
 
@@ -428,6 +652,11 @@ void Array::set(int p_idx, const Variant &p_value) {
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "set"));
 
+	if (_p->is_packed) {
+		CRASH_BAD_INDEX(p_idx, _get_packed_size(_p));
+		_write_packed(_p, p_idx, value);
+		return;
+	}
 	operator[](p_idx) = value;
 }
 
@@ -442,13 +671,21 @@ Array Array::duplicate(bool p_deep) const {
 Array Array::recursive_duplicate(bool p_deep, int recursion_count) const {
 	Array new_arr;
 	new_arr._p->typed = _p->typed;
+	_init_packed(new_arr._p);
 
 	if (recursion_count > MAX_RECURSION) {
 		ERR_PRINT("Max recursion reached");
 		return new_arr;
 	}
 
-	if (p_deep) {
+	if (new_arr._p->packed_stride > 0) {
+		// Elements are values, a deep copy is the same.
+		if (_p->is_packed) {
+			new_arr._p->packed = _p->packed;
+		} else {
+			_set_variants(new_arr._p, _p->array);
+		}
+	} else if (p_deep) {
 		recursion_count++;
 		int element_count = size();
 		new_arr.resize(element_count);
@@ -465,6 +702,7 @@ Array Array::recursive_duplicate(bool p_deep, int recursion_count) const {
 Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const {
 	Array result;
 	result._p->typed = _p->typed;
+	_init_packed(result._p);
 
 	ERR_FAIL_COND_V_MSG(p_step == 0, result, "Slice step cannot be zero.");
 
@@ -490,7 +728,7 @@ Array Array::slice(int p_begin, int p_end, int p_step, bool p_deep) const {
 	result.resize(result_size);
 
 	for (int src_idx = begin, dest_idx = 0; dest_idx < result_size; ++dest_idx) {
-		result[dest_idx] = p_deep ? get(src_idx).duplicate(true) : get(src_idx);
+		result.set(dest_idx, p_deep ? get_value(src_idx).duplicate(true) : get_value(src_idx));
 		src_idx += p_step;
 	}
 
@@ -501,11 +739,14 @@ Array Array::filter(const Callable &p_callable) const {
 	Array new_arr;
 	new_arr.resize(size());
 	new_arr._p->typed = _p->typed;
+	// Not packed, since the elements are set before the type.
+	new_arr._p->packed_stride = _get_packed_stride(_p->typed.type);
 	int accepted_count = 0;
 
 	const Variant *argptrs[1];
 	for (int i = 0; i < size(); i++) {
-		argptrs[0] = &get(i);
+		const Variant value = get_value(i);
+		argptrs[0] = &value;
 
 		Variant result;
 		Callable::CallError ce;
@@ -515,7 +756,7 @@ Array Array::filter(const Callable &p_callable) const {
 		}
 
 		if (result.operator bool()) {
-			new_arr[accepted_count] = get(i);
+			new_arr[accepted_count] = value;
 			accepted_count++;
 		}
 	}
@@ -531,7 +772,8 @@ Array Array::map(const Callable &p_callable) const {
 
 	const Variant *argptrs[1];
 	for (int i = 0; i < size(); i++) {
-		argptrs[0] = &get(i);
+		const Variant value = get_value(i);
+		argptrs[0] = &value;
 
 		Variant result;
 		Callable::CallError ce;
@@ -556,8 +798,9 @@ Variant Array::reduce(const Callable &p_callable, const Variant &p_accum) const
 
 	const Variant *argptrs[2];
 	for (int i = start; i < size(); i++) {
+		const Variant value = get_value(i);
 		argptrs[0] = &ret;
-		argptrs[1] = &get(i);
+		argptrs[1] = &value;
 
 		Variant result;
 		Callable::CallError ce;
@@ -574,7 +817,8 @@ Variant Array::reduce(const Callable &p_callable, const Variant &p_accum) const
 bool Array::any(const Callable &p_callable) const {
 	const Variant *argptrs[1];
 	for (int i = 0; i < size(); i++) {
-		argptrs[0] = &get(i);
+		const Variant value = get_value(i);
+		argptrs[0] = &value;
 
 		Variant result;
 		Callable::CallError ce;
@@ -596,7 +840,8 @@ bool Array::any(const Callable &p_callable) const {
 bool Array::all(const Callable &p_callable) const {
 	const Variant *argptrs[1];
 	for (int i = 0; i < size(); i++) {
-		argptrs[0] = &get(i);
+		const Variant value = get_value(i);
+		argptrs[0] = &value;
 
 		Variant result;
 		Callable::CallError ce;
@@ -627,18 +872,47 @@ struct _ArrayVariantSort {
 	}
 };
 
+// Reordering packed arrays goes through a temporary copy, and keeps them packed.
 void Array::sort() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_packed) {
+		Vector<Variant> variants = _get_variants(_p);
+		variants.sort_custom<_ArrayVariantSort>();
+		_set_variants(_p, variants);
+		return;
+	}
+	_unpack();
 	_p->array.sort_custom<_ArrayVariantSort>();
 }
 
 void Array::sort_custom(const Callable &p_callable) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_packed) {
+		Vector<Variant> variants = _get_variants(_p);
+		variants.sort_custom<CallableComparator, true>(p_callable);
+		_set_variants(_p, variants);
+		return;
+	}
+	_unpack();
 	_p->array.sort_custom<CallableComparator, true>(p_callable);
 }
 
 void Array::shuffle() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_packed) {
+		const int n = _get_packed_size(_p);
+		const uint32_t stride = _p->packed_stride;
+		uint8_t *data = _p->packed.ptrw();
+		uint8_t tmp[sizeof(real_t) * 4];
+		for (int i = n - 1; i >= 1; i--) {
+			const int j = Math::rand() % (i + 1);
+			memcpy(tmp, data + j * stride, stride);
+			memcpy(data + j * stride, data + i * stride, stride);
+			memcpy(data + i * stride, tmp, stride);
+		}
+		return;
+	}
+	_unpack();
 	const int n = _p->array.size();
 	if (n < 2) {
 		return;
@@ -652,9 +926,39 @@ void Array::shuffle() {
 	}
 }
 
+// Same as `SearchArray::bisect()`, reading elements by value.
+template <typename Less>
+static int _bisect_values(const Array &p_array, const Variant &p_value, bool p_before, const Less &p_less) {
+	int lo = 0;
+	int hi = p_array.size();
+	if (p_before) {
+		while (lo < hi) {
+			const int mid = (lo + hi) / 2;
+			if (p_less(p_array.get_value(mid), p_value)) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+	} else {
+		while (lo < hi) {
+			const int mid = (lo + hi) / 2;
+			if (p_less(p_value, p_array.get_value(mid))) {
+				hi = mid;
+			} else {
+				lo = mid + 1;
+			}
+		}
+	}
+	return lo;
+}
+
 int Array::bsearch(const Variant &p_value, bool p_before) const {
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "binary search"), -1);
+	if (_p->is_packed) {
+		return _bisect_values(*this, value, p_before, _ArrayVariantSort());
+	}
 	SearchArray<Variant, _ArrayVariantSort> avs;
 	return avs.bisect(_p->array.ptrw(), _p->array.size(), value, p_before);
 }
@@ -663,11 +967,22 @@ int Array::bsearch_custom(const Variant &p_value, const Callable &p_callable, bo
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "custom binary search"), -1);
 
+	if (_p->is_packed) {
+		CallableComparator less{ p_callable };
+		return _bisect_values(*this, value, p_before, less);
+	}
 	return _p->array.bsearch_custom<CallableComparator>(value, p_before, p_callable);
 }
 
 void Array::reverse() {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	if (_p->is_packed) {
+		Vector<Variant> variants = _get_variants(_p);
+		variants.reverse();
+		_set_variants(_p, variants);
+		return;
+	}
+	_unpack();
 	_p->array.reverse();
 }
 
@@ -675,11 +990,26 @@ void Array::push_front(const Variant &p_value) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	Variant value = p_value;
 	ERR_FAIL_COND(!_p->typed.validate(value, "push_front"));
+	if (_p->is_packed) {
+		insert(0, value);
+		return;
+	}
+	_unpack();
 	_p->array.insert(0, value);
 }
 
 Variant Array::pop_back() {
 	ERR_FAIL_COND_V_MSG(_p->read_only, Variant(), "Array is in read-only state.");
+	if (_p->is_packed) {
+		const int n = _get_packed_size(_p) - 1;
+		if (n < 0) {
+			return Variant();
+		}
+		const Variant ret = get_value(n);
+		_p->packed.resize(n * _p->packed_stride);
+		return ret;
+	}
+	_unpack();
 	if (!_p->array.is_empty()) {
 		const int n = _p->array.size() - 1;
 		const Variant ret = _p->array.get(n);
@@ -691,6 +1021,15 @@ Variant Array::pop_back() {
 
 Variant Array::pop_front() {
 	ERR_FAIL_COND_V_MSG(_p->read_only, Variant(), "Array is in read-only state.");
+	if (_p->is_packed) {
+		if (is_empty()) {
+			return Variant();
+		}
+		const Variant ret = get_value(0);
+		remove_at(0);
+		return ret;
+	}
+	_unpack();
 	if (!_p->array.is_empty()) {
 		const Variant ret = _p->array.get(0);
 		_p->array.remove_at(0);
@@ -701,6 +1040,20 @@ Variant Array::pop_front() {
 
 Variant Array::pop_at(int p_pos) {
 	ERR_FAIL_COND_V_MSG(_p->read_only, Variant(), "Array is in read-only state.");
+	if (_p->is_packed) {
+		const int size = _get_packed_size(_p);
+		if (size == 0) {
+			return Variant();
+		}
+		if (p_pos < 0) {
+			p_pos = size + p_pos;
+		}
+		ERR_FAIL_INDEX_V_MSG(p_pos, size, Variant(), vformat("The calculated index %s is out of bounds (the array has %s elements). Leaving the array untouched and returning `null`.", p_pos, size));
+		const Variant ret = get_value(p_pos);
+		remove_at(p_pos);
+		return ret;
+	}
+	_unpack();
 	if (_p->array.is_empty()) {
 		// Return `null` without printing an error to mimic `pop_back()` and `pop_front()` behavior.
 		return Variant();
@@ -729,11 +1082,11 @@ Variant Array::min() const {
 	Variant minval;
 	for (int i = 0; i < size(); i++) {
 		if (i == 0) {
-			minval = get(i);
+			minval = get_value(i);
 		} else {
 			bool valid;
 			Variant ret;
-			Variant test = get(i);
+			Variant test = get_value(i);
 			Variant::evaluate(Variant::OP_LESS, test, minval, ret, valid);
 			if (!valid) {
 				return Variant(); //not a valid comparison
@@ -751,11 +1104,11 @@ Variant Array::max() const {
 	Variant maxval;
 	for (int i = 0; i < size(); i++) {
 		if (i == 0) {
-			maxval = get(i);
+			maxval = get_value(i);
 		} else {
 			bool valid;
 			Variant ret;
-			Variant test = get(i);
+			Variant test = get_value(i);
 			Variant::evaluate(Variant::OP_GREATER, test, maxval, ret, valid);
 			if (!valid) {
 				return Variant(); //not a valid comparison
@@ -782,7 +1135,7 @@ Array::Array(const Array &p_from, uint32_t p_type, const StringName &p_class_nam
 
 void Array::set_typed(uint32_t p_type, const StringName &p_class_name, const Variant &p_script) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
-	ERR_FAIL_COND_MSG(_p->array.size() > 0, "Type can only be set when array is empty.");
+	ERR_FAIL_COND_MSG(size() > 0, "Type can only be set when array is empty.");
 	ERR_FAIL_COND_MSG(_p->refcount.get() > 1, "Type can only be set when array has no more than one user.");
 	ERR_FAIL_COND_MSG(_p->typed.type != Variant::NIL, "Type can only be set once.");
 	ERR_FAIL_COND_MSG(p_class_name != StringName() && p_type != Variant::OBJECT, "Class names can only be set for type OBJECT");
@@ -793,6 +1146,7 @@ void Array::set_typed(uint32_t p_type, const StringName &p_class_name, const Var
 	_p->typed.class_name = p_class_name;
 	_p->typed.script = script;
 	_p->typed.where = "TypedArray";
+	_init_packed(_p);
 }
 
 bool Array::is_typed() const {
@@ -825,6 +1179,17 @@ bool Array::is_read_only() const {
 	return _p->read_only != nullptr;
 }
 
+bool Array::is_packed() const {
+	return _p->is_packed;
+}
+
+const void *Array::get_packed_data(uint32_t p_type, uint32_t p_element_size) const {
+	if (!_p->is_packed || _p->typed.type != Variant::Type(p_type) || _p->packed_stride != p_element_size) {
+		return nullptr;
+	}
+	return _p->packed.ptr();
+}
+
 Array::Array(const Array &p_from) {
 	_p = nullptr;
 	_ref(p_from);
@@ -44,6 +44,7 @@ class Callable;
 class Array {
 	mutable ArrayPrivate *_p;
 	void _unref() const;
+	void _unpack() const;
 
 public:
 	struct ConstIterator {
@@ -53,24 +54,31 @@ public:
 		_FORCE_INLINE_ ConstIterator &operator++();
 		_FORCE_INLINE_ ConstIterator &operator--();
 
-		_FORCE_INLINE_ bool operator==(const ConstIterator &p_other) const { return element_ptr == p_other.element_ptr; }
-		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return element_ptr != p_other.element_ptr; }
+		_FORCE_INLINE_ bool operator==(const ConstIterator &p_other) const { return element_ptr == p_other.element_ptr && packed_index == p_other.packed_index; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return !(*this == p_other); }
 
 		_FORCE_INLINE_ ConstIterator(const Variant *p_element_ptr, Variant *p_read_only = nullptr) :
 				element_ptr(p_element_ptr), read_only(p_read_only) {}
+		// Reads the elements of a packed array by index, without unpacking it.
+		_FORCE_INLINE_ ConstIterator(const Array *p_packed_array, int p_packed_index) :
+				packed_array(p_packed_array), packed_index(p_packed_index) {}
 		_FORCE_INLINE_ ConstIterator() {}
 		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_other) :
-				element_ptr(p_other.element_ptr), read_only(p_other.read_only) {}
+				element_ptr(p_other.element_ptr), read_only(p_other.read_only), packed_array(p_other.packed_array), packed_index(p_other.packed_index) {}
 
 		_FORCE_INLINE_ ConstIterator &operator=(const ConstIterator &p_other) {
 			element_ptr = p_other.element_ptr;
 			read_only = p_other.read_only;
+			packed_array = p_other.packed_array;
+			packed_index = p_other.packed_index;
 			return *this;
 		}
 
 	private:
 		const Variant *element_ptr = nullptr;
 		Variant *read_only = nullptr;
+		const Array *packed_array = nullptr;
+		int packed_index = 0;
 	};
 
 	struct Iterator {
@@ -117,6 +125,8 @@ public:
 
 	void set(int p_idx, const Variant &p_value);
 	const Variant &get(int p_idx) const;
+	// Same as `get()`, but doesn't unpack packed arrays. Prefer it when a copy of the element is enough.
+	Variant get_value(int p_idx) const;
 
 	int size() const;
 	bool is_empty() const;
@@ -193,6 +203,13 @@ public:
 	void make_read_only();
 	bool is_read_only() const;
 
+	// Typed arrays of fixed size builtin types (int, float, vectors, Color, Quaternion) store their elements
+	// packed, like the `Packed*Array` types, until something needs a reference to an element as a `Variant`.
+	// Unpacking replaces the packed elements, so taking such a reference is a write even from const methods.
+	bool is_packed() const;
+	// The packed elements, if this array is packed with elements of the given type and size.
+	const void *get_packed_data(uint32_t p_type, uint32_t p_element_size) const;
+
 	Array(const Array &p_base, uint32_t p_type, const StringName &p_class_name, const Variant &p_script);
 	Array(const Array &p_from);
 	Array();
@@ -2193,11 +2193,67 @@ inline DA _convert_array(const SA &p_array) {
 	return da;
 }
 
+// Typed arrays store some builtin types packed, which can be copied at once.
+template <typename DA>
+inline bool _copy_packed_array(const Array &p_array, DA &r_array) {
+	return false;
+}
+
+template <typename T>
+inline bool _copy_packed_elements(const Array &p_array, Vector<T> &r_array, Variant::Type p_type) {
+	const void *data = p_array.get_packed_data(p_type, sizeof(T));
+	if (!data) {
+		return false;
+	}
+	r_array.resize(p_array.size());
+	memcpy(r_array.ptrw(), data, sizeof(T) * p_array.size());
+	return true;
+}
+
+inline bool _copy_packed_array(const Array &p_array, PackedInt64Array &r_array) {
+	return _copy_packed_elements(p_array, r_array, Variant::INT);
+}
+
+inline bool _copy_packed_array(const Array &p_array, PackedFloat64Array &r_array) {
+	return _copy_packed_elements(p_array, r_array, Variant::FLOAT);
+}
+
+inline bool _copy_packed_array(const Array &p_array, PackedVector2Array &r_array) {
+	return _copy_packed_elements(p_array, r_array, Variant::VECTOR2);
+}
+
+inline bool _copy_packed_array(const Array &p_array, PackedVector3Array &r_array) {
+	return _copy_packed_elements(p_array, r_array, Variant::VECTOR3);
+}
+
+inline bool _copy_packed_array(const Array &p_array, PackedColorArray &r_array) {
+	return _copy_packed_elements(p_array, r_array, Variant::COLOR);
+}
+
+inline bool _copy_packed_array(const Array &p_array, PackedVector4Array &r_array) {
+	return _copy_packed_elements(p_array, r_array, Variant::VECTOR4);
+}
+
+template <typename DA>
+inline DA _convert_array_from_array(const Array &p_array) {
+	DA da;
+	if (_copy_packed_array(p_array, da)) {
+		return da;
+	}
+	da.resize(p_array.size());
+
+	for (int i = 0; i < p_array.size(); i++) {
+		da.set(i, p_array.get_value(i));
+	}
+
+	return da;
+}
+
 template <typename DA>
 inline DA _convert_array_from_variant(const Variant &p_variant) {
 	switch (p_variant.get_type()) {
 		case Variant::ARRAY: {
-			return _convert_array<DA, Array>(p_variant.operator Array());
+			return _convert_array_from_array<DA>(p_variant.operator Array());
 		}
 		case Variant::PACKED_BYTE_ARRAY: {
 			return _convert_array<DA, PackedByteArray>(p_variant.operator PackedByteArray());
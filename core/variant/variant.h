@@ -913,6 +913,9 @@ Array::Iterator &Array::Iterator::operator--() {
 }
 
 const Variant &Array::ConstIterator::operator*() const {
+	if (unlikely(packed_array)) {
+		return (*packed_array)[packed_index];
+	}
 	if (unlikely(read_only)) {
 		*read_only = *element_ptr;
 		return *read_only;
@@ -921,6 +924,9 @@ const Variant &Array::ConstIterator::operator*() const {
 }
 
 const Variant *Array::ConstIterator::operator->() const {
+	if (unlikely(packed_array)) {
+		return &(*packed_array)[packed_index];
+	}
 	if (unlikely(read_only)) {
 		*read_only = *element_ptr;
 		return read_only;
@@ -929,12 +935,20 @@ const Variant *Array::ConstIterator::operator->() const {
 }
 
 Array::ConstIterator &Array::ConstIterator::operator++() {
-	element_ptr++;
+	if (unlikely(packed_array)) {
+		packed_index++;
+	} else {
+		element_ptr++;
+	}
 	return *this;
 }
 
 Array::ConstIterator &Array::ConstIterator::operator--() {
-	element_ptr--;
+	if (unlikely(packed_array)) {
+		packed_index--;
+	} else {
+		element_ptr--;
+	}
 	return *this;
 }
 
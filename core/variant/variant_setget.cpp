@@ -642,7 +642,7 @@ struct VariantIndexedSetGet_Array {
 			*oob = true;
 			return;
 		}
-		*value = (*VariantGetInternalPtr<Array>::get_ptr(base))[index];
+		*value = VariantGetInternalPtr<Array>::get_ptr(base)->get_value(index);
 		*oob = false;
 	}
 	static void ptr_get(const void *base, int64_t index, void *member) {
@@ -652,7 +652,7 @@ struct VariantIndexedSetGet_Array {
 			index += v.size();
 		}
 		OOB_TEST(index, v.size());
-		PtrToArg<Variant>::encode(v[index], member);
+		PtrToArg<Variant>::encode(v.get_value(index), member);
 	}
 	static void set(Variant *base, int64_t index, const Variant *value, bool *valid, bool *oob) {
 		if (VariantGetInternalPtr<Array>::get_ptr(base)->is_read_only()) {
@@ -1840,7 +1840,7 @@ Variant Variant::iter_get(const Variant &r_iter, bool &r_valid) const {
 				return Variant();
 			}
 #endif
-			return arr->get(idx);
+			return arr->get_value(idx);
 		} break;
 		case PACKED_BYTE_ARRAY: {
 			const Vector<uint8_t> *arr = &PackedArrayRef<uint8_t>::get_array(_data.packed_array);
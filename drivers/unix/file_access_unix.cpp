@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -142,6 +143,13 @@ void FileAccessUnix::_close() {
 		return;
 	}
 
+	if (mapping) {
+		munmap((void *)mapping, mapping_size);
+		mapping = nullptr;
+		mapping_size = 0;
+	}
+	mapping_failed = false;
+
 	fclose(f);
 	f = nullptr;
 
@@ -282,6 +290,42 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	if (flags != READ) {
+		// Writable files can change size under the mapping.
+		return nullptr;
+	}
+
+	if (!mapping) {
+		if (mapping_failed) {
+			return nullptr;
+		}
+		const uint64_t size = get_length();
+		void *map = MAP_FAILED;
+		if (size > 0 && size <= (uint64_t)SIZE_MAX) {
+			map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+		}
+		if (map == MAP_FAILED) {
+			mapping_failed = true;
+			return nullptr;
+		}
+		mapping = (const uint8_t *)map;
+		mapping_size = size;
+	}
+
+	const uint64_t pos = get_position();
+	if (pos > mapping_size || p_length > mapping_size - pos) {
+		return nullptr;
+	}
+	if (fseeko(f, pos + p_length, SEEK_SET)) {
+		check_errors();
+		return nullptr;
+	}
+	return mapping + pos;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,6 +49,11 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Read-only mapping of the whole file, created by the first get_buffer_view().
+	mutable const uint8_t *mapping = nullptr;
+	mutable uint64_t mapping_size = 0;
+	mutable bool mapping_failed = false;
+
 	void _close();
 
 public:
@@ -72,6 +77,7 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_length) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
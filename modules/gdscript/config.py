@@ -3,6 +3,12 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    return [
+        ("gdscript_native_code", "Path to a C++ file of GDScript functions transpiled at export time", ""),
+    ]
+
+
 def configure(env):
     pass
 
@@ -31,10 +31,12 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -65,6 +67,7 @@
 
 GDScriptNativeClass::GDScriptNativeClass(const StringName &p_name) {
 	name = p_name;
+	_custom_callp = true;
 }
 
 bool GDScriptNativeClass::_get(const StringName &p_name, Variant &r_ret) const {
@@ -794,6 +797,27 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	if (!has_instances && GDScriptBytecodeCache::load_script(this)) {
+		// Compiled in an earlier run, so there are no parse tree, docs or warnings.
+		can_run = ScriptServer::is_scripting_enabled() || is_tool();
+		if (can_run) {
+			Error err = _static_init();
+			if (err) {
+				reloading = false;
+				return err;
+			}
+		}
+#ifdef TOOLS_ENABLED
+		if (can_run && p_keep_state) {
+			_restore_old_static_data();
+		} else if (!can_run) {
+			_static_default_init();
+		}
+#endif
+		reloading = false;
+		return OK;
+	}
+
 	valid = false;
 	GDScriptParser parser;
 	Error err;
@@ -848,6 +872,8 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	GDScriptBytecodeCache::save_script(this, &parser);
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -1406,6 +1432,8 @@ void GDScript::_collect_dependencies(RBSet<GDScript *> &p_dependencies, const GD
 
 GDScript::GDScript() :
 		script_list(this) {
+	_custom_callp = true;
+
 	{
 		MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 
@@ -2258,6 +2286,15 @@ void GDScriptLanguage::init() {
 		_add_global(E.name, E.ptr);
 	}
 
+	if (GLOBAL_GET("debug/gdscript/sampling_profiler/enabled") && !Engine::get_singleton()->is_editor_hint()) {
+		GDScriptSamplingProfiler::start(GLOBAL_GET("debug/gdscript/sampling_profiler/sample_interval_usec"));
+	}
+
+	// The editor and the debugger need scripts to be compiled from source.
+	if (GLOBAL_GET("gdscript/bytecode_cache/enabled") && !Engine::get_singleton()->is_editor_hint() && !EngineDebugger::is_active()) {
+		GDScriptBytecodeCache::set_cache_dir("user://gdscript_cache");
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2272,6 +2309,13 @@ String GDScriptLanguage::get_extension() const {
 }
 
 void GDScriptLanguage::finish() {
+	if (GDScriptSamplingProfiler::is_running()) {
+		GDScriptSamplingProfiler::stop();
+		String output_path = GLOBAL_GET("debug/gdscript/sampling_profiler/output_path");
+		GDScriptSamplingProfiler::save_collapsed_stacks(output_path + ".folded");
+		GDScriptSamplingProfiler::save_chrome_trace(output_path + ".json");
+	}
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2885,6 +2929,12 @@ GDScriptLanguage::GDScriptLanguage() {
 		_debug_max_call_stack = 0;
 	}
 
+	GLOBAL_DEF_RST("debug/gdscript/sampling_profiler/enabled", false);
+	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/gdscript/sampling_profiler/sample_interval_usec", PROPERTY_HINT_RANGE, "100,100000,1"), 1000);
+	GLOBAL_DEF(PropertyInfo(Variant::STRING, "debug/gdscript/sampling_profiler/output_path", PROPERTY_HINT_FILE), "user://gdscript_profile");
+
+	GLOBAL_DEF_RST("gdscript/bytecode_cache/enabled", false);
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
@@ -0,0 +1,1361 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+#include "gdscript_function.h"
+#include "gdscript_parser.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/os/mutex.h"
+#include "core/version.h"
+
+// Bump when the layout of the cache files changes. Byte code changes are covered by the build string,
+// which includes a hash of the files emitting and running it.
+#define BYTECODE_CACHE_FORMAT_VERSION 3
+
+static const uint8_t BYTECODE_CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+
+String GDScriptBytecodeCache::cache_dir;
+
+enum VariantTag {
+	TAG_VALUE,
+	TAG_NULL_OBJECT,
+	TAG_LOCAL_SCRIPT,
+	TAG_EXTERNAL_SCRIPT,
+	TAG_NATIVE_CLASS,
+	TAG_RESOURCE,
+	TAG_ARRAY,
+	TAG_DICTIONARY,
+};
+
+static String _get_build_string() {
+	String build = String(VERSION_FULL_BUILD) + " " + VERSION_HASH + " " + String::num_uint64(GDSCRIPT_BYTECODE_LAYOUT_HASH, 16);
+#ifdef DEBUG_ENABLED
+	build += " debug";
+#endif
+#ifdef TOOLS_ENABLED
+	build += " tools";
+#endif
+#ifdef REAL_T_IS_DOUBLE
+	build += " double";
+#endif
+	return build;
+}
+
+static String _hash_buffer(const uint8_t *p_data, int p_size) {
+	unsigned char hash[16];
+	CryptoCore::md5(p_data, p_size, hash);
+	return String::md5(hash);
+}
+
+static String _get_script_hash(const GDScript *p_script) {
+	const Vector<uint8_t> &tokens = p_script->get_binary_tokens_source();
+	if (!tokens.is_empty()) {
+		return _hash_buffer(tokens.ptr(), tokens.size());
+	}
+	return p_script->get_source_code().md5_text();
+}
+
+// Dependencies are hashed from disk once per run.
+static Mutex file_hashes_mutex;
+static HashMap<String, String> file_hashes;
+
+static String _get_file_hash(const String &p_path) {
+	MutexLock lock(file_hashes_mutex);
+	if (const String *hash = file_hashes.getptr(p_path)) {
+		return *hash;
+	}
+	String hash;
+	String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
+		if (!tokens.is_empty()) {
+			hash = _hash_buffer(tokens.ptr(), tokens.size());
+		}
+	} else if (FileAccess::exists(remapped_path)) {
+		hash = GDScriptCache::get_source_code(remapped_path).md5_text();
+	}
+	file_hashes[p_path] = hash;
+	return hash;
+}
+
+// Byte code refers to globals by their index in `GDScriptLanguage::get_global_array()`, which only grows.
+// Hashes the names of the first `p_count` globals, so an entry is only used when those are at the same indices.
+static uint32_t _get_globals_hash(int p_count) {
+	uint32_t hash = 0;
+	for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+		if (E.value < p_count) {
+			hash += hash_fmix32(E.key.hash() ^ hash_murmur3_one_32(E.value));
+		}
+	}
+	return hash;
+}
+
+static bool _has_static_data(const GDScriptParser::ClassNode *p_class) {
+	if (p_class->has_static_data) {
+		return true;
+	}
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		if (member.type == GDScriptParser::ClassNode::Member::CLASS && _has_static_data(member.m_class)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Pointer tables. */
+
+// The byte code stores native function pointers through per function tables. These maps give back
+// what each pointer was looked up with, so it can be looked up again when loading.
+struct GDScriptValidatedNames {
+	RBMap<Variant::ValidatedOperatorEvaluator, Vector<uint32_t>> operators;
+	RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setters;
+	RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	GDScriptValidatedNames() {
+		for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+			Variant::Type type = Variant::Type(i);
+
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, { uint32_t(op), uint32_t(i), uint32_t(j) });
+					}
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(type, &members);
+			for (const StringName &member : members) {
+				if (Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member)) {
+					setters.insert(setter, { type, member });
+				}
+				if (Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member)) {
+					getters.insert(getter, { type, member });
+				}
+			}
+
+			if (Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type)) {
+				keyed_setters.insert(keyed_setter, type);
+			}
+			if (Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type)) {
+				keyed_getters.insert(keyed_getter, type);
+			}
+			if (Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type)) {
+				indexed_setters.insert(indexed_setter, type);
+			}
+			if (Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type)) {
+				indexed_getters.insert(indexed_getter, type);
+			}
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(type, &methods);
+			for (const StringName &method : methods) {
+				if (Variant::ValidatedBuiltInMethod builtin_method = Variant::get_validated_builtin_method(type, method)) {
+					builtin_methods.insert(builtin_method, { type, method });
+				}
+			}
+
+			for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+				if (Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j)) {
+					constructors.insert(constructor, { type, j });
+				}
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &function : functions) {
+			if (Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(function)) {
+				utilities.insert(utility, function);
+			}
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &function : functions) {
+			if (GDScriptUtilityFunctions::FunctionPtr gds_utility = GDScriptUtilityFunctions::get_function(function)) {
+				gds_utilities.insert(gds_utility, function);
+			}
+		}
+	}
+};
+
+static const GDScriptValidatedNames &_get_validated_names() {
+	// Built on first save only, loading just looks the names up.
+	static GDScriptValidatedNames names;
+	return names;
+}
+
+/* Writing. */
+
+class GDScriptBytecodeWriter {
+	const GDScript *root = nullptr;
+
+	void _put_property_info(const PropertyInfo &p_info) {
+		put_variant(Dictionary(p_info));
+	}
+
+public:
+	Vector<uint8_t> buffer;
+	String error;
+	// Files of the other scripts the written data refers to, along with their base classes,
+	// since their member indices and constants are baked into it.
+	HashSet<String> dependencies;
+
+	void add_dependency(GDScript *p_script) {
+		for (GDScript *script = p_script; script; script = script->_base) {
+			const String path = script->get_script_path();
+			if (script->get_root_script() != root && path.is_resource_file()) {
+				dependencies.insert(path);
+			}
+		}
+	}
+
+	void fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+	}
+
+	void put_u8(uint8_t p_value) {
+		buffer.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		int pos = buffer.size();
+		buffer.resize(pos + 4);
+		encode_uint32(p_value, &buffer.write[pos]);
+	}
+
+	void put_string(const String &p_string) {
+		CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		int pos = buffer.size();
+		buffer.resize(pos + utf8.length());
+		memcpy(&buffer.write[pos], utf8.get_data(), utf8.length());
+	}
+
+	void put_object(Object *p_object) {
+		if (p_object == nullptr) {
+			put_u8(TAG_NULL_OBJECT);
+			return;
+		}
+		if (GDScript *script = Object::cast_to<GDScript>(p_object)) {
+			if (script->get_root_script() == root) {
+				// Relative to the root, `find_class()` starts from the script it's called on for those.
+				put_u8(TAG_LOCAL_SCRIPT);
+				put_string(script->get_fully_qualified_name().trim_prefix(root->get_fully_qualified_name()));
+			} else if (script->get_script_path().is_resource_file()) {
+				put_u8(TAG_EXTERNAL_SCRIPT);
+				put_string(script->get_script_path());
+				put_string(script->get_fully_qualified_name());
+				add_dependency(script);
+			} else {
+				fail("Reference to built-in script.");
+			}
+			return;
+		}
+		if (GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(p_object)) {
+			put_u8(TAG_NATIVE_CLASS);
+			put_string(native_class->get_name());
+			return;
+		}
+		Resource *resource = Object::cast_to<Resource>(p_object);
+		if (resource && resource->get_path().is_resource_file()) {
+			put_u8(TAG_RESOURCE);
+			put_string(resource->get_path());
+			put_string(resource->get_class());
+			return;
+		}
+		fail(vformat(R"(Constant of type "%s" can't be stored.)", p_object->get_class()));
+	}
+
+	void put_variant(const Variant &p_value) {
+		switch (p_value.get_type()) {
+			case Variant::OBJECT: {
+				bool freed = false;
+				Object *object = p_value.get_validated_object_with_check(freed);
+				if (freed) {
+					fail("Reference to freed object.");
+					return;
+				}
+				put_object(object);
+			} break;
+			case Variant::ARRAY: {
+				Array array = p_value;
+				put_u8(TAG_ARRAY);
+				put_u8(array.is_read_only());
+				put_u32(array.get_typed_builtin());
+				put_string(array.get_typed_class_name());
+				put_object(array.get_typed_script());
+				put_u32(array.size());
+				for (int i = 0; i < array.size(); i++) {
+					put_variant(array[i]);
+				}
+			} break;
+			case Variant::DICTIONARY: {
+				Dictionary dictionary = p_value;
+				put_u8(TAG_DICTIONARY);
+				put_u8(dictionary.is_read_only());
+				put_u32(dictionary.size());
+				for (const Variant &key : dictionary.keys()) {
+					put_variant(key);
+					put_variant(dictionary[key]);
+				}
+			} break;
+			case Variant::RID:
+			case Variant::CALLABLE:
+			case Variant::SIGNAL: {
+				fail(vformat(R"(Constant of type "%s" can't be stored.)", Variant::get_type_name(p_value.get_type())));
+			} break;
+			default: {
+				int len = 0;
+				Error err = encode_variant(p_value, nullptr, len, false);
+				if (err != OK) {
+					fail("Can't encode constant.");
+					return;
+				}
+				put_u8(TAG_VALUE);
+				put_u32(len);
+				int pos = buffer.size();
+				buffer.resize(pos + len);
+				encode_variant(p_value, &buffer.write[pos], len, false);
+			} break;
+		}
+	}
+
+	void put_data_type(const GDScriptDataType &p_type) {
+		put_u8(p_type.has_type);
+		put_u8(p_type.kind);
+		put_u32(p_type.builtin_type);
+		put_string(p_type.native_type);
+		put_object(p_type.kind == GDScriptDataType::SCRIPT || p_type.kind == GDScriptDataType::GDSCRIPT ? p_type.script_type : nullptr);
+		put_u32(p_type.container_element_types.size());
+		for (const GDScriptDataType &element_type : p_type.container_element_types) {
+			put_data_type(element_type);
+		}
+	}
+
+	void put_member_indices(const HashMap<StringName, GDScript::MemberInfo> &p_indices) {
+		put_u32(p_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_indices) {
+			put_string(E.key);
+			put_u32(E.value.index);
+			put_string(E.value.setter);
+			put_string(E.value.getter);
+			put_data_type(E.value.data_type);
+			_put_property_info(E.value.property_info);
+		}
+	}
+
+	void put_function(const GDScriptFunction *p_function);
+	void put_class_tree(const GDScript *p_script);
+	void put_class(const GDScript *p_script);
+
+	GDScriptBytecodeWriter(const GDScript *p_root) :
+			root(p_root) {}
+};
+
+template <typename T, typename M, typename F>
+static void _put_table(GDScriptBytecodeWriter &p_writer, const Vector<T> &p_table, const M &p_names, F p_put) {
+	p_writer.put_u32(p_table.size());
+	for (const T &ptr : p_table) {
+		typename M::ConstIterator E = p_names.find(ptr);
+		if (!E) {
+			p_writer.fail("Unknown native function pointer.");
+			return;
+		}
+		p_put(E->value);
+	}
+}
+
+void GDScriptBytecodeWriter::put_function(const GDScriptFunction *p_function) {
+	put_string(p_function->name);
+	put_u8(p_function->_static);
+	put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &type : p_function->argument_types) {
+		put_data_type(type);
+	}
+	put_data_type(p_function->return_type);
+	put_variant(Dictionary(p_function->method_info));
+	put_variant(p_function->rpc_config);
+	put_u32(p_function->_initial_line);
+	put_u32(p_function->_argument_count);
+	put_u32(p_function->_stack_size);
+	put_u32(p_function->_instruction_args_size);
+	put_u32(p_function->inline_cache_count);
+
+	put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		put_u32(E.key);
+		put_u32(E.value);
+	}
+
+	put_u32(p_function->default_arguments.size());
+	for (int arg : p_function->default_arguments) {
+		put_u32(arg);
+	}
+
+	put_u32(p_function->code.size());
+	for (int code : p_function->code) {
+		put_u32(code);
+	}
+
+	put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		put_variant(constant);
+	}
+
+	put_u32(p_function->global_names.size());
+	for (const StringName &name : p_function->global_names) {
+		put_string(name);
+	}
+
+	const GDScriptValidatedNames &names = _get_validated_names();
+	_put_table(*this, p_function->operator_funcs, names.operators, [&](const Vector<uint32_t> &p_op) {
+		put_u32(p_op[0]);
+		put_u32(p_op[1]);
+		put_u32(p_op[2]);
+	});
+	_put_table(*this, p_function->setters, names.setters, [&](const Pair<Variant::Type, StringName> &p_setter) {
+		put_u32(p_setter.first);
+		put_string(p_setter.second);
+	});
+	_put_table(*this, p_function->getters, names.getters, [&](const Pair<Variant::Type, StringName> &p_getter) {
+		put_u32(p_getter.first);
+		put_string(p_getter.second);
+	});
+	_put_table(*this, p_function->keyed_setters, names.keyed_setters, [&](Variant::Type p_type) { put_u32(p_type); });
+	_put_table(*this, p_function->keyed_getters, names.keyed_getters, [&](Variant::Type p_type) { put_u32(p_type); });
+	_put_table(*this, p_function->indexed_setters, names.indexed_setters, [&](Variant::Type p_type) { put_u32(p_type); });
+	_put_table(*this, p_function->indexed_getters, names.indexed_getters, [&](Variant::Type p_type) { put_u32(p_type); });
+	_put_table(*this, p_function->builtin_methods, names.builtin_methods, [&](const Pair<Variant::Type, StringName> &p_method) {
+		put_u32(p_method.first);
+		put_string(p_method.second);
+	});
+	_put_table(*this, p_function->constructors, names.constructors, [&](const Pair<Variant::Type, int> &p_constructor) {
+		put_u32(p_constructor.first);
+		put_u32(p_constructor.second);
+	});
+	_put_table(*this, p_function->utilities, names.utilities, [&](const StringName &p_name) { put_string(p_name); });
+	_put_table(*this, p_function->gds_utilities, names.gds_utilities, [&](const StringName &p_name) { put_string(p_name); });
+
+	put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		put_string(method->get_instance_class());
+		put_string(method->get_name());
+		// The argument layout the byte code was validated against.
+		put_u32(method->get_hash());
+	}
+
+	put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		put_u32(info ? info->capture_count : 0);
+		put_u8(info ? info->use_self : false);
+		put_function(lambda);
+	}
+
+#ifdef DEBUG_ENABLED
+	const Vector<String> *debug_names[] = {
+		&p_function->operator_names,
+		&p_function->setter_names,
+		&p_function->getter_names,
+		&p_function->builtin_methods_names,
+		&p_function->constructors_names,
+		&p_function->utilities_names,
+		&p_function->gds_utilities_names,
+	};
+	for (const Vector<String> *list : debug_names) {
+		put_u32(list->size());
+		for (const String &name : *list) {
+			put_string(name);
+		}
+	}
+	put_string(p_function->profile.signature);
+#endif
+
+	put_u32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+		put_u32(stack_debug.line);
+		put_u32(stack_debug.pos);
+		put_u8(stack_debug.added);
+		put_string(stack_debug.identifier);
+	}
+}
+
+void GDScriptBytecodeWriter::put_class_tree(const GDScript *p_script) {
+	put_string(p_script->local_name);
+	put_string(p_script->fully_qualified_name);
+	put_string(p_script->global_name);
+	put_string(p_script->simplified_icon_path);
+	put_u32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		put_string(E.key);
+		put_class_tree(E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeWriter::put_class(const GDScript *p_script) {
+	put_u8(p_script->tool);
+	put_string(p_script->native.is_valid() ? p_script->native->get_name() : StringName());
+	put_object(p_script->base.ptr());
+	put_u32(p_script->base.is_valid() ? p_script->base->member_indices.size() : 0);
+
+	put_member_indices(p_script->member_indices);
+	put_u32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		put_string(member);
+	}
+	put_member_indices(p_script->static_variables_indices);
+
+	put_u32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		put_string(E.key);
+		put_variant(E.value);
+	}
+
+	put_u32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		put_string(E.key);
+		put_variant(Dictionary(E.value));
+	}
+	put_variant(p_script->rpc_config);
+
+	const GDScriptFunction *special_functions[] = { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer };
+	for (const GDScriptFunction *function : special_functions) {
+		put_u8(function != nullptr);
+		if (function) {
+			put_function(function);
+		}
+	}
+	put_u32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		put_function(E.value);
+	}
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		put_class(E.value.ptr());
+	}
+}
+
+/* Reading. */
+
+class GDScriptBytecodeReader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	GDScript *root = nullptr;
+
+public:
+	bool failed = false;
+	bool static_data = false;
+
+	bool has_data(int p_size) {
+		if (failed || p_size < 0 || pos + p_size > size) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!has_data(1)) {
+			return 0;
+		}
+		return data[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (!has_data(4)) {
+			return 0;
+		}
+		uint32_t value = decode_uint32(&data[pos]);
+		pos += 4;
+		return value;
+	}
+
+	// For element counts, so a corrupted count fails instead of allocating.
+	int get_count() {
+		uint32_t count = get_u32();
+		if (count > uint32_t(size - pos)) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		int len = get_count();
+		if (!has_data(len)) {
+			return String();
+		}
+		String string = String::utf8((const char *)&data[pos], len);
+		pos += len;
+		return string;
+	}
+
+	StringName get_string_name() {
+		String string = get_string();
+		return string.is_empty() ? StringName() : StringName(string);
+	}
+
+	Variant get_object(bool *r_local = nullptr) {
+		uint8_t tag = get_u8();
+		if (r_local) {
+			*r_local = tag == TAG_LOCAL_SCRIPT;
+		}
+		switch (tag) {
+			case TAG_NULL_OBJECT:
+				return Variant();
+			case TAG_LOCAL_SCRIPT: {
+				GDScript *script = root->find_class(get_string());
+				failed = failed || script == nullptr;
+				return script;
+			}
+			case TAG_EXTERNAL_SCRIPT: {
+				String path = get_string();
+				String fqcn = get_string();
+				if (failed) {
+					return Variant();
+				}
+				Error err = OK;
+				Ref<GDScript> script = GDScriptCache::get_shallow_script(path, err, root->path);
+				if (script.is_valid()) {
+					script = Ref<GDScript>(script->find_class(fqcn));
+				}
+				failed = failed || err != OK || script.is_null();
+				return script;
+			}
+			case TAG_NATIVE_CLASS: {
+				StringName name = get_string_name();
+				const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+				HashMap<StringName, int>::ConstIterator E = global_map.find(name);
+				if (!E) {
+					failed = true;
+					return Variant();
+				}
+				return GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+			}
+			case TAG_RESOURCE: {
+				String path = get_string();
+				String type = get_string();
+				if (failed) {
+					return Variant();
+				}
+				Ref<Resource> resource = ResourceLoader::load(path, type);
+				failed = failed || resource.is_null();
+				return resource;
+			}
+			default:
+				failed = true;
+				return Variant();
+		}
+	}
+
+	Variant get_variant() {
+		uint8_t tag = get_u8();
+		switch (tag) {
+			case TAG_VALUE: {
+				int len = get_count();
+				if (!has_data(len)) {
+					return Variant();
+				}
+				Variant value;
+				if (decode_variant(value, &data[pos], len, nullptr, false) != OK) {
+					failed = true;
+				}
+				pos += len;
+				return value;
+			}
+			case TAG_ARRAY: {
+				bool read_only = get_u8();
+				uint32_t typed_builtin = get_u32();
+				StringName typed_class_name = get_string_name();
+				Variant typed_script = get_object();
+				int count = get_count();
+				Array array;
+				if (typed_builtin != Variant::NIL) {
+					array.set_typed(typed_builtin, typed_class_name, typed_script);
+				}
+				array.resize(count);
+				for (int i = 0; i < count && !failed; i++) {
+					array[i] = get_variant();
+				}
+				if (read_only) {
+					array.make_read_only();
+				}
+				return array;
+			}
+			case TAG_DICTIONARY: {
+				bool read_only = get_u8();
+				int count = get_count();
+				Dictionary dictionary;
+				for (int i = 0; i < count && !failed; i++) {
+					Variant key = get_variant();
+					dictionary[key] = get_variant();
+				}
+				if (read_only) {
+					dictionary.make_read_only();
+				}
+				return dictionary;
+			}
+			default: {
+				// Go back so the object tag is read again.
+				pos--;
+				return get_object();
+			}
+		}
+	}
+
+	GDScriptDataType get_data_type() {
+		GDScriptDataType type;
+		type.has_type = get_u8();
+		type.kind = GDScriptDataType::Kind(get_u8());
+		type.builtin_type = Variant::Type(get_u32());
+		type.native_type = get_string_name();
+		bool local = false;
+		Variant script = get_object(&local);
+		type.script_type = Object::cast_to<Script>(script);
+		if (!local) {
+			// Same as the compiler, only hold a reference to scripts from other files to avoid cycles.
+			type.script_type_ref = Ref<Script>(type.script_type);
+		}
+		int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			type.container_element_types.push_back(get_data_type());
+		}
+		if (type.kind > GDScriptDataType::GDSCRIPT || type.builtin_type >= Variant::VARIANT_MAX) {
+			failed = true;
+		}
+		return type;
+	}
+
+	void get_member_indices(HashMap<StringName, GDScript::MemberInfo> &r_indices) {
+		int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			StringName name = get_string_name();
+			GDScript::MemberInfo &info = r_indices[name];
+			info.index = get_u32();
+			info.setter = get_string_name();
+			info.getter = get_string_name();
+			info.data_type = get_data_type();
+			info.property_info = PropertyInfo::from_dict(get_variant());
+		}
+	}
+
+	static void clear_class(GDScript *p_script);
+	bool get_header(const GDScript *p_script);
+	GDScriptFunction *get_function(GDScript *p_script);
+	void get_class_tree(GDScript *p_script);
+	void get_class(GDScript *p_script);
+
+	GDScriptBytecodeReader(GDScript *p_root, const Vector<uint8_t> &p_buffer) :
+			data(p_buffer.ptr()), size(p_buffer.size()), root(p_root) {}
+};
+
+bool GDScriptBytecodeReader::get_header(const GDScript *p_script) {
+	if (!has_data(4) || memcmp(data, BYTECODE_CACHE_MAGIC, 4) != 0) {
+		failed = true;
+		return false;
+	}
+	pos += 4;
+	if (get_u32() != BYTECODE_CACHE_FORMAT_VERSION || get_u32() != GDScriptFunction::OPCODE_END || get_string() != _get_build_string()) {
+		return false;
+	}
+	if (get_string() != _get_script_hash(p_script)) {
+		return false;
+	}
+	int global_count = get_u32();
+	uint32_t globals_hash = get_u32();
+	if (failed || global_count > GDScriptLanguage::get_singleton()->get_global_array_size() || globals_hash != _get_globals_hash(global_count)) {
+		return false;
+	}
+	int dependency_count = get_count();
+	for (int i = 0; i < dependency_count && !failed; i++) {
+		String path = get_string();
+		String hash = get_string();
+		if (failed || _get_file_hash(path) != hash) {
+			return false;
+		}
+	}
+	static_data = get_u8();
+
+	// Everything after the header must be exactly what was written, since the reader trusts its indices.
+	if (!has_data(16)) {
+		failed = true;
+		return false;
+	}
+	unsigned char payload_hash[16];
+	CryptoCore::md5(data + pos + 16, size - pos - 16, payload_hash);
+	if (memcmp(data + pos, payload_hash, 16) != 0) {
+		failed = true;
+		return false;
+	}
+	pos += 16;
+	return !failed;
+}
+
+template <typename T, typename F>
+static void _get_table(GDScriptBytecodeReader &p_reader, Vector<T> &r_table, F p_get) {
+	int count = p_reader.get_count();
+	r_table.resize(count);
+	for (int i = 0; i < count && !p_reader.failed; i++) {
+		r_table.write[i] = p_get();
+		if (!r_table[i]) {
+			p_reader.failed = true;
+		}
+	}
+}
+
+template <typename T>
+static void _set_table_ptr(Vector<T> &p_table, T *&r_ptr, int &r_count) {
+	r_count = p_table.size();
+	r_ptr = r_count ? p_table.ptrw() : nullptr;
+}
+
+template <typename T>
+static void _set_table_ptr(Vector<T> &p_table, const T *&r_ptr, int &r_count) {
+	r_count = p_table.size();
+	r_ptr = r_count ? p_table.ptr() : nullptr;
+}
+
+GDScriptFunction *GDScriptBytecodeReader::get_function(GDScript *p_script) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->source = p_script->get_script_path();
+	function->name = get_string_name();
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+	function->_static = get_u8();
+	int argument_count = get_count();
+	for (int i = 0; i < argument_count && !failed; i++) {
+		function->argument_types.push_back(get_data_type());
+	}
+	function->return_type = get_data_type();
+	function->method_info = MethodInfo::from_dict(get_variant());
+	function->rpc_config = get_variant();
+	function->_initial_line = get_u32();
+	function->_argument_count = get_u32();
+	function->_stack_size = get_u32();
+	function->_instruction_args_size = get_u32();
+	int inline_cache_count = get_count();
+
+	int temporary_count = get_count();
+	for (int i = 0; i < temporary_count && !failed; i++) {
+		int slot = get_u32();
+		function->temporary_slots[slot] = Variant::Type(get_u32());
+	}
+
+	int default_argument_count = get_count();
+	for (int i = 0; i < default_argument_count && !failed; i++) {
+		function->default_arguments.push_back(get_u32());
+	}
+	int code_size = get_count();
+	function->code.resize(code_size);
+	for (int i = 0; i < code_size && !failed; i++) {
+		function->code.write[i] = get_u32();
+	}
+	int constant_count = get_count();
+	function->constants.resize(constant_count);
+	for (int i = 0; i < constant_count && !failed; i++) {
+		function->constants.write[i] = get_variant();
+	}
+	int global_name_count = get_count();
+	function->global_names.resize(global_name_count);
+	for (int i = 0; i < global_name_count && !failed; i++) {
+		function->global_names.write[i] = get_string_name();
+	}
+
+	_get_table(*this, function->operator_funcs, [&]() {
+		uint32_t op = get_u32();
+		uint32_t type_a = get_u32();
+		uint32_t type_b = get_u32();
+		if (op >= Variant::OP_MAX || type_a >= Variant::VARIANT_MAX || type_b >= Variant::VARIANT_MAX) {
+			return Variant::ValidatedOperatorEvaluator();
+		}
+		return Variant::get_validated_operator_evaluator(Variant::Operator(op), Variant::Type(type_a), Variant::Type(type_b));
+	});
+	// Types are checked before lookups, since those index arrays by type.
+	auto get_type = [&]() {
+		uint32_t type = get_u32();
+		if (type >= Variant::VARIANT_MAX) {
+			failed = true;
+			return Variant::NIL;
+		}
+		return Variant::Type(type);
+	};
+	_get_table(*this, function->setters, [&]() {
+		Variant::Type type = get_type();
+		StringName name = get_string_name();
+		return failed ? Variant::ValidatedSetter() : Variant::get_member_validated_setter(type, name);
+	});
+	_get_table(*this, function->getters, [&]() {
+		Variant::Type type = get_type();
+		StringName name = get_string_name();
+		return failed ? Variant::ValidatedGetter() : Variant::get_member_validated_getter(type, name);
+	});
+	_get_table(*this, function->keyed_setters, [&]() {
+		Variant::Type type = get_type();
+		return failed ? Variant::ValidatedKeyedSetter() : Variant::get_member_validated_keyed_setter(type);
+	});
+	_get_table(*this, function->keyed_getters, [&]() {
+		Variant::Type type = get_type();
+		return failed ? Variant::ValidatedKeyedGetter() : Variant::get_member_validated_keyed_getter(type);
+	});
+	_get_table(*this, function->indexed_setters, [&]() {
+		Variant::Type type = get_type();
+		return failed ? Variant::ValidatedIndexedSetter() : Variant::get_member_validated_indexed_setter(type);
+	});
+	_get_table(*this, function->indexed_getters, [&]() {
+		Variant::Type type = get_type();
+		return failed ? Variant::ValidatedIndexedGetter() : Variant::get_member_validated_indexed_getter(type);
+	});
+	_get_table(*this, function->builtin_methods, [&]() {
+		Variant::Type type = get_type();
+		StringName name = get_string_name();
+		return failed ? Variant::ValidatedBuiltInMethod() : Variant::get_validated_builtin_method(type, name);
+	});
+	_get_table(*this, function->constructors, [&]() {
+		Variant::Type type = get_type();
+		int index = get_u32();
+		return failed || index >= Variant::get_constructor_count(type) ? Variant::ValidatedConstructor() : Variant::get_validated_constructor(type, index);
+	});
+	_get_table(*this, function->utilities, [&]() { return Variant::get_validated_utility_function(get_string_name()); });
+	_get_table(*this, function->gds_utilities, [&]() { return GDScriptUtilityFunctions::get_function(get_string_name()); });
+	_get_table(*this, function->methods, [&]() {
+		StringName class_name = get_string_name();
+		StringName method_name = get_string_name();
+		uint32_t hash = get_u32();
+		MethodBind *method = failed ? nullptr : ClassDB::get_method(class_name, method_name);
+		return method && method->get_hash() == hash ? method : nullptr;
+	});
+
+	int lambda_count = get_count();
+	for (int i = 0; i < lambda_count && !failed; i++) {
+		GDScript::LambdaInfo info;
+		info.capture_count = get_u32();
+		info.use_self = get_u8();
+		GDScriptFunction *lambda = get_function(p_script);
+		if (lambda) {
+			function->lambdas.push_back(lambda);
+			p_script->lambda_info.insert(lambda, info);
+		}
+	}
+
+#ifdef DEBUG_ENABLED
+	Vector<String> *debug_names[] = {
+		&function->operator_names,
+		&function->setter_names,
+		&function->getter_names,
+		&function->builtin_methods_names,
+		&function->constructors_names,
+		&function->utilities_names,
+		&function->gds_utilities_names,
+	};
+	for (Vector<String> *list : debug_names) {
+		int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			list->push_back(get_string());
+		}
+	}
+	function->profile.signature = get_string_name();
+#endif
+
+	int stack_debug_count = get_count();
+	for (int i = 0; i < stack_debug_count && !failed; i++) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = get_u32();
+		stack_debug.pos = get_u32();
+		stack_debug.added = get_u8();
+		stack_debug.identifier = get_string_name();
+		function->stack_debug.push_back(stack_debug);
+	}
+
+	if (failed) {
+		memdelete(function);
+		return nullptr;
+	}
+
+	// Same as `GDScriptByteCodeGenerator::write_end()`.
+	_set_table_ptr(function->code, function->_code_ptr, function->_code_size);
+	_set_table_ptr(function->constants, function->_constants_ptr, function->_constant_count);
+	_set_table_ptr(function->global_names, function->_global_names_ptr, function->_global_names_count);
+	_set_table_ptr(function->operator_funcs, function->_operator_funcs_ptr, function->_operator_funcs_count);
+	_set_table_ptr(function->setters, function->_setters_ptr, function->_setters_count);
+	_set_table_ptr(function->getters, function->_getters_ptr, function->_getters_count);
+	_set_table_ptr(function->keyed_setters, function->_keyed_setters_ptr, function->_keyed_setters_count);
+	_set_table_ptr(function->keyed_getters, function->_keyed_getters_ptr, function->_keyed_getters_count);
+	_set_table_ptr(function->indexed_setters, function->_indexed_setters_ptr, function->_indexed_setters_count);
+	_set_table_ptr(function->indexed_getters, function->_indexed_getters_ptr, function->_indexed_getters_count);
+	_set_table_ptr(function->builtin_methods, function->_builtin_methods_ptr, function->_builtin_methods_count);
+	_set_table_ptr(function->constructors, function->_constructors_ptr, function->_constructors_count);
+	_set_table_ptr(function->utilities, function->_utilities_ptr, function->_utilities_count);
+	_set_table_ptr(function->gds_utilities, function->_gds_utilities_ptr, function->_gds_utilities_count);
+	_set_table_ptr(function->methods, function->_methods_ptr, function->_methods_count);
+	_set_table_ptr(function->lambdas, function->_lambdas_ptr, function->_lambdas_count);
+	if (function->default_arguments.size()) {
+		function->_default_arg_count = function->default_arguments.size() - 1;
+		function->_default_arg_ptr = &function->default_arguments[0];
+	}
+	if (inline_cache_count) {
+		function->inline_caches = memnew_arr(GDScriptInlineCache, inline_cache_count);
+		function->inline_cache_count = inline_cache_count;
+	}
+
+	return function;
+}
+
+void GDScriptBytecodeReader::get_class_tree(GDScript *p_script) {
+	p_script->local_name = get_string_name();
+	p_script->fully_qualified_name = get_string();
+	p_script->global_name = get_string_name();
+	p_script->simplified_icon_path = get_string();
+
+	// Keep existing inner class scripts, other scripts may already point to them.
+	HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	int count = get_count();
+	for (int i = 0; i < count && !failed; i++) {
+		StringName name = get_string_name();
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass.instantiate();
+		}
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+		get_class_tree(subclass.ptr());
+	}
+}
+
+// Same cleanup as `GDScriptCompiler::_prepare_compilation()`.
+void GDScriptBytecodeReader::clear_class(GDScript *p_script) {
+	p_script->clearing = true;
+
+	p_script->native = Ref<GDScriptNativeClass>();
+	p_script->base = Ref<GDScript>();
+	p_script->_base = nullptr;
+	p_script->members.clear();
+
+	HashMap<StringName, Variant> constants = p_script->constants;
+	p_script->constants.clear();
+	constants.clear();
+
+	HashMap<StringName, GDScriptFunction *> member_functions = p_script->member_functions;
+	p_script->member_functions.clear();
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		memdelete(E.value);
+	}
+	if (p_script->implicit_initializer) {
+		memdelete(p_script->implicit_initializer);
+	}
+	if (p_script->implicit_ready) {
+		memdelete(p_script->implicit_ready);
+	}
+	if (p_script->static_initializer) {
+		memdelete(p_script->static_initializer);
+	}
+
+	p_script->member_functions.clear();
+	p_script->member_indices.clear();
+	p_script->static_variables_indices.clear();
+	p_script->static_variables.clear();
+	p_script->_signals.clear();
+	p_script->initializer = nullptr;
+	p_script->implicit_initializer = nullptr;
+	p_script->implicit_ready = nullptr;
+	p_script->static_initializer = nullptr;
+	p_script->rpc_config.clear();
+	p_script->lambda_info.clear();
+
+	p_script->clearing = false;
+}
+
+void GDScriptBytecodeReader::get_class(GDScript *p_script) {
+	clear_class(p_script);
+
+	p_script->tool = get_u8();
+	StringName native_type = get_string_name();
+	const HashMap<StringName, int> &global_map = GDScriptLanguage::get_singleton()->get_global_map();
+	HashMap<StringName, int>::ConstIterator native_index = global_map.find(native_type);
+	if (!native_index) {
+		failed = true;
+		return;
+	}
+	p_script->native = GDScriptLanguage::get_singleton()->get_global_array()[native_index->value];
+	Ref<GDScript> base = get_object();
+	p_script->base = base;
+	p_script->_base = base.ptr();
+	if (p_script->native.is_null()) {
+		failed = true;
+		return;
+	}
+
+	// Members are indexed after the ones of the base, which must not have changed.
+	uint32_t base_member_count = get_u32();
+	get_member_indices(p_script->member_indices);
+	if (base.is_valid()) {
+		if (base->member_indices.size() != base_member_count) {
+			failed = true;
+			return;
+		}
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : base->member_indices) {
+			const GDScript::MemberInfo *info = p_script->member_indices.getptr(E.key);
+			if (!info || info->index != E.value.index) {
+				failed = true;
+				return;
+			}
+		}
+	}
+	int member_count = get_count();
+	for (int i = 0; i < member_count && !failed; i++) {
+		p_script->members.insert(get_string_name());
+	}
+	get_member_indices(p_script->static_variables_indices);
+	p_script->static_variables.resize(p_script->static_variables_indices.size());
+
+	int constant_count = get_count();
+	for (int i = 0; i < constant_count && !failed; i++) {
+		StringName name = get_string_name();
+		p_script->constants.insert(name, get_variant());
+	}
+
+	int signal_count = get_count();
+	for (int i = 0; i < signal_count && !failed; i++) {
+		StringName name = get_string_name();
+		p_script->_signals[name] = MethodInfo::from_dict(get_variant());
+	}
+	p_script->rpc_config = get_variant();
+
+	GDScriptFunction **special_functions[] = { &p_script->implicit_initializer, &p_script->implicit_ready, &p_script->static_initializer };
+	for (GDScriptFunction **function : special_functions) {
+		if (get_u8()) {
+			*function = get_function(p_script);
+			failed = failed || *function == nullptr;
+		}
+	}
+	int function_count = get_count();
+	for (int i = 0; i < function_count && !failed; i++) {
+		GDScriptFunction *function = get_function(p_script);
+		if (function) {
+			p_script->member_functions[function->name] = function;
+			if (function->name == GDScriptLanguage::get_singleton()->strings._init) {
+				p_script->initializer = function;
+			}
+		}
+	}
+
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (failed) {
+			return;
+		}
+		get_class(E.value.ptr());
+	}
+
+	p_script->valid = !failed;
+}
+
+/* GDScriptBytecodeCache. */
+
+void GDScriptBytecodeCache::set_cache_dir(const String &p_dir) {
+	cache_dir = p_dir;
+	if (!cache_dir.is_empty() && DirAccess::make_dir_recursive_absolute(cache_dir) != OK) {
+		ERR_PRINT("Can't create GDScript byte code cache folder, no byte code caching will happen: " + cache_dir);
+		cache_dir = String();
+	}
+}
+
+bool GDScriptBytecodeCache::is_enabled() {
+	return !cache_dir.is_empty();
+}
+
+Error GDScriptBytecodeCache::serialize(const GDScript *p_script, GDScriptParser *p_parser, Vector<uint8_t> &r_buffer) {
+	ERR_FAIL_COND_V(!p_script->valid, ERR_INVALID_PARAMETER);
+
+	// The payload is written first, to know which scripts it refers to.
+	GDScriptBytecodeWriter payload(p_script);
+	payload.put_class_tree(p_script);
+	payload.put_class(p_script);
+	if (!payload.error.is_empty()) {
+		print_verbose(vformat(R"(GDScript: Can't cache byte code of "%s": %s)", p_script->path, payload.error));
+		return ERR_UNAVAILABLE;
+	}
+
+	GDScriptBytecodeWriter writer(p_script);
+	for (int i = 0; i < 4; i++) {
+		writer.put_u8(BYTECODE_CACHE_MAGIC[i]);
+	}
+	writer.put_u32(BYTECODE_CACHE_FORMAT_VERSION);
+	writer.put_u32(GDScriptFunction::OPCODE_END);
+	writer.put_string(_get_build_string());
+	writer.put_string(_get_script_hash(p_script));
+	int global_count = GDScriptLanguage::get_singleton()->get_global_array_size();
+	writer.put_u32(global_count);
+	writer.put_u32(_get_globals_hash(global_count));
+
+	HashSet<String> &dependencies = payload.dependencies;
+	for (const KeyValue<String, Ref<GDScriptParserRef>> &E : p_parser->get_depended_parsers()) {
+		if (E.key != p_script->path) {
+			dependencies.insert(E.key);
+		}
+	}
+	// The whole base class chain, the analyzer only depends on the direct base.
+	payload.add_dependency(p_script->_base);
+	writer.put_u32(dependencies.size());
+	for (const String &dependency : dependencies) {
+		writer.put_string(dependency);
+		writer.put_string(_get_file_hash(dependency));
+	}
+	const GDScriptParser::ClassNode *tree = p_parser->get_tree();
+	writer.put_u8(tree && !tree->annotated_static_unload && _has_static_data(tree));
+
+	unsigned char payload_hash[16];
+	CryptoCore::md5(payload.buffer.ptr(), payload.buffer.size(), payload_hash);
+	for (int i = 0; i < 16; i++) {
+		writer.put_u8(payload_hash[i]);
+	}
+	writer.buffer.append_array(payload.buffer);
+	r_buffer = writer.buffer;
+	return OK;
+}
+
+bool GDScriptBytecodeCache::is_up_to_date(const GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	GDScriptBytecodeReader reader(const_cast<GDScript *>(p_script), p_buffer);
+	return reader.get_header(p_script);
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer) {
+	GDScriptBytecodeReader reader(p_script, p_buffer);
+	if (!reader.get_header(p_script)) {
+		return ERR_INVALID_DATA;
+	}
+	reader.get_class_tree(p_script);
+	return reader.failed ? ERR_FILE_CORRUPT : OK;
+}
+
+Error GDScriptBytecodeCache::deserialize(GDScript *p_script, const Vector<uint8_t> &p_buffer, bool *r_static_data) {
+	GDScriptBytecodeReader reader(p_script, p_buffer);
+	if (!reader.get_header(p_script)) {
+		return ERR_INVALID_DATA;
+	}
+	reader.get_class_tree(p_script);
+	if (reader.failed) {
+		return ERR_FILE_CORRUPT;
+	}
+	reader.get_class(p_script);
+	if (reader.failed) {
+		p_script->valid = false;
+		return ERR_FILE_CORRUPT;
+	}
+	if (r_static_data) {
+		*r_static_data = reader.static_data;
+	}
+	return OK;
+}
+
+static String _get_cache_file(const String &p_dir, const String &p_path) {
+	return p_dir.path_join(p_path.md5_text() + ".gdbc");
+}
+
+bool GDScriptBytecodeCache::make_shallow_script(GDScript *p_script) {
+	if (!is_enabled() || !p_script->path.is_resource_file()) {
+		return false;
+	}
+	Vector<uint8_t> buffer = FileAccess::get_file_as_bytes(_get_cache_file(cache_dir, p_script->path));
+	if (buffer.is_empty() || make_scripts(p_script, buffer) != OK) {
+		return false;
+	}
+	// Kept for the reload that compiles the script.
+	p_script->bytecode_cache = buffer;
+	return true;
+}
+
+bool GDScriptBytecodeCache::load_script(GDScript *p_script) {
+	if (!is_enabled() || !p_script->path.is_resource_file()) {
+		return false;
+	}
+	Vector<uint8_t> buffer = p_script->bytecode_cache;
+	p_script->bytecode_cache.clear();
+	if (buffer.is_empty()) {
+		buffer = FileAccess::get_file_as_bytes(_get_cache_file(cache_dir, p_script->path));
+	}
+	bool static_data = false;
+	if (buffer.is_empty() || deserialize(p_script, buffer, &static_data) != OK) {
+		return false;
+	}
+	if (static_data) {
+		GDScriptCache::add_static_script(p_script);
+	}
+	if (GDScriptCache::finish_compiling(p_script->path) != OK) {
+		// Let the compiler report why.
+		p_script->valid = false;
+		return false;
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::save_script(const GDScript *p_script, GDScriptParser *p_parser) {
+	if (!is_enabled() || !p_script->path.is_resource_file()) {
+		return;
+	}
+	Vector<uint8_t> buffer;
+	if (serialize(p_script, p_parser, buffer) != OK) {
+		return;
+	}
+	String cache_file = _get_cache_file(cache_dir, p_script->path);
+	Ref<FileAccess> file = FileAccess::open(cache_file, FileAccess::WRITE);
+	ERR_FAIL_COND_MSG(file.is_null(), "Can't write GDScript byte code cache file: " + cache_file);
+	file->store_buffer(buffer.ptr(), buffer.size());
+}
@@ -0,0 +1,70 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "core/string/ustring.h"
+#include "core/templates/vector.h"
+
+class GDScript;
+class GDScriptParser;
+
+// Persistent cache of compiled scripts, so later runs can skip parsing, analyzing and compiling them.
+//
+// An entry stores the whole class tree of a script file: members, constants, signals and the byte code
+// of every function along with the tables it indexes into. Native pointers (operator evaluators, method
+// binds, utility functions...) are stored by name and resolved again when loading. Entries are only used
+// when the engine build, the script source, the sources of every script its analysis depended on or its
+// data refers to (with their whole base class chains), and the global names referenced by index from the
+// byte code all match the ones they were written with. Method binds must also keep their hash, and the
+// base class its member count.
+class GDScriptBytecodeCache {
+	static String cache_dir;
+
+public:
+	// Enables the cache, storing one file per script in the given directory. Empty disables it.
+	static void set_cache_dir(const String &p_dir);
+	static bool is_enabled();
+
+	static Error serialize(const GDScript *p_script, GDScriptParser *p_parser, Vector<uint8_t> &r_buffer);
+	// Checks that the buffer was made from the current source of the script and its dependencies.
+	static bool is_up_to_date(const GDScript *p_script, const Vector<uint8_t> &p_buffer);
+	// Creates the inner class scripts, like `GDScriptCompiler::make_scripts()` does from a parse tree.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_buffer);
+	static Error deserialize(GDScript *p_script, const Vector<uint8_t> &p_buffer, bool *r_static_data = nullptr);
+
+	// Used by `GDScriptCache` and `GDScript::reload()` to read and write entries of the cache directory.
+	static bool make_shallow_script(GDScript *p_script);
+	static bool load_script(GDScript *p_script);
+	static void save_script(const GDScript *p_script, GDScriptParser *p_parser);
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
@@ -33,10 +33,12 @@
 #include "gdscript.h"
 #include "gdscript_byte_codegen.h"
 #include "gdscript_cache.h"
+#include "gdscript_transpiler.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
 
 #include "scene/scene_string_names.h"
 
@@ -2436,6 +2438,17 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 
 	gd_function->method_info = method_info;
 
+	// Use the ahead-of-time compiled version if there's one generated from this exact code.
+	// Not while debugging, since it doesn't stop at breakpoints.
+	// Only functions with an entry are transpiled, to check that it still matches the source.
+	if (p_func && !p_for_lambda && GDScriptNativeFunctions::has_functions() && !EngineDebugger::is_active()) {
+		const GDScriptNativeFunctions::Entry *native_entry = GDScriptNativeFunctions::get_entry(p_script->path, func_name);
+		String native_body;
+		if (native_entry && GDScriptTranspiler::transpile_function(p_func, native_body) && GDScriptTranspiler::get_body_hash(native_body) == native_entry->hash) {
+			gd_function->native_function = native_entry->function;
+		}
+	}
+
 	if (!is_implicit_initializer && !is_implicit_ready && !p_for_lambda) {
 		p_script->member_functions[func_name] = gd_function;
 	}
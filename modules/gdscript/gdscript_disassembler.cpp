@@ -141,6 +141,41 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_OPERATOR_TYPED(m_op, m_type)                \
+	case OPCODE_OPERATOR_##m_op##_##m_type: {                   \
+		text += "operator (typed ";                             \
+		text += #m_type;                                        \
+		text += ") ";                                           \
+		text += DADDR(3);                                       \
+		text += " = ";                                          \
+		text += DADDR(1);                                       \
+		text += " ";                                            \
+		text += Variant::get_operator_name(Variant::OP_##m_op); \
+		text += " ";                                            \
+		text += DADDR(2);                                       \
+		incr += 4;                                              \
+	} break
+
+			DISASSEMBLE_OPERATOR_TYPED(ADD, INT);
+			DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, INT);
+			DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, INT);
+			DISASSEMBLE_OPERATOR_TYPED(EQUAL, INT);
+			DISASSEMBLE_OPERATOR_TYPED(NOT_EQUAL, INT);
+			DISASSEMBLE_OPERATOR_TYPED(LESS, INT);
+			DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL, INT);
+			DISASSEMBLE_OPERATOR_TYPED(GREATER, INT);
+			DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL, INT);
+			DISASSEMBLE_OPERATOR_TYPED(ADD, FLOAT);
+			DISASSEMBLE_OPERATOR_TYPED(SUBTRACT, FLOAT);
+			DISASSEMBLE_OPERATOR_TYPED(MULTIPLY, FLOAT);
+			DISASSEMBLE_OPERATOR_TYPED(DIVIDE, FLOAT);
+			DISASSEMBLE_OPERATOR_TYPED(EQUAL, FLOAT);
+			DISASSEMBLE_OPERATOR_TYPED(NOT_EQUAL, FLOAT);
+			DISASSEMBLE_OPERATOR_TYPED(LESS, FLOAT);
+			DISASSEMBLE_OPERATOR_TYPED(LESS_EQUAL, FLOAT);
+			DISASSEMBLE_OPERATOR_TYPED(GREATER, FLOAT);
+			DISASSEMBLE_OPERATOR_TYPED(GREATER_EQUAL, FLOAT);
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -267,7 +302,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -288,7 +323,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -597,7 +632,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -945,6 +980,22 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 3;
 			} break;
+			case OPCODE_JUMP_IF_BOOL: {
+				text += "jump-if (typed bool) ";
+				text += DADDR(1);
+				text += " to ";
+				text += itos(_code_ptr[ip + 2]);
+
+				incr = 3;
+			} break;
+			case OPCODE_JUMP_IF_NOT_BOOL: {
+				text += "jump-if-not (typed bool) ";
+				text += DADDR(1);
+				text += " to ";
+				text += itos(_code_ptr[ip + 2]);
+
+				incr = 3;
+			} break;
 			case OPCODE_JUMP_TO_DEF_ARGUMENT: {
 				text += "jump-to-default-argument ";
 
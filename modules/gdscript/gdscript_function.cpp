@@ -114,6 +114,8 @@ GDScriptFunction::GDScriptFunction() {
 #endif
 }
 
+SafeNumeric<uint32_t> GDScriptInlineCache::global_generation(1);
+
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
 
@@ -121,6 +123,12 @@ GDScriptFunction::~GDScriptFunction() {
 		memdelete(lambdas[i]);
 	}
 
+	if (inline_caches) {
+		memdelete_arr(inline_caches);
+	}
+	// Cached entries may point to this function or to members of its script.
+	GDScriptInlineCache::global_generation.increment();
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
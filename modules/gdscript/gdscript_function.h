@@ -31,18 +31,24 @@
 #ifndef GDSCRIPT_FUNCTION_H
 #define GDSCRIPT_FUNCTION_H
 
+#include "gdscript_native.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
 class GDScript;
+class GDScriptFunction;
+class MethodBind;
 
 class GDScriptDataType {
 public:
@@ -213,11 +219,108 @@ public:
 	~GDScriptDataType() {}
 };
 
+// Per call site cache of member lookups on untyped receivers, keyed on the receiver's script and native class.
+// Holds up to MAX_ENTRIES receiver shapes; once full the site is megamorphic and always takes the slow path.
+//
+// Hits only load memory: the entries are guarded by a sequence counter that writers make odd while they
+// update them, and a reader that sees it change while copying its entry treats the lookup as a miss.
+struct GDScriptInlineCache {
+	enum Kind {
+		KIND_METHOD_BIND, // Native method, or native property accessor when member_index is -1.
+		KIND_FUNCTION, // GDScript member function.
+		KIND_MEMBER, // GDScript member variable without getter or setter.
+	};
+
+	struct Entry {
+		const void *script = nullptr;
+		const void *native_class = nullptr;
+		Kind kind = KIND_METHOD_BIND;
+		MethodBind *method = nullptr;
+		GDScriptFunction *function = nullptr;
+		int member_index = -1;
+		const GDScriptDataType *member_type = nullptr;
+	};
+
+	static constexpr int MAX_ENTRIES = 4;
+
+	// Bumped whenever compiled functions are freed (e.g. on script reload), which drops every cached entry.
+	static SafeNumeric<uint32_t> global_generation;
+
+	std::atomic<uint32_t> sequence = 0;
+	SpinLock write_lock; // Only taken on misses, to serialize writers.
+	uint32_t generation = 0;
+	int entry_count = 0;
+	Entry entries[MAX_ENTRIES];
+
+	// On a miss, r_generation is the generation the caller must pass to insert() once it has resolved the entry.
+	_FORCE_INLINE_ bool find(const void *p_script, const void *p_native_class, Entry &r_entry, uint32_t &r_generation) {
+		r_generation = global_generation.get();
+		const uint32_t seq = sequence.load(std::memory_order_acquire);
+		if (seq & 1) {
+			return false;
+		}
+		// Copied to a local first, since a torn copy must not leak into the caller's slow path.
+		Entry entry;
+		bool found = false;
+		if (generation == r_generation) {
+			for (int i = 0; i < entry_count && i < MAX_ENTRIES; i++) {
+				if (entries[i].script == p_script && entries[i].native_class == p_native_class) {
+					entry = entries[i];
+					found = true;
+					break;
+				}
+			}
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (!found || sequence.load(std::memory_order_relaxed) != seq) {
+			return false;
+		}
+		r_entry = entry;
+		return true;
+	}
+
+	void insert(const Entry &p_entry, uint32_t p_generation) {
+		write_lock.lock();
+		// Functions freed since the lookup may be referenced by the entry.
+		if (p_generation == global_generation.get() && (generation != p_generation || entry_count < MAX_ENTRIES)) {
+			const uint32_t seq = sequence.load(std::memory_order_relaxed);
+			sequence.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			if (generation != p_generation) {
+				generation = p_generation;
+				entry_count = 0;
+			}
+			entries[entry_count++] = p_entry;
+			sequence.store(seq + 2, std::memory_order_release);
+		}
+		write_lock.unlock();
+	}
+};
+
 class GDScriptFunction {
 public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_ADD_INT,
+		OPCODE_OPERATOR_SUBTRACT_INT,
+		OPCODE_OPERATOR_MULTIPLY_INT,
+		OPCODE_OPERATOR_EQUAL_INT,
+		OPCODE_OPERATOR_NOT_EQUAL_INT,
+		OPCODE_OPERATOR_LESS_INT,
+		OPCODE_OPERATOR_LESS_EQUAL_INT,
+		OPCODE_OPERATOR_GREATER_INT,
+		OPCODE_OPERATOR_GREATER_EQUAL_INT,
+		OPCODE_OPERATOR_ADD_FLOAT,
+		OPCODE_OPERATOR_SUBTRACT_FLOAT,
+		OPCODE_OPERATOR_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_DIVIDE_FLOAT,
+		OPCODE_OPERATOR_EQUAL_FLOAT,
+		OPCODE_OPERATOR_NOT_EQUAL_FLOAT,
+		OPCODE_OPERATOR_LESS_FLOAT,
+		OPCODE_OPERATOR_LESS_EQUAL_FLOAT,
+		OPCODE_OPERATOR_GREATER_FLOAT,
+		OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_NATIVE,
@@ -275,6 +378,8 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_JUMP_IF_BOOL,
+		OPCODE_JUMP_IF_NOT_BOOL,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
 		OPCODE_RETURN,
@@ -402,6 +507,8 @@ private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeReader;
+	friend class GDScriptBytecodeWriter;
 
 	StringName name;
 	StringName source;
@@ -439,6 +546,11 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+	GDScriptInlineCache *inline_caches = nullptr;
+	int inline_cache_count = 0;
+
+	// Ahead-of-time compiled version of this function, used instead of the byte code when the arguments have the exact declared types.
+	GDScriptNativeFunctions::FunctionPtr native_function = nullptr;
 
 	int _code_size = 0;
 	int _default_arg_count = 0;
@@ -512,6 +624,11 @@ private:
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	// Fast paths for untyped member access, return false when the generic Variant path must be used.
+	bool _inline_cache_call(GDScriptInlineCache &p_cache, Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+	bool _inline_cache_get(GDScriptInlineCache &p_cache, Object *p_object, const StringName &p_name, Variant &r_ret);
+	bool _inline_cache_set(GDScriptInlineCache &p_cache, Object *p_object, const StringName &p_name, const Variant &p_value, bool &r_valid);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
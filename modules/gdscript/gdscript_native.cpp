@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  gdscript_native.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_native.h"
+
+#include "core/templates/local_vector.h"
+
+GDScriptNativeFunctions::Table *GDScriptNativeFunctions::tables = nullptr;
+HashMap<String, HashMap<StringName, const GDScriptNativeFunctions::Entry *>> GDScriptNativeFunctions::entries;
+
+void GDScriptNativeFunctions::_update_entries() {
+	entries.clear();
+	// Walk the oldest tables first, so the most recently added one wins.
+	LocalVector<const Table *> ordered;
+	for (const Table *table = tables; table; table = table->next) {
+		ordered.push_back(table);
+	}
+	for (int64_t i = int64_t(ordered.size()) - 1; i >= 0; i--) {
+		for (const Entry *E = ordered[i]->entries; E->function; E++) {
+			entries[String::utf8(E->path)][StringName(E->name)] = E;
+		}
+	}
+}
+
+void GDScriptNativeFunctions::add_table(Table *p_table) {
+	for (const Table *table = tables; table; table = table->next) {
+		ERR_FAIL_COND_MSG(table == p_table, "GDScript native function table is already registered.");
+	}
+	p_table->next = tables;
+	tables = p_table;
+	_update_entries();
+}
+
+void GDScriptNativeFunctions::remove_table(Table *p_table) {
+	for (Table **table = &tables; *table; table = &(*table)->next) {
+		if (*table == p_table) {
+			*table = p_table->next;
+			p_table->next = nullptr;
+			_update_entries();
+			return;
+		}
+	}
+}
+
+bool GDScriptNativeFunctions::has_functions() {
+	return tables != nullptr;
+}
+
+const GDScriptNativeFunctions::Entry *GDScriptNativeFunctions::get_entry(const String &p_path, const StringName &p_name) {
+	// Tables are only added during module initialization, before scripts compile, so this needs no locking.
+	const HashMap<StringName, const Entry *> *functions = entries.getptr(p_path);
+	if (!functions) {
+		return nullptr;
+	}
+	const Entry *const *E = functions->getptr(p_name);
+	return E ? *E : nullptr;
+}
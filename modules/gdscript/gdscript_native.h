@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*  gdscript_native.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_NATIVE_H
+#define GDSCRIPT_NATIVE_H
+
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant.h"
+
+// Registry of GDScript functions that were transpiled to C++ ahead of time (see `GDScriptTranspiler`)
+// and compiled into the binary. The generated file defines `register_gdscript_native_code()`, which
+// the module calls on initialization to link the file's static `Table` into the registry. Calling it
+// from there also keeps the linker from dropping the file out of the static modules library.
+//
+// When the compiler builds a function that has an entry here, it transpiles the function again and
+// only uses the native version if the hash of the generated code still matches, so a stale table
+// never replaces a function whose source has changed since it was generated. Functions without an
+// entry are not transpiled.
+class GDScriptNativeFunctions {
+public:
+	// Arguments are guaranteed to have exactly the declared built-in types.
+	typedef void (*FunctionPtr)(Variant *r_ret, const Variant **p_args);
+
+	struct Entry {
+		const char *path = nullptr;
+		const char *name = nullptr;
+		uint32_t hash = 0;
+		FunctionPtr function = nullptr;
+	};
+
+	struct Table {
+		const Entry *entries = nullptr;
+		Table *next = nullptr;
+	};
+
+private:
+	static Table *tables;
+	// Path, then function name. Rebuilt when tables are added or removed.
+	static HashMap<String, HashMap<StringName, const Entry *>> entries;
+
+	static void _update_entries();
+
+public:
+	// Tables must be added before any script is compiled, and stay registered until they're removed.
+	static void add_table(Table *p_table);
+	static void remove_table(Table *p_table);
+
+	static bool has_functions();
+	// Returns the entry of the most recently added table that has this function, or null.
+	static const Entry *get_entry(const String &p_path, const StringName &p_name);
+};
+
+#ifdef GDSCRIPT_NATIVE_CODE_ENABLED
+// Defined in the file given by the `gdscript_native_code` build option.
+void register_gdscript_native_code();
+#endif
+
+#endif // GDSCRIPT_NATIVE_H
@@ -0,0 +1,295 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript_function.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+
+SafeFlag GDScriptSamplingProfiler::active;
+SafeNumeric<uint32_t> GDScriptSamplingProfiler::tick;
+uint32_t GDScriptSamplingProfiler::start_tick = 0;
+uint64_t GDScriptSamplingProfiler::interval_usec = 0;
+Thread GDScriptSamplingProfiler::sampler_thread;
+SafeFlag GDScriptSamplingProfiler::sampler_running;
+
+Mutex GDScriptSamplingProfiler::mutex;
+LocalVector<GDScriptSamplingProfiler::ThreadStack *> GDScriptSamplingProfiler::thread_stacks;
+LocalVector<GDScriptSamplingProfiler::FinishedThread> GDScriptSamplingProfiler::finished_threads;
+LocalVector<String> GDScriptSamplingProfiler::frame_names;
+HashMap<String, uint32_t> GDScriptSamplingProfiler::frame_name_ids;
+
+/* ThreadStack. */
+
+void GDScriptSamplingProfiler::ThreadStack::capture(uint32_t p_tick) {
+	// Count ticks from the start, in case this thread kept an old tick from an earlier run.
+	uint32_t weight = MIN(p_tick - last_tick, p_tick - start_tick);
+	last_tick = p_tick;
+	if (weight == 0 || frames.is_empty()) {
+		return;
+	}
+
+	// Function addresses can be reused once freed.
+	uint32_t generation = GDScriptInlineCache::global_generation.get();
+	if (generation != frame_ids_generation) {
+		frame_ids.clear();
+		frame_ids_generation = generation;
+	}
+
+	// Resolved before locking, `_get_frame_id()` locks the profiler.
+	frame_scratch.clear();
+	for (const Frame &frame : frames) {
+		FrameKey key = { frame.function, *frame.line };
+		HashMap<FrameKey, uint32_t, FrameKey>::Iterator E = frame_ids.find(key);
+		if (E) {
+			frame_scratch.push_back(E->value);
+		} else {
+			uint32_t id = _get_frame_id(frame);
+			frame_ids.insert(key, id);
+			frame_scratch.push_back(id);
+		}
+	}
+
+	Sample sample;
+	sample.time = OS::get_singleton()->get_ticks_usec();
+	sample.weight = weight;
+	sample.depth = frame_scratch.size();
+
+	MutexLock lock(mutex);
+	sample.first_frame = sample_frames.size();
+	for (uint32_t id : frame_scratch) {
+		sample_frames.push_back(id);
+	}
+	samples.push_back(sample);
+	sampled = true;
+}
+
+void GDScriptSamplingProfiler::ThreadStack::mark_idle() {
+	Sample sample;
+	sample.time = OS::get_singleton()->get_ticks_usec();
+
+	MutexLock lock(mutex);
+	sample.first_frame = sample_frames.size();
+	samples.push_back(sample);
+	sampled = false;
+}
+
+GDScriptSamplingProfiler::ThreadStack::ThreadStack() {
+	thread_id = Thread::get_caller_id();
+	last_tick = tick.get();
+
+	MutexLock lock(GDScriptSamplingProfiler::mutex);
+	thread_stacks.push_back(this);
+}
+
+GDScriptSamplingProfiler::ThreadStack::~ThreadStack() {
+	MutexLock lock(GDScriptSamplingProfiler::mutex);
+	thread_stacks.erase(this);
+	if (!samples.is_empty()) {
+		// Keep the samples of threads that are gone, worker threads may exit before the profile is saved.
+		FinishedThread finished;
+		finished.thread_id = thread_id;
+		finished.samples = samples;
+		finished.sample_frames = sample_frames;
+		finished_threads.push_back(finished);
+	}
+}
+
+/* GDScriptSamplingProfiler. */
+
+GDScriptSamplingProfiler::ThreadStack *GDScriptSamplingProfiler::_get_thread_stack() {
+	static thread_local ThreadStack thread_stack;
+	return &thread_stack;
+}
+
+uint32_t GDScriptSamplingProfiler::_get_frame_id(const ThreadStack::Frame &p_frame) {
+	String name = vformat("%s (%s:%d)", p_frame.function->get_name(), p_frame.function->get_source(), *p_frame.line);
+	// Reserved by the collapsed stack format.
+	name = name.replace(";", ":");
+
+	MutexLock lock(mutex);
+	HashMap<String, uint32_t>::Iterator E = frame_name_ids.find(name);
+	if (E) {
+		return E->value;
+	}
+	uint32_t id = frame_names.size();
+	frame_names.push_back(name);
+	frame_name_ids.insert(name, id);
+	return id;
+}
+
+void GDScriptSamplingProfiler::_sampler_thread_func(void *p_userdata) {
+	Thread::set_name("GDScript Sampling Profiler");
+	while (sampler_running.is_set()) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		tick.increment();
+	}
+}
+
+template <typename F>
+void GDScriptSamplingProfiler::_for_each_thread(F p_callback) {
+	MutexLock lock(mutex);
+	for (ThreadStack *thread_stack : thread_stacks) {
+		MutexLock thread_lock(thread_stack->mutex);
+		p_callback(thread_stack->thread_id, thread_stack->samples, thread_stack->sample_frames);
+	}
+	for (const FinishedThread &finished : finished_threads) {
+		p_callback(finished.thread_id, finished.samples, finished.sample_frames);
+	}
+}
+
+void GDScriptSamplingProfiler::start(uint64_t p_interval_usec) {
+	if (active.is_set()) {
+		return;
+	}
+	interval_usec = p_interval_usec;
+	start_tick = tick.get();
+	active.set();
+
+	if (interval_usec > 0) {
+#ifdef THREADS_ENABLED
+		sampler_running.set();
+		sampler_thread.start(_sampler_thread_func, nullptr);
+#else
+		WARN_PRINT("GDScript sampling profiler: no threads available, samples are only taken on request.");
+#endif
+	}
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!active.is_set()) {
+		return;
+	}
+	active.clear();
+	if (sampler_running.is_set()) {
+		sampler_running.clear();
+		sampler_thread.wait_to_finish();
+	}
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	for (ThreadStack *thread_stack : thread_stacks) {
+		MutexLock thread_lock(thread_stack->mutex);
+		thread_stack->samples.clear();
+		thread_stack->sample_frames.clear();
+		thread_stack->sampled = false;
+	}
+	finished_threads.clear();
+}
+
+static String _get_thread_name(Thread::ID p_thread_id) {
+	return p_thread_id == Thread::get_main_id() ? String("Main Thread") : vformat("Thread %d", p_thread_id);
+}
+
+String GDScriptSamplingProfiler::get_collapsed_stacks() {
+	HashMap<String, uint64_t> counts;
+	_for_each_thread([&](Thread::ID p_thread_id, const LocalVector<ThreadStack::Sample> &p_samples, const LocalVector<uint32_t> &p_frames) {
+		String thread_name = _get_thread_name(p_thread_id);
+		for (const ThreadStack::Sample &sample : p_samples) {
+			if (sample.depth == 0) {
+				continue;
+			}
+			String stack = thread_name;
+			for (uint32_t i = 0; i < sample.depth; i++) {
+				stack += ";" + frame_names[p_frames[sample.first_frame + i]];
+			}
+			counts[stack] += sample.weight;
+		}
+	});
+
+	Vector<String> stacks;
+	for (const KeyValue<String, uint64_t> &E : counts) {
+		stacks.push_back(E.key + " " + itos(E.value));
+	}
+	stacks.sort();
+
+	String collapsed;
+	for (const String &stack : stacks) {
+		collapsed += stack + "\n";
+	}
+	return collapsed;
+}
+
+String GDScriptSamplingProfiler::get_chrome_trace() {
+	Vector<String> events;
+	uint64_t duration = MAX(interval_usec, (uint64_t)1);
+
+	_for_each_thread([&](Thread::ID p_thread_id, const LocalVector<ThreadStack::Sample> &p_samples, const LocalVector<uint32_t> &p_frames) {
+		events.push_back(vformat(R"({"name":"thread_name","ph":"M","pid":1,"tid":%d,"args":{"name":"%s"}})", p_thread_id, _get_thread_name(p_thread_id)));
+
+		// A frame stays open while consecutive samples contain it at the same depth.
+		struct OpenFrame {
+			uint32_t id = 0;
+			uint64_t start = 0;
+		};
+		LocalVector<OpenFrame> open_frames;
+		auto close_frames = [&](uint32_t p_depth, uint64_t p_time) {
+			while (open_frames.size() > p_depth) {
+				const OpenFrame &frame = open_frames[open_frames.size() - 1];
+				events.push_back(vformat(R"({"name":"%s","cat":"gdscript","ph":"X","ts":%d,"dur":%d,"pid":1,"tid":%d})",
+						frame_names[frame.id].json_escape(), frame.start, MAX(p_time - frame.start, (uint64_t)1), p_thread_id));
+				open_frames.resize(open_frames.size() - 1);
+			}
+		};
+
+		uint64_t last_time = 0;
+		for (const ThreadStack::Sample &sample : p_samples) {
+			uint32_t common = 0;
+			while (common < open_frames.size() && common < sample.depth && open_frames[common].id == p_frames[sample.first_frame + common]) {
+				common++;
+			}
+			close_frames(common, sample.time);
+			for (uint32_t i = common; i < sample.depth; i++) {
+				open_frames.push_back({ p_frames[sample.first_frame + i], sample.time });
+			}
+			last_time = sample.time;
+		}
+		close_frames(0, last_time + duration);
+	});
+
+	return "{\"traceEvents\":[\n" + String(",\n").join(events) + "\n]}\n";
+}
+
+Error GDScriptSamplingProfiler::save_collapsed_stacks(const String &p_path) {
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_CANT_CREATE, "Can't write GDScript profile: " + p_path);
+	file->store_string(get_collapsed_stacks());
+	return OK;
+}
+
+Error GDScriptSamplingProfiler::save_chrome_trace(const String &p_path) {
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_CANT_CREATE, "Can't write GDScript profile: " + p_path);
+	file->store_string(get_chrome_trace());
+	return OK;
+}
@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+
+// Statistical profiler for the GDScript VM, cheap enough to leave running in release builds.
+//
+// A sampler thread only advances a tick counter. Each thread running GDScript keeps a shadow stack of the
+// functions it is in, and records it at the next line (or function exit) once it notices a new tick. Samples
+// are taken by the thread that owns the stack, so no thread needs to be suspended and functions can't be
+// freed while they are being sampled. Time spent in native code is attributed to the script line that called it.
+class GDScriptSamplingProfiler {
+public:
+	struct ThreadStack {
+		struct Frame {
+			const GDScriptFunction *function = nullptr;
+			const int *line = nullptr;
+		};
+
+		struct Sample {
+			uint64_t time = 0;
+			uint32_t weight = 0;
+			uint32_t first_frame = 0;
+			uint32_t depth = 0;
+		};
+
+		struct FrameKey {
+			const GDScriptFunction *function = nullptr;
+			int line = 0;
+
+			bool operator==(const FrameKey &p_key) const { return function == p_key.function && line == p_key.line; }
+			static uint32_t hash(const FrameKey &p_key) { return hash_murmur3_one_32(p_key.line, hash_one_uint64((uint64_t)p_key.function)); }
+		};
+
+		Thread::ID thread_id;
+		uint32_t last_tick = 0;
+		bool sampled = false; // Since the stack was last empty.
+		LocalVector<Frame> frames;
+		LocalVector<uint32_t> frame_scratch;
+
+		// Ids of the frames seen by this thread, dropped when any function is freed.
+		HashMap<FrameKey, uint32_t, FrameKey> frame_ids;
+		uint32_t frame_ids_generation = 0;
+
+		// Locked when recording, and when samples are read or cleared from another thread.
+		BinaryMutex mutex;
+		LocalVector<Sample> samples;
+		LocalVector<uint32_t> sample_frames;
+
+		void capture(uint32_t p_tick);
+		// Records an empty stack, so the trace doesn't stretch the last sample over the time spent outside scripts.
+		void mark_idle();
+
+		ThreadStack();
+		~ThreadStack();
+	};
+
+private:
+	struct FinishedThread {
+		Thread::ID thread_id;
+		LocalVector<ThreadStack::Sample> samples;
+		LocalVector<uint32_t> sample_frames;
+	};
+
+	static SafeFlag active;
+	static SafeNumeric<uint32_t> tick;
+	static uint32_t start_tick;
+	static uint64_t interval_usec;
+	static Thread sampler_thread;
+	static SafeFlag sampler_running;
+
+	static Mutex mutex;
+	static LocalVector<ThreadStack *> thread_stacks;
+	static LocalVector<FinishedThread> finished_threads;
+	static LocalVector<String> frame_names;
+	static HashMap<String, uint32_t> frame_name_ids;
+
+	static ThreadStack *_get_thread_stack();
+	static uint32_t _get_frame_id(const ThreadStack::Frame &p_frame);
+	static void _sampler_thread_func(void *p_userdata);
+
+	template <typename F>
+	static void _for_each_thread(F p_callback);
+
+public:
+	// Samples every `p_interval_usec` microseconds. With 0, samples are only taken on `request_sample()`.
+	static void start(uint64_t p_interval_usec);
+	static void stop();
+	static bool is_running() { return active.is_set(); }
+	static void clear();
+	// Makes every thread running GDScript record its stack at its next line.
+	static void request_sample() { tick.increment(); }
+
+	// One line per unique stack, "thread;outermost;...;innermost <count>", for `flamegraph.pl` and compatible tools.
+	static String get_collapsed_stacks();
+	// Complete ("X") events in the Chrome trace event format, for `chrome://tracing`, Perfetto or speedscope.
+	static String get_chrome_trace();
+	static Error save_collapsed_stacks(const String &p_path);
+	static Error save_chrome_trace(const String &p_path);
+
+	_FORCE_INLINE_ static ThreadStack *enter_function(const GDScriptFunction *p_function, const int *p_line) {
+		if (likely(!active.is_set())) {
+			return nullptr;
+		}
+		ThreadStack *thread_stack = _get_thread_stack();
+		if (thread_stack->frames.is_empty()) {
+			// Ticks that passed while not running scripts don't count.
+			thread_stack->last_tick = tick.get();
+		}
+		thread_stack->frames.push_back({ p_function, p_line });
+		return thread_stack;
+	}
+
+	_FORCE_INLINE_ static void poll(ThreadStack *p_thread_stack) {
+		uint32_t current_tick = tick.get();
+		if (unlikely(p_thread_stack->last_tick != current_tick)) {
+			p_thread_stack->capture(current_tick);
+		}
+	}
+
+	_FORCE_INLINE_ static void exit_function(ThreadStack *p_thread_stack) {
+		poll(p_thread_stack);
+		p_thread_stack->frames.resize(p_thread_stack->frames.size() - 1);
+		if (p_thread_stack->frames.is_empty() && p_thread_stack->sampled) {
+			p_thread_stack->mark_idle();
+		}
+	}
+};
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
@@ -0,0 +1,538 @@
+/**************************************************************************/
+/*  gdscript_transpiler.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_transpiler.h"
+
+#include "core/math/math_funcs.h"
+
+bool GDScriptTranspiler::_get_type(const GDScriptParser::DataType &p_datatype, Variant::Type &r_type) {
+	if (!p_datatype.is_set() || !p_datatype.is_hard_type() || p_datatype.kind != GDScriptParser::DataType::BUILTIN) {
+		return false;
+	}
+
+	switch (p_datatype.builtin_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+			r_type = p_datatype.builtin_type;
+			return true;
+		default:
+			return false;
+	}
+}
+
+String GDScriptTranspiler::_get_c_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return "bool";
+		case Variant::INT:
+			return "int64_t";
+		case Variant::FLOAT:
+			return "double";
+		default:
+			ERR_FAIL_V_MSG("void", "Unsupported type in GDScript transpiler.");
+	}
+}
+
+bool GDScriptTranspiler::_get_local_name(const GDScriptParser::IdentifierNode *p_identifier, String &r_name) {
+	if (p_identifier->source != GDScriptParser::IdentifierNode::FUNCTION_PARAMETER && p_identifier->source != GDScriptParser::IdentifierNode::LOCAL_VARIABLE) {
+		return false;
+	}
+
+	// Identifiers are used as is, with a prefix so they can't clash with C++ keywords.
+	const String name = p_identifier->name;
+	if (!name.is_valid_identifier()) {
+		return false;
+	}
+	r_name = "l_" + name;
+	return true;
+}
+
+String GDScriptTranspiler::_convert(const String &p_expression, Variant::Type p_from, Variant::Type p_to) {
+	if (p_from == p_to) {
+		return p_expression;
+	}
+	// Same truncation and promotion rules as the Variant conversions the VM would do.
+	return _get_c_type(p_to) + "(" + p_expression + ")";
+}
+
+bool GDScriptTranspiler::_write_constant(const Variant &p_value, String &r_code, Variant::Type &r_type) {
+	switch (p_value.get_type()) {
+		case Variant::BOOL: {
+			r_code = bool(p_value) ? "true" : "false";
+		} break;
+		case Variant::INT: {
+			const int64_t value = p_value;
+			// The negation of INT64_MAX + 1 is not a valid literal.
+			r_code = value == INT64_MIN ? String("INT64_MIN") : "int64_t(" + itos(value) + ")";
+		} break;
+		case Variant::FLOAT: {
+			const double value = p_value;
+			if (Math::is_nan(value)) {
+				r_code = "double(NAN)";
+			} else if (Math::is_inf(value)) {
+				r_code = value > 0 ? "double(INFINITY)" : "double(-INFINITY)";
+			} else {
+				// Hexadecimal floats round-trip exactly.
+				char buffer[64];
+				snprintf(buffer, sizeof(buffer), "%a", value);
+				r_code = "double(" + String(buffer) + ")";
+			}
+		} break;
+		default:
+			return false;
+	}
+
+	r_type = p_value.get_type();
+	return true;
+}
+
+bool GDScriptTranspiler::_write_expression(const GDScriptParser::ExpressionNode *p_expression, String &r_code, Variant::Type &r_type) {
+	if (p_expression->is_constant) {
+		return _write_constant(p_expression->reduced_value, r_code, r_type);
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::IDENTIFIER: {
+			const GDScriptParser::IdentifierNode *identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_expression);
+			return _get_local_name(identifier, r_code) && _get_type(identifier->get_datatype(), r_type);
+		} break;
+		case GDScriptParser::Node::UNARY_OPERATOR: {
+			const GDScriptParser::UnaryOpNode *unary_op = static_cast<const GDScriptParser::UnaryOpNode *>(p_expression);
+			String operand;
+			Variant::Type operand_type;
+			if (!_write_expression(unary_op->operand, operand, operand_type)) {
+				return false;
+			}
+
+			switch (unary_op->operation) {
+				case GDScriptParser::UnaryOpNode::OP_POSITIVE:
+					if (operand_type == Variant::BOOL) {
+						return false;
+					}
+					r_code = operand;
+					break;
+				case GDScriptParser::UnaryOpNode::OP_NEGATIVE:
+					if (operand_type == Variant::BOOL) {
+						return false;
+					}
+					r_code = "(-" + operand + ")";
+					break;
+				case GDScriptParser::UnaryOpNode::OP_COMPLEMENT:
+					if (operand_type != Variant::INT) {
+						return false;
+					}
+					r_code = "(~" + operand + ")";
+					break;
+				case GDScriptParser::UnaryOpNode::OP_LOGIC_NOT:
+					if (operand_type != Variant::BOOL) {
+						return false;
+					}
+					r_code = "(!" + operand + ")";
+					break;
+			}
+			r_type = operand_type;
+			return true;
+		} break;
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary_op = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			Variant::Type result_type;
+			if (!_get_type(binary_op->get_datatype(), result_type)) {
+				return false;
+			}
+
+			String left, right;
+			Variant::Type left_type, right_type;
+			if (!_write_expression(binary_op->left_operand, left, left_type) || !_write_expression(binary_op->right_operand, right, right_type)) {
+				return false;
+			}
+
+			const bool numeric = left_type != Variant::BOOL && right_type != Variant::BOOL;
+			const bool both_int = left_type == Variant::INT && right_type == Variant::INT;
+			const bool both_bool = left_type == Variant::BOOL && right_type == Variant::BOOL;
+			String op;
+			switch (binary_op->operation) {
+				case GDScriptParser::BinaryOpNode::OP_ADDITION:
+					op = "+";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_SUBTRACTION:
+					op = "-";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_MULTIPLICATION:
+					op = "*";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_DIVISION:
+					// Integer division has to report division by zero, leave it to the VM.
+					if (both_int) {
+						return false;
+					}
+					op = "/";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_BIT_AND:
+					op = "&";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_BIT_OR:
+					op = "|";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_BIT_XOR:
+					op = "^";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_LOGIC_AND:
+					op = "&&";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_LOGIC_OR:
+					op = "||";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_COMP_EQUAL:
+					op = "==";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_COMP_NOT_EQUAL:
+					op = "!=";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_COMP_LESS:
+					op = "<";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_COMP_LESS_EQUAL:
+					op = "<=";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_COMP_GREATER:
+					op = ">";
+					break;
+				case GDScriptParser::BinaryOpNode::OP_COMP_GREATER_EQUAL:
+					op = ">=";
+					break;
+				default:
+					return false;
+			}
+
+			switch (binary_op->operation) {
+				case GDScriptParser::BinaryOpNode::OP_BIT_AND:
+				case GDScriptParser::BinaryOpNode::OP_BIT_OR:
+				case GDScriptParser::BinaryOpNode::OP_BIT_XOR:
+					if (!both_int) {
+						return false;
+					}
+					break;
+				case GDScriptParser::BinaryOpNode::OP_LOGIC_AND:
+				case GDScriptParser::BinaryOpNode::OP_LOGIC_OR:
+					if (!both_bool) {
+						return false;
+					}
+					break;
+				case GDScriptParser::BinaryOpNode::OP_COMP_EQUAL:
+				case GDScriptParser::BinaryOpNode::OP_COMP_NOT_EQUAL:
+					if (!numeric && !both_bool) {
+						return false;
+					}
+					break;
+				default:
+					if (!numeric) {
+						return false;
+					}
+					break;
+			}
+
+			// Mixed int and float operands are promoted to float, like the Variant evaluators do.
+			r_code = "(" + left + " " + op + " " + right + ")";
+			r_type = result_type;
+			return true;
+		} break;
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary_op = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			String condition, true_expr, false_expr;
+			Variant::Type condition_type, true_type, false_type;
+			if (!_write_expression(ternary_op->condition, condition, condition_type) || condition_type != Variant::BOOL) {
+				return false;
+			}
+			if (!_write_expression(ternary_op->true_expr, true_expr, true_type) || !_write_expression(ternary_op->false_expr, false_expr, false_type) || true_type != false_type) {
+				return false;
+			}
+			r_code = "(" + condition + " ? " + true_expr + " : " + false_expr + ")";
+			r_type = true_type;
+			return true;
+		} break;
+		case GDScriptParser::Node::CALL: {
+			// Only `int()` and `float()` conversions of numbers.
+			const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(p_expression);
+			if (call->is_super || !call->callee || call->callee->type != GDScriptParser::Node::IDENTIFIER || call->arguments.size() != 1) {
+				return false;
+			}
+			const Variant::Type target_type = GDScriptParser::get_builtin_type(call->function_name);
+			if (target_type != Variant::INT && target_type != Variant::FLOAT) {
+				return false;
+			}
+
+			String argument;
+			Variant::Type argument_type;
+			if (!_write_expression(call->arguments[0], argument, argument_type) || argument_type == Variant::BOOL) {
+				return false;
+			}
+			r_code = _convert(argument, argument_type, target_type);
+			r_type = target_type;
+			return true;
+		} break;
+		default:
+			return false;
+	}
+}
+
+bool GDScriptTranspiler::_write_assignment(const GDScriptParser::AssignmentNode *p_assignment, String &r_code) {
+	if (p_assignment->assignee->type != GDScriptParser::Node::IDENTIFIER) {
+		return false;
+	}
+
+	const GDScriptParser::IdentifierNode *assignee = static_cast<const GDScriptParser::IdentifierNode *>(p_assignment->assignee);
+	String target;
+	Variant::Type target_type;
+	if (!_get_local_name(assignee, target) || !_get_type(assignee->get_datatype(), target_type)) {
+		return false;
+	}
+
+	String value;
+	Variant::Type value_type;
+	if (!_write_expression(p_assignment->assigned_value, value, value_type)) {
+		return false;
+	}
+
+	if (p_assignment->operation != GDScriptParser::AssignmentNode::OP_NONE) {
+		String op;
+		switch (p_assignment->operation) {
+			case GDScriptParser::AssignmentNode::OP_ADDITION:
+				op = "+";
+				break;
+			case GDScriptParser::AssignmentNode::OP_SUBTRACTION:
+				op = "-";
+				break;
+			case GDScriptParser::AssignmentNode::OP_MULTIPLICATION:
+				op = "*";
+				break;
+			case GDScriptParser::AssignmentNode::OP_DIVISION:
+				if (target_type == Variant::INT && value_type == Variant::INT) {
+					return false;
+				}
+				op = "/";
+				break;
+			default:
+				return false;
+		}
+		if (target_type == Variant::BOOL || value_type == Variant::BOOL) {
+			return false;
+		}
+
+		const Variant::Type result_type = (target_type == Variant::FLOAT || value_type == Variant::FLOAT) ? Variant::FLOAT : Variant::INT;
+		value = "(" + target + " " + op + " " + value + ")";
+		value_type = result_type;
+	}
+
+	if ((target_type == Variant::BOOL) != (value_type == Variant::BOOL)) {
+		return false;
+	}
+
+	r_code = target + " = " + _convert(value, value_type, target_type) + ";";
+	return true;
+}
+
+bool GDScriptTranspiler::_write_block(const GDScriptParser::SuiteNode *p_suite, Variant::Type p_return_type, int p_indent, String &r_code) {
+	const String indent = String("\t").repeat(p_indent);
+
+	for (const GDScriptParser::Node *statement : p_suite->statements) {
+		switch (statement->type) {
+			case GDScriptParser::Node::PASS:
+			case GDScriptParser::Node::CONSTANT: {
+				// Local constants are folded into the expressions using them.
+			} break;
+			case GDScriptParser::Node::VARIABLE: {
+				const GDScriptParser::VariableNode *variable = static_cast<const GDScriptParser::VariableNode *>(statement);
+				String name;
+				Variant::Type type;
+				if (!variable->identifier->name.operator String().is_valid_identifier() || !_get_type(variable->get_datatype(), type)) {
+					return false;
+				}
+				name = "l_" + variable->identifier->name;
+
+				String value;
+				Variant::Type value_type = type;
+				if (variable->initializer) {
+					if (!_write_expression(variable->initializer, value, value_type) || (type == Variant::BOOL) != (value_type == Variant::BOOL)) {
+						return false;
+					}
+				} else {
+					value = type == Variant::BOOL ? "false" : _get_c_type(type) + "(0)";
+				}
+				r_code += indent + _get_c_type(type) + " " + name + " = " + _convert(value, value_type, type) + ";\n";
+			} break;
+			case GDScriptParser::Node::ASSIGNMENT: {
+				String assignment;
+				if (!_write_assignment(static_cast<const GDScriptParser::AssignmentNode *>(statement), assignment)) {
+					return false;
+				}
+				r_code += indent + assignment + "\n";
+			} break;
+			case GDScriptParser::Node::IF: {
+				const GDScriptParser::IfNode *if_node = static_cast<const GDScriptParser::IfNode *>(statement);
+				String condition;
+				Variant::Type condition_type;
+				if (!_write_expression(if_node->condition, condition, condition_type) || condition_type != Variant::BOOL) {
+					return false;
+				}
+				r_code += indent + "if (" + condition + ") {\n";
+				if (!_write_block(if_node->true_block, p_return_type, p_indent + 1, r_code)) {
+					return false;
+				}
+				if (if_node->false_block) {
+					r_code += indent + "} else {\n";
+					if (!_write_block(if_node->false_block, p_return_type, p_indent + 1, r_code)) {
+						return false;
+					}
+				}
+				r_code += indent + "}\n";
+			} break;
+			case GDScriptParser::Node::WHILE: {
+				const GDScriptParser::WhileNode *while_node = static_cast<const GDScriptParser::WhileNode *>(statement);
+				String condition;
+				Variant::Type condition_type;
+				if (!_write_expression(while_node->condition, condition, condition_type) || condition_type != Variant::BOOL) {
+					return false;
+				}
+				r_code += indent + "while (" + condition + ") {\n";
+				if (!_write_block(while_node->loop, p_return_type, p_indent + 1, r_code)) {
+					return false;
+				}
+				r_code += indent + "}\n";
+			} break;
+			case GDScriptParser::Node::BREAK: {
+				r_code += indent + "break;\n";
+			} break;
+			case GDScriptParser::Node::CONTINUE: {
+				r_code += indent + "continue;\n";
+			} break;
+			case GDScriptParser::Node::RETURN: {
+				const GDScriptParser::ReturnNode *return_node = static_cast<const GDScriptParser::ReturnNode *>(statement);
+				if (return_node->return_value && !return_node->void_return) {
+					String value;
+					Variant::Type value_type;
+					if (p_return_type == Variant::NIL || !_write_expression(return_node->return_value, value, value_type) || (p_return_type == Variant::BOOL) != (value_type == Variant::BOOL)) {
+						return false;
+					}
+					r_code += indent + "*r_ret = " + _convert(value, value_type, p_return_type) + ";\n";
+				} else if (return_node->return_value) {
+					// `return void_function()` would need a call.
+					return false;
+				}
+				r_code += indent + "return;\n";
+			} break;
+			default:
+				return false;
+		}
+	}
+
+	return true;
+}
+
+bool GDScriptTranspiler::transpile_function(const GDScriptParser::FunctionNode *p_function, String &r_body) {
+	if (!p_function->identifier || !p_function->body || p_function->is_coroutine || p_function->source_lambda || !p_function->default_arg_values.is_empty()) {
+		return false;
+	}
+
+	Variant::Type return_type = Variant::NIL;
+	if (p_function->body->has_return && !_get_type(p_function->get_datatype(), return_type)) {
+		return false;
+	}
+
+	String body;
+	for (int i = 0; i < p_function->parameters.size(); i++) {
+		const GDScriptParser::ParameterNode *parameter = p_function->parameters[i];
+		Variant::Type type;
+		if (parameter->initializer || !parameter->identifier->name.operator String().is_valid_identifier() || !_get_type(parameter->get_datatype(), type)) {
+			return false;
+		}
+
+		String getter;
+		switch (type) {
+			case Variant::BOOL:
+				getter = "get_bool";
+				break;
+			case Variant::INT:
+				getter = "get_int";
+				break;
+			default:
+				getter = "get_float";
+				break;
+		}
+		body += "\t" + _get_c_type(type) + " l_" + parameter->identifier->name + " = *VariantInternal::" + getter + "(p_args[" + itos(i) + "]);\n";
+	}
+
+	if (!_write_block(p_function->body, return_type, 1, body)) {
+		return false;
+	}
+
+	r_body = body;
+	return true;
+}
+
+void GDScriptTranspiler::add_script(const String &p_path, const GDScriptParser::ClassNode *p_class) {
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		if (member.type != GDScriptParser::ClassNode::Member::FUNCTION) {
+			continue;
+		}
+
+		String body;
+		if (!transpile_function(member.function, body)) {
+			continue;
+		}
+
+		const String function_name = "_gdscript_native_" + itos(function_count++);
+		const String name = member.function->identifier->name;
+		functions += vformat("// %s::%s\n", p_path, name);
+		functions += "void " + function_name + "(Variant *r_ret, const Variant **p_args) {\n" + body + "}\n\n";
+		entries += vformat("\t{ \"%s\", \"%s\", %du, &%s },\n", p_path.c_escape(), name.c_escape(), get_body_hash(body), function_name);
+	}
+}
+
+String GDScriptTranspiler::get_code() const {
+	String code;
+	code += "/* THIS FILE IS GENERATED DO NOT EDIT */\n\n";
+	code += "#include \"modules/gdscript/gdscript_native.h\"\n\n";
+	code += "#include \"core/object/class_db.h\"\n";
+	code += "#include \"core/variant/variant_internal.h\"\n\n";
+	code += "#include <math.h>\n\n";
+	code += "namespace {\n\n";
+	code += functions;
+	code += "const GDScriptNativeFunctions::Entry entries[] = {\n";
+	code += entries;
+	code += "\t{},\n";
+	code += "};\n\n";
+	code += "GDScriptNativeFunctions::Table table = { entries };\n\n";
+	code += "} // namespace\n\n";
+	code += "void register_gdscript_native_code() {\n";
+	code += "\tGDScriptNativeFunctions::add_table(&table);\n";
+	code += "}\n";
+	return code;
+}
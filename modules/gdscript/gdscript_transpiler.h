@@ -0,0 +1,69 @@
+/**************************************************************************/
+/*  gdscript_transpiler.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_TRANSPILER_H
+#define GDSCRIPT_TRANSPILER_H
+
+#include "gdscript_parser.h"
+
+// Translates analyzed GDScript functions to C++ so they can be compiled into the binary and
+// registered with `GDScriptNativeFunctions`.
+//
+// Only a statically typed subset is supported: `int`, `float` and `bool` parameters, locals and
+// return values; arithmetic, comparison and logic operators; `if`, `while`, `break`, `continue`
+// and `return`. Functions using anything else (calls, members, other types, default arguments,
+// `await`...) are skipped and keep running in the VM.
+class GDScriptTranspiler {
+	String functions;
+	String entries;
+	int function_count = 0;
+
+	static bool _get_type(const GDScriptParser::DataType &p_datatype, Variant::Type &r_type);
+	static String _get_c_type(Variant::Type p_type);
+	static bool _get_local_name(const GDScriptParser::IdentifierNode *p_identifier, String &r_name);
+	static String _convert(const String &p_expression, Variant::Type p_from, Variant::Type p_to);
+	static bool _write_constant(const Variant &p_value, String &r_code, Variant::Type &r_type);
+	static bool _write_expression(const GDScriptParser::ExpressionNode *p_expression, String &r_code, Variant::Type &r_type);
+	static bool _write_assignment(const GDScriptParser::AssignmentNode *p_assignment, String &r_code);
+	static bool _write_block(const GDScriptParser::SuiteNode *p_suite, Variant::Type p_return_type, int p_indent, String &r_code);
+
+public:
+	// Writes the body of the C++ function implementing `p_function`, or returns false if it uses
+	// anything outside the supported subset.
+	static bool transpile_function(const GDScriptParser::FunctionNode *p_function, String &r_body);
+	static uint32_t get_body_hash(const String &p_body) { return p_body.hash(); }
+
+	// Transpiles every supported function of the script at `p_path`, which must have been analyzed.
+	void add_script(const String &p_path, const GDScriptParser::ClassNode *p_class);
+	int get_function_count() const { return function_count; }
+	String get_code() const;
+};
+
+#endif // GDSCRIPT_TRANSPILER_H
@@ -31,8 +31,10 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/os/os.h"
+#include "scene/scene_string_names.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -168,6 +170,194 @@ String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const
 	return err_text;
 }
 
+// Only plain native objects and GDScript instances are cached, other script languages may resolve members dynamically.
+// Objects overriding callp() (e.g. scripts calling their static functions) always take the slow path too.
+static _FORCE_INLINE_ bool _inline_cache_is_cacheable(Object *p_object, GDScriptInstance *&r_instance) {
+	if (p_object->has_custom_callp()) {
+		return false;
+	}
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (!script_instance) {
+		r_instance = nullptr;
+		return true;
+	}
+	if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+		return false;
+	}
+	r_instance = static_cast<GDScriptInstance *>(script_instance);
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_call(GDScriptInlineCache &p_cache, Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	GDScriptInstance *instance;
+	if (!_inline_cache_is_cacheable(p_object, instance)) {
+		return false;
+	}
+	GDScript *script = instance ? instance->script.ptr() : nullptr;
+	if (script && unlikely(!script->valid)) {
+		return false;
+	}
+	const void *native_class = p_object->get_class_name().data_unique_pointer();
+
+	GDScriptInlineCache::Entry entry;
+	uint32_t generation;
+	if (!p_cache.find(script, native_class, entry, generation)) {
+		// `free` and `_ready` are special cased by Object::callp() and GDScriptInstance::callp().
+		if (p_method == CoreStringName(free_) || p_method == SceneStringName(_ready)) {
+			return false;
+		}
+		for (GDScript *sptr = script; sptr; sptr = sptr->_base) {
+			HashMap<StringName, GDScriptFunction *>::Iterator E = sptr->member_functions.find(p_method);
+			if (E) {
+				entry.kind = GDScriptInlineCache::KIND_FUNCTION;
+				entry.function = E->value;
+				break;
+			}
+		}
+		if (!entry.function) {
+			entry.kind = GDScriptInlineCache::KIND_METHOD_BIND;
+			entry.method = ClassDB::get_method(p_object->get_class_name(), p_method);
+			if (!entry.method) {
+				return false;
+			}
+		}
+		entry.script = script;
+		entry.native_class = native_class;
+		p_cache.insert(entry, generation);
+	}
+
+#ifdef DEBUG_ENABLED
+	// Like Object::callp(), so the object can't free itself during the call.
+	_ObjectDebugLock debug_lock(p_object);
+#endif
+	if (entry.kind == GDScriptInlineCache::KIND_FUNCTION) {
+		r_ret = entry.function->call(instance, p_args, p_argcount, r_err);
+	} else {
+		r_err.error = Callable::CallError::CALL_OK;
+		r_ret = entry.method->call(p_object, p_args, p_argcount, r_err);
+	}
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_get(GDScriptInlineCache &p_cache, Object *p_object, const StringName &p_name, Variant &r_ret) {
+	GDScriptInstance *instance;
+	if (!_inline_cache_is_cacheable(p_object, instance)) {
+		return false;
+	}
+	GDScript *script = instance ? instance->script.ptr() : nullptr;
+	if (script && unlikely(!script->valid)) {
+		return false;
+	}
+	const void *native_class = p_object->get_class_name().data_unique_pointer();
+
+	GDScriptInlineCache::Entry entry;
+	uint32_t generation;
+	if (!p_cache.find(script, native_class, entry, generation)) {
+		// Extension classes may intercept properties with their own callbacks.
+		ClassDB::APIType api = ClassDB::get_api_type(p_object->get_class_name());
+		if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+			return false;
+		}
+		if (instance) {
+			// Only plain member variables, anything else goes through GDScriptInstance::get().
+			HashMap<StringName, GDScript::MemberInfo>::Iterator E = script->member_indices.find(p_name);
+			if (!E || E->value.getter) {
+				return false;
+			}
+			entry.kind = GDScriptInlineCache::KIND_MEMBER;
+			entry.member_index = E->value.index;
+		} else {
+			bool found = false;
+			int index = ClassDB::get_property_index(p_object->get_class_name(), p_name, &found);
+			if (!found || index >= 0) {
+				return false;
+			}
+			StringName getter = ClassDB::get_property_getter(p_object->get_class_name(), p_name);
+			entry.method = getter == StringName() ? nullptr : ClassDB::get_method(p_object->get_class_name(), getter);
+			if (!entry.method) {
+				return false;
+			}
+			entry.kind = GDScriptInlineCache::KIND_METHOD_BIND;
+		}
+		entry.script = script;
+		entry.native_class = native_class;
+		p_cache.insert(entry, generation);
+	}
+
+	if (entry.kind == GDScriptInlineCache::KIND_MEMBER) {
+		r_ret = instance->members[entry.member_index];
+	} else {
+		Callable::CallError ce;
+		r_ret = entry.method->call(p_object, nullptr, 0, ce);
+	}
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_set(GDScriptInlineCache &p_cache, Object *p_object, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+	GDScriptInstance *instance;
+	if (!_inline_cache_is_cacheable(p_object, instance)) {
+		return false;
+	}
+	GDScript *script = instance ? instance->script.ptr() : nullptr;
+	if (script && unlikely(!script->valid)) {
+		return false;
+	}
+	const void *native_class = p_object->get_class_name().data_unique_pointer();
+
+	GDScriptInlineCache::Entry entry;
+	uint32_t generation;
+	if (!p_cache.find(script, native_class, entry, generation)) {
+		// Extension classes may intercept properties with their own callbacks.
+		ClassDB::APIType api = ClassDB::get_api_type(p_object->get_class_name());
+		if (api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION) {
+			return false;
+		}
+		if (instance) {
+			// Only plain member variables, anything else goes through GDScriptInstance::set().
+			HashMap<StringName, GDScript::MemberInfo>::Iterator E = script->member_indices.find(p_name);
+			if (!E || E->value.setter) {
+				return false;
+			}
+			entry.kind = GDScriptInlineCache::KIND_MEMBER;
+			entry.member_index = E->value.index;
+			entry.member_type = &E->value.data_type;
+		} else {
+			bool found = false;
+			int index = ClassDB::get_property_index(p_object->get_class_name(), p_name, &found);
+			if (!found || index >= 0) {
+				return false;
+			}
+			StringName setter = ClassDB::get_property_setter(p_object->get_class_name(), p_name);
+			entry.method = setter == StringName() ? nullptr : ClassDB::get_method(p_object->get_class_name(), setter);
+			if (!entry.method) {
+				return false;
+			}
+			entry.kind = GDScriptInlineCache::KIND_METHOD_BIND;
+		}
+		entry.script = script;
+		entry.native_class = native_class;
+		p_cache.insert(entry, generation);
+	}
+
+	if (entry.kind == GDScriptInlineCache::KIND_MEMBER) {
+		if (entry.member_type->has_type && !entry.member_type->is_type(p_value)) {
+			// Needs a conversion, let GDScriptInstance::set() handle it.
+			return false;
+		}
+		instance->members.write[entry.member_index] = p_value;
+		r_valid = true;
+	} else {
+		Callable::CallError ce;
+		const Variant *args[1] = { &p_value };
+		entry.method->call(p_object, args, 1, ce);
+		r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
+#ifdef TOOLS_ENABLED
+	p_object->set_edited(true);
+#endif
+	return true;
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -215,6 +405,25 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_ADD_INT,                       \
+		&&OPCODE_OPERATOR_SUBTRACT_INT,                  \
+		&&OPCODE_OPERATOR_MULTIPLY_INT,                  \
+		&&OPCODE_OPERATOR_EQUAL_INT,                     \
+		&&OPCODE_OPERATOR_NOT_EQUAL_INT,                 \
+		&&OPCODE_OPERATOR_LESS_INT,                      \
+		&&OPCODE_OPERATOR_LESS_EQUAL_INT,                \
+		&&OPCODE_OPERATOR_GREATER_INT,                   \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_INT,             \
+		&&OPCODE_OPERATOR_ADD_FLOAT,                     \
+		&&OPCODE_OPERATOR_SUBTRACT_FLOAT,                \
+		&&OPCODE_OPERATOR_MULTIPLY_FLOAT,                \
+		&&OPCODE_OPERATOR_DIVIDE_FLOAT,                  \
+		&&OPCODE_OPERATOR_EQUAL_FLOAT,                   \
+		&&OPCODE_OPERATOR_NOT_EQUAL_FLOAT,               \
+		&&OPCODE_OPERATOR_LESS_FLOAT,                    \
+		&&OPCODE_OPERATOR_LESS_EQUAL_FLOAT,              \
+		&&OPCODE_OPERATOR_GREATER_FLOAT,                 \
+		&&OPCODE_OPERATOR_GREATER_EQUAL_FLOAT,           \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_NATIVE,                       \
@@ -272,6 +481,8 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP,                                   \
 		&&OPCODE_JUMP_IF,                                \
 		&&OPCODE_JUMP_IF_NOT,                            \
+		&&OPCODE_JUMP_IF_BOOL,                           \
+		&&OPCODE_JUMP_IF_NOT_BOOL,                       \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                   \
 		&&OPCODE_JUMP_IF_SHARED,                         \
 		&&OPCODE_RETURN,                                 \
@@ -481,6 +692,51 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		return _get_default_variant_for_data_type(return_type);
 	}
 
+	if (native_function && !p_state && p_argcount == _argument_count) {
+		bool exact_arguments = true;
+		for (int i = 0; i < p_argcount; i++) {
+			if (p_args[i]->get_type() != argument_types[i].builtin_type) {
+				exact_arguments = false;
+				break;
+			}
+		}
+		// Otherwise let the VM convert the arguments or report the error.
+		if (exact_arguments) {
+			int line = _initial_line;
+			GDScriptSamplingProfiler::ThreadStack *sampling_stack = GDScriptSamplingProfiler::enter_function(this, &line);
+#ifdef DEBUG_ENABLED
+			uint64_t function_start_time = 0;
+			if (GDScriptLanguage::get_singleton()->profiling) {
+				function_start_time = OS::get_singleton()->get_ticks_usec();
+				profile.call_count.increment();
+				profile.frame_call_count.increment();
+			}
+#endif
+
+			Variant native_ret;
+			native_function(&native_ret, p_args);
+
+			if (unlikely(sampling_stack)) {
+				GDScriptSamplingProfiler::exit_function(sampling_stack);
+			}
+#ifdef DEBUG_ENABLED
+			// Native functions don't call other functions, so all of the time is self time.
+			if (GDScriptLanguage::get_singleton()->profiling) {
+				uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
+				profile.total_time.add(time_taken);
+				profile.self_time.add(time_taken);
+				profile.frame_total_time.add(time_taken);
+				profile.frame_self_time.add(time_taken);
+				if (Thread::get_caller_id() == Thread::get_main_id()) {
+					GDScriptLanguage::get_singleton()->script_frame_time += time_taken;
+				}
+			}
+#endif
+			call_depth--;
+			return native_ret;
+		}
+	}
+
 	Variant retvalue;
 	Variant *stack = nullptr;
 	Variant **instruction_args = nullptr;
@@ -584,6 +840,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	String err_text;
 
+	GDScriptSamplingProfiler::ThreadStack *sampling_stack = GDScriptSamplingProfiler::enter_function(this, &line);
+
 #ifdef DEBUG_ENABLED
 
 	if (EngineDebugger::is_active()) {
@@ -779,6 +1037,38 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_OPERATOR_TYPED(m_op, m_type, m_c_op, m_get_func, m_ret_get_func)                                         \
+	OPCODE(OPCODE_OPERATOR_##m_op##_##m_type) {                                                                         \
+		CHECK_SPACE(4);                                                                                                 \
+		GET_VARIANT_PTR(a, 0);                                                                                          \
+		GET_VARIANT_PTR(b, 1);                                                                                          \
+		GET_VARIANT_PTR(dst, 2);                                                                                        \
+		*VariantInternal::m_ret_get_func(dst) = *VariantInternal::m_get_func(a) m_c_op *VariantInternal::m_get_func(b); \
+		ip += 4;                                                                                                        \
+	}                                                                                                                   \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(ADD, INT, +, get_int, get_int);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, INT, -, get_int, get_int);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, INT, *, get_int, get_int);
+			OPCODE_OPERATOR_TYPED(EQUAL, INT, ==, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL, INT, !=, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(LESS, INT, <, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL, INT, <=, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(GREATER, INT, >, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL, INT, >=, get_int, get_bool);
+			OPCODE_OPERATOR_TYPED(ADD, FLOAT, +, get_float, get_float);
+			OPCODE_OPERATOR_TYPED(SUBTRACT, FLOAT, -, get_float, get_float);
+			OPCODE_OPERATOR_TYPED(MULTIPLY, FLOAT, *, get_float, get_float);
+			OPCODE_OPERATOR_TYPED(DIVIDE, FLOAT, /, get_float, get_float);
+			OPCODE_OPERATOR_TYPED(EQUAL, FLOAT, ==, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(NOT_EQUAL, FLOAT, !=, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(LESS, FLOAT, <, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(LESS_EQUAL, FLOAT, <=, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(GREATER, FLOAT, >, get_float, get_bool);
+			OPCODE_OPERATOR_TYPED(GREATER_EQUAL, FLOAT, >=, get_float, get_bool);
+#undef OPCODE_OPERATOR_TYPED
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1093,7 +1383,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1103,8 +1393,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= inline_cache_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				Object *obj = dst->get_type() == Variant::OBJECT ? dst->get_validated_object() : nullptr;
+				if (!obj || !_inline_cache_set(inline_caches[cache_idx], obj, *index, *value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1125,7 +1421,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1145,7 +1441,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1155,22 +1451,26 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-#ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= inline_cache_count);
 
-#else
-				*dst = src->get_named(*index, valid);
-#endif
+				bool valid;
+				// Read into a temporary, src may hold the only reference to the object and share the stack position with dst.
+				Variant ret;
+				Object *obj = src->get_type() == Variant::OBJECT ? src->get_validated_object() : nullptr;
+				if (obj && _inline_cache_get(inline_caches[cache_idx], obj, *index, ret)) {
+					valid = true;
+				} else {
+					ret = src->get_named(*index, valid);
+				}
 #ifdef DEBUG_ENABLED
 				if (!valid) {
 					err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
 					OPCODE_BREAK;
 				}
-				*dst = ret;
 #endif
-				ip += 4;
+				*dst = ret;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1706,7 +2006,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1717,8 +2017,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= inline_cache_count);
+				GDScriptInlineCache &inline_cache = inline_caches[cache_idx];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
+				Object *cache_obj = base->get_type() == Variant::OBJECT ? base->get_validated_object() : nullptr;
 
 #ifdef DEBUG_ENABLED
 				uint64_t call_time = 0;
@@ -1734,7 +2039,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (!cache_obj || !_inline_cache_call(inline_cache, cache_obj, *methodname, (const Variant **)argptrs, argc, *ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1764,7 +2071,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (!cache_obj || !_inline_cache_call(inline_cache, cache_obj, *methodname, (const Variant **)argptrs, argc, ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1814,7 +2123,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2545,6 +2854,36 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_JUMP_IF_BOOL) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(test, 0);
+
+				if (*VariantInternal::get_bool(test)) {
+					int to = _code_ptr[ip + 2];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_JUMP_IF_NOT_BOOL) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(test, 0);
+
+				if (!*VariantInternal::get_bool(test)) {
+					int to = _code_ptr[ip + 2];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
@@ -3019,7 +3358,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 				if (!array->is_empty()) {
 					GET_VARIANT_PTR(iterator, 2);
-					*iterator = array->get(0);
+					*iterator = array->get_value(0);
 
 					// Skip regular iterate.
 					ip += 5;
@@ -3363,7 +3702,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					ip = jumpto;
 				} else {
 					GET_VARIANT_PTR(iterator, 2);
-					*iterator = array->get(*idx);
+					*iterator = array->get_value(*idx);
 
 					ip += 5; // Loop again.
 				}
@@ -3575,6 +3914,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE(OPCODE_LINE) {
 				CHECK_SPACE(2);
 
+				// Before updating the line, time since the last sample was spent on the previous one.
+				if (unlikely(sampling_stack)) {
+					GDScriptSamplingProfiler::poll(sampling_stack);
+				}
+
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
@@ -3659,6 +4003,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 
 	OPCODES_OUT
+	if (unlikely(sampling_stack)) {
+		GDScriptSamplingProfiler::exit_function(sampling_stack);
+	}
+
 #ifdef DEBUG_ENABLED
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
@@ -33,8 +33,10 @@
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
 #include "gdscript_cache.h"
+#include "gdscript_native.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
+#include "gdscript_transpiler.h"
 #include "gdscript_utility_functions.h"
 
 #ifdef TOOLS_ENABLED
@@ -85,18 +87,48 @@ class EditorExportGDScript : public EditorExportPlugin {
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
 
+	// C++ file receiving the transpiled functions, to be compiled into a custom export template.
+	String native_code_path;
+	GDScriptTranspiler *transpiler = nullptr;
+
+	void _transpile(const String &p_path, const String &p_source) {
+		GDScriptParser parser;
+		if (parser.parse(p_source, p_path, false) != OK) {
+			return;
+		}
+		GDScriptAnalyzer analyzer(&parser);
+		if (analyzer.analyze() != OK) {
+			return;
+		}
+		transpiler->add_script(p_path, parser.get_tree());
+	}
+
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::STRING, "gdscript/native_code_path", PROPERTY_HINT_GLOBAL_SAVE_FILE, "*.cpp"), ""));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		native_code_path = String();
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			native_code_path = get_option("gdscript/native_code_path");
+		}
+
+		if (transpiler) {
+			memdelete(transpiler);
+			transpiler = nullptr;
+		}
+		if (!native_code_path.is_empty()) {
+			transpiler = memnew(GDScriptTranspiler);
 		}
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
-		if (p_path.get_extension() != "gd" || script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+		if (p_path.get_extension() != "gd" || (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT && !transpiler)) {
 			return;
 		}
 
@@ -107,6 +139,14 @@ protected:
 
 		String source;
 		source.parse_utf8(reinterpret_cast<const char *>(file.ptr()), file.size());
+
+		if (transpiler) {
+			_transpile(p_path, source);
+		}
+		if (script_mode == EditorExportPreset::MODE_SCRIPT_TEXT) {
+			return;
+		}
+
 		GDScriptTokenizerBuffer::CompressMode compress_mode = script_mode == EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED ? GDScriptTokenizerBuffer::COMPRESS_ZSTD : GDScriptTokenizerBuffer::COMPRESS_NONE;
 		file = GDScriptTokenizerBuffer::parse_code_string(source, compress_mode);
 		if (file.is_empty()) {
@@ -116,8 +156,31 @@ protected:
 		add_file(p_path.get_basename() + ".gdc", file, true);
 	}
 
+	virtual void _export_end() override {
+		if (!transpiler) {
+			return;
+		}
+
+		Ref<FileAccess> f = FileAccess::open(native_code_path, FileAccess::WRITE);
+		if (f.is_valid()) {
+			f->store_string(transpiler->get_code());
+			print_verbose(vformat("GDScript: Wrote %d natively compiled functions to \"%s\".", transpiler->get_function_count(), native_code_path));
+		} else {
+			ERR_PRINT(vformat("Cannot write GDScript native code to \"%s\".", native_code_path));
+		}
+
+		memdelete(transpiler);
+		transpiler = nullptr;
+	}
+
 public:
 	virtual String get_name() const override { return "GDScript"; }
+
+	~EditorExportGDScript() {
+		if (transpiler) {
+			memdelete(transpiler);
+		}
+	}
 };
 
 static void _editor_init() {
@@ -157,6 +220,10 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+
+#ifdef GDSCRIPT_NATIVE_CODE_ENABLED
+		register_gdscript_native_code();
+#endif
 	}
 
 #ifdef TOOLS_ENABLED
@@ -33,6 +33,12 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_analyzer.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_sampling_profiler.h"
+#include "../gdscript_transpiler.h"
+
+#include "core/io/json.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -70,6 +76,502 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+static Error _reload_source(const Ref<GDScript> &p_script, const String &p_source) {
+	p_script->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error error = p_script->reload();
+	ERR_PRINT_ON;
+	return error;
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches are invalidated when scripts reload") {
+	Ref<GDScript> caller = memnew(GDScript);
+	REQUIRE(_reload_source(caller, R"(
+extends RefCounted
+
+func call_value(object):
+	return object.value()
+
+func get_b(object):
+	return object.b
+
+func set_b(object, value):
+	object.b = value
+)") == OK);
+	Ref<RefCounted> caller_object = memnew(RefCounted);
+	caller_object->set_script(caller);
+
+	Ref<GDScript> callee = memnew(GDScript);
+	REQUIRE(_reload_source(callee, R"(
+extends RefCounted
+
+var a = 1
+var b = 2
+
+func value():
+	return "first"
+)") == OK);
+	{
+		Ref<RefCounted> callee_object = memnew(RefCounted);
+		callee_object->set_script(callee);
+		// The second iteration hits the caches filled by the first.
+		for (int i = 0; i < 2; i++) {
+			CHECK(String(caller_object->call("call_value", callee_object)) == "first");
+			CHECK(int(caller_object->call("get_b", callee_object)) == 2);
+		}
+		caller_object->call("set_b", callee_object, 5);
+		CHECK(int(callee_object->get("b")) == 5);
+	}
+
+	// Same script object, so the caches are only dropped by the generation bump.
+	REQUIRE(_reload_source(callee, R"(
+extends RefCounted
+
+var b = 3
+
+func value():
+	return "second"
+)") == OK);
+	Ref<RefCounted> callee_object = memnew(RefCounted);
+	callee_object->set_script(callee);
+	CHECK_MESSAGE(String(caller_object->call("call_value", callee_object)) == "second", "The reload freed the cached function.");
+	CHECK_MESSAGE(int(caller_object->call("get_b", callee_object)) == 3, "The reload moved the cached member.");
+	caller_object->call("set_b", callee_object, 7);
+	CHECK(int(callee_object->get("b")) == 7);
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches skip objects overriding callp") {
+	Ref<GDScript> with_static = memnew(GDScript);
+	REQUIRE(_reload_source(with_static, R"(
+extends RefCounted
+
+static func get_base_script():
+	return "static"
+)") == OK);
+	CHECK(with_static->has_custom_callp());
+
+	Ref<GDScript> caller = memnew(GDScript);
+	REQUIRE(_reload_source(caller, R"(
+extends RefCounted
+
+func call_it(object):
+	return object.get_base_script()
+)") == OK);
+	Ref<RefCounted> caller_object = memnew(RefCounted);
+	caller_object->set_script(caller);
+	CHECK_FALSE(caller_object->has_custom_callp());
+
+	// GDScript::callp() runs static functions before methods bound in ClassDB.
+	for (int i = 0; i < 2; i++) {
+		CHECK(String(caller_object->call("call_it", with_static)) == "static");
+	}
+}
+
+static void _native_twice_stub(Variant *r_ret, const Variant **p_args) {
+	*r_ret = *VariantInternal::get_int(p_args[0]) * 1000;
+}
+
+TEST_CASE("[Modules][GDScript] Transpile typed functions to C++") {
+	const String source = R"(
+extends RefCounted
+
+func fibonacci(n: int) -> int:
+	var a: int = 0
+	var b := 1
+	while n > 0:
+		var t: int = a + b
+		a = b
+		b = t
+		n -= 1
+	return a
+
+func lerp_clamped(from: float, to: float, weight: float) -> float:
+	if weight <= 0.0:
+		return from
+	elif weight >= 1:
+		return to
+	return from + (to - from) * weight
+
+func untyped(n):
+	return n + 1
+
+func calls_method(n: int) -> int:
+	return abs(n)
+
+func has_default(n: int = 2) -> int:
+	return n
+)";
+
+	GDScriptParser parser;
+	REQUIRE(parser.parse(source, "res://transpiler_test.gd", false) == OK);
+	GDScriptAnalyzer analyzer(&parser);
+	REQUIRE(analyzer.analyze() == OK);
+
+	const GDScriptParser::ClassNode *tree = parser.get_tree();
+	String body;
+	CHECK(GDScriptTranspiler::transpile_function(tree->get_member("fibonacci").function, body));
+	CHECK(body.contains("int64_t l_n = *VariantInternal::get_int(p_args[0]);"));
+	CHECK(body.contains("while ((l_n > int64_t(0))) {"));
+	CHECK(body.contains("l_n = (l_n - int64_t(1));"));
+	CHECK(body.contains("*r_ret = l_a;"));
+
+	CHECK(GDScriptTranspiler::transpile_function(tree->get_member("lerp_clamped").function, body));
+	CHECK(body.contains("if ((l_weight <= double(0x0p+0))) {"));
+	CHECK_MESSAGE(body.contains("if ((l_weight >= int64_t(1))) {"), "Mixed operands are written as is, C++ promotes them like the Variant evaluators.");
+	CHECK(body.contains("*r_ret = (l_from + ((l_to - l_from) * l_weight));"));
+	CHECK(body.contains("} else {"));
+
+	CHECK_FALSE(GDScriptTranspiler::transpile_function(tree->get_member("untyped").function, body));
+	CHECK_FALSE(GDScriptTranspiler::transpile_function(tree->get_member("calls_method").function, body));
+	CHECK_FALSE(GDScriptTranspiler::transpile_function(tree->get_member("has_default").function, body));
+
+	GDScriptTranspiler transpiler;
+	transpiler.add_script("res://transpiler_test.gd", tree);
+	CHECK(transpiler.get_function_count() == 2);
+	const String code = transpiler.get_code();
+	CHECK(code.contains("{ \"res://transpiler_test.gd\", \"fibonacci\", "));
+	CHECK(code.contains("GDScriptNativeFunctions::Table table = { entries };"));
+	CHECK(code.contains("void register_gdscript_native_code() {\n\tGDScriptNativeFunctions::add_table(&table);\n}"));
+}
+
+#ifdef GDSCRIPT_NATIVE_CODE_ENABLED
+TEST_CASE("[Modules][GDScript] Native code from the build is registered") {
+	CHECK_MESSAGE(GDScriptNativeFunctions::has_functions(), "The module should register the generated table when it's compiled in.");
+}
+#endif // GDSCRIPT_NATIVE_CODE_ENABLED
+
+TEST_CASE("[Modules][GDScript] Call natively compiled function") {
+	const String source = R"(
+extends RefCounted
+
+func twice(n: int) -> int:
+	return n * 2
+)";
+
+	String body;
+	{
+		GDScriptParser parser;
+		REQUIRE(parser.parse(source, "res://native_test.gd", false) == OK);
+		GDScriptAnalyzer analyzer(&parser);
+		REQUIRE(analyzer.analyze() == OK);
+		REQUIRE(GDScriptTranspiler::transpile_function(parser.get_tree()->get_member("twice").function, body));
+	}
+
+	const CharString name = String("twice").utf8();
+	GDScriptNativeFunctions::Entry entries[2];
+	entries[0] = { "res://native_test.gd", name.get_data(), GDScriptTranspiler::get_body_hash(body), &_native_twice_stub };
+	GDScriptNativeFunctions::Table table = { entries };
+	GDScriptNativeFunctions::add_table(&table);
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_path("res://native_test.gd");
+	gdscript->set_source_code(source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	// The stub multiplies by 1000 to tell it apart from the byte code.
+	CHECK_MESSAGE(int(ref_counted->call("twice", 3)) == 3000, "Exact argument types should use the native function.");
+	CHECK_MESSAGE(int(ref_counted->call("twice", 3.0)) == 6, "Other argument types should fall back to the VM.");
+
+	GDScriptNativeFunctions::remove_table(&table);
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Typed number operators") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func int_typed(n: int) -> int:
+	var total: int = 0
+	var i: int = 0
+	while i < n:
+		total = total + i * 3 - 1
+		i += 1
+	return total
+
+func int_untyped(n):
+	var total = 0
+	var i = 0
+	while i < n:
+		total = total + i * 3 - 1
+		i += 1
+	return total
+
+func float_typed(n: int) -> float:
+	var x: float = 0.0
+	var i: int = 0
+	while i < n:
+		x = x * 0.5 + 1.25 / (x + 1.0)
+		i += 1
+	return x
+
+func float_untyped(n):
+	var x = 0.0
+	var i = 0
+	while i < n:
+		x = x * 0.5 + 1.25 / (x + 1.0)
+		i += 1
+	return x
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The benchmark script should parse successfully.");
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	// Operators evaluated per loop iteration, including the loop condition and counter increment.
+	const int int_ops = 5;
+	const int float_ops = 6;
+	const int iterations = 1000000;
+
+	const char *functions[] = { "int_typed", "int_untyped", "float_typed", "float_untyped" };
+	Variant results[4];
+	double ops_per_sec[4];
+	for (int i = 0; i < 4; i++) {
+		const BenchmarkTimer timer;
+		results[i] = ref_counted->call(functions[i], iterations);
+		const uint64_t usec = timer.get_elapsed_usec();
+		ops_per_sec[i] = double(iterations) * (i < 2 ? int_ops : float_ops) * 1000000.0 / double(usec);
+	}
+
+	CHECK_MESSAGE(results[0] == results[1], "Typed and untyped int arithmetic should give the same result.");
+	CHECK_MESSAGE(results[2] == results[3], "Typed and untyped float arithmetic should give the same result.");
+
+	for (int i = 0; i < 4; i++) {
+		BENCHMARK_MESSAGE("%s: %.1f Mops/sec.", functions[i], ops_per_sec[i] / 1000000.0);
+	}
+}
+
+static Error _parse_for_bytecode_cache(GDScriptParser &r_parser, const String &p_source, const String &p_path) {
+	Error err = r_parser.parse(p_source, p_path, false);
+	if (err != OK) {
+		return err;
+	}
+	GDScriptAnalyzer analyzer(&r_parser);
+	return analyzer.analyze();
+}
+
+TEST_CASE("[Modules][GDScript] Byte code cache round trip") {
+	const String path = "res://bytecode_cache_test.gd";
+	const String source = R"(
+extends RefCounted
+
+const OFFSETS = [1, 2, 3]
+const NAMES = { "a": "first" }
+
+signal changed(value: int)
+
+var value: int = 10
+
+class Inner:
+	var factor := 3
+
+	func scale(n: int) -> int:
+		return n * factor
+
+func sum_offsets() -> int:
+	var total := 0
+	for offset in OFFSETS:
+		total += offset + value
+	return total
+
+func scaled(n: int) -> int:
+	return Inner.new().scale(n)
+
+func apply_lambda(n: int) -> int:
+	var add := func(x: int) -> int: return x + value
+	return add.call(n)
+
+func name_of(key: String) -> String:
+	return NAMES[key] + " " + str(Vector2(1, 2))
+)";
+
+	Vector<uint8_t> buffer;
+	{
+		Ref<GDScript> compiled;
+		compiled.instantiate();
+		compiled->set_path(path, true);
+		compiled->set_source_code(source);
+		ERR_PRINT_OFF;
+		const Error error = compiled->reload();
+		ERR_PRINT_ON;
+		REQUIRE(error == OK);
+
+		GDScriptParser parser;
+		REQUIRE(_parse_for_bytecode_cache(parser, source, path) == OK);
+		REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), &parser, buffer) == OK);
+	}
+
+	Ref<GDScript> cached;
+	cached.instantiate();
+	cached->set_path(path, true);
+	cached->set_source_code(source);
+	CHECK(GDScriptBytecodeCache::is_up_to_date(cached.ptr(), buffer));
+	REQUIRE(GDScriptBytecodeCache::make_scripts(cached.ptr(), buffer) == OK);
+	REQUIRE(GDScriptBytecodeCache::deserialize(cached.ptr(), buffer) == OK);
+	CHECK(cached->is_valid());
+	CHECK(cached->has_script_signal("changed"));
+	CHECK(cached->get_subclasses().has("Inner"));
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(cached);
+	CHECK(int(ref_counted->get("value")) == 10);
+	CHECK(int(ref_counted->call("sum_offsets")) == 36);
+	CHECK(int(ref_counted->call("scaled", 7)) == 21);
+	CHECK(int(ref_counted->call("apply_lambda", 5)) == 15);
+	CHECK(String(ref_counted->call("name_of", "a")) == "first (1, 2)");
+
+	SUBCASE("Stale entries are rejected") {
+		Ref<GDScript> edited;
+		edited.instantiate();
+		edited->set_path(path, true);
+		edited->set_source_code(source + "\nfunc added():\n\tpass\n");
+		CHECK_FALSE(GDScriptBytecodeCache::is_up_to_date(edited.ptr(), buffer));
+		CHECK(GDScriptBytecodeCache::deserialize(edited.ptr(), buffer) == ERR_INVALID_DATA);
+
+		Vector<uint8_t> truncated = buffer;
+		truncated.resize(buffer.size() / 2);
+		Ref<GDScript> corrupted;
+		corrupted.instantiate();
+		corrupted->set_path(path, true);
+		corrupted->set_source_code(source);
+		CHECK(GDScriptBytecodeCache::deserialize(corrupted.ptr(), truncated) != OK);
+		CHECK_FALSE(corrupted->is_valid());
+
+		// A flipped bit in the payload is caught by its hash before any of it is read.
+		Vector<uint8_t> flipped = buffer;
+		flipped.write[flipped.size() - 8] ^= 0x10;
+		CHECK_FALSE(GDScriptBytecodeCache::is_up_to_date(corrupted.ptr(), flipped));
+		CHECK(GDScriptBytecodeCache::deserialize(corrupted.ptr(), flipped) == ERR_INVALID_DATA);
+		CHECK_FALSE(corrupted->is_valid());
+	}
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Startup with a byte code cache") {
+	// Stands in for a project with thousands of small scripts.
+	const int script_count = 2000;
+	Vector<String> sources;
+	for (int i = 0; i < script_count; i++) {
+		sources.push_back(vformat(R"(
+extends RefCounted
+
+const ID = %d
+
+var health: int = %d
+var speed: float = %d.5
+var tags: Array[String] = ["script_%d"]
+
+func damage(amount: int) -> int:
+	health = max(health - amount, 0)
+	return health
+
+func move(delta: float, direction: Vector2) -> Vector2:
+	return direction.normalized() * speed * delta
+
+func describe() -> String:
+	var parts := PackedStringArray()
+	for tag in tags:
+		parts.push_back(tag)
+	return "%%d: %%s" %% [ID, ", ".join(parts)]
+)",
+				i, 100 + i, i % 10, i));
+	}
+
+	Vector<Vector<uint8_t>> buffers;
+	uint64_t compile_usec = 0;
+	for (int i = 0; i < script_count; i++) {
+		Ref<GDScript> compiled;
+		compiled.instantiate();
+		compiled->set_source_code(sources[i]);
+		const BenchmarkTimer timer;
+		const Error error = compiled->reload();
+		compile_usec += timer.get_elapsed_usec();
+		REQUIRE(error == OK);
+
+		GDScriptParser parser;
+		REQUIRE(_parse_for_bytecode_cache(parser, sources[i], String()) == OK);
+		Vector<uint8_t> buffer;
+		REQUIRE(GDScriptBytecodeCache::serialize(compiled.ptr(), &parser, buffer) == OK);
+		buffers.push_back(buffer);
+	}
+
+	uint64_t load_usec = 0;
+	Ref<GDScript> last;
+	for (int i = 0; i < script_count; i++) {
+		Ref<GDScript> cached;
+		cached.instantiate();
+		cached->set_source_code(sources[i]);
+		const BenchmarkTimer timer;
+		Error error = GDScriptBytecodeCache::make_scripts(cached.ptr(), buffers[i]);
+		if (error == OK) {
+			error = GDScriptBytecodeCache::deserialize(cached.ptr(), buffers[i]);
+		}
+		load_usec += timer.get_elapsed_usec();
+		REQUIRE(error == OK);
+		last = cached;
+	}
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(last);
+	CHECK(String(ref_counted->call("describe")) == vformat("%d: script_%d", script_count - 1, script_count - 1));
+
+	// Loading still hashes every source to validate the entries.
+	BENCHMARK_MESSAGE("Compiling %d scripts: %.1f scripts/sec.", script_count, script_count * 1000000.0 / compile_usec);
+	BENCHMARK_MESSAGE("Loading %d scripts from the byte code cache: %.1f scripts/sec.", script_count, script_count * 1000000.0 / load_usec);
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler") {
+	Ref<GDScript> gdscript;
+	gdscript.instantiate();
+	gdscript->set_path("res://sampling_profiler_test.gd", true);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func inner(sampler: Callable) -> int:
+	sampler.call()
+	return 1
+
+func outer(sampler: Callable, count: int) -> int:
+	var total := 0
+	for i in count:
+		total += inner(sampler)
+	return total
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE(error == OK);
+
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	// Without a sampler thread, so each call of `sampler` takes exactly one sample.
+	GDScriptSamplingProfiler::clear();
+	GDScriptSamplingProfiler::start(0);
+	CHECK(int(ref_counted->call("outer", callable_mp_static(&GDScriptSamplingProfiler::request_sample), 10)) == 10);
+	GDScriptSamplingProfiler::stop();
+
+	// Samples are recorded at the line after the call, and attributed to the line that was running.
+	const String collapsed = GDScriptSamplingProfiler::get_collapsed_stacks();
+	CHECK_MESSAGE(collapsed.contains(";outer (res://sampling_profiler_test.gd:11);inner (res://sampling_profiler_test.gd:5) 10\n"), collapsed);
+	CHECK(collapsed.split("\n", false).size() == 1);
+
+	const String trace = GDScriptSamplingProfiler::get_chrome_trace();
+	Ref<JSON> json;
+	json.instantiate();
+	REQUIRE_MESSAGE(json->parse(trace) == OK, "The Chrome trace should be valid JSON.");
+	CHECK(trace.contains("\"name\":\"inner (res://sampling_profiler_test.gd:5)\",\"cat\":\"gdscript\",\"ph\":\"X\""));
+
+	GDScriptSamplingProfiler::clear();
+	CHECK(GDScriptSamplingProfiler::get_collapsed_stacks().is_empty());
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
@@ -0,0 +1,38 @@
+func test():
+	var a: int = 7
+	var b: int = 3
+	print(a + b)
+	print(a - b)
+	print(a * b)
+	print(a == b)
+	print(a != b)
+	print(a < b)
+	print(a <= 7)
+	print(a > b)
+	print(a >= 8)
+
+	var big: int = 9223372036854775807
+	print(big + 1)
+
+	var x: float = 7.25
+	var y: float = 2.5
+	print(x + y)
+	print(x - y)
+	print(x * y)
+	print(x / y)
+	print(x == y)
+	print(x != y)
+	print(x < y)
+	print(x <= 7.25)
+	print(x > y)
+	print(x >= 8.0)
+
+	var flag: bool = a > b
+	if flag:
+		print("if")
+	var count: int = 0
+	while count < 3:
+		count += 1
+	print(count)
+	print("and" if flag and a < b else "not and")
+	print("or" if flag or a < b else "not or")
@@ -0,0 +1,61 @@
+class A:
+	var value = 1
+	func name():
+		return "A"
+
+class B extends A:
+	func name():
+		return "B"
+
+class C:
+	var value = 3
+	func name():
+		return "C"
+
+class D:
+	var value = 4
+	func name():
+		return "D"
+
+class E:
+	var value = 5
+	func name():
+		return "E"
+
+class Typed:
+	var value: int = 0
+	func name():
+		return "Typed"
+
+class WithAccessors:
+	var stored = 0
+	var value:
+		get:
+			return stored * 10
+		set(v):
+			stored = v
+	func name():
+		return "WithAccessors"
+
+func describe(obj):
+	obj.value = obj.value + 1
+	return "%s %s" % [obj.name(), obj.value]
+
+func test():
+	# Same call sites see more receiver shapes than the cache can hold.
+	var objects = [A.new(), B.new(), C.new(), D.new(), E.new(), Typed.new(), WithAccessors.new(), A.new()]
+	for i in 2:
+		for obj in objects:
+			print(describe(obj))
+
+	# Native receivers share the sites with script instances.
+	var native = Node.new()
+	native.name = "Native"
+	var receivers = [native, A.new()]
+	for obj in receivers:
+		print(obj.name if obj is Node else obj.name())
+	native.free()
+
+	var ref = RefCounted.new()
+	for i in 2:
+		print(ref.get_reference_count())
@@ -106,16 +106,20 @@ Error jpeg_load_image_from_buffer(Image *p_image, const uint8_t *p_buffer, int p
 }
 
 Error ImageLoaderJPG::load_image(Ref<Image> p_image, Ref<FileAccess> f, BitField<ImageFormatLoader::LoaderFlags> p_flags, float p_scale) {
-	Vector<uint8_t> src_image;
 	uint64_t src_image_len = f->get_length();
 	ERR_FAIL_COND_V(src_image_len == 0, ERR_FILE_CORRUPT);
-	src_image.resize(src_image_len);
-
-	uint8_t *w = src_image.ptrw();
 
-	f->get_buffer(&w[0], src_image_len);
+	// Decode straight from the file's memory when it is mapped.
+	const uint8_t *r = f->get_buffer_view(src_image_len);
+	Vector<uint8_t> src_image;
+	if (!r) {
+		src_image.resize(src_image_len);
+		uint8_t *w = src_image.ptrw();
+		f->get_buffer(&w[0], src_image_len);
+		r = w;
+	}
 
-	Error err = jpeg_load_image_from_buffer(p_image.ptr(), w, src_image_len);
+	Error err = jpeg_load_image_from_buffer(p_image.ptr(), r, src_image_len);
 
 	return err;
 }
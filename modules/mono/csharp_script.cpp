@@ -2734,6 +2734,7 @@ void CSharpScript::_clear() {
 }
 
 CSharpScript::CSharpScript() {
+	_custom_callp = true;
 	_clear();
 
 #ifdef DEBUG_ENABLED
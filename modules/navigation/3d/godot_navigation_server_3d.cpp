@@ -209,6 +209,20 @@ bool GodotNavigationServer3D::map_get_use_edge_connections(RID p_map) const {
 	return map->get_use_edge_connections();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer3D::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	NavMap *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
 COMMAND_2(map_set_edge_connection_margin, RID, p_map, real_t, p_connection_margin) {
 	NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL(map);
@@ -396,6 +410,10 @@ COMMAND_2(region_set_map, RID, p_region, RID, p_map) {
 
 	NavMap *map = map_owner.get_or_null(p_map);
 
+	if (region->get_map() != nullptr && region->get_map() != map) {
+		// Batched path queries may still be searching the region.
+		_wait_for_path_query_batches();
+	}
 	region->set_map(map);
 }
 
@@ -549,6 +567,10 @@ COMMAND_2(link_set_map, RID, p_link, RID, p_map) {
 
 	NavMap *map = map_owner.get_or_null(p_map);
 
+	if (link->get_map() != nullptr && link->get_map() != map) {
+		// Batched path queries may still be searching the link.
+		_wait_for_path_query_batches();
+	}
 	link->set_map(map);
 }
 
@@ -1139,7 +1161,19 @@ bool GodotNavigationServer3D::is_baking_navigation_mesh(Ref<NavigationMesh> p_na
 #endif // _3D_DISABLED
 }
 
+void GodotNavigationServer3D::free_navigation_mesh_tiles(ObjectID p_navigation_mesh) {
+#ifndef _3D_DISABLED
+	NavMeshGenerator3D::free_tiles(p_navigation_mesh);
+#endif // _3D_DISABLED
+}
+
 COMMAND_1(free, RID, p_object) {
+	// Batched path queries read the maps, regions and links from worker threads,
+	// wait for them before freeing any of those.
+	if (map_owner.owns(p_object) || region_owner.owns(p_object) || link_owner.owns(p_object)) {
+		_wait_for_path_query_batches();
+	}
+
 	if (map_owner.owns(p_object)) {
 		NavMap *map = map_owner.get_or_null(p_object);
 
@@ -1284,6 +1318,8 @@ void GodotNavigationServer3D::sync() {
 }
 
 void GodotNavigationServer3D::process(real_t p_delta_time) {
+	_dispatch_path_query_batches();
+
 	flush_queries();
 
 	if (!active) {
@@ -1341,6 +1377,7 @@ void GodotNavigationServer3D::init() {
 }
 
 void GodotNavigationServer3D::finish() {
+	_clear_path_query_batches();
 	flush_queries();
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -74,6 +74,19 @@ HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
 RID_Owner<NavMeshGenerator3D::NavMeshGeometryParser3D> NavMeshGenerator3D::generator_parser_owner;
 LocalVector<NavMeshGenerator3D::NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
+Mutex NavMeshGenerator3D::tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshTileCache3D *> NavMeshGenerator3D::tile_caches;
+
+struct NavMeshGenerator3D::NavMeshTileBakeJob3D {
+	Ref<NavigationMesh> navigation_mesh;
+	const float *verts = nullptr;
+	int nverts = 0;
+	const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> *projected_obstructions = nullptr;
+
+	LocalVector<rcConfig> configs;
+	LocalVector<const LocalVector<int> *> tris;
+	LocalVector<NavMeshBakeTile3D *> tiles;
+};
 
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
@@ -149,6 +162,13 @@ void NavMeshGenerator3D::cleanup() {
 	generator_parsers.clear();
 	generator_rid_rwlock.write_unlock();
 
+	tile_cache_mutex.lock();
+	for (KeyValue<ObjectID, NavMeshTileCache3D *> &E : tile_caches) {
+		memdelete(E.value);
+	}
+	tile_caches.clear();
+	tile_cache_mutex.unlock();
+
 	generator_task_mutex.unlock();
 	baking_navmesh_mutex.unlock();
 }
@@ -237,6 +257,22 @@ void NavMeshGenerator3D::bake_from_source_geometry_data_async(Ref<NavigationMesh
 	generator_task_mutex.unlock();
 }
 
+int NavMeshGenerator3D::get_baked_tile_count(const Ref<NavigationMesh> &p_navigation_mesh) {
+	ERR_FAIL_COND_V(p_navigation_mesh.is_null(), 0);
+	MutexLock lock(tile_cache_mutex);
+	NavMeshTileCache3D *const *tile_cache = tile_caches.getptr(p_navigation_mesh->get_instance_id());
+	return tile_cache ? (*tile_cache)->baked_tile_count : 0;
+}
+
+void NavMeshGenerator3D::free_tiles(ObjectID p_navigation_mesh) {
+	MutexLock lock(tile_cache_mutex);
+	HashMap<ObjectID, NavMeshTileCache3D *>::Iterator E = tile_caches.find(p_navigation_mesh);
+	if (E) {
+		memdelete(E->value);
+		tile_caches.remove(E);
+	}
+}
+
 bool NavMeshGenerator3D::is_baking(Ref<NavigationMesh> p_navigation_mesh) {
 	baking_navmesh_mutex.lock();
 	bool baking = baking_navmeshes.has(p_navigation_mesh);
@@ -685,13 +721,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
 	// added to keep track of steps, no functionality right now
 	String bake_state = "";
 
@@ -771,6 +800,19 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
 	}
 
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		generator_bake_tiles(p_navigation_mesh, cfg, source_geometry_vertices, source_geometry_indices, projected_obstructions);
+		return;
+	}
+
+	// The tiles of a previous tiled bake won't be used anymore.
+	tile_cache_mutex.lock();
+	if (tile_caches.has(p_navigation_mesh->get_instance_id())) {
+		memdelete(tile_caches[p_navigation_mesh->get_instance_id()]);
+		tile_caches.erase(p_navigation_mesh->get_instance_id());
+	}
+	tile_cache_mutex.unlock();
+
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
@@ -785,48 +827,320 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	bake_state = "Creating heightfield..."; // step #3
+	bake_state = "Baking heightfield..."; // steps #3 to #10
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	if (!generator_bake_heightfield(cfg, p_navigation_mesh, verts, nverts, tris, ntris, projected_obstructions, nav_vertices, nav_polygons)) {
+		return;
+	}
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+
+	bake_state = "Baking finished."; // step #12
+}
+
+void NavMeshGenerator3D::generator_bake_tiles(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_cfg, const Vector<float> &p_vertices, const Vector<int> &p_indices, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions) {
+	const float *verts = p_vertices.ptr();
+	const int *tris = p_indices.ptr();
+	const int ntris = p_indices.size() / 3;
+
+	// Tiles are aligned with the world origin, so they keep their content when the geometry changes elsewhere.
+	const int tile_cells = MAX(1, (int)Math::ceil(p_navigation_mesh->get_tile_size() / p_cfg.cs));
+	const float tile_world_size = tile_cells * p_cfg.cs;
+	// Each tile also rasterizes a border of its neighbors, so eroding by the agent radius and
+	// building the contours give the same result on both sides of the tile edges.
+	const int border_cells = p_cfg.walkableRadius + 3;
+	const float border_world_size = border_cells * p_cfg.cs;
+
+	uint32_t settings_hash = hash_murmur3_one_32(tile_cells);
+	settings_hash = hash_murmur3_one_float(p_cfg.cs, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.ch, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.walkableSlopeAngle, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.walkableHeight, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.walkableClimb, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.walkableRadius, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.maxEdgeLen, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.maxSimplificationError, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.minRegionArea, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.mergeRegionArea, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_cfg.maxVertsPerPoly, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.detailSampleDist, settings_hash);
+	settings_hash = hash_murmur3_one_float(p_cfg.detailSampleMaxError, settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), settings_hash);
+	const AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	if (baking_aabb.has_volume()) {
+		for (int i = 0; i < 3; i++) {
+			settings_hash = hash_murmur3_one_float(p_cfg.bmin[i], settings_hash);
+			settings_hash = hash_murmur3_one_float(p_cfg.bmax[i], settings_hash);
+		}
+	}
+	settings_hash = hash_fmix32(settings_hash);
+
+	// Only the tiles overlapping the baking bounds are baked.
+	const Vector2i first_tile = Vector2i(Math::floor(p_cfg.bmin[0] / tile_world_size), Math::floor(p_cfg.bmin[2] / tile_world_size));
+	const Vector2i last_tile = Vector2i(Math::floor(p_cfg.bmax[0] / tile_world_size), Math::floor(p_cfg.bmax[2] / tile_world_size));
+
+	// Triangles overlapping each tile or its border.
+	HashMap<Vector2i, LocalVector<int>> tile_tris;
+	for (int i = 0; i < ntris; i++) {
+		const float *a = &verts[tris[i * 3 + 0] * 3];
+		const float *b = &verts[tris[i * 3 + 1] * 3];
+		const float *c = &verts[tris[i * 3 + 2] * 3];
+		const Vector2i from = Vector2i(
+				Math::floor((MIN(a[0], MIN(b[0], c[0])) - border_world_size) / tile_world_size),
+				Math::floor((MIN(a[2], MIN(b[2], c[2])) - border_world_size) / tile_world_size));
+		const Vector2i to = Vector2i(
+				Math::floor((MAX(a[0], MAX(b[0], c[0])) + border_world_size) / tile_world_size),
+				Math::floor((MAX(a[2], MAX(b[2], c[2])) + border_world_size) / tile_world_size));
+
+		for (int z = MAX(from.y, first_tile.y); z <= MIN(to.y, last_tile.y); z++) {
+			for (int x = MAX(from.x, first_tile.x); x <= MIN(to.x, last_tile.x); x++) {
+				LocalVector<int> &triangles = tile_tris[Vector2i(x, z)];
+				triangles.push_back(tris[i * 3 + 0]);
+				triangles.push_back(tris[i * 3 + 1]);
+				triangles.push_back(tris[i * 3 + 2]);
+			}
+		}
+	}
+
+	NavMeshTileCache3D *tile_cache = nullptr;
+	{
+		MutexLock lock(tile_cache_mutex);
+		HashMap<ObjectID, NavMeshTileCache3D *>::Iterator E = tile_caches.find(p_navigation_mesh->get_instance_id());
+		if (!E) {
+			E = tile_caches.insert(p_navigation_mesh->get_instance_id(), memnew(NavMeshTileCache3D));
+		}
+		tile_cache = E->value;
+	}
+
+	if (tile_cache->settings_hash != settings_hash) {
+		tile_cache->tiles.clear();
+		tile_cache->settings_hash = settings_hash;
+	}
+
+	LocalVector<Vector2i> empty_tiles;
+	for (const KeyValue<Vector2i, NavMeshBakeTile3D> &E : tile_cache->tiles) {
+		if (!tile_tris.has(E.key)) {
+			empty_tiles.push_back(E.key);
+		}
+	}
+	for (const Vector2i &tile_position : empty_tiles) {
+		tile_cache->tiles.erase(tile_position);
+	}
+
+	NavMeshTileBakeJob3D job;
+	job.navigation_mesh = p_navigation_mesh;
+	job.verts = verts;
+	job.nverts = p_vertices.size() / 3;
+	job.projected_obstructions = &p_projected_obstructions;
+
+	for (const KeyValue<Vector2i, LocalVector<int>> &E : tile_tris) {
+		rcConfig cfg = p_cfg;
+		cfg.borderSize = border_cells;
+		cfg.width = tile_cells + border_cells * 2;
+		cfg.height = tile_cells + border_cells * 2;
+		cfg.bmin[0] = E.key.x * tile_world_size - border_world_size;
+		cfg.bmin[2] = E.key.y * tile_world_size - border_world_size;
+		cfg.bmax[0] = (E.key.x + 1) * tile_world_size + border_world_size;
+		cfg.bmax[2] = (E.key.y + 1) * tile_world_size + border_world_size;
+
+		uint32_t source_hash = HASH_MURMUR3_SEED;
+		float min_y = FLT_MAX;
+		float max_y = -FLT_MAX;
+		for (const int index : E.value) {
+			const float *v = &verts[index * 3];
+			source_hash = hash_murmur3_one_float(v[0], source_hash);
+			source_hash = hash_murmur3_one_float(v[1], source_hash);
+			source_hash = hash_murmur3_one_float(v[2], source_hash);
+			min_y = MIN(min_y, v[1]);
+			max_y = MAX(max_y, v[1]);
+		}
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
+			const Vector<float> &obstruction_vertices = projected_obstruction.vertices;
+			bool overlaps = false;
+			for (int i = 0; i + 2 < obstruction_vertices.size() && !overlaps; i += 3) {
+				overlaps = obstruction_vertices[i] >= cfg.bmin[0] && obstruction_vertices[i] <= cfg.bmax[0] && obstruction_vertices[i + 2] >= cfg.bmin[2] && obstruction_vertices[i + 2] <= cfg.bmax[2];
+			}
+			if (!overlaps) {
+				continue;
+			}
+			for (const float value : obstruction_vertices) {
+				source_hash = hash_murmur3_one_float(value, source_hash);
+			}
+			source_hash = hash_murmur3_one_float(projected_obstruction.elevation, source_hash);
+			source_hash = hash_murmur3_one_float(projected_obstruction.height, source_hash);
+			source_hash = hash_murmur3_one_32(projected_obstruction.carve, source_hash);
+		}
+		source_hash = hash_fmix32(source_hash);
+
+		NavMeshBakeTile3D *tile = tile_cache->tiles.getptr(E.key);
+		if (tile && tile->source_hash == source_hash) {
+			continue;
+		}
+		if (!tile) {
+			tile = &tile_cache->tiles.insert(E.key, NavMeshBakeTile3D())->value;
+		}
+		tile->source_hash = source_hash;
+
+		// Keep the voxels of all tiles aligned on the Y axis too, so the heights match on the tile edges.
+		cfg.bmin[1] = Math::floor(MAX(min_y, p_cfg.bmin[1]) / p_cfg.ch) * p_cfg.ch;
+		cfg.bmax[1] = Math::ceil(MIN(max_y, p_cfg.bmax[1]) / p_cfg.ch) * p_cfg.ch + p_cfg.ch;
+
+		job.configs.push_back(cfg);
+		job.tris.push_back(&E.value);
+		job.tiles.push_back(tile);
+	}
+	tile_cache->baked_tile_count = job.tiles.size();
+
+	if (use_threads && job.tiles.size() > 1) {
+		// Always high priority, the async bake waiting for the tiles may itself occupy the low priority threads.
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_bake_tile_task, &job, job.tiles.size(), -1, true, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < job.tiles.size(); i++) {
+			generator_bake_tile_task(&job, i);
+		}
+	}
+
+	// Merge the vertices shared by neighbor tiles so their polygons connect.
+	LocalVector<Vector2i> tile_positions;
+	for (const KeyValue<Vector2i, NavMeshBakeTile3D> &E : tile_cache->tiles) {
+		tile_positions.push_back(E.key);
+	}
+	tile_positions.sort();
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	HashMap<Vector3i, int> vertex_indices;
+	const float merge_size = p_cfg.cs * 0.1;
+	const float merge_height = p_cfg.ch * 0.1;
+	LocalVector<int> tile_to_nav_index;
+
+	for (const Vector2i &tile_position : tile_positions) {
+		const NavMeshBakeTile3D &tile = tile_cache->tiles[tile_position];
+
+		tile_to_nav_index.resize(tile.vertices.size());
+		for (int i = 0; i < tile.vertices.size(); i++) {
+			const Vector3 &vertex = tile.vertices[i];
+			const Vector3i vertex_key = Vector3i(Math::round(vertex.x / merge_size), Math::round(vertex.y / merge_height), Math::round(vertex.z / merge_size));
+			const int *existing_index = vertex_indices.getptr(vertex_key);
+			if (existing_index) {
+				tile_to_nav_index[i] = *existing_index;
+			} else {
+				tile_to_nav_index[i] = nav_vertices.size();
+				vertex_indices.insert(vertex_key, nav_vertices.size());
+				nav_vertices.push_back(vertex);
+			}
+		}
+
+		for (const Vector<int> &tile_polygon : tile.polygons) {
+			// The merge can collapse neighbor vertices of a polygon into one, keep them once
+			// and skip what is left of the tiny polygons.
+			Vector<int> nav_polygon;
+			for (int i = 0; i < tile_polygon.size(); i++) {
+				const int nav_index = tile_to_nav_index[tile_polygon[i]];
+				if (nav_polygon.is_empty() || nav_polygon[nav_polygon.size() - 1] != nav_index) {
+					nav_polygon.push_back(nav_index);
+				}
+			}
+			while (nav_polygon.size() > 1 && nav_polygon[nav_polygon.size() - 1] == nav_polygon[0]) {
+				nav_polygon.remove_at(nav_polygon.size() - 1);
+			}
+			if (nav_polygon.size() < 3) {
+				continue;
+			}
+			nav_polygons.push_back(nav_polygon);
+		}
+	}
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+}
+
+void NavMeshGenerator3D::generator_bake_tile_task(void *p_arg, uint32_t p_index) {
+	NavMeshTileBakeJob3D *job = static_cast<NavMeshTileBakeJob3D *>(p_arg);
+	NavMeshBakeTile3D *tile = job->tiles[p_index];
+	const LocalVector<int> &tris = *job->tris[p_index];
+
+	tile->vertices.clear();
+	tile->polygons.clear();
+	if (!generator_bake_heightfield(job->configs[p_index], job->navigation_mesh, job->verts, job->nverts, tris.ptr(), tris.size() / 3, *job->projected_obstructions, tile->vertices, tile->polygons)) {
+		// Try again on the next bake.
+		tile->source_hash = 0;
+		tile->vertices.clear();
+		tile->polygons.clear();
+	}
+}
+
+bool NavMeshGenerator3D::generator_bake_heightfield(const rcConfig &p_cfg, const Ref<NavigationMesh> &p_navigation_mesh, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	// Frees what is still allocated when returning, also from the failure checks below.
+	struct RecastData {
+		rcHeightfield *hf = nullptr;
+		rcCompactHeightfield *chf = nullptr;
+		rcContourSet *cset = nullptr;
+		rcPolyMesh *poly_mesh = nullptr;
+		rcPolyMeshDetail *detail_mesh = nullptr;
+
+		~RecastData() {
+			rcFreeHeightField(hf);
+			rcFreeCompactHeightfield(chf);
+			rcFreeContourSet(cset);
+			rcFreePolyMesh(poly_mesh);
+			rcFreePolyMeshDetail(detail_mesh);
+		}
+	} recast_data;
+	rcHeightfield *&hf = recast_data.hf;
+	rcCompactHeightfield *&chf = recast_data.chf;
+	rcContourSet *&cset = recast_data.cset;
+	rcPolyMesh *&poly_mesh = recast_data.poly_mesh;
+	rcPolyMeshDetail *&detail_mesh = recast_data.detail_mesh;
+	rcContext ctx;
+
+	// Creating heightfield.
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
 
-	bake_state = "Marking walkable triangles..."; // step #4
+	// Marking walkable triangles.
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_ntris);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLowHangingWalkableObstacles(&ctx, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, p_cfg.walkableHeight, *hf);
 	}
 
-	bake_state = "Constructing compact heightfield..."; // step #5
+	// Constructing compact heightfield.
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
 	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (projected_obstruction.carve) {
 				continue;
 			}
@@ -841,13 +1155,13 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		}
 	}
 
-	bake_state = "Eroding walkable area..."; // step #6
+	// Eroding walkable area.
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_cfg.walkableRadius, *chf), false);
 
 	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (!projected_obstruction.carve) {
 				continue;
 			}
@@ -862,43 +1176,40 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		}
 	}
 
-	bake_state = "Partitioning..."; // step #7
+	// Partitioning.
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
 	}
 
-	bake_state = "Creating contours..."; // step #8
+	// Creating contours.
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), false);
 
-	bake_state = "Creating polymesh..."; // step #9
+	// Creating polymesh.
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
 	rcFreeContourSet(cset);
 	cset = nullptr;
 
-	bake_state = "Converting to native navigation mesh..."; // step #10
-
-	Vector<Vector3> nav_vertices;
-	Vector<Vector<int>> nav_polygons;
+	// Converting to native navigation mesh.
 
 	HashMap<Vector3, int> recast_vertex_to_native_index;
 	LocalVector<int> recast_index_to_native_index;
@@ -912,7 +1223,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			int new_index = recast_vertex_to_native_index.size();
 			recast_index_to_native_index[i] = new_index;
 			recast_vertex_to_native_index[vertex] = new_index;
-			nav_vertices.push_back(vertex);
+			r_vertices.push_back(vertex);
 		} else {
 			recast_index_to_native_index[i] = *existing_index_ptr;
 		}
@@ -936,20 +1247,18 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			nav_indices.write[1] = recast_index_to_native_index[index2];
 			nav_indices.write[2] = recast_index_to_native_index[index3];
 
-			nav_polygons.push_back(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 
-	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
-
-	bake_state = "Cleanup..."; // step #11
+	// Cleanup.
 
 	rcFreePolyMesh(poly_mesh);
 	poly_mesh = nullptr;
 	rcFreePolyMeshDetail(detail_mesh);
 	detail_mesh = nullptr;
 
-	bake_state = "Baking finished."; // step #12
+	return true;
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
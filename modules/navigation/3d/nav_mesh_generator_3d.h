@@ -37,10 +37,12 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/templates/rid_owner.h"
 #include "modules/modules_enabled.gen.h" // For csg, gridmap.
+#include "scene/resources/3d/navigation_mesh_source_geometry_data_3d.h"
+
+struct rcConfig;
 
 class Node;
 class NavigationMesh;
-class NavigationMeshSourceGeometryData3D;
 
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
@@ -82,6 +84,29 @@ class NavMeshGenerator3D : public Object {
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
+	/// Polygons baked for a tile of a navigation mesh, see NavigationMesh::tile_size.
+	struct NavMeshBakeTile3D {
+		uint32_t source_hash = 0; // Of the source geometry overlapping the tile and its border.
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	struct NavMeshTileCache3D {
+		uint32_t settings_hash = 0;
+		HashMap<Vector2i, NavMeshBakeTile3D> tiles;
+		uint32_t baked_tile_count = 0; // By the last bake, the other tiles were kept.
+	};
+
+	/// Tiles of the last bake of each navigation mesh, so baking it again only rebakes the changed ones.
+	static Mutex tile_cache_mutex;
+	static HashMap<ObjectID, NavMeshTileCache3D *> tile_caches;
+
+	struct NavMeshTileBakeJob3D;
+
+	static void generator_bake_tiles(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_cfg, const Vector<float> &p_vertices, const Vector<int> &p_indices, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions);
+	static void generator_bake_tile_task(void *p_arg, uint32_t p_index);
+	static bool generator_bake_heightfield(const rcConfig &p_cfg, const Ref<NavigationMesh> &p_navigation_mesh, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
+
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
@@ -110,6 +135,9 @@ public:
 	static void bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationMesh> p_navigation_mesh);
+	/// Tiles baked again by the last tiled bake of the navigation mesh, to check which tiles the changes touched.
+	static int get_baked_tile_count(const Ref<NavigationMesh> &p_navigation_mesh);
+	static void free_tiles(ObjectID p_navigation_mesh);
 
 	static RID source_geometry_parser_create();
 	static void source_geometry_parser_set_callback(RID p_parser, const Callable &p_callback);
@@ -37,9 +37,15 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/sort_array.h"
 
 #include <Obstacle2d.h>
 
+// Below this many agents, building the avoidance trees in parallel costs more than it saves.
+#define AVOIDANCE_PARALLEL_TREE_MIN_AGENTS 1024
+// The first levels of the avoidance trees are split on the calling thread, 2^depth subtrees are then built in parallel.
+#define AVOIDANCE_PARALLEL_TREE_SPLIT_DEPTH 5
+
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
 // Helper macro
@@ -63,6 +69,50 @@
 #define NAVMAP_ITERATION_ZERO_ERROR_MSG()
 #endif // DEBUG_ENABLED
 
+// Search buffers reused by the path queries run on each thread, so that repathing
+// many agents (possibly in parallel, see `query_path_batch()`) doesn't allocate.
+struct PolygonDistance {
+	uint32_t id = 0;
+	real_t distance = 0.0;
+};
+
+struct SortPolygonDistances {
+	_FORCE_INLINE_ bool operator()(const PolygonDistance &p_a, const PolygonDistance &p_b) const {
+		return p_a.distance > p_b.distance; // The shortest distance is on top of the heap.
+	}
+};
+
+struct PortalNode {
+	const gd::Polygon *poly = nullptr;
+	real_t cost = 0.0;
+	int32_t back_id = -1;
+};
+
+struct PathQueryScratch {
+	// List of all reachable navigation polys.
+	LocalVector<gd::NavigationPoly> navigation_polys;
+	// List of polygon IDs to visit.
+	LocalVector<uint32_t> to_visit;
+
+	// Regions and links the polygon search may enter, see `NavMap::_find_path_corridor()`.
+	HashSet<const NavBase *> corridor;
+	// Search over the portals, with the node of each polygon valid when its search id is the current one.
+	LocalVector<PortalNode> portal_nodes;
+	LocalVector<PolygonDistance> portal_open_list;
+	LocalVector<uint32_t> portal_node_ids;
+	LocalVector<uint32_t> portal_search_ids;
+	uint32_t portal_search_id = 0;
+	LocalVector<real_t> begin_distances;
+	LocalVector<real_t> end_distances;
+	// Search inside a region, with the distance of each polygon valid when its search id is the current one.
+	LocalVector<real_t> polygon_distances;
+	LocalVector<PolygonDistance> polygon_open_list;
+	LocalVector<uint32_t> polygon_search_ids;
+	uint32_t polygon_search_id = 0;
+};
+
+static thread_local PathQueryScratch path_query_scratch;
+
 void NavMap::set_up(Vector3 p_up) {
 	if (up == p_up) {
 		return;
@@ -106,6 +156,14 @@ void NavMap::set_use_edge_connections(bool p_enabled) {
 	regenerate_links = true;
 }
 
+void NavMap::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	regenerate_links = true;
+}
+
 void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 	if (edge_connection_margin == p_edge_connection_margin) {
 		return;
@@ -154,40 +212,17 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	}
 
 	// Find the start poly and the end poly on this map.
-	const gd::Polygon *begin_poly = nullptr;
-	const gd::Polygon *end_poly = nullptr;
-	Vector3 begin_point;
-	Vector3 end_point;
-	real_t begin_d = FLT_MAX;
+	// Only consider polygons in regions with compatible layers.
+	gd::ClosestPolygonPoint begin_closest;
+	gd::ClosestPolygonPoint end_closest;
+	_find_closest_polygon_point(p_origin, begin_closest, true, p_navigation_layers);
+	_find_closest_polygon_point(p_destination, end_closest, true, p_navigation_layers);
+
+	const gd::Polygon *begin_poly = begin_closest.polygon;
+	const gd::Polygon *end_poly = end_closest.polygon;
+	Vector3 begin_point = begin_closest.point;
+	Vector3 end_point = end_closest.point;
 	real_t end_d = FLT_MAX;
-	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
-			continue;
-		}
-
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
-
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
-			}
-		}
-	}
 
 	// Check for trivial cases
 	if (!begin_poly || !end_poly) {
@@ -219,8 +254,14 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
-	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
+	// Paths between regions can first be searched over the portals between them,
+	// the polygon search then only enters the regions and links found on the way.
+	HashSet<const NavBase *> &corridor = path_query_scratch.corridor;
+	corridor.clear();
+	bool use_corridor = use_hierarchical_pathfinding && begin_poly->owner != end_poly->owner && _find_path_corridor(begin_poly, end_poly, p_navigation_layers, corridor);
+
+	LocalVector<gd::NavigationPoly> &navigation_polys = path_query_scratch.navigation_polys;
+	navigation_polys.clear();
 	navigation_polys.reserve(polygons.size() * 0.75);
 
 	// Add the start polygon to the reachable navigation polygons.
@@ -231,8 +272,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
 	navigation_polys.push_back(begin_navigation_poly);
 
-	// List of polygon IDs to visit.
-	List<uint32_t> to_visit;
+	LocalVector<uint32_t> &to_visit = path_query_scratch.to_visit;
+	to_visit.clear();
 	to_visit.push_back(0);
 
 	// This is an implementation of the A* algorithm.
@@ -255,6 +296,9 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				if ((p_navigation_layers & connection.polygon->owner->get_navigation_layers()) == 0) {
 					continue;
 				}
+				if (use_corridor && !corridor.has(connection.polygon->owner)) {
+					continue;
+				}
 
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
@@ -304,6 +348,22 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		to_visit.erase(least_cost_id);
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
+		if (to_visit.size() == 0 && use_corridor) {
+			// Not through the corridor at least, search every region instead.
+			use_corridor = false;
+			gd::NavigationPoly np = navigation_polys[0];
+			navigation_polys.clear();
+			navigation_polys.push_back(np);
+			to_visit.clear();
+			to_visit.push_back(0);
+			least_cost_id = 0;
+			prev_least_cost_id = -1;
+
+			reachable_end = nullptr;
+			reachable_d = FLT_MAX;
+
+			continue;
+		}
 		if (to_visit.size() == 0) {
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
@@ -383,8 +443,8 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		// Find the polygon with the minimum cost from the list of polygons to visit.
 		least_cost_id = -1;
 		real_t least_cost = FLT_MAX;
-		for (List<uint32_t>::Element *element = to_visit.front(); element != nullptr; element = element->next()) {
-			gd::NavigationPoly *np = &navigation_polys[element->get()];
+		for (const uint32_t to_visit_id : to_visit) {
+			gd::NavigationPoly *np = &navigation_polys[to_visit_id];
 			real_t cost = np->traveled_distance;
 			cost += (np->entry.distance_to(end_point) * np->poly->owner->get_travel_cost());
 			if (cost < least_cost) {
@@ -683,24 +743,333 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	RWLockRead read_lock(map_rwlock);
 
 	gd::ClosestPointQueryResult result;
-	real_t closest_point_ds = FLT_MAX;
+	gd::ClosestPolygonPoint closest;
+	_find_closest_polygon_point(p_point, closest);
+	if (closest.polygon) {
+		result.point = closest.point;
+		result.normal = closest.normal;
+		result.owner = closest.polygon->owner->get_self();
+	}
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
+	return result;
+}
+
+void NavMap::_find_closest_polygon_point(const Vector3 &p_point, gd::ClosestPolygonPoint &r_closest, bool p_filter_layers, uint32_t p_navigation_layers) const {
+	for (const RegionPolygons &E : region_polygons) {
+		if (p_filter_layers && (p_navigation_layers & E.region->get_navigation_layers()) == 0) {
+			continue;
+		}
+
+		const gd::PolygonBVH &bvh = E.region->get_polygons_bvh();
+		if (bvh.is_empty() || gd::PolygonBVH::get_aabb_distance_squared(bvh.get_aabb(), p_point) > r_closest.distance_squared) {
+			continue;
+		}
+		bvh.closest_point_query(&polygons[E.first_polygon], p_point, r_closest);
+	}
+}
+
+const NavMap::RegionPolygons *NavMap::_get_region_polygons(const gd::Polygon *p_polygon) const {
+	if (p_polygon < polygons.ptr() || p_polygon >= polygons.ptr() + polygons.size()) {
+		return nullptr; // Link polygon.
+	}
+	const uint32_t polygon_index = p_polygon - polygons.ptr();
+
+	// Last region starting at or before the polygon, regions without polygons start where the next one does.
+	uint32_t low = 0;
+	uint32_t high = region_polygons.size();
+	while (high - low > 1) {
+		const uint32_t middle = (low + high) / 2;
+		if (region_polygons[middle].first_polygon <= polygon_index) {
+			low = middle;
+		} else {
+			high = middle;
+		}
+	}
+	return &region_polygons[low];
+}
+
+// Index of a region polygon in the sorted portals of the region, or -1 if it isn't one.
+static int64_t _find_portal(const LocalVector<uint32_t> &p_portals, uint32_t p_polygon) {
+	uint32_t low = 0;
+	uint32_t high = p_portals.size();
+	while (low < high) {
+		const uint32_t middle = (low + high) / 2;
+		if (p_portals[middle] < p_polygon) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return (low < p_portals.size() && p_portals[low] == p_polygon) ? (int64_t)low : -1;
+}
+
+// Starts a new search over entries which are only valid when their search id is the current one,
+// so that the entries don't have to be cleared for every query.
+static uint32_t _begin_search(LocalVector<uint32_t> &r_search_ids, uint32_t &r_search_id, uint32_t p_size) {
+	const uint32_t old_size = r_search_ids.size();
+	if (old_size < p_size) {
+		r_search_ids.resize(p_size);
+		memset(r_search_ids.ptr() + old_size, 0, (p_size - old_size) * sizeof(uint32_t));
+	}
+	r_search_id++;
+	if (r_search_id == 0) {
+		// Wrapped around, ids of old searches could match again.
+		memset(r_search_ids.ptr(), 0, r_search_ids.size() * sizeof(uint32_t));
+		r_search_id = 1;
+	}
+	return r_search_id;
+}
+
+void NavMap::_compute_portal_distances(uint32_t p_polygon, const RegionPolygons &p_region, LocalVector<real_t> &r_distances) const {
+	const LocalVector<uint32_t> &portals = p_region.region->get_portals();
+	r_distances.resize(portals.size());
+	for (real_t &distance : r_distances) {
+		distance = FLT_MAX;
+	}
+
+	PathQueryScratch &scratch = path_query_scratch;
+	const uint32_t search_id = _begin_search(scratch.polygon_search_ids, scratch.polygon_search_id, polygons.size());
+	if (scratch.polygon_distances.size() < polygons.size()) {
+		scratch.polygon_distances.resize(polygons.size());
+	}
+	LocalVector<PolygonDistance> &open_list = scratch.polygon_open_list;
+	open_list.clear();
+
+	// Dijkstra over the polygon centers, staying inside the region and stopping once every portal is reached.
+	SortArray<PolygonDistance, SortPolygonDistances> sorter;
+	scratch.polygon_distances[p_polygon] = 0.0;
+	scratch.polygon_search_ids[p_polygon] = search_id;
+	open_list.push_back({ p_polygon, 0.0 });
+	uint32_t portals_left = portals.size();
+
+	while (!open_list.is_empty() && portals_left > 0) {
+		const PolygonDistance least = open_list[0];
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.remove_at(open_list.size() - 1);
+		if (least.distance > scratch.polygon_distances[least.id]) {
+			continue; // Reached again with a shorter distance since.
+		}
+
+		const int64_t portal = _find_portal(portals, least.id - p_region.first_polygon);
+		if (portal >= 0 && r_distances[portal] == FLT_MAX) {
+			r_distances[portal] = least.distance;
+			portals_left--;
+		}
+
+		const gd::Polygon &polygon = polygons[least.id];
+		for (const gd::Edge &edge : polygon.edges) {
+			for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+				const gd::Edge::Connection &connection = edge.connections[connection_index];
+				if (connection.polygon->owner != polygon.owner) {
+					continue;
+				}
+				const uint32_t neighbor = connection.polygon - polygons.ptr();
+				const real_t distance = least.distance + polygon.center.distance_to(connection.polygon->center);
+				if (scratch.polygon_search_ids[neighbor] != search_id || distance < scratch.polygon_distances[neighbor]) {
+					scratch.polygon_search_ids[neighbor] = search_id;
+					scratch.polygon_distances[neighbor] = distance;
+					open_list.push_back({ neighbor, distance });
+					sorter.push_heap(0, open_list.size() - 1, 0, open_list[open_list.size() - 1], open_list.ptr());
+				}
 			}
 		}
 	}
+}
 
-	return result;
+const real_t *NavMap::_get_portal_distances(uint32_t p_portal, const RegionPolygons &p_region) const {
+	const real_t *distances = p_region.region->get_portal_distances(p_portal);
+	if (distances) {
+		return distances;
+	}
+
+	LocalVector<real_t> new_distances;
+	_compute_portal_distances(p_region.first_polygon + p_region.region->get_portals()[p_portal], p_region, new_distances);
+	return p_region.region->set_portal_distances(p_portal, new_distances);
+}
+
+bool NavMap::_find_path_corridor(const gd::Polygon *p_begin_poly, const gd::Polygon *p_end_poly, uint32_t p_navigation_layers, HashSet<const NavBase *> &r_corridor) const {
+	const RegionPolygons *begin_region = _get_region_polygons(p_begin_poly);
+	const RegionPolygons *end_region = _get_region_polygons(p_end_poly);
+	ERR_FAIL_COND_V(!begin_region || !end_region, false);
+	const LocalVector<uint32_t> &begin_portals = begin_region->region->get_portals();
+	const LocalVector<uint32_t> &end_portals = end_region->region->get_portals();
+	if (begin_portals.is_empty() || end_portals.is_empty()) {
+		return false;
+	}
+
+	// Distances from and to the path endpoints aren't cached, they change with every query.
+	PathQueryScratch &scratch = path_query_scratch;
+	LocalVector<real_t> &begin_distances = scratch.begin_distances;
+	LocalVector<real_t> &end_distances = scratch.end_distances;
+	_compute_portal_distances(p_begin_poly - polygons.ptr(), *begin_region, begin_distances);
+	_compute_portal_distances(p_end_poly - polygons.ptr(), *end_region, end_distances);
+
+	// A* over the portal polygons, regions are crossed with the distances cached in them.
+	// Link polygons are numbered after the map polygons.
+	const uint32_t search_id = _begin_search(scratch.portal_search_ids, scratch.portal_search_id, polygons.size() + link_polygons.size());
+	if (scratch.portal_node_ids.size() < polygons.size() + link_polygons.size()) {
+		scratch.portal_node_ids.resize(polygons.size() + link_polygons.size());
+	}
+	LocalVector<PortalNode> &nodes = scratch.portal_nodes;
+	nodes.clear();
+	LocalVector<PolygonDistance> &open_list = scratch.portal_open_list;
+	open_list.clear();
+	SortArray<PolygonDistance, SortPolygonDistances> sorter;
+
+	const Vector3 end_center = p_end_poly->center;
+	auto reach_portal = [&](const gd::Polygon *p_poly, real_t p_cost, int32_t p_back_id) {
+		const bool is_link = p_poly < polygons.ptr() || p_poly >= polygons.ptr() + polygons.size();
+		const uint32_t index = is_link ? polygons.size() + (p_poly - link_polygons.ptr()) : p_poly - polygons.ptr();
+		uint32_t id;
+		if (scratch.portal_search_ids[index] == search_id) {
+			id = scratch.portal_node_ids[index];
+			if (p_cost >= nodes[id].cost) {
+				return;
+			}
+			nodes[id].cost = p_cost;
+			nodes[id].back_id = p_back_id;
+		} else {
+			id = nodes.size();
+			scratch.portal_search_ids[index] = search_id;
+			scratch.portal_node_ids[index] = id;
+			nodes.push_back({ p_poly, p_cost, p_back_id });
+		}
+		open_list.push_back({ id, p_cost + p_poly->center.distance_to(end_center) * min_travel_cost });
+		sorter.push_heap(0, open_list.size() - 1, 0, open_list[open_list.size() - 1], open_list.ptr());
+	};
+
+	const real_t begin_travel_cost = begin_region->region->get_travel_cost();
+	for (uint32_t i = 0; i < begin_portals.size(); i++) {
+		if (begin_distances[i] < FLT_MAX) {
+			reach_portal(&polygons[begin_region->first_polygon + begin_portals[i]], begin_distances[i] * begin_travel_cost, -1);
+		}
+	}
+
+	int32_t best_id = -1;
+	real_t best_cost = FLT_MAX;
+	while (!open_list.is_empty()) {
+		const PolygonDistance least = open_list[0];
+		sorter.pop_heap(0, open_list.size(), open_list.ptr());
+		open_list.remove_at(open_list.size() - 1);
+		if (least.distance >= best_cost) {
+			break;
+		}
+
+		const PortalNode node = nodes[least.id];
+		if (least.distance > node.cost + node.poly->center.distance_to(end_center) * min_travel_cost) {
+			continue; // Reached again with a lower cost since.
+		}
+
+		const RegionPolygons *region = _get_region_polygons(node.poly);
+		const int64_t portal = region ? _find_portal(region->region->get_portals(), node.poly - polygons.ptr() - region->first_polygon) : -1;
+		if (region == end_region && portal >= 0 && end_distances[portal] < FLT_MAX) {
+			const real_t cost = node.cost + end_distances[portal] * end_region->region->get_travel_cost();
+			if (cost < best_cost) {
+				best_cost = cost;
+				best_id = least.id;
+			}
+		}
+
+		// Leave the region or link through its connections.
+		for (const gd::Edge &edge : node.poly->edges) {
+			for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+				const gd::Edge::Connection &connection = edge.connections[connection_index];
+				const NavBase *owner = connection.polygon->owner;
+				if (owner == node.poly->owner || (p_navigation_layers & owner->get_navigation_layers()) == 0) {
+					continue;
+				}
+				const real_t cost = node.cost + node.poly->center.distance_to(connection.polygon->center) * owner->get_travel_cost() + owner->get_enter_cost();
+				reach_portal(connection.polygon, cost, least.id);
+			}
+		}
+
+		// Cross the region to its other portals.
+		if (portal >= 0) {
+			const LocalVector<uint32_t> &portals = region->region->get_portals();
+			const real_t *distances = _get_portal_distances(portal, *region);
+			ERR_CONTINUE(!distances);
+			const real_t travel_cost = region->region->get_travel_cost();
+			for (uint32_t i = 0; i < portals.size(); i++) {
+				if (i != portal && distances[i] < FLT_MAX) {
+					reach_portal(&polygons[region->first_polygon + portals[i]], node.cost + distances[i] * travel_cost, least.id);
+				}
+			}
+		}
+	}
+
+	if (best_id == -1) {
+		return false;
+	}
+
+	r_corridor.insert(begin_region->region);
+	r_corridor.insert(end_region->region);
+	for (int32_t id = best_id; id != -1; id = nodes[id].back_id) {
+		r_corridor.insert(nodes[id].poly->owner);
+	}
+	return true;
+}
+
+void NavMap::_update_portals() {
+	min_travel_cost = 1.0;
+
+	if (!use_hierarchical_pathfinding) {
+		for (const RegionPolygons &E : region_polygons) {
+			E.region->set_portals(LocalVector<uint32_t>());
+		}
+		return;
+	}
+
+	// Portals are the polygons with a connection to or from another region or a link.
+	LocalVector<uint8_t> is_portal;
+	is_portal.resize(polygons.size());
+	memset(is_portal.ptr(), 0, is_portal.size());
+	const gd::Polygon *polygons_begin = polygons.ptr();
+	const gd::Polygon *polygons_end = polygons.ptr() + polygons.size();
+
+	for (const gd::Polygon &polygon : polygons) {
+		for (const gd::Edge &edge : polygon.edges) {
+			for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+				const gd::Edge::Connection &connection = edge.connections[connection_index];
+				if (connection.polygon->owner == polygon.owner) {
+					continue;
+				}
+				is_portal[&polygon - polygons_begin] = 1;
+				if (connection.polygon >= polygons_begin && connection.polygon < polygons_end) {
+					is_portal[connection.polygon - polygons_begin] = 1;
+				}
+			}
+		}
+	}
+	for (const gd::Polygon &polygon : link_polygons) {
+		for (const gd::Edge &edge : polygon.edges) {
+			for (int connection_index = 0; connection_index < edge.connections.size(); connection_index++) {
+				const gd::Edge::Connection &connection = edge.connections[connection_index];
+				if (connection.polygon >= polygons_begin && connection.polygon < polygons_end) {
+					is_portal[connection.polygon - polygons_begin] = 1;
+				}
+			}
+		}
+	}
+
+	// Regions keep their cached portal distances unless their portals changed.
+	LocalVector<uint32_t> portals;
+	for (const RegionPolygons &E : region_polygons) {
+		portals.clear();
+		const uint32_t polygon_count = E.region->get_polygons().size();
+		for (uint32_t i = 0; i < polygon_count; i++) {
+			if (is_portal[E.first_polygon + i]) {
+				portals.push_back(i);
+			}
+		}
+		E.region->set_portals(portals);
+		min_travel_cost = MIN(min_travel_cost, E.region->get_travel_cost());
+	}
+	for (const NavLink *link : links) {
+		if (link->get_enabled()) {
+			min_travel_cost = MIN(min_travel_cost, link->get_travel_cost());
+		}
+	}
+	min_travel_cost = MAX(min_travel_cost, 0.0);
 }
 
 void NavMap::add_region(NavRegion *p_region) {
@@ -932,10 +1301,12 @@ void NavMap::sync() {
 
 		// Copy all region polygons in the map.
 		count = 0;
-		for (const NavRegion *region : regions) {
+		region_polygons.clear();
+		for (NavRegion *region : regions) {
 			if (!region->get_enabled()) {
 				continue;
 			}
+			region_polygons.push_back({ region, (uint32_t)count });
 			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
 			for (uint32_t n = 0; n < polygons_source.size(); n++) {
 				polygons[count + n] = polygons_source[n];
@@ -1067,49 +1438,18 @@ void NavMap::sync() {
 			const Vector3 start = link->get_start_position();
 			const Vector3 end = link->get_end_position();
 
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
+			// Find the closest polygons within the search radius of the start and end points.
+			gd::ClosestPolygonPoint closest_start;
+			closest_start.distance_squared = link_connection_radius * link_connection_radius;
+			_find_closest_polygon_point(start, closest_start);
+			gd::Polygon *closest_start_polygon = closest_start.polygon ? &polygons[closest_start.polygon - polygons.ptr()] : nullptr;
+			const Vector3 closest_start_point = closest_start.point;
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
-
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
+			gd::ClosestPolygonPoint closest_end;
+			closest_end.distance_squared = link_connection_radius * link_connection_radius;
+			_find_closest_polygon_point(end, closest_end);
+			gd::Polygon *closest_end_polygon = closest_end.polygon ? &polygons[closest_end.polygon - polygons.ptr()] : nullptr;
+			const Vector3 closest_end_point = closest_end.point;
 
 			// If we have both a start and end point, then create a synthetic polygon to route through.
 			if (closest_start_polygon && closest_end_polygon) {
@@ -1170,6 +1510,8 @@ void NavMap::sync() {
 			}
 		}
 
+		_update_portals();
+
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
 		iteration_id = iteration_id % UINT32_MAX + 1;
 	}
@@ -1293,7 +1635,15 @@ void NavMap::_update_rvo_agents_tree_2d() {
 	for (NavAgent *agent : active_2d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_2d());
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+
+	if (use_threads && avoidance_use_multiple_threads && raw_agents.size() >= AVOIDANCE_PARALLEL_TREE_MIN_AGENTS) {
+		rvo_agent_subtrees_2d.clear();
+		rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents, AVOIDANCE_PARALLEL_TREE_SPLIT_DEPTH, rvo_agent_subtrees_2d);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::build_single_agents_subtree_2d, rvo_agent_subtrees_2d.data(), rvo_agent_subtrees_2d.size(), -1, true, SNAME("RVOAgentsTree2D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+	}
 }
 
 void NavMap::_update_rvo_agents_tree_3d() {
@@ -1303,7 +1653,23 @@ void NavMap::_update_rvo_agents_tree_3d() {
 	for (NavAgent *agent : active_3d_avoidance_agents) {
 		raw_agents.push_back(agent->get_rvo_agent_3d());
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+
+	if (use_threads && avoidance_use_multiple_threads && raw_agents.size() >= AVOIDANCE_PARALLEL_TREE_MIN_AGENTS) {
+		rvo_agent_subtrees_3d.clear();
+		rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents, AVOIDANCE_PARALLEL_TREE_SPLIT_DEPTH, rvo_agent_subtrees_3d);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::build_single_agents_subtree_3d, rvo_agent_subtrees_3d.data(), rvo_agent_subtrees_3d.size(), -1, true, SNAME("RVOAgentsTree3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+	}
+}
+
+void NavMap::build_single_agents_subtree_2d(uint32_t index, RVO2D::KdTree2D::AgentSubtree *subtree) {
+	rvo_simulation_2d.kdTree_->buildAgentTreeRecursive(subtree[index].begin, subtree[index].end, subtree[index].node);
+}
+
+void NavMap::build_single_agents_subtree_3d(uint32_t index, RVO3D::KdTree3D::AgentSubtree3D *subtree) {
+	rvo_simulation_3d.kdTree_->buildAgentTreeRecursive(subtree[index].begin, subtree[index].end, subtree[index].node);
 }
 
 void NavMap::_update_rvo_simulation() {
@@ -1319,15 +1685,11 @@ void NavMap::_update_rvo_simulation() {
 void NavMap::compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent) {
 	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
 	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-	(*(agent + index))->update();
 }
 
 void NavMap::compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent) {
 	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
 	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-	(*(agent + index))->update();
 }
 
 void NavMap::step(real_t p_deltatime) {
@@ -1337,6 +1699,9 @@ void NavMap::step(real_t p_deltatime) {
 	rvo_simulation_3d.setTimeStep(float(deltatime));
 
 	if (active_2d_avoidance_agents.size() > 0) {
+		// The agents moved in the last step, the tree is only rebuilt when they change.
+		rvo_simulation_2d.kdTree_->updateAgentPositions();
+
 		if (use_threads && avoidance_use_multiple_threads) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
@@ -1344,13 +1709,19 @@ void NavMap::step(real_t p_deltatime) {
 			for (NavAgent *agent : active_2d_avoidance_agents) {
 				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
 				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-				agent->update();
 			}
 		}
+
+		// Only apply the new velocities once every agent computed its own from the same state.
+		for (NavAgent *agent : active_2d_avoidance_agents) {
+			agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
+			agent->update();
+		}
 	}
 
 	if (active_3d_avoidance_agents.size() > 0) {
+		rvo_simulation_3d.kdTree_->updateAgentPositions();
+
 		if (use_threads && avoidance_use_multiple_threads) {
 			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
@@ -1358,10 +1729,13 @@ void NavMap::step(real_t p_deltatime) {
 			for (NavAgent *agent : active_3d_avoidance_agents) {
 				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
 				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-				agent->update();
 			}
 		}
+
+		for (NavAgent *agent : active_3d_avoidance_agents) {
+			agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
+			agent->update();
+		}
 	}
 }
 
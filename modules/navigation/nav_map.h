@@ -31,11 +31,13 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_polygon_bvh.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_set.h"
 
 #include <KdTree2d.h>
 #include <KdTree3d.h>
@@ -71,6 +73,11 @@ class NavMap : public NavRid {
 	/// This value is used to limit how far links search to find polygons to connect to.
 	real_t link_connection_radius = 1.0;
 
+	/// Search paths between regions over the portals between them first, see `_find_path_corridor()`.
+	bool use_hierarchical_pathfinding = false;
+	/// Lowest travel cost of the regions and links, to keep the portal search heuristic admissible.
+	real_t min_travel_cost = 1.0;
+
 	bool regenerate_polygons = true;
 	bool regenerate_links = true;
 
@@ -84,6 +91,13 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Where the polygons of each enabled region start in `polygons`, to query them with the region's BVH.
+	struct RegionPolygons {
+		NavRegion *region = nullptr;
+		uint32_t first_polygon = 0;
+	};
+	LocalVector<RegionPolygons> region_polygons;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -95,6 +109,10 @@ class NavMap : public NavRid {
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
+	/// Subtrees of the agent kd-trees left to build in parallel
+	std::vector<RVO2D::KdTree2D::AgentSubtree> rvo_agent_subtrees_2d;
+	std::vector<RVO3D::KdTree3D::AgentSubtree3D> rvo_agent_subtrees_3d;
+
 	/// All the Agents (even the controlled one)
 	LocalVector<NavAgent *> agents;
 
@@ -163,6 +181,11 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
 	gd::PointKey get_point_key(const Vector3 &p_pos) const;
 
 	Vector<Vector3> get_path(Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
@@ -222,6 +245,16 @@ private:
 
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
+	void build_single_agents_subtree_2d(uint32_t index, RVO2D::KdTree2D::AgentSubtree *subtree);
+	void build_single_agents_subtree_3d(uint32_t index, RVO3D::KdTree3D::AgentSubtree3D *subtree);
+
+	void _find_closest_polygon_point(const Vector3 &p_point, gd::ClosestPolygonPoint &r_closest, bool p_filter_layers = false, uint32_t p_navigation_layers = 0) const;
+
+	const RegionPolygons *_get_region_polygons(const gd::Polygon *p_polygon) const;
+	void _compute_portal_distances(uint32_t p_polygon, const RegionPolygons &p_region, LocalVector<real_t> &r_distances) const;
+	const real_t *_get_portal_distances(uint32_t p_portal, const RegionPolygons &p_region) const;
+	bool _find_path_corridor(const gd::Polygon *p_begin_poly, const gd::Polygon *p_end_poly, uint32_t p_navigation_layers, HashSet<const NavBase *> &r_corridor) const;
+	void _update_portals();
 
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
@@ -0,0 +1,181 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_polygon_bvh.h"
+
+#include "core/math/face3.h"
+#include "core/templates/sort_array.h"
+
+using namespace gd;
+
+struct PolygonCenterComparator {
+	const Vector3 *centers = nullptr;
+	int axis = 0;
+
+	_FORCE_INLINE_ bool operator()(uint32_t p_a, uint32_t p_b) const {
+		return centers[p_a][axis] < centers[p_b][axis];
+	}
+};
+
+void PolygonBVH::_build_node(uint32_t p_node, uint32_t p_begin, uint32_t p_end, const LocalVector<AABB> &p_aabbs, const LocalVector<Vector3> &p_centers) {
+	AABB aabb = p_aabbs[indices[p_begin]];
+	AABB center_bounds(p_centers[indices[p_begin]], Vector3());
+	for (uint32_t i = p_begin + 1; i < p_end; i++) {
+		aabb.merge_with(p_aabbs[indices[i]]);
+		center_bounds.expand_to(p_centers[indices[i]]);
+	}
+	nodes[p_node].aabb = aabb;
+
+	if (p_end - p_begin <= LEAF_SIZE) {
+		nodes[p_node].first = p_begin;
+		nodes[p_node].count = p_end - p_begin;
+		return;
+	}
+
+	// Split at the median polygon along the longest axis.
+	SortArray<uint32_t, PolygonCenterComparator> sorter;
+	sorter.compare.centers = p_centers.ptr();
+	sorter.compare.axis = center_bounds.get_longest_axis_index();
+	uint32_t middle = (p_begin + p_end) / 2;
+	sorter.nth_element(p_begin, p_end, middle, indices.ptr());
+
+	uint32_t first_child = nodes.size();
+	nodes.resize(first_child + 2);
+	nodes[p_node].first = first_child;
+	nodes[p_node].count = 0;
+
+	_build_node(first_child, p_begin, middle, p_aabbs, p_centers);
+	_build_node(first_child + 1, middle, p_end, p_aabbs, p_centers);
+}
+
+void PolygonBVH::build(const LocalVector<Polygon> &p_polygons) {
+	clear();
+
+	LocalVector<AABB> aabbs;
+	LocalVector<Vector3> centers;
+	aabbs.resize(p_polygons.size());
+	centers.resize(p_polygons.size());
+
+	for (uint32_t i = 0; i < p_polygons.size(); i++) {
+		const Polygon &polygon = p_polygons[i];
+		if (polygon.points.size() < 3) {
+			continue; // No faces to query.
+		}
+
+		AABB aabb(polygon.points[0].pos, Vector3());
+		for (uint32_t j = 1; j < polygon.points.size(); j++) {
+			aabb.expand_to(polygon.points[j].pos);
+		}
+		aabbs[i] = aabb;
+		centers[i] = aabb.get_center();
+		indices.push_back(i);
+	}
+
+	if (indices.is_empty()) {
+		return;
+	}
+
+	nodes.reserve(indices.size() / LEAF_SIZE * 2 + 1);
+	nodes.resize(1);
+	_build_node(0, 0, indices.size(), aabbs, centers);
+}
+
+void PolygonBVH::clear() {
+	nodes.clear();
+	indices.clear();
+}
+
+real_t PolygonBVH::get_aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point) {
+	const Vector3 end = p_aabb.position + p_aabb.size;
+	real_t distance_squared = 0.0;
+	for (int i = 0; i < 3; i++) {
+		if (p_point[i] < p_aabb.position[i]) {
+			distance_squared += (p_aabb.position[i] - p_point[i]) * (p_aabb.position[i] - p_point[i]);
+		} else if (p_point[i] > end[i]) {
+			distance_squared += (p_point[i] - end[i]) * (p_point[i] - end[i]);
+		}
+	}
+	return distance_squared;
+}
+
+void PolygonBVH::closest_point_query(const Polygon *p_polygons, const Vector3 &p_point, ClosestPolygonPoint &r_closest) const {
+	// Nodes as far as the closest point are still visited: on ties, the polygon first in memory wins,
+	// which gives the same result as testing all of them in order. Before any polygon is found, the
+	// initial distance is an inclusive bound, so points exactly at a search radius are accepted.
+	if (nodes.is_empty() || get_aabb_distance_squared(nodes[0].aabb, p_point) > r_closest.distance_squared) {
+		return;
+	}
+
+	// The depth of the hierarchy is logarithmic, this is enough for any polygon count.
+	uint32_t stack[64];
+	uint32_t stack_size = 0;
+	stack[stack_size++] = 0;
+
+	while (stack_size > 0) {
+		const Node &node = nodes[stack[--stack_size]];
+		if (get_aabb_distance_squared(node.aabb, p_point) > r_closest.distance_squared) {
+			continue; // A closer point was found since it was pushed.
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				const Polygon &polygon = p_polygons[indices[i]];
+				for (uint32_t point_id = 2; point_id < polygon.points.size(); point_id++) {
+					const Face3 face(polygon.points[0].pos, polygon.points[point_id - 1].pos, polygon.points[point_id].pos);
+					const Vector3 point = face.get_closest_point_to(p_point);
+					const real_t distance_squared = point.distance_squared_to(p_point);
+					if (distance_squared < r_closest.distance_squared || (distance_squared == r_closest.distance_squared && (!r_closest.polygon || &polygon < r_closest.polygon))) {
+						r_closest.polygon = &polygon;
+						r_closest.point = point;
+						r_closest.normal = face.get_plane().normal;
+						r_closest.distance_squared = distance_squared;
+					}
+				}
+			}
+			continue;
+		}
+
+		// Visit the nearest child first, it is more likely to shrink the search distance.
+		uint32_t near = node.first;
+		uint32_t far = node.first + 1;
+		real_t near_distance = get_aabb_distance_squared(nodes[near].aabb, p_point);
+		real_t far_distance = get_aabb_distance_squared(nodes[far].aabb, p_point);
+		if (far_distance < near_distance) {
+			SWAP(near, far);
+			SWAP(near_distance, far_distance);
+		}
+		if (far_distance <= r_closest.distance_squared) {
+			stack[stack_size++] = far;
+		}
+		if (near_distance <= r_closest.distance_squared) {
+			stack[stack_size++] = near;
+		}
+	}
+}
@@ -0,0 +1,84 @@
+/**************************************************************************/
+/*  nav_polygon_bvh.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_POLYGON_BVH_H
+#define NAV_POLYGON_BVH_H
+
+#include "nav_utils.h"
+
+#include "core/math/aabb.h"
+
+namespace gd {
+
+struct ClosestPolygonPoint {
+	const Polygon *polygon = nullptr;
+	Vector3 point;
+	Vector3 normal;
+	real_t distance_squared = FLT_MAX;
+};
+
+/// Bounding volume hierarchy over the polygons of a region, so closest point
+/// queries don't need to test every polygon face.
+class PolygonBVH {
+	enum {
+		LEAF_SIZE = 4,
+	};
+
+	struct Node {
+		AABB aabb;
+		/// First child for internal nodes, the second one follows it.
+		/// First entry in `indices` for leaves.
+		uint32_t first = 0;
+		/// Number of polygons of leaves, 0 for internal nodes.
+		uint32_t count = 0;
+	};
+
+	LocalVector<Node> nodes;
+	LocalVector<uint32_t> indices;
+
+	void _build_node(uint32_t p_node, uint32_t p_begin, uint32_t p_end, const LocalVector<AABB> &p_aabbs, const LocalVector<Vector3> &p_centers);
+
+public:
+	void build(const LocalVector<Polygon> &p_polygons);
+	void clear();
+
+	bool is_empty() const { return nodes.is_empty(); }
+	AABB get_aabb() const { return nodes.is_empty() ? AABB() : nodes[0].aabb; }
+
+	/// Updates `r_closest` if a face of the polygons is closer to `p_point`.
+	/// `p_polygons` must have the layout of the polygons the hierarchy was built from.
+	void closest_point_query(const Polygon *p_polygons, const Vector3 &p_point, ClosestPolygonPoint &r_closest) const;
+
+	static real_t get_aabb_distance_squared(const AABB &p_aabb, const Vector3 &p_point);
+};
+
+} // namespace gd
+
+#endif // NAV_POLYGON_BVH_H
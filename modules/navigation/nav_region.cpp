@@ -206,6 +206,37 @@ Vector3 NavRegion::get_random_point(uint32_t p_navigation_layers, bool p_uniform
 	}
 }
 
+void NavRegion::set_portals(const LocalVector<uint32_t> &p_portals) {
+	if (portals.size() == p_portals.size() && memcmp(portals.ptr(), p_portals.ptr(), portals.size() * sizeof(uint32_t)) == 0) {
+		return; // Keep the distances computed so far.
+	}
+	portals = p_portals;
+
+	MutexLock lock(portal_distances_mutex);
+	portal_distances.resize(portals.size() * portals.size());
+	portal_distances_computed.resize(portals.size());
+	memset(portal_distances_computed.ptr(), 0, portal_distances_computed.size());
+}
+
+const real_t *NavRegion::get_portal_distances(uint32_t p_portal) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_portal, portals.size(), nullptr);
+	MutexLock lock(portal_distances_mutex);
+	return portal_distances_computed[p_portal] ? &portal_distances[p_portal * portals.size()] : nullptr;
+}
+
+const real_t *NavRegion::set_portal_distances(uint32_t p_portal, const LocalVector<real_t> &p_distances) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_portal, portals.size(), nullptr);
+	ERR_FAIL_COND_V(p_distances.size() != portals.size(), nullptr);
+	MutexLock lock(portal_distances_mutex);
+	real_t *row = &portal_distances[p_portal * portals.size()];
+	// Another query may have computed the same distances in the meantime, rows are never written twice.
+	if (!portal_distances_computed[p_portal]) {
+		memcpy(row, p_distances.ptr(), portals.size() * sizeof(real_t));
+		portal_distances_computed[p_portal] = 1;
+	}
+	return row;
+}
+
 bool NavRegion::sync() {
 	bool something_changed = polygons_dirty /* || something_dirty? */;
 
@@ -219,6 +250,8 @@ void NavRegion::update_polygons() {
 		return;
 	}
 	polygons.clear();
+	polygons_bvh.clear();
+	set_portals(LocalVector<uint32_t>());
 	surface_area = 0.0;
 	polygons_dirty = false;
 
@@ -312,4 +345,7 @@ void NavRegion::update_polygons() {
 	}
 
 	surface_area = _new_region_surface_area;
+
+	// Only rebuilt when the polygons of this region change.
+	polygons_bvh.build(polygons);
 }
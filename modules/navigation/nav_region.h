@@ -32,8 +32,10 @@
 #define NAV_REGION_H
 
 #include "nav_base.h"
+#include "nav_polygon_bvh.h"
 #include "nav_utils.h"
 
+#include "core/os/mutex.h"
 #include "core/os/rw_lock.h"
 #include "scene/resources/navigation_mesh.h"
 
@@ -49,6 +51,15 @@ class NavRegion : public NavBase {
 
 	/// Cache
 	LocalVector<gd::Polygon> polygons;
+	gd::PolygonBVH polygons_bvh;
+
+	/// Polygons connected to other regions or to links, set by the map when it uses hierarchical pathfinding.
+	LocalVector<uint32_t> portals;
+	/// Distances walked inside the region between each pair of portals, one row per portal,
+	/// filled on demand by the path queries of the map and cleared with the polygons or portals.
+	mutable BinaryMutex portal_distances_mutex;
+	mutable LocalVector<real_t> portal_distances;
+	mutable LocalVector<uint8_t> portal_distances_computed;
 
 	real_t surface_area = 0.0;
 
@@ -96,6 +107,18 @@ public:
 		return polygons;
 	}
 
+	const gd::PolygonBVH &get_polygons_bvh() const {
+		return polygons_bvh;
+	}
+
+	void set_portals(const LocalVector<uint32_t> &p_portals);
+	const LocalVector<uint32_t> &get_portals() const {
+		return portals;
+	}
+
+	const real_t *get_portal_distances(uint32_t p_portal) const;
+	const real_t *set_portal_distances(uint32_t p_portal, const LocalVector<real_t> &p_distances) const;
+
 	Vector3 get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const;
 
 	real_t get_surface_area() const { return surface_area; };
@@ -0,0 +1,93 @@
+/**************************************************************************/
+/*  test_nav_mesh_generator_3d.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_MESH_GENERATOR_3D_H
+#define TEST_NAV_MESH_GENERATOR_3D_H
+
+#ifndef _3D_DISABLED
+
+#include "../3d/nav_mesh_generator_3d.h"
+
+#include "scene/resources/3d/primitive_meshes.h"
+#include "scene/resources/navigation_mesh.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavMeshGenerator3D {
+
+// A 40 by 40 ground with a box obstacle at p_box_position.
+static Ref<NavigationMeshSourceGeometryData3D> create_box_source_geometry(const Vector3 &p_box_position) {
+	Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+	Array arr;
+	arr.resize(RS::ARRAY_MAX);
+	BoxMesh::create_mesh_array(arr, Vector3(40.0, 0.001, 40.0));
+	source_geometry->add_mesh_array(arr, Transform3D(Basis(), Vector3(20.0, 0, 20.0)));
+
+	arr.clear();
+	arr.resize(RS::ARRAY_MAX);
+	BoxMesh::create_mesh_array(arr, Vector3(2.0, 2.0, 2.0));
+	source_geometry->add_mesh_array(arr, Transform3D(Basis(), p_box_position));
+	return source_geometry;
+}
+
+TEST_CASE("[Navigation][NavMeshGenerator3D] Tiled baking should only rebake the changed tiles") {
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+	navigation_mesh->set_tile_size(10.0);
+
+	NavMeshGenerator3D::bake_from_source_geometry_data(navigation_mesh, create_box_source_geometry(Vector3(15.0, 1.0, 15.0)));
+	const int tile_count = NavMeshGenerator3D::get_baked_tile_count(navigation_mesh);
+	CHECK_GT(tile_count, 1);
+	const int polygon_count = navigation_mesh->get_polygon_count();
+	CHECK_GT(polygon_count, 0);
+
+	NavMeshGenerator3D::bake_from_source_geometry_data(navigation_mesh, create_box_source_geometry(Vector3(15.0, 1.0, 15.0)));
+	CHECK_EQ(NavMeshGenerator3D::get_baked_tile_count(navigation_mesh), 0);
+	CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+
+	// The box stays inside the tile and away from its border.
+	NavMeshGenerator3D::bake_from_source_geometry_data(navigation_mesh, create_box_source_geometry(Vector3(16.0, 1.0, 15.0)));
+	CHECK_EQ(NavMeshGenerator3D::get_baked_tile_count(navigation_mesh), 1);
+
+	SUBCASE("Baking without tiles should drop the tiles") {
+		navigation_mesh->set_tile_size(0.0);
+		NavMeshGenerator3D::bake_from_source_geometry_data(navigation_mesh, create_box_source_geometry(Vector3(16.0, 1.0, 15.0)));
+		CHECK_GT(navigation_mesh->get_polygon_count(), 0);
+
+		navigation_mesh->set_tile_size(10.0);
+		NavMeshGenerator3D::bake_from_source_geometry_data(navigation_mesh, create_box_source_geometry(Vector3(16.0, 1.0, 15.0)));
+		CHECK_EQ(NavMeshGenerator3D::get_baked_tile_count(navigation_mesh), tile_count);
+	}
+}
+
+} // namespace TestNavMeshGenerator3D
+
+#endif // _3D_DISABLED
+
+#endif // TEST_NAV_MESH_GENERATOR_3D_H
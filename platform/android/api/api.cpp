@@ -70,6 +70,7 @@ Variant JavaClass::callp(const StringName &, const Variant **, int, Callable::Ca
 }
 
 JavaClass::JavaClass() {
+	_custom_callp = true;
 }
 
 Variant JavaObject::callp(const StringName &, const Variant **, int, Callable::CallError &) {
@@ -230,6 +230,7 @@ public:
 #endif
 
 	JNISingleton() {
+		_custom_callp = true;
 #ifdef ANDROID_ENABLED
 		instance = nullptr;
 #endif
@@ -496,6 +496,7 @@ Variant JavaClass::callp(const StringName &p_method, const Variant **p_args, int
 }
 
 JavaClass::JavaClass() {
+	_custom_callp = true;
 }
 
 /////////////////////
@@ -505,6 +506,7 @@ Variant JavaObject::callp(const StringName &p_method, const Variant **p_args, in
 }
 
 JavaObject::JavaObject(const Ref<JavaClass> &p_base, jobject *p_instance) {
+	_custom_callp = true;
 }
 
 JavaObject::~JavaObject() {
@@ -107,25 +107,47 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		return;
 	}
 
-	for (Node3D *&E : data.children) {
-		if (E->data.top_level) {
-			continue; //don't propagate to a top_level
+	// Walks the subtree with a stack instead of recursing, as hierarchies can be large.
+	// Children are still visited first and in order, so nodes are added to `xform_change_list`
+	// (and notified) in the same order as the recursive version did.
+	struct StackEntry {
+		Node3D *node = nullptr;
+		bool children_pushed = false;
+	};
+	static thread_local LocalVector<StackEntry> stack;
+	const uint32_t base = stack.size();
+	stack.push_back({ this, false });
+
+	while (stack.size() > base) {
+		StackEntry &entry = stack[stack.size() - 1];
+		Node3D *n = entry.node;
+		if (!entry.children_pushed) {
+			entry.children_pushed = true;
+			// In reverse, so the first child is on top.
+			for (List<Node3D *>::Element *E = n->data.children.back(); E; E = E->prev()) {
+				if (E->get()->data.top_level) {
+					continue; //don't propagate to a top_level
+				}
+				stack.push_back({ E->get(), false });
+			}
+			continue;
 		}
-		E->_propagate_transform_changed(p_origin);
-	}
+		stack.resize(stack.size() - 1);
+
 #ifdef TOOLS_ENABLED
-	if ((!data.gizmos.is_empty() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
+		if ((!n->data.gizmos.is_empty() || n->data.notify_transform) && !n->data.ignore_notification && !n->xform_change.in_list()) {
 #else
-	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
+		if (n->data.notify_transform && !n->data.ignore_notification && !n->xform_change.in_list()) {
 #endif
-		if (likely(is_accessible_from_caller_thread())) {
-			get_tree()->xform_change_list.add(&xform_change);
-		} else {
-			// This should very rarely happen, but if it does at least make sure the notification is received eventually.
-			callable_mp(this, &Node3D::_propagate_transform_changed_deferred).call_deferred();
+			if (likely(n->is_accessible_from_caller_thread() && !is_auto_thread_partition_processing())) {
+				get_tree()->xform_change_list.add(&n->xform_change);
+			} else {
+				// This should very rarely happen, but if it does at least make sure the notification is received eventually.
+				callable_mp(n, &Node3D::_propagate_transform_changed_deferred).call_deferred();
+			}
 		}
+		n->_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM);
 	}
-	_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM);
 }
 
 void Node3D::_notification(int p_what) {
@@ -48,6 +48,7 @@
 int Node::orphan_node_count = 0;
 
 thread_local Node *Node::current_process_thread_group = nullptr;
+thread_local Node *Node::current_auto_thread_partition = nullptr;
 
 void Node::_notification(int p_notification) {
 	switch (p_notification) {
@@ -545,6 +546,13 @@ void Node::owner_changed_notify() {
 
 void Node::_physics_interpolated_changed() {}
 
+void Node::_signal_connections_changed() {
+	// Connections decide which subtrees can be processed on their own thread.
+	if (data.tree && data.tree->auto_thread_partitioning) {
+		data.tree->_queue_auto_thread_partition_check(this);
+	}
+}
+
 void Node::set_physics_process(bool p_process) {
 	ERR_THREAD_GUARD
 	if (data.physics_process == p_process) {
@@ -980,6 +988,25 @@ void Node::set_process_internal(bool p_process_internal) {
 	}
 }
 
+bool Node::_is_in_current_auto_thread_partition() const {
+	if (!data.inside_tree) {
+		return true;
+	}
+	const Node *n = this;
+	while (n) {
+		if (n == current_auto_thread_partition) {
+			return true;
+		}
+		n = n->data.parent;
+	}
+	return false;
+}
+
+void Node::_report_auto_thread_partition_violation(const char *p_access) const {
+	ERR_FAIL_NULL(current_auto_thread_partition);
+	data.tree->_report_auto_thread_partition_violation(current_auto_thread_partition, this, p_access);
+}
+
 void Node::_add_process_group() {
 	get_tree()->_add_process_group(this);
 }
@@ -1771,6 +1798,10 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 		current = next;
 	}
 
+	if (unlikely(current_auto_thread_partition != nullptr) && current && !current->_is_in_current_auto_thread_partition()) {
+		current->_report_auto_thread_partition_violation("get_node");
+	}
+
 	return current;
 }
 
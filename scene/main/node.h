@@ -306,6 +306,10 @@ private:
 	void _add_tree_to_process_thread_group(Node *p_owner);
 
 	static thread_local Node *current_process_thread_group;
+	static thread_local Node *current_auto_thread_partition; // Root of the subtree being processed by SceneTree automatic thread partitioning.
+
+	bool _is_in_current_auto_thread_partition() const;
+	void _report_auto_thread_partition_violation(const char *p_access) const;
 
 	Variant _call_deferred_thread_group_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Variant _call_thread_safe_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
@@ -317,6 +321,7 @@ protected:
 	void _notification(int p_notification);
 
 	virtual void _physics_interpolated_changed();
+	virtual void _signal_connections_changed() override;
 
 	virtual void add_child_notify(Node *p_child);
 	virtual void remove_child_notify(Node *p_child);
@@ -581,6 +586,10 @@ public:
 	}
 	_FORCE_INLINE_ bool is_accessible_from_caller_thread() const {
 		if (current_process_thread_group == nullptr) {
+			if (unlikely(current_auto_thread_partition != nullptr)) {
+				// Automatic thread partitioning, only the partition subtree can be accessed.
+				return _is_in_current_auto_thread_partition();
+			}
 			// No thread processing.
 			// Only accessible if node is outside the scene tree
 			// or access will happen from a node-safe thread.
@@ -593,6 +602,10 @@ public:
 
 	_FORCE_INLINE_ bool is_readable_from_caller_thread() const {
 		if (current_process_thread_group == nullptr) {
+			if (unlikely(current_auto_thread_partition != nullptr)) {
+				// Automatic thread partitioning, same as thread processing.
+				return true;
+			}
 			// No thread processing.
 			// Only accessible if node is outside the scene tree
 			// or access will happen from a node-safe thread.
@@ -603,7 +616,19 @@ public:
 		}
 	}
 
-	_FORCE_INLINE_ static bool is_group_processing() { return current_process_thread_group; }
+	_FORCE_INLINE_ static bool is_group_processing() { return current_process_thread_group || current_auto_thread_partition; }
+	_FORCE_INLINE_ static bool is_auto_thread_partition_processing() { return current_auto_thread_partition; }
+
+	// Used by the thread guards, also reports accesses that break automatic thread partitioning.
+	_FORCE_INLINE_ bool _check_thread_guard() const {
+		if (likely(is_accessible_from_caller_thread())) {
+			return true;
+		}
+		if (current_auto_thread_partition != nullptr) {
+			_report_auto_thread_partition_violation("call");
+		}
+		return false;
+	}
 
 	void set_process_thread_messages(BitField<ProcessThreadMessages> p_flags);
 	BitField<ProcessThreadMessages> get_process_thread_messages() const;
@@ -798,8 +823,8 @@ Error Node::rpc_id(int p_peer_id, const StringName &p_method, VarArgs... p_args)
 }
 
 #ifdef DEBUG_ENABLED
-#define ERR_THREAD_GUARD ERR_FAIL_COND_MSG(!is_accessible_from_caller_thread(), vformat("Caller thread can't call this function in this node (%s). Use call_deferred() or call_thread_group() instead.", get_description()));
-#define ERR_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!is_accessible_from_caller_thread(), (m_ret), vformat("Caller thread can't call this function in this node (%s). Use call_deferred() or call_thread_group() instead.", get_description()));
+#define ERR_THREAD_GUARD ERR_FAIL_COND_MSG(!_check_thread_guard(), vformat("Caller thread can't call this function in this node (%s). Use call_deferred() or call_thread_group() instead.", get_description()));
+#define ERR_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!_check_thread_guard(), (m_ret), vformat("Caller thread can't call this function in this node (%s). Use call_deferred() or call_thread_group() instead.", get_description()));
 #define ERR_MAIN_THREAD_GUARD ERR_FAIL_COND_MSG(is_inside_tree() && !is_current_thread_safe_for_nodes(), vformat("This function in this node (%s) can only be accessed from the main thread. Use call_deferred() instead.", get_description()));
 #define ERR_MAIN_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(is_inside_tree() && !is_current_thread_safe_for_nodes(), (m_ret), vformat("This function in this node (%s) can only be accessed from the main thread. Use call_deferred() instead.", get_description()));
 #define ERR_READ_THREAD_GUARD ERR_FAIL_COND_MSG(!is_readable_from_caller_thread(), vformat("This function in this node (%s) can only be accessed from either the main thread or a thread group. Use call_deferred() instead.", get_description()));
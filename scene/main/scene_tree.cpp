@@ -59,6 +59,7 @@
 #include "servers/navigation_server_3d.h"
 #include "servers/physics_server_2d.h"
 #ifndef _3D_DISABLED
+#include "scene/3d/node_3d.h"
 #include "scene/resources/3d/world_3d.h"
 #include "servers/physics_server_3d.h"
 #endif // _3D_DISABLED
@@ -123,6 +124,9 @@ void SceneTree::tree_changed() {
 }
 
 void SceneTree::node_added(Node *p_node) {
+	if (auto_thread_partitioning) {
+		_queue_auto_thread_partition_check(p_node);
+	}
 	emit_signal(node_added_name, p_node);
 }
 
@@ -131,6 +135,11 @@ void SceneTree::node_removed(Node *p_node) {
 	if (current_scene == p_node) {
 		current_scene = nullptr;
 	}
+	if (auto_thread_partitioning) {
+		// Its connections may have kept the rest of the partition in the main thread.
+		_queue_auto_thread_partition_check(p_node);
+		auto_thread_partition_roots.erase(p_node);
+	}
 	emit_signal(node_removed_name, p_node);
 	if (nodes_removed_on_group_call_lock) {
 		nodes_removed_on_group_call.insert(p_node);
@@ -149,10 +158,40 @@ SceneTree::Group *SceneTree::add_to_group(const StringName &p_group, Node *p_nod
 		E = group_map.insert(p_group, Group());
 	}
 
-	ERR_FAIL_COND_V_MSG(E->value.nodes.has(p_node), &E->value, "Already in group: " + p_group + ".");
-	E->value.nodes.push_back(p_node);
-	E->value.changed = true;
-	return &E->value;
+	Group &g = E->value;
+	ERR_FAIL_COND_V_MSG(g.nodes.has(p_node), &g, "Already in group: " + p_group + ".");
+	if (!g.changed && p_node->is_inside_tree()) {
+		// Keep the group sorted instead of resorting it on the next call.
+		_insert_in_group_order(g, p_node);
+	} else {
+		g.nodes.push_back(p_node);
+		g.changed = true;
+	}
+	g.version = ++group_version;
+	return &g;
+}
+
+void SceneTree::_insert_in_group_order(Group &g, Node *p_node) {
+	int count = g.nodes.size();
+	const Node *const *gr_nodes = g.nodes.ptr();
+
+	// Nodes usually enter the tree in hierarchy order, so check the end first.
+	if (count == 0 || p_node->is_greater_than(gr_nodes[count - 1])) {
+		g.nodes.push_back(p_node);
+		return;
+	}
+
+	int lo = 0;
+	int hi = count - 1;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (gr_nodes[mid]->is_greater_than(p_node)) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
+		}
+	}
+	g.nodes.insert(lo, p_node);
 }
 
 void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
@@ -164,6 +203,8 @@ void SceneTree::remove_from_group(const StringName &p_group, Node *p_node) {
 	E->value.nodes.erase(p_node);
 	if (E->value.nodes.is_empty()) {
 		group_map.remove(E);
+	} else {
+		E->value.version = ++group_version;
 	}
 }
 
@@ -175,9 +216,100 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 	}
 }
 
+// Levels with fewer nodes than this are updated in the main thread.
+#define XFORM_CHANGE_THREADED_LEVEL_MIN 2048
+
+static bool _is_node_3d(Node *p_node) {
+#ifndef _3D_DISABLED
+	return Object::cast_to<Node3D>(p_node) != nullptr;
+#else
+	return false;
+#endif // _3D_DISABLED
+}
+
+static void _update_global_transform(Node *p_node) {
+#ifndef _3D_DISABLED
+	Node3D *node_3d = Object::cast_to<Node3D>(p_node);
+	if (node_3d) {
+		node_3d->get_global_transform();
+		return;
+	}
+#endif // _3D_DISABLED
+	CanvasItem *canvas_item = Object::cast_to<CanvasItem>(p_node);
+	if (canvas_item) {
+		canvas_item->get_global_transform();
+	}
+}
+
+void SceneTree::_update_xform_change_global_thread(uint32_t p_index, Node *const *p_nodes) {
+#ifndef _3D_DISABLED
+	static_cast<Node3D *>(p_nodes[p_index])->get_global_transform();
+#endif // _3D_DISABLED
+}
+
+void SceneTree::_update_xform_change_globals() {
+	// Global transforms are computed lazily, walking up to the first valid parent.
+	// Updating all notified nodes by depth, parents before children, makes each one a single multiplication.
+	int max_depth = -1;
+	uint32_t count = 0;
+	for (SelfList<Node> *n = xform_change_list.first(); n; n = n->next()) {
+		max_depth = MAX(max_depth, n->self()->data.depth);
+		count++;
+	}
+	if (count < 2) {
+		return;
+	}
+
+	// Counting sort, 3D nodes go first in each level so they can be split off for threads.
+	const uint32_t level_count = max_depth + 1;
+	xform_change_depth_offsets.resize(level_count * 2 + 1);
+	memset(xform_change_depth_offsets.ptr(), 0, xform_change_depth_offsets.size() * sizeof(uint32_t));
+	for (SelfList<Node> *n = xform_change_list.first(); n; n = n->next()) {
+		xform_change_depth_offsets[n->self()->data.depth * 2 + (_is_node_3d(n->self()) ? 0 : 1) + 1]++;
+	}
+	for (uint32_t i = 1; i < xform_change_depth_offsets.size(); i++) {
+		xform_change_depth_offsets[i] += xform_change_depth_offsets[i - 1];
+	}
+	xform_change_sorted.resize(count);
+	for (SelfList<Node> *n = xform_change_list.first(); n; n = n->next()) {
+		// Offsets are moved while filling, they end up at the start of the next bucket.
+		xform_change_sorted[xform_change_depth_offsets[n->self()->data.depth * 2 + (_is_node_3d(n->self()) ? 0 : 1)]++] = n->self();
+	}
+
+	Node **sorted = xform_change_sorted.ptr();
+	uint32_t from = 0;
+	for (uint32_t level = 0; level < level_count; level++) {
+		const uint32_t end_3d = xform_change_depth_offsets[level * 2];
+		const uint32_t end = xform_change_depth_offsets[level * 2 + 1];
+
+#ifndef _3D_DISABLED
+		if (end_3d - from >= XFORM_CHANGE_THREADED_LEVEL_MIN && !node_threading_disabled) {
+			// Parents not in this batch may still be dirty, update them first so each thread only writes its own node.
+			for (uint32_t i = from; i < end_3d; i++) {
+				Node3D *node_3d = static_cast<Node3D *>(sorted[i]);
+				Node3D *parent = node_3d->get_parent_node_3d();
+				if (parent && !node_3d->is_set_as_top_level()) {
+					parent->get_global_transform();
+				}
+			}
+			WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_update_xform_change_global_thread, (Node *const *)sorted + from, end_3d - from, -1, true);
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+			from = end_3d;
+		}
+#endif // _3D_DISABLED
+
+		for (uint32_t i = from; i < end; i++) {
+			_update_global_transform(sorted[i]);
+		}
+		from = end;
+	}
+}
+
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+	_update_xform_change_globals();
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -223,6 +355,7 @@ void SceneTree::_update_group_order(Group &g) {
 	node_sort.sort(gr_nodes, gr_node_count);
 
 	g.changed = false;
+	g.version = ++group_version;
 }
 
 void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_group, const StringName &p_function, const Variant **p_args, int p_argcount) {
@@ -264,7 +397,8 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 		nodes_copy = g.nodes;
 	}
 
-	Node **gr_nodes = nodes_copy.ptrw();
+	// Read-only access shares the group's storage, it is only copied if the group changes during the call.
+	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
 	{
@@ -328,7 +462,7 @@ void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_gr
 		nodes_copy = g.nodes;
 	}
 
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
 	{
@@ -390,7 +524,7 @@ void SceneTree::set_group_flags(uint32_t p_call_flags, const StringName &p_group
 
 		nodes_copy = g.nodes;
 	}
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 	int gr_node_count = nodes_copy.size();
 
 	{
@@ -508,6 +642,12 @@ bool SceneTree::process(double p_time) {
 		_quit = true;
 	}
 
+	if (auto_thread_partitioning) {
+		MutexLock lock(auto_thread_violation_mutex);
+		auto_thread_violations_last_frame = auto_thread_violations;
+		auto_thread_violations.clear();
+	}
+
 	process_time = p_time;
 
 	if (multiplayer_poll) {
@@ -921,22 +1061,36 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 		if (p_group->physics_node_order_dirty) {
 			nodes.sort_custom<Node::ComparatorWithPhysicsPriority>();
 			p_group->physics_node_order_dirty = false;
+			if (p_group == &default_process_group) {
+				auto_thread_partition_nodes_dirty.set();
+				auto_thread_partitions_dirty.set();
+			}
 		}
 	} else {
 		if (p_group->node_order_dirty) {
 			nodes.sort_custom<Node::ComparatorWithPriority>();
 			p_group->node_order_dirty = false;
+			if (p_group == &default_process_group) {
+				auto_thread_partition_nodes_dirty.set();
+				auto_thread_partitions_dirty.set();
+			}
 		}
 	}
 
-	// Make a copy, so if nodes are added/removed from process, this does not break
-	Vector<Node *> nodes_copy = nodes;
+	if (p_group == &default_process_group && auto_thread_partitioning && !node_threading_disabled) {
+		_process_auto_thread_partitions(p_physics);
+	} else {
+		// Make a copy, so if nodes are added/removed from process, this does not break
+		Vector<Node *> nodes_copy = nodes;
+		_process_nodes(nodes_copy.ptr(), nodes_copy.size(), p_physics);
+	}
 
-	uint32_t node_count = nodes_copy.size();
-	Node **nodes_ptr = (Node **)nodes_copy.ptr(); // Force cast, pointer will not change.
+	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
+}
 
-	for (uint32_t i = 0; i < node_count; i++) {
-		Node *n = nodes_ptr[i];
+void SceneTree::_process_nodes(Node *const *p_nodes, uint32_t p_node_count, bool p_physics) {
+	for (uint32_t i = 0; i < p_node_count; i++) {
+		Node *n = p_nodes[i];
 		if (nodes_removed_on_group_call.has(n)) {
 			// Node may have been removed during process, skip it.
 			// Keep in mind removals can only happen on the main thread.
@@ -963,8 +1117,6 @@ void SceneTree::_process_group(ProcessGroup *p_group, bool p_physics) {
 			}
 		}
 	}
-
-	p_group->call_queue.flush(); // Flush messages also after processing (for potential deferred calls).
 }
 
 void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
@@ -973,6 +1125,234 @@ void SceneTree::_process_groups_thread(uint32_t p_index, bool p_physics) {
 	Node::current_process_thread_group = nullptr;
 }
 
+Node *SceneTree::_find_auto_thread_partition_root(Node *p_node) const {
+	if (!current_scene) {
+		return nullptr;
+	}
+	// Nodes outside the current scene, like autoloads, are usually shared and stay in the main thread.
+	Node *n = p_node;
+	while (n && n->data.parent != current_scene) {
+		n = n->data.parent;
+	}
+	return n;
+}
+
+Node *SceneTree::_get_auto_thread_partition_root(Node *p_node) {
+	HashMap<Node *, Node *>::Iterator E = auto_thread_partition_roots.find(p_node);
+	if (E) {
+		return E->value;
+	}
+	Node *root = _find_auto_thread_partition_root(p_node);
+	auto_thread_partition_roots.insert(p_node, root);
+	return root;
+}
+
+bool SceneTree::_is_auto_thread_partition_independent(Node *p_root) const {
+	LocalVector<Node *> stack;
+	stack.push_back(p_root);
+
+	while (!stack.is_empty()) {
+		Node *n = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
+
+		bool inside = n->for_each_connected_object([p_root](Object *p_object) {
+			Node *other = Object::cast_to<Node>(p_object);
+			return other && (other == p_root || p_root->is_ancestor_of(other));
+		});
+		if (!inside) {
+			return false;
+		}
+
+		for (const KeyValue<StringName, Node *> &K : n->data.children) {
+			stack.push_back(K.value);
+		}
+	}
+
+	return true;
+}
+
+bool SceneTree::_is_auto_thread_partition_threaded(Node *p_root) const {
+	return !auto_thread_partitions_demoted.has(p_root->get_instance_id()) && _is_auto_thread_partition_independent(p_root);
+}
+
+void SceneTree::_queue_auto_thread_partition_check(Node *p_node) {
+	// May be called from partition threads, so the root isn't cached here.
+	Node *root = _find_auto_thread_partition_root(p_node);
+	if (!root) {
+		return;
+	}
+	MutexLock lock(auto_thread_violation_mutex);
+	auto_thread_partitions_to_check.insert(root->get_instance_id());
+	auto_thread_partitions_dirty.set();
+}
+
+void SceneTree::_update_auto_thread_partitions() {
+	auto_thread_partitions_dirty.clear();
+
+	if (auto_thread_partition_scene != current_scene) {
+		// Every partition root changes along with the scene.
+		auto_thread_partition_scene = current_scene;
+		auto_thread_partition_roots.clear();
+		auto_thread_partitions.clear();
+		auto_thread_partition_indices.clear();
+		auto_thread_partition_nodes_dirty.set();
+	}
+
+	HashSet<ObjectID> to_check;
+	{
+		MutexLock lock(auto_thread_violation_mutex);
+		to_check = auto_thread_partitions_to_check;
+		auto_thread_partitions_to_check.clear();
+	}
+
+	bool redistribute = auto_thread_partition_nodes_dirty.is_set();
+	auto_thread_partition_nodes_dirty.clear();
+
+	// Only the partitions that changed are scanned for connections crossing their boundary again.
+	for (const ObjectID &id : to_check) {
+		Node *root = Object::cast_to<Node>(ObjectDB::get_instance(id));
+		const uint32_t *index = root ? auto_thread_partition_indices.getptr(root) : nullptr;
+		if (!index) {
+			continue; // Not a partition yet, it's checked if it becomes one below.
+		}
+		AutoThreadPartition &partition = auto_thread_partitions[*index];
+		const bool threaded = _is_auto_thread_partition_threaded(root);
+		if (threaded != partition.threaded) {
+			partition.threaded = threaded;
+			redistribute = true;
+		}
+	}
+
+	if (!redistribute) {
+		return;
+	}
+
+	// Distribute the nodes keeping their process order. Partitions that already existed keep their state.
+	LocalVector<AutoThreadPartition> partitions;
+	HashMap<Node *, uint32_t> partition_indices;
+	auto_thread_main_nodes.clear();
+	auto_thread_main_physics_nodes.clear();
+
+	const Vector<Node *> *node_lists[2] = { &default_process_group.nodes, &default_process_group.physics_nodes };
+	for (int i = 0; i < 2; i++) {
+		Vector<Node *> &main_nodes = i == 0 ? auto_thread_main_nodes : auto_thread_main_physics_nodes;
+		for (Node *n : *node_lists[i]) {
+			Node *partition_root = _get_auto_thread_partition_root(n);
+			if (!partition_root) {
+				main_nodes.push_back(n);
+				continue;
+			}
+			HashMap<Node *, uint32_t>::Iterator E = partition_indices.find(partition_root);
+			if (!E) {
+				AutoThreadPartition partition;
+				partition.root = partition_root;
+				const uint32_t *old_index = auto_thread_partition_indices.getptr(partition_root);
+				partition.threaded = old_index ? auto_thread_partitions[*old_index].threaded : _is_auto_thread_partition_threaded(partition_root);
+				E = partition_indices.insert(partition_root, partitions.size());
+				partitions.push_back(partition);
+			}
+			AutoThreadPartition &partition = partitions[E->value];
+			if (partition.threaded) {
+				(i == 0 ? partition.nodes : partition.physics_nodes).push_back(n);
+			} else {
+				main_nodes.push_back(n);
+			}
+		}
+	}
+
+	auto_thread_partitions = partitions;
+	auto_thread_partition_indices = partition_indices;
+}
+
+void SceneTree::_process_auto_thread_partitions(bool p_physics) {
+	if (auto_thread_partitions_dirty.is_set()) {
+		_update_auto_thread_partitions();
+	}
+
+	// Main thread nodes go first, so they can prepare what the partitions read.
+	const Vector<Node *> &main_nodes = p_physics ? auto_thread_main_physics_nodes : auto_thread_main_nodes;
+	_process_nodes(main_nodes.ptr(), main_nodes.size(), p_physics);
+
+	local_auto_thread_partition_cache.clear();
+	for (uint32_t i = 0; i < auto_thread_partitions.size(); i++) {
+		const AutoThreadPartition &partition = auto_thread_partitions[i];
+		if (!(p_physics ? partition.physics_nodes : partition.nodes).is_empty()) {
+			local_auto_thread_partition_cache.push_back(i);
+		}
+	}
+
+	if (!local_auto_thread_partition_cache.is_empty()) {
+		WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_process_auto_thread_partition_thread, p_physics, local_auto_thread_partition_cache.size(), -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+	}
+}
+
+void SceneTree::_process_auto_thread_partition_thread(uint32_t p_index, bool p_physics) {
+	const AutoThreadPartition &partition = auto_thread_partitions[local_auto_thread_partition_cache[p_index]];
+	const Vector<Node *> &nodes = p_physics ? partition.physics_nodes : partition.nodes;
+	Node::current_auto_thread_partition = partition.root;
+	_process_nodes(nodes.ptr(), nodes.size(), p_physics);
+	Node::current_auto_thread_partition = nullptr;
+}
+
+void SceneTree::_report_auto_thread_partition_violation(Node *p_partition, const Node *p_node, const char *p_access) {
+	MutexLock lock(auto_thread_violation_mutex);
+
+	AutoThreadPartitionViolation violation;
+	violation.partition = p_partition->get_instance_id();
+	violation.node = p_node->get_instance_id();
+	violation.access = p_access;
+	auto_thread_violations.push_back(violation);
+
+	// The partition keeps running on its thread this frame, but moves to the main thread from the next one.
+	if (!auto_thread_partitions_demoted.has(violation.partition)) {
+		auto_thread_partitions_demoted.insert(violation.partition);
+		auto_thread_partitions_to_check.insert(violation.partition);
+		auto_thread_partitions_dirty.set();
+	}
+}
+
+void SceneTree::set_auto_thread_partitioning_enabled(bool p_enabled) {
+	ERR_FAIL_COND_MSG(!Thread::is_main_thread(), "Automatic thread partitioning can only be changed from the main thread.");
+	if (auto_thread_partitioning == p_enabled) {
+		return;
+	}
+	auto_thread_partitioning = p_enabled;
+	auto_thread_partitions_dirty.set();
+	auto_thread_partition_nodes_dirty.set();
+	auto_thread_partitions.clear();
+	auto_thread_partition_indices.clear();
+	auto_thread_partition_roots.clear();
+	auto_thread_main_nodes.clear();
+	auto_thread_main_physics_nodes.clear();
+	auto_thread_partitions_demoted.clear();
+
+	MutexLock lock(auto_thread_violation_mutex);
+	auto_thread_partitions_to_check.clear();
+	auto_thread_violations.clear();
+	auto_thread_violations_last_frame.clear();
+}
+
+bool SceneTree::is_auto_thread_partitioning_enabled() const {
+	return auto_thread_partitioning;
+}
+
+TypedArray<Dictionary> SceneTree::get_auto_thread_partition_report() const {
+	TypedArray<Dictionary> report;
+
+	MutexLock lock(auto_thread_violation_mutex);
+	for (const AutoThreadPartitionViolation &violation : auto_thread_violations_last_frame) {
+		Node *partition = Object::cast_to<Node>(ObjectDB::get_instance(violation.partition));
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(violation.node));
+		Dictionary entry;
+		entry["partition"] = partition && partition->is_inside_tree() ? partition->get_path() : NodePath();
+		entry["node"] = node && node->is_inside_tree() ? node->get_path() : NodePath();
+		entry["access"] = violation.access;
+		report.push_back(entry);
+	}
+	return report;
+}
+
 void SceneTree::_process(bool p_physics) {
 	if (process_groups_dirty) {
 		{
@@ -1132,6 +1512,10 @@ void SceneTree::_add_process_group(Node *p_node) {
 void SceneTree::_remove_node_from_process_group(Node *p_node, Node *p_owner) {
 	_THREAD_SAFE_METHOD_
 	ProcessGroup *pg = p_owner ? (ProcessGroup *)p_owner->data.process_group : &default_process_group;
+	if (pg == &default_process_group) {
+		auto_thread_partition_nodes_dirty.set();
+		auto_thread_partitions_dirty.set();
+	}
 
 	if (p_node->is_processing() || p_node->is_processing_internal()) {
 		bool found = pg->nodes.erase(p_node);
@@ -1147,6 +1531,10 @@ void SceneTree::_remove_node_from_process_group(Node *p_node, Node *p_owner) {
 void SceneTree::_add_node_to_process_group(Node *p_node, Node *p_owner) {
 	_THREAD_SAFE_METHOD_
 	ProcessGroup *pg = p_owner ? (ProcessGroup *)p_owner->data.process_group : &default_process_group;
+	if (pg == &default_process_group) {
+		auto_thread_partition_nodes_dirty.set();
+		auto_thread_partitions_dirty.set();
+	}
 
 	if (p_node->is_processing() || p_node->is_processing_internal()) {
 		pg->nodes.push_back(p_node);
@@ -1181,7 +1569,7 @@ void SceneTree::_call_input_pause(const StringName &p_group, CallInputType p_cal
 	}
 
 	int gr_node_count = nodes_copy.size();
-	Node **gr_nodes = nodes_copy.ptrw();
+	Node *const *gr_nodes = nodes_copy.ptr();
 
 	{
 		_THREAD_SAFE_METHOD_
@@ -1300,7 +1688,7 @@ TypedArray<Node> SceneTree::_get_nodes_in_group(const StringName &p_group) {
 
 	ret.resize(nc);
 
-	Node **ptr = E->value.nodes.ptrw();
+	Node *const *ptr = E->value.nodes.ptr();
 	for (int i = 0; i < nc; i++) {
 		ret[i] = ptr[i];
 	}
@@ -1308,6 +1696,37 @@ TypedArray<Node> SceneTree::_get_nodes_in_group(const StringName &p_group) {
 	return ret;
 }
 
+TypedArray<Node> SceneTree::_get_group_snapshot(const StringName &p_group) {
+	_THREAD_SAFE_METHOD_
+	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
+	if (!E) {
+		TypedArray<Node> ret;
+		ret.make_read_only();
+		return ret;
+	}
+
+	Group &g = E->value;
+	_update_group_order(g);
+	if (!g.cached_array || g.cached_array_version != g.version) {
+		// Build a new array rather than modifying the cached one, scripts may still hold it.
+		TypedArray<Node> ret;
+		int nc = g.nodes.size();
+		ret.resize(nc);
+		Node *const *ptr = g.nodes.ptr();
+		for (int i = 0; i < nc; i++) {
+			ret[i] = ptr[i];
+		}
+		ret.make_read_only();
+		if (!g.cached_array) {
+			g.cached_array = memnew(TypedArray<Node>);
+		}
+		*g.cached_array = ret;
+		g.cached_array_version = g.version;
+	}
+
+	return *g.cached_array;
+}
+
 bool SceneTree::has_group(const StringName &p_identifier) const {
 	_THREAD_SAFE_METHOD_
 	return group_map.has(p_identifier);
@@ -1351,12 +1770,37 @@ void SceneTree::get_nodes_in_group(const StringName &p_group, List<Node *> *p_li
 	if (nc == 0) {
 		return;
 	}
-	Node **ptr = E->value.nodes.ptrw();
+	Node *const *ptr = E->value.nodes.ptr();
 	for (int i = 0; i < nc; i++) {
 		p_list->push_back(ptr[i]);
 	}
 }
 
+SceneTree::GroupSnapshot SceneTree::get_group_snapshot(const StringName &p_group) {
+	_THREAD_SAFE_METHOD_
+	GroupSnapshot snapshot;
+	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
+	if (!E) {
+		return snapshot;
+	}
+
+	_update_group_order(E->value);
+	snapshot.nodes = E->value.nodes;
+	snapshot.version = E->value.version;
+	return snapshot;
+}
+
+uint64_t SceneTree::get_group_version(const StringName &p_group) {
+	_THREAD_SAFE_METHOD_
+	HashMap<StringName, Group>::Iterator E = group_map.find(p_group);
+	if (!E) {
+		return 0;
+	}
+
+	_update_group_order(E->value); // Apply pending reorders, so they are part of the version.
+	return E->value.version;
+}
+
 void SceneTree::_flush_delete_queue() {
 	_THREAD_SAFE_METHOD_
 
@@ -1616,6 +2060,10 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_physics_interpolation_enabled", "enabled"), &SceneTree::set_physics_interpolation_enabled);
 	ClassDB::bind_method(D_METHOD("is_physics_interpolation_enabled"), &SceneTree::is_physics_interpolation_enabled);
 
+	ClassDB::bind_method(D_METHOD("set_auto_thread_partitioning_enabled", "enabled"), &SceneTree::set_auto_thread_partitioning_enabled);
+	ClassDB::bind_method(D_METHOD("is_auto_thread_partitioning_enabled"), &SceneTree::is_auto_thread_partitioning_enabled);
+	ClassDB::bind_method(D_METHOD("get_auto_thread_partition_report"), &SceneTree::get_auto_thread_partition_report);
+
 	ClassDB::bind_method(D_METHOD("queue_delete", "obj"), &SceneTree::queue_delete);
 
 	MethodInfo mi;
@@ -1640,6 +2088,8 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_group", "group", "property", "value"), &SceneTree::set_group);
 
 	ClassDB::bind_method(D_METHOD("get_nodes_in_group", "group"), &SceneTree::_get_nodes_in_group);
+	ClassDB::bind_method(D_METHOD("get_group_snapshot", "group"), &SceneTree::_get_group_snapshot);
+	ClassDB::bind_method(D_METHOD("get_group_version", "group"), &SceneTree::get_group_version);
 	ClassDB::bind_method(D_METHOD("get_first_node_in_group", "group"), &SceneTree::get_first_node_in_group);
 	ClassDB::bind_method(D_METHOD("get_node_count_in_group", "group"), &SceneTree::get_node_count_in_group);
 
@@ -1668,6 +2118,7 @@ void SceneTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "root", PROPERTY_HINT_RESOURCE_TYPE, "Node", PROPERTY_USAGE_NONE), "", "get_root");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "multiplayer_poll"), "set_multiplayer_poll_enabled", "is_multiplayer_poll_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "physics_interpolation"), "set_physics_interpolation_enabled", "is_physics_interpolation_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "auto_thread_partitioning"), "set_auto_thread_partitioning_enabled", "is_auto_thread_partitioning_enabled");
 
 	ADD_SIGNAL(MethodInfo("tree_changed"));
 	ADD_SIGNAL(MethodInfo("tree_process_mode_changed")); //editor only signal, but due to API hash it can't be removed in run-time
@@ -1706,7 +2157,7 @@ void SceneTree::get_argument_options(const StringName &p_function, int p_idx, Li
 	const String pf = p_function;
 	bool add_options = false;
 	if (p_idx == 0) {
-		add_options = pf == "get_nodes_in_group" || pf == "has_group" || pf == "get_first_node_in_group" || pf == "set_group" || pf == "notify_group" || pf == "call_group" || pf == "add_to_group";
+		add_options = pf == "get_nodes_in_group" || pf == "get_group_snapshot" || pf == "get_group_version" || pf == "has_group" || pf == "get_first_node_in_group" || pf == "set_group" || pf == "notify_group" || pf == "call_group" || pf == "add_to_group";
 	} else if (p_idx == 1) {
 		add_options = pf == "set_group_flags" || pf == "call_group_flags" || pf == "notify_group_flags";
 	}
@@ -1760,6 +2211,7 @@ SceneTree::SceneTree() {
 #endif // _3D_DISABLED
 
 	set_physics_interpolation_enabled(GLOBAL_DEF("physics/common/physics_interpolation", false));
+	set_auto_thread_partitioning_enabled(GLOBAL_DEF("application/run/auto_thread_partitioning", false));
 
 	// Initialize network state.
 	set_multiplayer(MultiplayerAPI::create_default_interface());
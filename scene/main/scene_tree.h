@@ -115,11 +115,69 @@ private:
 
 	bool node_threading_disabled = false;
 
+	// Automatic thread partitioning of the default process group.
+	// Each child subtree of the current scene becomes a partition, processed on a worker thread
+	// unless it has signal connections crossing its boundary or it was caught accessing other nodes.
+	struct AutoThreadPartition {
+		Node *root = nullptr;
+		Vector<Node *> nodes;
+		Vector<Node *> physics_nodes;
+		bool threaded = false;
+	};
+
+	struct AutoThreadPartitionViolation {
+		ObjectID partition;
+		ObjectID node;
+		const char *access = nullptr;
+	};
+
+	bool auto_thread_partitioning = false;
+	SafeFlag auto_thread_partitions_dirty; // Something changed. Also set from partition threads, by violations and connection changes.
+	SafeFlag auto_thread_partition_nodes_dirty; // The process lists changed, nodes must be distributed again.
+	LocalVector<AutoThreadPartition> auto_thread_partitions;
+	HashMap<Node *, uint32_t> auto_thread_partition_indices; // By root.
+	HashMap<Node *, Node *> auto_thread_partition_roots; // Cached root of each node, for the current scene below.
+	Node *auto_thread_partition_scene = nullptr;
+	Vector<Node *> auto_thread_main_nodes; // Nodes that stay in the main thread, in process order.
+	Vector<Node *> auto_thread_main_physics_nodes;
+	LocalVector<uint32_t> local_auto_thread_partition_cache;
+	HashSet<ObjectID> auto_thread_partitions_demoted;
+	HashSet<ObjectID> auto_thread_partitions_to_check; // Roots of partitions whose connections or nodes changed.
+	Mutex auto_thread_violation_mutex; // Also guards `auto_thread_partitions_to_check`.
+	LocalVector<AutoThreadPartitionViolation> auto_thread_violations; // Current frame.
+	LocalVector<AutoThreadPartitionViolation> auto_thread_violations_last_frame;
+
 	struct Group {
 		Vector<Node *> nodes;
 		bool changed = false;
+		uint64_t version = 0; // Changes whenever the members or their order change.
+		// Read-only, valid while cached_array_version matches version. Most groups never get a snapshot,
+		// so it's only allocated by the first one, and copies of the group rebuild their own.
+		TypedArray<Node> *cached_array = nullptr;
+		uint64_t cached_array_version = 0;
+
+		void operator=(const Group &p_other) {
+			nodes = p_other.nodes;
+			changed = p_other.changed;
+			version = p_other.version;
+			cached_array_version = 0;
+			if (cached_array) {
+				memdelete(cached_array);
+				cached_array = nullptr;
+			}
+		}
+
+		Group() {}
+		Group(const Group &p_other) { *this = p_other; }
+		~Group() {
+			if (cached_array) {
+				memdelete(cached_array);
+			}
+		}
 	};
 
+	uint64_t group_version = 0;
+
 	Window *root = nullptr;
 
 	double physics_process_time = 0.0;
@@ -173,8 +231,10 @@ private:
 	void _flush_ugc();
 
 	_FORCE_INLINE_ void _update_group_order(Group &g);
+	void _insert_in_group_order(Group &g, Node *p_node);
 
 	TypedArray<Node> _get_nodes_in_group(const StringName &p_group);
+	TypedArray<Node> _get_group_snapshot(const StringName &p_group);
 
 	Node *current_scene = nullptr;
 	Node *prev_scene = nullptr;
@@ -214,10 +274,21 @@ private:
 	void remove_from_group(const StringName &p_group, Node *p_node);
 	void make_group_changed(const StringName &p_group);
 
+	void _process_nodes(Node *const *p_nodes, uint32_t p_node_count, bool p_physics);
 	void _process_group(ProcessGroup *p_group, bool p_physics);
 	void _process_groups_thread(uint32_t p_index, bool p_physics);
 	void _process(bool p_physics);
 
+	Node *_find_auto_thread_partition_root(Node *p_node) const;
+	Node *_get_auto_thread_partition_root(Node *p_node);
+	bool _is_auto_thread_partition_independent(Node *p_root) const;
+	bool _is_auto_thread_partition_threaded(Node *p_root) const;
+	void _queue_auto_thread_partition_check(Node *p_node);
+	void _update_auto_thread_partitions();
+	void _process_auto_thread_partitions(bool p_physics);
+	void _process_auto_thread_partition_thread(uint32_t p_index, bool p_physics);
+	void _report_auto_thread_partition_violation(Node *p_partition, const Node *p_node, const char *p_access);
+
 	void _remove_process_group(Node *p_node);
 	void _add_process_group(Node *p_node);
 	void _remove_node_from_process_group(Node *p_node, Node *p_owner);
@@ -234,6 +305,13 @@ private:
 
 	SelfList<Node>::List xform_change_list;
 
+	// Nodes of `xform_change_list` sorted by depth, to update their global transforms in batch before notifying them.
+	LocalVector<Node *> xform_change_sorted;
+	LocalVector<uint32_t> xform_change_depth_offsets;
+
+	void _update_xform_change_globals();
+	void _update_xform_change_global_thread(uint32_t p_index, Node *const *p_nodes);
+
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
 #endif
@@ -382,6 +460,16 @@ public:
 	bool has_group(const StringName &p_identifier) const;
 	int get_node_count_in_group(const StringName &p_group) const;
 
+	// Members of a group in scene hierarchy order. The nodes vector shares the group's storage
+	// (copy on write), so taking a snapshot does not allocate and it stays stable if the group changes.
+	struct GroupSnapshot {
+		Vector<Node *> nodes;
+		uint64_t version = 0;
+	};
+
+	GroupSnapshot get_group_snapshot(const StringName &p_group);
+	uint64_t get_group_version(const StringName &p_group);
+
 	//void change_scene(const String& p_path);
 	//Node *get_loaded_scene();
 
@@ -418,6 +506,10 @@ public:
 	static void add_idle_callback(IdleCallback p_callback);
 
 	void set_disable_node_threading(bool p_disable);
+
+	void set_auto_thread_partitioning_enabled(bool p_enabled);
+	bool is_auto_thread_partitioning_enabled() const;
+	TypedArray<Dictionary> get_auto_thread_partition_report() const;
 	//default texture settings
 
 	void set_physics_interpolation_enabled(bool p_enabled);
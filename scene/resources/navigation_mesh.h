@@ -83,6 +83,7 @@ protected:
 	float cell_size = 0.25f; // Must match ProjectSettings default 3D cell_size and NavigationServer NavMap cell_size.
 	float cell_height = 0.25f; // Must match ProjectSettings default 3D cell_height and NavigationServer NavMap cell_height.
 	float border_size = 0.0f;
+	float tile_size = 0.0f;
 	float agent_height = 1.5f;
 	float agent_radius = 0.5f;
 	float agent_max_climb = 0.25f;
@@ -137,6 +138,9 @@ public:
 	void set_border_size(float p_value);
 	float get_border_size() const;
 
+	void set_tile_size(float p_value);
+	float get_tile_size() const;
+
 	void set_agent_height(float p_value);
 	float get_agent_height() const;
 
@@ -205,7 +209,7 @@ public:
 #endif // DEBUG_ENABLED
 
 	NavigationMesh() {}
-	~NavigationMesh() {}
+	~NavigationMesh();
 };
 
 VARIANT_ENUM_CAST(NavigationMesh::SamplePartitionType);
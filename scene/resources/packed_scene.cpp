@@ -34,6 +34,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/missing_resource.h"
 #include "core/io/resource_loader.h"
+#include "core/os/os.h"
 #include "core/templates/local_vector.h"
 #include "scene/2d/node_2d.h"
 #ifndef _3D_DISABLED
@@ -165,6 +166,8 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	LocalVector<DeferredNodePathProperties> deferred_node_paths;
 
+	const InstantiationProgram *program = p_edit_state == GEN_EDIT_STATE_DISABLED ? _get_instantiation_program() : nullptr;
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
 
@@ -191,6 +194,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		Node *node = nullptr;
 		MissingNode *missing_node = nullptr;
 		bool is_inherited_scene = false;
+		bool created_from_type = false;
 
 		if (i == 0 && base_scene_idx >= 0) {
 			// Scene inheritance on root node.
@@ -260,6 +264,7 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			Object *obj = ClassDB::instantiate(snames[n.type]);
 
 			node = Object::cast_to<Node>(obj);
+			created_from_type = node != nullptr;
 
 			if (!node) {
 				if (obj) {
@@ -308,6 +313,11 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 				Dictionary missing_resource_properties;
 				HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_sub_scene; // Record the mappings in the sub-scene.
 
+				const PropertySetter *setters = nullptr;
+				if (program && created_from_type && node->get_class_name() == program->node_classes[i]) {
+					setters = &program->setters[program->node_setters[i]];
+				}
+
 				for (int j = 0; j < nprop_count; j++) {
 					bool valid;
 
@@ -337,6 +347,27 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 					ERR_FAIL_INDEX_V(nprops[j].name, sname_count, nullptr);
 
+					if (setters && setters[j].method && !node->get_script_instance()) {
+						// Values that may hold resources still go through the checks below.
+						const Variant &value = props[nprops[j].value];
+						Variant::Type value_type = value.get_type();
+						if (value_type != Variant::OBJECT && value_type != Variant::ARRAY && value_type != Variant::DICTIONARY) {
+							const PropertySetter &setter = setters[j];
+							bool validated = setter.validated && (setter.type == Variant::NIL || setter.type == value_type);
+							Variant index = setter.index;
+							const Variant *args[2] = { &index, &value };
+							const Variant **argptrs = setter.index >= 0 ? args : args + 1;
+							if (validated) {
+								Variant ret;
+								setter.method->validated_call(node, argptrs, &ret);
+							} else {
+								Callable::CallError ce;
+								setter.method->call(node, argptrs, setter.index >= 0 ? 2 : 1, ce);
+							}
+							continue;
+						}
+					}
+
 					if (snames[nprops[j].name] == CoreStringName(script)) {
 						//work around to avoid old script variables from disappearing, should be the proper fix to:
 						//https://github.com/godotengine/godot/issues/2958
@@ -1215,6 +1246,7 @@ String SceneState::get_path() const {
 }
 
 void SceneState::clear() {
+	_clear_instantiation_program();
 	names.clear();
 	variants.clear();
 	nodes.clear();
@@ -1383,6 +1415,70 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+bool SceneState::use_instantiation_program = true;
+
+void SceneState::set_use_instantiation_program(bool p_enable) {
+	use_instantiation_program = p_enable;
+}
+
+const SceneState::InstantiationProgram *SceneState::_get_instantiation_program() const {
+	if (!use_instantiation_program) {
+		return nullptr;
+	}
+	if (instantiation_program_valid.is_set()) {
+		return &instantiation_program;
+	}
+
+	MutexLock lock(instantiation_program_mutex);
+	if (instantiation_program_valid.is_set()) {
+		return &instantiation_program; // Compiled by another thread meanwhile.
+	}
+
+	InstantiationProgram &program = instantiation_program;
+	program.node_classes.clear();
+	program.node_setters.clear();
+	program.setters.clear();
+	program.node_classes.resize(nodes.size());
+	program.node_setters.resize(nodes.size());
+
+	for (int i = 0; i < nodes.size(); i++) {
+		const NodeData &n = nodes[i];
+		program.node_setters[i] = program.setters.size();
+
+		// Only nodes created from their type have a class known ahead of time.
+		bool created_from_type = n.instance < 0 && n.type != TYPE_INSTANTIATED && !(i == 0 && base_scene_idx >= 0);
+		if (!created_from_type || n.type < 0 || n.type >= names.size()) {
+			continue;
+		}
+		const StringName &class_name = names[n.type];
+		program.node_classes[i] = class_name;
+
+		for (const NodeData::Property &prop : n.properties) {
+			PropertySetter setter;
+			if (!(prop.name & FLAG_PATH_PROPERTY_IS_NODE) && prop.name >= 0 && prop.name < names.size() && names[prop.name] != CoreStringName(script)) {
+				setter.method = ClassDB::get_property_setter_bind(class_name, names[prop.name], &setter.index);
+			}
+			if (setter.method) {
+				int arg_count = setter.index >= 0 ? 2 : 1;
+				setter.validated = !setter.method->is_vararg() && setter.method->get_argument_count() == arg_count && (setter.index < 0 || setter.method->get_argument_type(0) == Variant::INT);
+				setter.type = setter.method->get_argument_type(arg_count - 1);
+			}
+			program.setters.push_back(setter);
+		}
+	}
+
+	instantiation_program_valid.set();
+	return &instantiation_program;
+}
+
+void SceneState::_clear_instantiation_program() {
+	MutexLock lock(instantiation_program_mutex);
+	instantiation_program_valid.clear();
+	instantiation_program.node_classes.clear();
+	instantiation_program.node_setters.clear();
+	instantiation_program.setters.clear();
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
@@ -1432,6 +1528,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_clear_instantiation_program();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -1898,6 +1996,8 @@ int SceneState::add_node_path(const NodePath &p_path) {
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_clear_instantiation_program();
+
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -1923,6 +2023,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	}
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_clear_instantiation_program();
 }
 
 void SceneState::add_node_group(int p_node, int p_group) {
@@ -1934,6 +2035,7 @@ void SceneState::add_node_group(int p_node, int p_group) {
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
 	base_scene_idx = p_idx;
+	_clear_instantiation_program();
 }
 
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, int p_unbinds, const Vector<int> &p_binds) {
@@ -1983,6 +2085,9 @@ bool SceneState::rename_group_references(const StringName &p_old_name, const Str
 			}
 		}
 	}
+	if (edited) {
+		_clear_instantiation_program(); // Names may be shared with properties.
+	}
 	return edited;
 }
 
@@ -2108,6 +2213,23 @@ Node *PackedScene::instantiate(GenEditState p_edit_state) const {
 	return s;
 }
 
+Ref<PackedSceneBatch> PackedScene::instantiate_batch(int p_count, bool p_use_threads) {
+	ERR_FAIL_COND_V(p_count < 0, Ref<PackedSceneBatch>());
+
+	Ref<PackedSceneBatch> batch;
+	batch.instantiate();
+	batch->scene = Ref<PackedScene>(this);
+	batch->count = p_count;
+	batch->instances.reserve(p_count);
+
+	if (p_use_threads && p_count > 0) {
+		batch->started = p_count;
+		batch->group_task = WorkerThreadPool::get_singleton()->add_template_group_task(batch.ptr(), &PackedSceneBatch::_instantiate_thread, (void *)nullptr, p_count, -1, false, "Instantiate " + get_path());
+	}
+
+	return batch;
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
 	state = p_by;
 	state->set_path(get_path());
@@ -2144,6 +2266,7 @@ void PackedScene::reset_state() {
 void PackedScene::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instantiate", "edit_state"), &PackedScene::instantiate, DEFVAL(GEN_EDIT_STATE_DISABLED));
+	ClassDB::bind_method(D_METHOD("instantiate_batch", "count", "use_threads"), &PackedScene::instantiate_batch, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("can_instantiate"), &PackedScene::can_instantiate);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene", "scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
@@ -2160,3 +2283,105 @@ void PackedScene::_bind_methods() {
 PackedScene::PackedScene() {
 	state = Ref<SceneState>(memnew(SceneState));
 }
+
+////////////////
+
+void PackedSceneBatch::_instantiate_one() {
+	Node *node = scene->instantiate();
+	if (node) {
+		MutexLock lock(mutex);
+		instances.push_back(node);
+	}
+	finished_count.increment();
+}
+
+void PackedSceneBatch::_instantiate_thread(uint32_t p_index, void *p_userdata) {
+	_instantiate_one();
+}
+
+void PackedSceneBatch::_finish_group_task() {
+	if (group_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		group_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+}
+
+bool PackedSceneBatch::process(uint64_t p_max_usec) {
+	if (group_task != WorkerThreadPool::INVALID_TASK_ID) {
+		if (!is_finished()) {
+			return false;
+		}
+		_finish_group_task();
+		return true;
+	}
+
+	// Build at least one instance per call, so a small budget still makes progress.
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	while (started < count) {
+		started++;
+		_instantiate_one();
+		if (OS::get_singleton()->get_ticks_usec() - start >= p_max_usec) {
+			break;
+		}
+	}
+
+	return is_finished();
+}
+
+void PackedSceneBatch::wait() {
+	_finish_group_task();
+	while (started < count) {
+		started++;
+		_instantiate_one();
+	}
+}
+
+bool PackedSceneBatch::is_finished() const {
+	return (int)finished_count.get() == count;
+}
+
+int PackedSceneBatch::get_count() const {
+	return count;
+}
+
+int PackedSceneBatch::get_instantiated_count() const {
+	return finished_count.get();
+}
+
+TypedArray<Node> PackedSceneBatch::take_instances(int p_max_count) {
+	TypedArray<Node> ret;
+	MutexLock lock(mutex);
+
+	int take_count = p_max_count < 0 ? (int)instances.size() : MIN(p_max_count, (int)instances.size());
+	ret.resize(take_count);
+	for (int i = 0; i < take_count; i++) {
+		ret[i] = instances[i];
+	}
+
+	// Keep the order in which the remaining instances were built.
+	int remaining = instances.size() - take_count;
+	for (int i = 0; i < remaining; i++) {
+		instances[i] = instances[take_count + i];
+	}
+	instances.resize(remaining);
+
+	return ret;
+}
+
+void PackedSceneBatch::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("process", "max_usec"), &PackedSceneBatch::process);
+	ClassDB::bind_method(D_METHOD("wait"), &PackedSceneBatch::wait);
+	ClassDB::bind_method(D_METHOD("is_finished"), &PackedSceneBatch::is_finished);
+	ClassDB::bind_method(D_METHOD("get_count"), &PackedSceneBatch::get_count);
+	ClassDB::bind_method(D_METHOD("get_instantiated_count"), &PackedSceneBatch::get_instantiated_count);
+	ClassDB::bind_method(D_METHOD("take_instances", "max_count"), &PackedSceneBatch::take_instances, DEFVAL(-1));
+}
+
+PackedSceneBatch::~PackedSceneBatch() {
+	_finish_group_task();
+
+	// Instances that were never taken belong to the batch.
+	for (Node *node : instances) {
+		memdelete(node);
+	}
+}
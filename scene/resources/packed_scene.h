@@ -32,6 +32,10 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -98,6 +102,30 @@ class SceneState : public RefCounted {
 
 	static bool disable_placeholders;
 
+	// Property setters resolved ahead of time, so instantiation can call them directly
+	// instead of looking each property up by name through Object::set().
+	struct PropertySetter {
+		MethodBind *method = nullptr; // Null if Object::set() is needed.
+		int index = -1; // For properties sharing an indexed setter.
+		bool validated = false; // If arguments of the expected types can skip conversion.
+		Variant::Type type = Variant::NIL;
+	};
+
+	struct InstantiationProgram {
+		LocalVector<StringName> node_classes; // Class the setters of each node were resolved for, empty if none.
+		LocalVector<uint32_t> node_setters; // First setter of each node, one per property.
+		LocalVector<PropertySetter> setters;
+	};
+
+	mutable InstantiationProgram instantiation_program;
+	mutable SafeFlag instantiation_program_valid;
+	mutable BinaryMutex instantiation_program_mutex;
+
+	static bool use_instantiation_program;
+
+	const InstantiationProgram *_get_instantiation_program() const;
+	void _clear_instantiation_program();
+
 	Vector<String> _get_node_groups(int p_idx) const;
 
 	int _find_base_scene_node_remap_key(int p_idx) const;
@@ -136,6 +164,7 @@ public:
 	};
 
 	static void set_disable_placeholders(bool p_disable);
+	static void set_use_instantiation_program(bool p_enable);
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
 	int find_node_by_path(const NodePath &p_node) const;
@@ -227,6 +256,8 @@ public:
 
 VARIANT_ENUM_CAST(SceneState::GenEditState)
 
+class PackedSceneBatch;
+
 class PackedScene : public Resource {
 	GDCLASS(PackedScene, Resource);
 	RES_BASE_EXTENSION("scn");
@@ -255,6 +286,7 @@ public:
 
 	bool can_instantiate() const;
 	Node *instantiate(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
+	Ref<PackedSceneBatch> instantiate_batch(int p_count, bool p_use_threads = true);
 
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
@@ -278,4 +310,41 @@ public:
 
 VARIANT_ENUM_CAST(PackedScene::GenEditState)
 
+// Instantiates a scene many times, either on worker threads or spread over several calls
+// to process(). Instances are built outside the tree and taken out to be added to it.
+class PackedSceneBatch : public RefCounted {
+	GDCLASS(PackedSceneBatch, RefCounted);
+
+	friend class PackedScene;
+
+	Ref<PackedScene> scene;
+	int count = 0;
+	int started = 0; // Instances started on the calling thread.
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::INVALID_TASK_ID;
+
+	Mutex mutex;
+	LocalVector<Node *> instances; // Built and not taken yet.
+	SafeNumeric<uint32_t> finished_count;
+
+	void _instantiate_one();
+	void _instantiate_thread(uint32_t p_index, void *p_userdata);
+	void _finish_group_task();
+
+protected:
+	static void _bind_methods();
+
+public:
+	bool process(uint64_t p_max_usec);
+	void wait();
+
+	bool is_finished() const;
+	int get_count() const;
+	int get_instantiated_count() const;
+
+	TypedArray<Node> take_instances(int p_max_count = -1);
+
+	~PackedSceneBatch();
+};
+
 #endif // PACKED_SCENE_H
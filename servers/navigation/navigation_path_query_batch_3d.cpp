@@ -0,0 +1,96 @@
+/**************************************************************************/
+/*  navigation_path_query_batch_3d.cpp                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "navigation_path_query_batch_3d.h"
+
+#include "servers/navigation_server_3d.h"
+
+void NavigationPathQueryBatch3D::_query_thread(uint32_t p_index, void *p_userdata) {
+	query_results[p_index] = NavigationServer3D::get_singleton()->_query_path(parameters[p_index]);
+	finished_count.increment();
+}
+
+void NavigationPathQueryBatch3D::_finish() {
+	MutexLock lock(mutex);
+	if (results_set) {
+		return;
+	}
+
+	if (group_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		group_task = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	for (uint32_t i = 0; i < query_results.size(); i++) {
+		Ref<NavigationPathQueryResult3D> result = results[i];
+		NavigationUtilities::PathQueryResult &query_result = query_results[i];
+		result->set_path(query_result.path);
+		result->set_path_types(query_result.path_types);
+		result->set_path_rids(query_result.path_rids);
+		result->set_path_owner_ids(query_result.path_owner_ids);
+	}
+	query_results.reset();
+	results_set = true;
+}
+
+void NavigationPathQueryBatch3D::wait() {
+	_finish();
+}
+
+bool NavigationPathQueryBatch3D::is_finished() const {
+	return finished_count.get() == parameters.size();
+}
+
+int NavigationPathQueryBatch3D::get_count() const {
+	return parameters.size();
+}
+
+int NavigationPathQueryBatch3D::get_finished_count() const {
+	return finished_count.get();
+}
+
+TypedArray<NavigationPathQueryResult3D> NavigationPathQueryBatch3D::get_results() {
+	_finish();
+	return results;
+}
+
+void NavigationPathQueryBatch3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("wait"), &NavigationPathQueryBatch3D::wait);
+	ClassDB::bind_method(D_METHOD("is_finished"), &NavigationPathQueryBatch3D::is_finished);
+	ClassDB::bind_method(D_METHOD("get_count"), &NavigationPathQueryBatch3D::get_count);
+	ClassDB::bind_method(D_METHOD("get_finished_count"), &NavigationPathQueryBatch3D::get_finished_count);
+	ClassDB::bind_method(D_METHOD("get_results"), &NavigationPathQueryBatch3D::get_results);
+}
+
+NavigationPathQueryBatch3D::~NavigationPathQueryBatch3D() {
+	if (group_task != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+}
@@ -0,0 +1,76 @@
+/**************************************************************************/
+/*  navigation_path_query_batch_3d.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAVIGATION_PATH_QUERY_BATCH_3D_H
+#define NAVIGATION_PATH_QUERY_BATCH_3D_H
+
+#include "core/object/ref_counted.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/templates/safe_refcount.h"
+#include "core/variant/typed_array.h"
+#include "servers/navigation/navigation_path_query_result_3d.h"
+#include "servers/navigation/navigation_utilities.h"
+
+class NavigationPathQueryBatch3D : public RefCounted {
+	GDCLASS(NavigationPathQueryBatch3D, RefCounted);
+
+	friend class NavigationServer3D;
+
+	LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+	LocalVector<NavigationUtilities::PathQueryResult> query_results; // Written by the worker threads.
+	TypedArray<NavigationPathQueryResult3D> results;
+	Callable callback;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::INVALID_TASK_ID;
+	SafeNumeric<uint32_t> finished_count;
+
+	Mutex mutex;
+	bool results_set = false;
+
+	void _query_thread(uint32_t p_index, void *p_userdata);
+	void _finish();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void wait();
+
+	bool is_finished() const;
+	int get_count() const;
+	int get_finished_count() const;
+
+	TypedArray<NavigationPathQueryResult3D> get_results();
+
+	~NavigationPathQueryBatch3D();
+};
+
+#endif // NAVIGATION_PATH_QUERY_BATCH_3D_H
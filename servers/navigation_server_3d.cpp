@@ -51,6 +51,8 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_merge_rasterizer_cell_scale", "map"), &NavigationServer3D::map_get_merge_rasterizer_cell_scale);
 	ClassDB::bind_method(D_METHOD("map_set_use_edge_connections", "map", "enabled"), &NavigationServer3D::map_set_use_edge_connections);
 	ClassDB::bind_method(D_METHOD("map_get_use_edge_connections", "map"), &NavigationServer3D::map_get_use_edge_connections);
+	ClassDB::bind_method(D_METHOD("map_set_use_hierarchical_pathfinding", "map", "enabled"), &NavigationServer3D::map_set_use_hierarchical_pathfinding);
+	ClassDB::bind_method(D_METHOD("map_get_use_hierarchical_pathfinding", "map"), &NavigationServer3D::map_get_use_hierarchical_pathfinding);
 	ClassDB::bind_method(D_METHOD("map_set_edge_connection_margin", "map", "margin"), &NavigationServer3D::map_set_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_get_edge_connection_margin", "map"), &NavigationServer3D::map_get_edge_connection_margin);
 	ClassDB::bind_method(D_METHOD("map_set_link_connection_radius", "map", "radius"), &NavigationServer3D::map_set_link_connection_radius);
@@ -72,6 +74,7 @@ void NavigationServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("map_get_random_point", "map", "navigation_layers", "uniformly"), &NavigationServer3D::map_get_random_point);
 
 	ClassDB::bind_method(D_METHOD("query_path", "parameters", "result"), &NavigationServer3D::query_path);
+	ClassDB::bind_method(D_METHOD("query_path_batch", "parameters", "results", "callback"), &NavigationServer3D::query_path_batch, DEFVAL(Callable()));
 
 	ClassDB::bind_method(D_METHOD("region_create"), &NavigationServer3D::region_create);
 	ClassDB::bind_method(D_METHOD("region_set_enabled", "region", "enabled"), &NavigationServer3D::region_set_enabled);
@@ -942,6 +945,70 @@ void NavigationServer3D::query_path(const Ref<NavigationPathQueryParameters3D> &
 	p_query_result->set_path_owner_ids(_query_result.path_owner_ids);
 }
 
+Ref<NavigationPathQueryBatch3D> NavigationServer3D::query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), Ref<NavigationPathQueryBatch3D>(), "The batch needs one result object for each query parameters object.");
+
+	Ref<NavigationPathQueryBatch3D> batch;
+	batch.instantiate();
+	batch->parameters.resize(p_query_parameters.size());
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		ERR_FAIL_COND_V(query_parameters.is_null(), Ref<NavigationPathQueryBatch3D>());
+		ERR_FAIL_COND_V(query_result.is_null(), Ref<NavigationPathQueryBatch3D>());
+		batch->parameters[i] = query_parameters->get_parameters();
+	}
+	batch->query_results.resize(p_query_parameters.size());
+	batch->results = p_query_results.duplicate();
+	batch->callback = p_callback;
+
+	if (!batch->parameters.is_empty()) {
+		batch->group_task = WorkerThreadPool::get_singleton()->add_template_group_task(batch.ptr(), &NavigationPathQueryBatch3D::_query_thread, (void *)nullptr, batch->parameters.size(), -1, false, SNAME("NavigationPathQueryBatch3D"));
+	}
+
+	MutexLock lock(path_query_batches_mutex);
+	path_query_batches.push_back(batch);
+
+	return batch;
+}
+
+void NavigationServer3D::_dispatch_path_query_batches() {
+	LocalVector<Ref<NavigationPathQueryBatch3D>> finished_batches;
+
+	path_query_batches_mutex.lock();
+	for (uint32_t i = 0; i < path_query_batches.size(); i++) {
+		if (path_query_batches[i]->is_finished()) {
+			finished_batches.push_back(path_query_batches[i]);
+			path_query_batches.remove_at_unordered(i);
+			i--;
+		}
+	}
+	path_query_batches_mutex.unlock();
+
+	// Callbacks may submit new batches.
+	for (const Ref<NavigationPathQueryBatch3D> &batch : finished_batches) {
+		batch->_finish();
+		if (batch->callback.is_valid()) {
+			batch->callback.call();
+		}
+	}
+}
+
+void NavigationServer3D::_wait_for_path_query_batches() {
+	MutexLock lock(path_query_batches_mutex);
+	for (const Ref<NavigationPathQueryBatch3D> &batch : path_query_batches) {
+		batch->_finish();
+	}
+}
+
+void NavigationServer3D::_clear_path_query_batches() {
+	MutexLock lock(path_query_batches_mutex);
+	for (const Ref<NavigationPathQueryBatch3D> &batch : path_query_batches) {
+		batch->_finish();
+	}
+	path_query_batches.clear();
+}
+
 ///////////////////////////////////////////////////////
 
 NavigationServer3DCallback NavigationServer3DManager::create_callback = nullptr;
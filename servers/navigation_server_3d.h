@@ -36,6 +36,7 @@
 
 #include "scene/resources/3d/navigation_mesh_source_geometry_data_3d.h"
 #include "scene/resources/navigation_mesh.h"
+#include "servers/navigation/navigation_path_query_batch_3d.h"
 #include "servers/navigation/navigation_path_query_parameters_3d.h"
 #include "servers/navigation/navigation_path_query_result_3d.h"
 
@@ -90,6 +91,12 @@ public:
 	virtual void map_set_use_edge_connections(RID p_map, bool p_enabled) = 0;
 	virtual bool map_get_use_edge_connections(RID p_map) const = 0;
 
+	/// Set the map hierarchical pathfinding use.
+	virtual void map_set_use_hierarchical_pathfinding(RID p_map, bool p_enabled) = 0;
+
+	/// Returns true if the map searches paths between regions over their portals first.
+	virtual bool map_get_use_hierarchical_pathfinding(RID p_map) const = 0;
+
 	/// Set the map edge connection margin used to weld the compatible region edges.
 	virtual void map_set_edge_connection_margin(RID p_map, real_t p_connection_margin) = 0;
 
@@ -344,11 +351,26 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const = 0;
 
+	/// Runs the path queries on the WorkerThreadPool, the callback is
+	/// called in the main thread by `process()` once all of them finished.
+	virtual Ref<NavigationPathQueryBatch3D> query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable());
+
+protected:
+	/// Sets the results and emits the callbacks of the finished batches.
+	void _dispatch_path_query_batches();
+	/// Waits for every running batch, e.g. before a map they may query is freed.
+	void _wait_for_path_query_batches();
+	void _clear_path_query_batches();
+
+public:
+
 #ifndef _3D_DISABLED
 	virtual void parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, Node *p_root_node, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 	virtual void bake_from_source_geometry_data_async(const Ref<NavigationMesh> &p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data, const Callable &p_callback = Callable()) = 0;
 	virtual bool is_baking_navigation_mesh(Ref<NavigationMesh> p_navigation_mesh) const = 0;
+	/// Drops the tiles kept to rebake a navigation mesh, called when it is freed.
+	virtual void free_navigation_mesh_tiles(ObjectID p_navigation_mesh) = 0;
 #endif // _3D_DISABLED
 
 	virtual RID source_geometry_parser_create() = 0;
@@ -379,6 +401,9 @@ public:
 private:
 	bool debug_enabled = false;
 
+	Mutex path_query_batches_mutex;
+	LocalVector<Ref<NavigationPathQueryBatch3D>> path_query_batches;
+
 #ifdef DEBUG_ENABLED
 	bool debug_dirty = true;
 
@@ -130,6 +130,14 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep3D::_pre_solve_islands(uint32_t p_island_count) {
+	setup_constraints_endtime = OS::get_singleton()->get_ticks_usec();
+
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		_pre_solve_island(constraint_islands[island_index]);
+	}
+}
+
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
@@ -344,32 +352,29 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
-	}
+	WorkerThreadPool::GroupID setup_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
-	}
+	// Warning: This doesn't run in parallel, because it involves thread-unsafe processing.
+	// It runs as a single task once all constraints are set up, while this thread is blocked.
+	WorkerThreadPool::TaskID pre_solve_task = WorkerThreadPool::get_singleton()->add_template_task_with_dependencies(this, &GodotStep3D::_pre_solve_islands, island_count, { setup_task }, true, SNAME("Physics3DConstraintPreSolveIslands"));
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	WorkerThreadPool::GroupID solve_task = WorkerThreadPool::get_singleton()->add_template_group_task_with_dependencies(this, &GodotStep3D::_solve_island, nullptr, island_count, { pre_solve_task }, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+
+	// The whole chain runs without this thread in between, the earlier steps are done by now and only need to be disposed of.
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(solve_task);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(pre_solve_task);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(setup_task);
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, setup_constraints_endtime - profile_begtime);
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - setup_constraints_endtime);
 		profile_begtime = profile_endtime;
 	}
 
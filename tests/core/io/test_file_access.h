@@ -32,6 +32,8 @@
 #define TEST_FILE_ACCESS_H
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_memory.h"
+#include "core/io/file_access_pack.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +109,113 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+static String write_bytes_file(const String &p_name) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	for (int i = 0; i < 256; i++) {
+		f->store_8(i);
+	}
+	// Views are only offered for read-only files.
+	CHECK(f->get_buffer_view(1) == nullptr);
+	return path;
+}
+
+TEST_CASE("[FileAccess] Get buffer view") {
+	const String path = write_bytes_file("buffer_view.bin");
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(10);
+	const uint8_t *view = f->get_buffer_view(16);
+#ifdef UNIX_ENABLED
+	// FileAccessUnix maps read-only files.
+	REQUIRE(view != nullptr);
+#else
+	if (!view) {
+		return;
+	}
+#endif
+	// The view must match the file and advance the position.
+	CHECK(view[0] == 10);
+	CHECK(view[15] == 25);
+	CHECK(f->get_position() == 26);
+	CHECK(f->get_8() == 26);
+	// Asking for more than what is left fails without moving.
+	CHECK(f->get_buffer_view(1000) == nullptr);
+	CHECK(f->get_position() == 27);
+}
+
+TEST_CASE("[FileAccess] Get buffer view from memory") {
+	Vector<uint8_t> data;
+	data.resize(8);
+	for (int i = 0; i < 8; i++) {
+		data.write[i] = i * 2;
+	}
+	Ref<FileAccessMemory> fm;
+	fm.instantiate();
+	REQUIRE(fm->open_custom(data.ptr(), data.size()) == OK);
+	fm->seek(2);
+	const uint8_t *view = fm->get_buffer_view(4);
+	REQUIRE(view != nullptr);
+	CHECK(view == data.ptr() + 2);
+	CHECK(fm->get_position() == 6);
+	CHECK(fm->get_buffer_view(3) == nullptr);
+	CHECK(fm->get_position() == 6);
+	CHECK(fm->get_buffer_view(2) != nullptr);
+	CHECK(fm->eof_reached());
+}
+
+TEST_CASE("[FileAccess] Read pack files through the mapping") {
+	const String path = write_bytes_file("pack_mapping.bin");
+	PackedData *packed_data = PackedData::get_singleton() ? nullptr : memnew(PackedData);
+
+	PackedData::PackedFile pf;
+	pf.pack = path;
+	pf.offset = 100;
+	pf.size = 50;
+	pf.encrypted = false;
+	memset(pf.md5, 0, sizeof(pf.md5));
+
+	{
+		Ref<FileAccess> f = memnew(FileAccessPack(path, pf));
+		REQUIRE(f->is_open());
+		CHECK(f->get_length() == 50);
+		CHECK(f->get_8() == 100);
+		uint8_t buffer[4];
+		CHECK(f->get_buffer(buffer, 4) == 4);
+		CHECK(buffer[0] == 101);
+		CHECK(buffer[3] == 104);
+		const uint8_t *view = f->get_buffer_view(10);
+#ifdef UNIX_ENABLED
+		REQUIRE(view != nullptr);
+#endif
+		if (view) {
+			CHECK(view[0] == 105);
+			CHECK(view[9] == 114);
+			CHECK(f->get_position() == 15);
+		}
+		f->seek(49);
+		CHECK(f->get_8() == 149);
+		CHECK(f->get_8() == 0);
+		CHECK(f->eof_reached());
+	}
+
+	// A file the pack's directory places past the end of the pack, as in a
+	// truncated pack, isn't read from the mapping.
+	pf.offset = 200;
+	pf.size = 100;
+	{
+		Ref<FileAccess> f = memnew(FileAccessPack(path, pf));
+		CHECK(f->get_buffer_view(100) == nullptr);
+		CHECK(f->get_8() == 200);
+	}
+
+	if (packed_data) {
+		memdelete(packed_data);
+	}
+}
+
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
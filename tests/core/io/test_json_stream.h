@@ -0,0 +1,319 @@
+/**************************************************************************/
+/*  test_json_stream.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_JSON_STREAM_H
+#define TEST_JSON_STREAM_H
+
+#include "core/io/json.h"
+#include "core/io/json_stream.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestJSONStream {
+
+static Vector<uint8_t> to_bytes(const String &p_json) {
+	return p_json.to_utf8_buffer();
+}
+
+static Variant make_document(int p_entries) {
+	Array entries;
+	for (int i = 0; i < p_entries; i++) {
+		Dictionary entry;
+		entry["id"] = i;
+		entry["name"] = vformat("Entity \"%d\" é中", i);
+		Array position;
+		position.push_back(i * 0.5);
+		position.push_back(-i * 0.25);
+		position.push_back(1.0 / (i + 1));
+		entry["position"] = position;
+		entry["visible"] = (i % 3) != 0;
+		entry["parent"] = Variant();
+		Dictionary stats;
+		stats["hp"] = 100 - (i % 100);
+		Array tags;
+		tags.push_back("a");
+		tags.push_back("b\n");
+		tags.push_back("c\t");
+		stats["tags"] = tags;
+		entry["stats"] = stats;
+		entries.push_back(entry);
+	}
+	Dictionary root;
+	root["version"] = 3;
+	root["entries"] = entries;
+	return root;
+}
+
+TEST_CASE("[JSONReader] Events") {
+	JSONReader reader;
+	reader.open_buffer(to_bytes(R"({"a": [1, -2.5e1, true, false, null], "b": {}, "c": "x"})"));
+
+	CHECK(reader.read() == JSONReader::EVENT_OBJECT_BEGIN);
+	CHECK(reader.read() == JSONReader::EVENT_KEY);
+	CHECK(reader.string_equals("a"));
+	CHECK(reader.read() == JSONReader::EVENT_ARRAY_BEGIN);
+	CHECK(reader.get_depth() == 2);
+	CHECK(reader.read() == JSONReader::EVENT_NUMBER);
+	CHECK(reader.get_number() == 1);
+	CHECK(reader.read() == JSONReader::EVENT_NUMBER);
+	CHECK(reader.get_number() == -25);
+	CHECK(reader.read() == JSONReader::EVENT_BOOL);
+	CHECK(reader.get_bool());
+	CHECK(reader.read() == JSONReader::EVENT_BOOL);
+	CHECK_FALSE(reader.get_bool());
+	CHECK(reader.read() == JSONReader::EVENT_NULL);
+	CHECK(reader.read() == JSONReader::EVENT_ARRAY_END);
+	CHECK(reader.read() == JSONReader::EVENT_KEY);
+	CHECK(reader.get_string() == "b");
+	CHECK(reader.read() == JSONReader::EVENT_OBJECT_BEGIN);
+	CHECK(reader.read() == JSONReader::EVENT_OBJECT_END);
+	CHECK(reader.read() == JSONReader::EVENT_KEY);
+	CHECK(reader.read() == JSONReader::EVENT_STRING);
+	CHECK(reader.get_string() == "x");
+	CHECK(reader.read() == JSONReader::EVENT_OBJECT_END);
+	CHECK(reader.get_depth() == 0);
+	CHECK(reader.read() == JSONReader::EVENT_END);
+	CHECK(reader.get_error_line() == 0);
+}
+
+TEST_CASE("[JSONReader] Escape sequences") {
+	JSONReader reader;
+	reader.open_buffer(to_bytes(R"("\"\\\/\b\f\n\r\té中😀")"));
+	CHECK(reader.read() == JSONReader::EVENT_STRING);
+	CHECK(reader.get_string() == String::utf8("\"\\/\b\f\n\r\té中\U0001F600"));
+
+	ERR_PRINT_OFF;
+	reader.open_buffer(to_bytes(R"("\ud83d")"));
+	CHECK(reader.read() == JSONReader::EVENT_ERROR);
+	reader.open_buffer(to_bytes(R"("\x")"));
+	CHECK(reader.read() == JSONReader::EVENT_ERROR);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[JSONReader] Errors") {
+	const char *invalid[] = {
+		"",
+		"{",
+		"[1 2]",
+		R"({"a" 1})",
+		R"({1: 2})",
+		R"("unterminated)",
+		R"("null \u0000 character")",
+		"nope",
+		"[1] [2]",
+		"-",
+	};
+
+	JSONReader reader;
+	for (const char *json : invalid) {
+		reader.open_buffer(to_bytes(json));
+		JSONReader::Event event;
+		do {
+			event = reader.read();
+		} while (event != JSONReader::EVENT_ERROR && event != JSONReader::EVENT_END);
+		CHECK_MESSAGE(event == JSONReader::EVENT_ERROR, vformat("`%s` should fail to parse.", json));
+		CHECK(!reader.get_error_message().is_empty());
+	}
+
+	reader.open_buffer(to_bytes("[\n1,\n2,\n}"));
+	Variant value;
+	CHECK(reader.read_variant(value) == ERR_PARSE_ERROR);
+	CHECK(reader.get_error_line() == 4);
+}
+
+TEST_CASE("[JSONReader] Numbers") {
+	const char *valid[] = { "0", "-0", "7", "-12", "0.5", "-0.25", "1e3", "1E+3", "25e-1", "1.5e2" };
+	const double values[] = { 0, 0, 7, -12, 0.5, -0.25, 1000, 1000, 2.5, 150 };
+
+	JSONReader reader;
+	for (uint32_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+		reader.open_buffer(to_bytes(valid[i]));
+		CHECK_MESSAGE(reader.read() == JSONReader::EVENT_NUMBER, vformat("`%s` should parse.", valid[i]));
+		CHECK(reader.get_number() == values[i]);
+		CHECK(reader.read() == JSONReader::EVENT_END);
+	}
+
+	const char *invalid[] = { "-", "01", "-01", "00", "1.", ".5", "-.5", "1e", "1e+", "1.e3", "+1", "1.2.3", "1-2", "1e2e3", "--1", "[1.]" };
+	for (const char *json : invalid) {
+		reader.open_buffer(to_bytes(json));
+		JSONReader::Event event;
+		do {
+			event = reader.read();
+		} while (event != JSONReader::EVENT_ERROR && event != JSONReader::EVENT_END);
+		CHECK_MESSAGE(event == JSONReader::EVENT_ERROR, vformat("`%s` should fail to parse.", json));
+	}
+}
+
+TEST_CASE("[JSONReader] Skip") {
+	JSONReader reader;
+	reader.open_buffer(to_bytes(R"({"skipped": {"x": [1, [2, {"y": 3}]]}, "kept": 4})"));
+	CHECK(reader.read() == JSONReader::EVENT_OBJECT_BEGIN);
+	CHECK(reader.read() == JSONReader::EVENT_KEY);
+	CHECK(reader.skip() == OK);
+	CHECK(reader.get_event() == JSONReader::EVENT_OBJECT_END);
+	CHECK(reader.read() == JSONReader::EVENT_KEY);
+	CHECK(reader.string_equals("kept"));
+	Variant value;
+	CHECK(reader.read_variant(value) == OK);
+	CHECK(value == Variant(4.0));
+	CHECK(reader.read() == JSONReader::EVENT_OBJECT_END);
+	CHECK(reader.read() == JSONReader::EVENT_END);
+}
+
+TEST_CASE("[JSONReader] Same result as JSON::parse") {
+	const String json = JSON::stringify(make_document(50), "\t");
+
+	Variant expected = JSON::parse_string(json);
+	JSONReader reader;
+	reader.open_buffer(to_bytes(json));
+	Variant value;
+	CHECK(reader.read_variant(value) == OK);
+	CHECK(reader.read() == JSONReader::EVENT_END);
+	CHECK(value == expected);
+}
+
+TEST_CASE("[JSONWriter] Same output as JSON::stringify") {
+	const Variant document = make_document(20);
+
+	JSONWriter writer;
+	writer.write_variant(document);
+	CHECK(String::utf8((const char *)writer.get_data().ptr(), writer.get_data().size()) == JSON::stringify(document));
+
+	JSONWriter pretty;
+	pretty.set_indent("\t");
+	pretty.write_variant(document);
+	CHECK(String::utf8((const char *)pretty.get_data().ptr(), pretty.get_data().size()) == JSON::stringify(document, "\t"));
+}
+
+TEST_CASE("[JSONWriter] Manual writing") {
+	JSONWriter writer;
+	writer.begin_object();
+	writer.write_key("list");
+	writer.begin_array();
+	writer.write_int(INT64_MIN);
+	writer.write_int(0);
+	writer.write_float(0.5);
+	writer.write_bool(false);
+	writer.write_null();
+	writer.write_string(String::utf8("é\x01"));
+	writer.end_array();
+	writer.write_key("empty");
+	writer.begin_object();
+	writer.end_object();
+	writer.end_object();
+
+	const Vector<uint8_t> data = writer.get_data();
+	CHECK(String::utf8((const char *)data.ptr(), data.size()) == String::utf8(R"({"list":[-9223372036854775808,0,0.5,false,null,"é\u0001"],"empty":{}})"));
+
+	JSONReader reader;
+	reader.open_buffer(data);
+	Variant value;
+	CHECK(reader.read_variant(value) == OK);
+	CHECK(String(Dictionary(value)["list"].get(5)) == String::utf8("é\x01"));
+}
+
+TEST_CASE("[JSONWriter] Round trip through a file and a stream") {
+	// Large enough to span several read chunks and flushes.
+	const Variant document = make_document(2000);
+	const String path = TestUtils::get_temp_path("json_stream_round_trip.json");
+
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		JSONWriter writer;
+		writer.open_file(f);
+		writer.set_indent(" ");
+		writer.write_variant(document);
+		CHECK(writer.flush() == OK);
+	}
+
+	JSONReader reader;
+	REQUIRE(reader.open(path) == OK);
+	Variant value;
+	CHECK(reader.read_variant(value) == OK);
+	CHECK(reader.read() == JSONReader::EVENT_END);
+	CHECK(value == JSON::parse_string(JSON::stringify(document)));
+	reader.close();
+
+	Ref<StreamPeerBuffer> peer;
+	peer.instantiate();
+	{
+		JSONWriter writer;
+		writer.open_stream(peer);
+		writer.write_variant(document);
+	}
+	CHECK(peer->get_data_array() == JSON::stringify(document).to_utf8_buffer());
+}
+
+TEST_CASE("[JSONReader][JSONWriter][Benchmark] Compare with JSON") {
+	const Variant document = make_document(20000);
+	const Vector<uint8_t> bytes = JSON::stringify(document).to_utf8_buffer();
+
+	BenchmarkTimer timer;
+	Variant parsed = JSON::parse_string(String::utf8((const char *)bytes.ptr(), bytes.size()));
+	const uint64_t parse_usec = timer.get_elapsed_usec();
+
+	timer.restart();
+	JSONReader reader;
+	reader.open_buffer(bytes);
+	Variant read;
+	CHECK(reader.read_variant(read) == OK);
+	const uint64_t read_usec = timer.get_elapsed_usec();
+
+	timer.restart();
+	uint64_t events = 0;
+	reader.open_buffer(bytes);
+	for (JSONReader::Event event = reader.read(); event != JSONReader::EVENT_END && event != JSONReader::EVENT_ERROR; event = reader.read()) {
+		events++;
+	}
+	CHECK(reader.get_error_message().is_empty());
+	const uint64_t walk_usec = timer.get_elapsed_usec();
+
+	timer.restart();
+	const Vector<uint8_t> stringified = JSON::stringify(document).to_utf8_buffer();
+	const uint64_t stringify_usec = timer.get_elapsed_usec();
+
+	timer.restart();
+	JSONWriter writer;
+	writer.write_variant(document);
+	const uint64_t write_usec = timer.get_elapsed_usec();
+
+	CHECK(parsed == read);
+	CHECK(writer.get_data() == stringified);
+
+	BENCHMARK_MESSAGE("%d bytes: JSON::parse_string %d usec, JSONReader::read_variant %d usec, %d events walked in %d usec.", bytes.size(), parse_usec, read_usec, events, walk_usec);
+	BENCHMARK_MESSAGE("JSON::stringify %d usec, JSONWriter::write_variant %d usec.", stringify_usec, write_usec);
+}
+
+} // namespace TestJSONStream
+
+#endif // TEST_JSON_STREAM_H
@@ -31,6 +31,7 @@
 #ifndef TEST_RESOURCE_H
 #define TEST_RESOURCE_H
 
+#include "core/io/dir_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -166,6 +167,165 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+// Saves a root resource depending on p_group_count groups, each depending on
+// p_leaves_per_group leaves, and returns the root's path.
+static String save_dependency_graph(const String &p_dir, int p_group_count, int p_leaves_per_group) {
+	DirAccess::make_dir_recursive_absolute(p_dir);
+
+	PackedFloat32Array payload;
+	payload.resize(4096);
+	for (int i = 0; i < payload.size(); i++) {
+		payload.set(i, i * 0.5f);
+	}
+
+	Array groups;
+	for (int g = 0; g < p_group_count; g++) {
+		Array leaves;
+		for (int l = 0; l < p_leaves_per_group; l++) {
+			Ref<Resource> leaf = memnew(Resource);
+			leaf->set_name(vformat("leaf_%d_%d", g, l));
+			leaf->set_meta("payload", payload);
+			ResourceSaver::save(leaf, p_dir.path_join(vformat("leaf_%d_%d.res", g, l)), ResourceSaver::FLAG_CHANGE_PATH);
+			leaves.push_back(leaf);
+		}
+		Ref<Resource> group = memnew(Resource);
+		group->set_meta("leaves", leaves);
+		ResourceSaver::save(group, p_dir.path_join(vformat("group_%d.res", g)), ResourceSaver::FLAG_CHANGE_PATH);
+		groups.push_back(group);
+	}
+	Ref<Resource> root = memnew(Resource);
+	root->set_meta("groups", groups);
+	const String root_path = p_dir.path_join("root.res");
+	ResourceSaver::save(root, root_path);
+	// Everything saved here is freed on return, so loads start from an empty cache.
+	return root_path;
+}
+
+static int count_graph_leaves(const Ref<Resource> &p_root) {
+	int count = 0;
+	const Array groups = p_root->get_meta("groups");
+	for (const Variant &group : groups) {
+		const Array leaves = Ref<Resource>(group)->get_meta("leaves");
+		for (const Variant &leaf : leaves) {
+			const Ref<Resource> leaf_res = leaf;
+			if (leaf_res.is_valid() && leaf_res->get_name().begins_with("leaf_")) {
+				count++;
+			}
+		}
+	}
+	return count;
+}
+
+// Logs what ResourceLoader asks about the files in one directory, and leaves
+// the actual work to the binary loader.
+class ResourceFormatLoaderSpy : public ResourceFormatLoader {
+public:
+	String dir_name;
+	Mutex mutex;
+	LocalVector<String> log;
+
+	virtual bool recognize_path(const String &p_path, const String &p_for_type = String()) const override {
+		return p_path.get_base_dir().get_file() == dir_name;
+	}
+
+	virtual void get_recognized_extensions(List<String> *p_extensions) const override {
+		p_extensions->push_back("res");
+	}
+
+	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false) override {
+		MutexLock lock(mutex);
+		log.push_back("dependencies " + p_path.get_file());
+	}
+
+	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override {
+		MutexLock lock(mutex);
+		log.push_back("load " + p_path.get_file());
+		return Ref<Resource>();
+	}
+};
+
+// Registers the spy for as long as it's in scope, so a failed REQUIRE
+// doesn't leave it in front of the other loaders.
+struct ResourceFormatLoaderSpyRegistration {
+	Ref<ResourceFormatLoaderSpy> spy;
+
+	ResourceFormatLoaderSpyRegistration(const Ref<ResourceFormatLoaderSpy> &p_spy) :
+			spy(p_spy) {
+		ResourceLoader::add_resource_format_loader(spy, true);
+	}
+	~ResourceFormatLoaderSpyRegistration() {
+		ResourceLoader::remove_resource_format_loader(spy);
+	}
+};
+
+TEST_CASE("[Resource] Sub-threaded loads prefetch the dependency graph") {
+	const int group_count = 2;
+	const int leaves_per_group = 3;
+	const String dir = TestUtils::get_temp_path("prefetch_graph");
+	const String root_path = save_dependency_graph(dir, group_count, leaves_per_group);
+
+	Ref<ResourceFormatLoaderSpy> spy;
+	spy.instantiate();
+	spy->dir_name = dir.get_file();
+	ResourceFormatLoaderSpyRegistration registration(spy);
+
+	// A regular load only discovers dependencies while parsing.
+	Ref<Resource> loaded = ResourceLoader::load(root_path);
+	REQUIRE(loaded.is_valid());
+	CHECK(count_graph_leaves(loaded) == group_count * leaves_per_group);
+	CHECK(spy->log.find("dependencies root.res") == -1);
+	loaded.unref();
+	spy->log.clear();
+
+	REQUIRE(ResourceLoader::load_threaded_request(root_path, "", true) == OK);
+	loaded = ResourceLoader::load_threaded_get(root_path);
+	REQUIRE(loaded.is_valid());
+	CHECK(count_graph_leaves(loaded) == group_count * leaves_per_group);
+
+	// Every leaf was reached, and its load started, before the root was parsed.
+	const int64_t root_load = spy->log.find("load root.res");
+	REQUIRE(root_load >= 0);
+	CHECK(spy->log.find("dependencies root.res") < root_load);
+	for (int g = 0; g < group_count; g++) {
+		const int64_t group_dependencies = spy->log.find(vformat("dependencies group_%d.res", g));
+		CHECK(group_dependencies >= 0);
+		CHECK(group_dependencies < root_load);
+		for (int l = 0; l < leaves_per_group; l++) {
+			const String leaf = vformat("leaf_%d_%d.res", g, l);
+			const int64_t leaf_dependencies = spy->log.find("dependencies " + leaf);
+			CHECK(leaf_dependencies >= 0);
+			CHECK(leaf_dependencies < root_load);
+			// Loaded once, by the prefetched task that the group then awaited.
+			const int64_t leaf_load = spy->log.find("load " + leaf);
+			CHECK(leaf_load >= 0);
+			CHECK(spy->log.find("load " + leaf, leaf_load + 1) == -1);
+		}
+	}
+}
+
+TEST_CASE("[Resource][Benchmark] Loading a large dependency graph") {
+	const int group_count = 32;
+	const int leaves_per_group = 64;
+	const String root_path = save_dependency_graph(TestUtils::get_temp_path("dependency_graph"), group_count, leaves_per_group);
+
+	BenchmarkTimer timer;
+	Ref<Resource> loaded = ResourceLoader::load(root_path);
+	const uint64_t load_usec = timer.get_elapsed_usec();
+	REQUIRE(loaded.is_valid());
+	CHECK(count_graph_leaves(loaded) == group_count * leaves_per_group);
+	loaded.unref();
+
+	timer.restart();
+	REQUIRE(ResourceLoader::load_threaded_request(root_path, "", true) == OK);
+	loaded = ResourceLoader::load_threaded_get(root_path);
+	const uint64_t threaded_usec = timer.get_elapsed_usec();
+	REQUIRE(loaded.is_valid());
+	CHECK(count_graph_leaves(loaded) == group_count * leaves_per_group);
+
+	BENCHMARK_MESSAGE("%d resources: load() %d usec, load_threaded_request() with sub-threads %d usec.", group_count * (leaves_per_group + 1) + 1, load_usec, threaded_usec);
+}
+
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
@@ -0,0 +1,244 @@
+/**************************************************************************/
+/*  test_batch_math.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BATCH_MATH_H
+#define TEST_BATCH_MATH_H
+
+#include "core/math/batch_math.h"
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBatchMath {
+
+struct BatchData {
+	LocalVector<Vector3> points;
+	LocalVector<Vector3> other_points;
+	LocalVector<AABB> aabbs;
+	Transform3D xform;
+	Plane planes[6];
+
+	BatchData(uint32_t p_count) {
+		Ref<RandomNumberGenerator> rng;
+		rng.instantiate();
+		rng->set_seed(42);
+		points.resize(p_count);
+		other_points.resize(p_count);
+		aabbs.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			points[i] = Vector3(rng->randf_range(-100, 100), rng->randf_range(-100, 100), rng->randf_range(-100, 100));
+			other_points[i] = Vector3(rng->randf_range(-1, 1), rng->randf_range(-1, 1), rng->randf_range(-1, 1));
+			aabbs[i] = AABB(points[i], Vector3(rng->randf_range(0, 10), rng->randf_range(0, 10), rng->randf_range(0, 10)));
+		}
+		xform = Transform3D(Basis(Vector3(1, 2, 3).normalized(), 0.7).scaled(Vector3(1.5, 0.5, 2)), Vector3(3, -2, 5));
+		// A box-shaped volume, 60 units wide, with outward facing planes.
+		planes[0] = Plane(Vector3(1, 0, 0), 30);
+		planes[1] = Plane(Vector3(-1, 0, 0), 30);
+		planes[2] = Plane(Vector3(0, 1, 0), 30);
+		planes[3] = Plane(Vector3(0, -1, 0), 30);
+		planes[4] = Plane(Vector3(0, 0, 1), 30);
+		planes[5] = Plane(Vector3(0, 0, -1), 30);
+	}
+};
+
+static bool is_inside_planes(const AABB &p_aabb, const Plane *p_planes, int p_plane_count) {
+	const Vector3 half_extents = p_aabb.size * 0.5;
+	const Vector3 center = p_aabb.position + half_extents;
+	for (int i = 0; i < p_plane_count; i++) {
+		const Plane &p = p_planes[i];
+		const Vector3 point = center + Vector3(p.normal.x > 0 ? -half_extents.x : half_extents.x, p.normal.y > 0 ? -half_extents.y : half_extents.y, p.normal.z > 0 ? -half_extents.z : half_extents.z);
+		if (p.is_point_over(point)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[BatchMath] All implementations match the scalar math") {
+	const BatchMath::Implementation default_implementation = BatchMath::get_implementation();
+	// Not a multiple of any vector width, so remainders are covered too.
+	BatchData data(1003);
+	const uint32_t count = data.points.size();
+
+	for (int impl = 0; impl < BatchMath::IMPLEMENTATION_MAX; impl++) {
+		if (!BatchMath::is_implementation_supported(BatchMath::Implementation(impl))) {
+			continue;
+		}
+		BatchMath::set_implementation(BatchMath::Implementation(impl));
+		INFO("Implementation: ", BatchMath::get_implementation_name(BatchMath::Implementation(impl)));
+
+		LocalVector<Vector3> xformed;
+		xformed.resize(count);
+		BatchMath::xform_points(data.xform, data.points.ptr(), xformed.ptr(), count);
+
+		LocalVector<AABB> xformed_aabbs;
+		xformed_aabbs.resize(count);
+		BatchMath::xform_aabbs(data.xform, data.aabbs.ptr(), xformed_aabbs.ptr(), count);
+
+		LocalVector<real_t> dots;
+		dots.resize(count);
+		BatchMath::dot(data.points.ptr(), data.other_points.ptr(), dots.ptr(), count);
+
+		LocalVector<real_t> distances;
+		distances.resize(count);
+		BatchMath::distances_to_plane(data.planes[2], data.points.ptr(), distances.ptr(), count);
+
+		LocalVector<uint8_t> inside;
+		inside.resize(count);
+		BatchMath::cull_aabbs(data.aabbs.ptr(), count, data.planes, 6, inside.ptr());
+
+		bool points_match = true;
+		bool aabbs_match = true;
+		bool dots_match = true;
+		bool distances_match = true;
+		bool culling_matches = true;
+		for (uint32_t i = 0; i < count; i++) {
+			// Every path has to round the same way the scalar math does.
+			points_match &= xformed[i] == data.xform.xform(data.points[i]);
+			aabbs_match &= xformed_aabbs[i] == data.xform.xform(data.aabbs[i]);
+			dots_match &= dots[i] == data.points[i].dot(data.other_points[i]);
+			distances_match &= distances[i] == data.planes[2].distance_to(data.points[i]);
+			culling_matches &= (inside[i] != 0) == is_inside_planes(data.aabbs[i], data.planes, 6);
+		}
+		CHECK(points_match);
+		CHECK(aabbs_match);
+		CHECK(dots_match);
+		CHECK(distances_match);
+		CHECK(culling_matches);
+
+		// In-place transform.
+		LocalVector<Vector3> in_place = data.points;
+		BatchMath::xform_points(data.xform, in_place.ptr(), in_place.ptr(), count);
+		bool in_place_matches = true;
+		for (uint32_t i = 0; i < count; i++) {
+			in_place_matches &= in_place[i] == xformed[i];
+		}
+		CHECK(in_place_matches);
+
+		// Transform3D * PackedVector3Array goes through the batched kernel.
+		Vector<Vector3> packed;
+		packed.resize(count);
+		memcpy(packed.ptrw(), data.points.ptr(), count * sizeof(Vector3));
+		const Vector<Vector3> packed_xformed = data.xform.xform(packed);
+		bool packed_matches = true;
+		for (uint32_t i = 0; i < count; i++) {
+			packed_matches &= packed_xformed[i] == data.xform.xform(data.points[i]);
+		}
+		CHECK(packed_matches);
+
+		AABB expected_bounds(data.points[0], Vector3());
+		AABB expected_merge = data.aabbs[0];
+		for (uint32_t i = 1; i < count; i++) {
+			expected_bounds.expand_to(data.points[i]);
+			expected_merge.merge_with(data.aabbs[i]);
+		}
+		CHECK(BatchMath::compute_aabb(data.points.ptr(), count).is_equal_approx(expected_bounds));
+		CHECK(BatchMath::merge_aabbs(data.aabbs.ptr(), count).is_equal_approx(expected_merge));
+	}
+
+	BatchMath::set_implementation(default_implementation);
+}
+
+TEST_CASE("[BatchMath] Edge cases") {
+	BatchData data(3);
+	Vector3 out[3];
+	// Fewer elements than any vector width.
+	BatchMath::xform_points(data.xform, data.points.ptr(), out, 3);
+	CHECK(out[2] == data.xform.xform(data.points[2]));
+	// Nothing to do.
+	BatchMath::xform_points(data.xform, data.points.ptr(), out, 0);
+	CHECK(BatchMath::compute_aabb(nullptr, 0) == AABB());
+	CHECK(BatchMath::merge_aabbs(nullptr, 0) == AABB());
+
+	// No planes means nothing is culled.
+	uint8_t inside[3] = { 0, 0, 0 };
+	BatchMath::cull_aabbs(data.aabbs.ptr(), 3, nullptr, 0, inside);
+	CHECK(inside[0] == 1);
+	CHECK(inside[1] == 1);
+	CHECK(inside[2] == 1);
+
+	Vector<Vector3> packed;
+	packed.push_back(Vector3(1, 2, 3));
+	packed.push_back(Vector3(4, 5, 6));
+	CHECK(BatchMath::xform_points(Transform3D(), packed) == packed);
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(BatchMath::dot(packed, Vector<Vector3>()).is_empty(), "Arrays of different sizes should be rejected.");
+	ERR_PRINT_ON;
+	Vector<real_t> dots = BatchMath::dot(packed, packed);
+	CHECK(dots.size() == 2);
+	CHECK(dots[1] == doctest::Approx(77));
+}
+
+TEST_CASE("[BatchMath][Benchmark] Compare implementations") {
+	const BatchMath::Implementation default_implementation = BatchMath::get_implementation();
+	BatchData data(16384);
+	const uint32_t count = data.points.size();
+	const int iterations = 50;
+	LocalVector<Vector3> xformed;
+	xformed.resize(count);
+	LocalVector<real_t> dots;
+	dots.resize(count);
+	LocalVector<uint8_t> inside;
+	inside.resize(count);
+
+	for (int impl = 0; impl < BatchMath::IMPLEMENTATION_MAX; impl++) {
+		if (!BatchMath::is_implementation_supported(BatchMath::Implementation(impl))) {
+			continue;
+		}
+		BatchMath::set_implementation(BatchMath::Implementation(impl));
+
+		BenchmarkTimer timer;
+		for (int i = 0; i < iterations; i++) {
+			BatchMath::xform_points(data.xform, data.points.ptr(), xformed.ptr(), count);
+		}
+		const uint64_t xform_usec = timer.get_elapsed_usec();
+
+		timer.restart();
+		for (int i = 0; i < iterations; i++) {
+			BatchMath::dot(data.points.ptr(), data.other_points.ptr(), dots.ptr(), count);
+		}
+		const uint64_t dot_usec = timer.get_elapsed_usec();
+
+		timer.restart();
+		for (int i = 0; i < iterations; i++) {
+			BatchMath::cull_aabbs(data.aabbs.ptr(), count, data.planes, 6, inside.ptr());
+		}
+		const uint64_t cull_usec = timer.get_elapsed_usec();
+
+		BENCHMARK_MESSAGE("%s: %d x %d elements, xform_points %d usec, dot %d usec, cull_aabbs %d usec.", BatchMath::get_implementation_name(BatchMath::Implementation(impl)), iterations, count, xform_usec, dot_usec, cull_usec);
+	}
+
+	BatchMath::set_implementation(default_implementation);
+}
+
+} // namespace TestBatchMath
+
+#endif // TEST_BATCH_MATH_H
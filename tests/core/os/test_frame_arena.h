@@ -0,0 +1,222 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ARENA_H
+#define TEST_FRAME_ARENA_H
+
+#include "core/os/frame_arena.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocations are aligned and distinct") {
+	uint8_t *a = (uint8_t *)FrameArena::alloc(3);
+	uint8_t *b = (uint8_t *)FrameArena::alloc(100);
+	uint8_t *c = (uint8_t *)FrameArena::alloc(1);
+
+	CHECK(((uintptr_t)a % 16) == 0);
+	CHECK(((uintptr_t)b % 16) == 0);
+	CHECK(((uintptr_t)c % 16) == 0);
+	CHECK(b >= a + 3);
+	CHECK(c >= b + 100);
+	CHECK(FrameArena::get_thread_live_allocations() == 3);
+
+	memset(a, 0xAA, 3);
+	memset(b, 0xBB, 100);
+	memset(c, 0xCC, 1);
+	CHECK(a[2] == 0xAA);
+	CHECK(b[99] == 0xBB);
+	CHECK(c[0] == 0xCC);
+
+	FrameArena::free(c);
+	FrameArena::free(a);
+	FrameArena::free(b);
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+TEST_CASE("[FrameArena] Rewinds once all allocations are released") {
+	void *first = FrameArena::alloc(64);
+	FrameArena::free(first);
+
+	// The whole arena is reused, so the same address comes back.
+	void *second = FrameArena::alloc(64);
+	CHECK(second == first);
+	FrameArena::free(second);
+
+	void *outer = FrameArena::alloc(32);
+	void *inner = FrameArena::alloc(32);
+	FrameArena::free(inner);
+	// Releasing the most recent allocation makes its space reusable right away.
+	void *again = FrameArena::alloc(32);
+	CHECK(again == inner);
+	FrameArena::free(again);
+	FrameArena::free(outer);
+}
+
+TEST_CASE("[FrameArena] Reallocation keeps contents") {
+	int *values = (int *)FrameArena::alloc(4 * sizeof(int));
+	for (int i = 0; i < 4; i++) {
+		values[i] = i;
+	}
+
+	// Growing the most recent allocation happens in place.
+	int *grown = (int *)FrameArena::realloc(values, 64 * sizeof(int));
+	CHECK(grown == values);
+
+	// Growing an older one needs a copy.
+	void *blocker = FrameArena::alloc(16);
+	int *moved = (int *)FrameArena::realloc(grown, 256 * sizeof(int));
+	CHECK(moved != grown);
+	for (int i = 0; i < 4; i++) {
+		CHECK(moved[i] == i);
+	}
+	CHECK(FrameArena::get_thread_live_allocations() == 2);
+
+	FrameArena::free(blocker);
+	FrameArena::free(moved);
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+TEST_CASE("[FrameArena] Blocks are coalesced after spilling") {
+	LocalVector<void *> allocations;
+	// Enough to spill over several blocks.
+	for (int i = 0; i < 64; i++) {
+		allocations.push_back(FrameArena::alloc(8 * 1024));
+	}
+	const size_t capacity = FrameArena::get_thread_capacity();
+	CHECK(capacity >= 64 * 8 * 1024);
+	for (void *ptr : allocations) {
+		FrameArena::free(ptr);
+	}
+
+	// The next generation fits in a single block and doesn't grow further.
+	allocations.clear();
+	for (int i = 0; i < 64; i++) {
+		allocations.push_back(FrameArena::alloc(8 * 1024));
+	}
+	CHECK(FrameArena::get_thread_capacity() == capacity);
+	for (void *ptr : allocations) {
+		FrameArena::free(ptr);
+	}
+}
+
+TEST_CASE("[FrameArena] FrameLocalVector") {
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 1000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 1000);
+	CHECK(FrameArena::get_thread_live_allocations() == 1);
+
+	int64_t sum = 0;
+	for (int value : vector) {
+		sum += value;
+	}
+	CHECK(sum == 999 * 1000 / 2);
+
+	{
+		// Nested vectors are released in reverse order, as in recursive culling.
+		FrameLocalVector<String> strings;
+		strings.push_back("a");
+		strings.push_back("b");
+		CHECK(strings[1] == "b");
+		CHECK(FrameArena::get_thread_live_allocations() == 2);
+	}
+	CHECK(FrameArena::get_thread_live_allocations() == 1);
+
+	vector.reset();
+	CHECK(FrameArena::get_thread_live_allocations() == 0);
+}
+
+TEST_CASE("[FrameArena] Per-subsystem counters") {
+	static FrameArena::Counter counter("TestFrameArena");
+
+	bool registered = false;
+	for (FrameArena::Counter *E = FrameArena::get_first_counter(); E; E = E->get_next()) {
+		registered = registered || E == &counter;
+	}
+	CHECK(registered);
+
+	FrameArena::begin_frame();
+	{
+		FrameArena::CounterScope scope(counter);
+		FrameLocalVector<int> vector;
+		vector.reserve(16); // One allocation.
+		vector.reserve(1024); // One reallocation.
+	}
+	// Outside of the scope, nothing is attributed to the counter.
+	FrameLocalVector<int> unattributed;
+	unattributed.push_back(1);
+
+	const uint64_t frame = FrameArena::get_frame();
+	FrameArena::begin_frame();
+	CHECK(FrameArena::get_frame() == frame + 1);
+	CHECK(counter.get_last_frame_allocations() == 2);
+	CHECK(counter.get_last_frame_bytes() == (16 + 1024) * sizeof(int));
+
+	FrameArena::begin_frame();
+	CHECK(counter.get_last_frame_allocations() == 0);
+	CHECK(counter.get_total_allocations() == 2);
+}
+
+struct ThreadData {
+	void *ptr = nullptr;
+	uint32_t live = 0;
+};
+
+static void thread_arena_func(void *p_userdata) {
+	ThreadData *data = (ThreadData *)p_userdata;
+	FrameLocalVector<int> vector;
+	vector.resize(16);
+	data->ptr = vector.ptr();
+	data->live = FrameArena::get_thread_live_allocations();
+}
+
+TEST_CASE("[FrameArena] Arenas are per thread") {
+	void *main_ptr = FrameArena::alloc(64);
+
+	ThreadData data;
+	Thread thread;
+	thread.start(thread_arena_func, &data);
+	thread.wait_to_finish();
+
+	CHECK(data.live == 1);
+	CHECK(data.ptr != nullptr);
+	CHECK(data.ptr != main_ptr);
+	CHECK(FrameArena::get_thread_live_allocations() == 1);
+
+	FrameArena::free(main_ptr);
+}
+
+} // namespace TestFrameArena
+
+#endif // TEST_FRAME_ARENA_H
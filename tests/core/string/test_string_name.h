@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName from_cstring("test_string_name_interning");
+	const StringName from_string(String("test_string_name_interning"));
+	const StringName from_static = _scs_create("test_string_name_interning");
+
+	CHECK(from_cstring == from_string);
+	CHECK(from_cstring == from_static);
+	CHECK(from_cstring.data_unique_pointer() == from_string.data_unique_pointer());
+	CHECK(from_cstring == String("test_string_name_interning"));
+	CHECK(String(from_static) == "test_string_name_interning");
+
+	CHECK(StringName() == StringName(""));
+	CHECK(StringName("a") != StringName("b"));
+}
+
+TEST_CASE("[StringName] Search") {
+	CHECK(StringName::search("test_string_name_never_created") == StringName());
+
+	const StringName name("test_string_name_search");
+	CHECK(StringName::search("test_string_name_search") == name);
+	CHECK(StringName::search(String("test_string_name_search")) == name);
+	CHECK(StringName::search(U"test_string_name_search") == name);
+}
+
+TEST_CASE("[StringName] Released names can be created again") {
+	const void *first = nullptr;
+	{
+		const StringName name("test_string_name_released");
+		first = name.data_unique_pointer();
+		CHECK(first != nullptr);
+	}
+	CHECK(StringName::search("test_string_name_released") == StringName());
+
+	const StringName again("test_string_name_released");
+	CHECK(again == String("test_string_name_released"));
+}
+
+TEST_CASE("[StringName] Many names") {
+	// Enough to make the table grow several times.
+	LocalVector<StringName> names;
+	for (int i = 0; i < 50000; i++) {
+		names.push_back(StringName("test_string_name_many_" + itos(i)));
+	}
+
+	bool all_found = true;
+	for (int i = 0; i < 50000; i++) {
+		all_found = all_found && StringName::search("test_string_name_many_" + itos(i)) == names[i];
+	}
+	CHECK(all_found);
+}
+
+struct StressData {
+	static constexpr int NAMES = 4096;
+	static constexpr int ITERATIONS = 20000;
+
+	LocalVector<String> strings;
+	LocalVector<StringName> names;
+	SafeNumeric<uint32_t> mismatches;
+};
+
+static void stress_string_names(void *p_userdata, uint32_t p_index) {
+	StressData *data = (StressData *)p_userdata;
+	for (int i = 0; i < StressData::ITERATIONS; i++) {
+		const uint32_t idx = (i * 7919 + p_index * 104729) % StressData::NAMES;
+
+		// Lookups of names that exist.
+		if (StringName(data->strings[idx]) != data->names[idx]) {
+			data->mismatches.increment();
+		}
+
+		// Short-lived names, created and released concurrently.
+		const String temp = "stress_temp_" + itos(p_index) + "_" + itos(i % 64);
+		const StringName temp_name(temp);
+		if (StringName::search(temp) != temp_name) {
+			data->mismatches.increment();
+		}
+	}
+}
+
+TEST_CASE("[StringName][Stress] Lookups and interning from every core") {
+	StressData data;
+	for (int i = 0; i < StressData::NAMES; i++) {
+		data.strings.push_back("stress_name_" + itos(i));
+		data.names.push_back(StringName(data.strings[i]));
+	}
+
+	const int thread_count = MAX(1, OS::get_singleton()->get_processor_count());
+	const uint64_t start = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&stress_string_names, &data, thread_count, thread_count, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+	CHECK(data.mismatches.get() == 0);
+	MESSAGE(vformat("%d threads x %d iterations: %d usec.", thread_count, StressData::ITERATIONS, elapsed));
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -446,6 +446,264 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+
+// The scheme CommandQueueMT used before the per-producer buffers, kept as a baseline:
+// a single buffer, locked for every push and for the whole flush.
+class LockedCommandQueue {
+	struct CommandBase {
+		bool sync = false;
+		virtual void call() = 0;
+		virtual ~CommandBase() = default;
+	};
+
+	template <typename T, typename M, typename P1, typename P2>
+	struct Command2 : public CommandBase {
+		T *instance;
+		M method;
+		P1 p1;
+		P2 p2;
+		virtual void call() override { (instance->*method)(p1, p2); }
+		Command2(T *p_instance, M p_method, P1 p_p1, P2 p_p2) :
+				instance(p_instance), method(p_method), p1(p_p1), p2(p_p2) {}
+	};
+
+	template <typename T, typename M, typename P1, typename P2, typename R>
+	struct CommandRet2 : public CommandBase {
+		T *instance;
+		M method;
+		P1 p1;
+		P2 p2;
+		R *ret;
+		virtual void call() override { *ret = (instance->*method)(p1, p2); }
+		CommandRet2(T *p_instance, M p_method, P1 p_p1, P2 p_p2, R *r_ret) :
+				instance(p_instance), method(p_method), p1(p_p1), p2(p_p2), ret(r_ret) {
+			sync = true;
+		}
+	};
+
+	struct SyncCommand : public CommandBase {
+		virtual void call() override {}
+		SyncCommand() { sync = true; }
+	};
+
+	BinaryMutex mutex;
+	LocalVector<uint8_t> command_mem;
+	ConditionVariable sync_cond_var;
+	uint32_t sync_head = 0;
+	uint32_t sync_tail = 0;
+
+	template <typename T, typename... Args>
+	void _push(Args... p_args) {
+		uint32_t alloc_size = ((sizeof(T) + 8 - 1) & ~(8 - 1));
+		uint64_t size = command_mem.size();
+		command_mem.resize(size + alloc_size + 8);
+		*(uint64_t *)&command_mem[size] = alloc_size;
+		memnew_placement(&command_mem[size + 8], T(p_args...));
+	}
+
+	void _wait_for_sync(MutexLock<BinaryMutex> &p_lock) {
+		uint32_t sync_head_goal = ++sync_tail;
+		do {
+			sync_cond_var.wait(p_lock);
+		} while (sync_head < sync_head_goal);
+	}
+
+	void _flush() {
+		MutexLock lock(mutex);
+		uint64_t read_ptr = 0;
+		while (read_ptr < command_mem.size()) {
+			uint64_t size = *(uint64_t *)&command_mem[read_ptr];
+			read_ptr += 8;
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[read_ptr]);
+			cmd->call();
+			if (cmd->sync) {
+				sync_head++;
+				sync_cond_var.notify_all();
+			}
+			cmd->~CommandBase();
+			read_ptr += size;
+		}
+		command_mem.clear();
+	}
+
+public:
+	template <typename T, typename M, typename P1, typename P2>
+	void push(T *p_instance, M p_method, P1 p_p1, P2 p_p2) {
+		MutexLock lock(mutex);
+		_push<Command2<T, M, P1, P2>>(p_instance, p_method, p_p1, p_p2);
+	}
+
+	template <typename T, typename M, typename P1, typename P2, typename R>
+	void push_and_ret(T *p_instance, M p_method, P1 p_p1, P2 p_p2, R *r_ret) {
+		MutexLock lock(mutex);
+		_push<CommandRet2<T, M, P1, P2, R>>(p_instance, p_method, p_p1, p_p2, r_ret);
+		_wait_for_sync(lock);
+	}
+
+	void flush_if_pending() {
+		if (command_mem.size() > 0) {
+			_flush();
+		}
+	}
+
+	void flush_all() {
+		_flush();
+	}
+
+	void sync() {
+		MutexLock lock(mutex);
+		_push<SyncCommand>();
+		_wait_for_sync(lock);
+	}
+};
+
+template <typename Q>
+class MultiProducerState {
+public:
+	Q command_queue;
+	SafeFlag exit_consumer;
+	LocalVector<uint32_t> received; // Per producer, only touched by the consumer.
+	uint32_t out_of_order = 0;
+	uint32_t commands_per_producer = 0;
+
+	void receive(uint32_t p_producer, uint32_t p_sequence) {
+		if (received[p_producer] != p_sequence) {
+			out_of_order++;
+		}
+		received[p_producer] = p_sequence + 1;
+	}
+	uint32_t receive_and_ret(uint32_t p_producer, uint32_t p_sequence) {
+		receive(p_producer, p_sequence);
+		return p_sequence;
+	}
+
+	static void consumer_loop(void *p_userdata) {
+		MultiProducerState *mps = static_cast<MultiProducerState *>(p_userdata);
+		while (!mps->exit_consumer.is_set()) {
+			mps->command_queue.flush_if_pending();
+		}
+		mps->command_queue.flush_all();
+	}
+
+	struct ProducerData {
+		MultiProducerState *state = nullptr;
+		uint32_t index = 0;
+		uint32_t wrong_returns = 0;
+	};
+
+	static void producer_loop(void *p_userdata) {
+		ProducerData *pd = static_cast<ProducerData *>(p_userdata);
+		MultiProducerState *mps = pd->state;
+		for (uint32_t i = 0; i < mps->commands_per_producer; i++) {
+			if (i % 64 == 63) {
+				uint32_t ret = 0;
+				mps->command_queue.push_and_ret(mps, &MultiProducerState::receive_and_ret, pd->index, i, &ret);
+				if (ret != i) {
+					pd->wrong_returns++;
+				}
+			} else {
+				mps->command_queue.push(mps, &MultiProducerState::receive, pd->index, i);
+			}
+		}
+	}
+};
+
+// Returns the time it took for every command to be pushed and flushed.
+template <typename Q>
+static uint64_t test_command_queue_multi_producer(uint32_t p_producers, uint32_t p_commands_per_producer) {
+	MultiProducerState<Q> mps;
+	mps.commands_per_producer = p_commands_per_producer;
+	mps.received.resize(p_producers);
+	for (uint32_t i = 0; i < p_producers; i++) {
+		mps.received[i] = 0;
+	}
+
+	Thread consumer;
+	consumer.start(&MultiProducerState<Q>::consumer_loop, &mps);
+
+	BenchmarkTimer timer;
+	LocalVector<typename MultiProducerState<Q>::ProducerData> producer_data;
+	producer_data.resize(p_producers);
+	LocalVector<Thread> producers;
+	producers.resize(p_producers);
+	for (uint32_t i = 0; i < p_producers; i++) {
+		producer_data[i].state = &mps;
+		producer_data[i].index = i;
+		producers[i].start(&MultiProducerState<Q>::producer_loop, &producer_data[i]);
+	}
+	for (uint32_t i = 0; i < p_producers; i++) {
+		producers[i].wait_to_finish();
+	}
+	mps.command_queue.sync();
+	uint64_t elapsed = timer.get_elapsed_usec();
+
+	mps.exit_consumer.set();
+	consumer.wait_to_finish();
+
+	bool all_received = true;
+	uint32_t wrong_returns = 0;
+	for (uint32_t i = 0; i < p_producers; i++) {
+		all_received &= mps.received[i] == mps.commands_per_producer;
+		wrong_returns += producer_data[i].wrong_returns;
+	}
+	CHECK_MESSAGE(all_received, "Every command from every producer should have been flushed.");
+	CHECK_MESSAGE(mps.out_of_order == 0, "Commands from the same producer should be flushed in push order.");
+	CHECK_MESSAGE(wrong_returns == 0, "Every push_and_ret() should have received its own return value.");
+
+	return elapsed;
+}
+
+TEST_CASE("[CommandQueue] Multiple producers and a single consumer") {
+	test_command_queue_multi_producer<CommandQueueMT>(4, 2000);
+}
+
+TEST_CASE("[CommandQueue][Benchmark] Multiple producers and a single consumer") {
+	const uint32_t commands_per_producer = 20000;
+	const uint32_t producer_counts[] = { 1, 4, 16 };
+	for (uint32_t producers : producer_counts) {
+		uint64_t total = (uint64_t)commands_per_producer * producers;
+		uint64_t locked_usec = test_command_queue_multi_producer<LockedCommandQueue>(producers, commands_per_producer);
+		uint64_t current_usec = test_command_queue_multi_producer<CommandQueueMT>(producers, commands_per_producer);
+		BENCHMARK_MESSAGE("%d producer(s), %d commands: single locked buffer %d commands/s, CommandQueueMT %d commands/s (%.2fx).",
+				producers, total, total * 1000000 / locked_usec, total * 1000000 / current_usec, (double)locked_usec / current_usec);
+	}
+}
+
+class ConcurrentFlushState {
+public:
+	CommandQueueMT command_queue;
+	SafeFlag command_started;
+	SafeFlag command_finished;
+
+	void slow_command() {
+		command_started.set();
+		OS::get_singleton()->delay_usec(50000);
+		command_finished.set();
+	}
+
+	static void flush_loop(void *p_userdata) {
+		ConcurrentFlushState *cfs = static_cast<ConcurrentFlushState *>(p_userdata);
+		cfs->command_queue.flush_all();
+	}
+};
+
+TEST_CASE("[CommandQueue] Flushing while another thread flushes waits for its commands") {
+	ConcurrentFlushState cfs;
+	cfs.command_queue.push(&cfs, &ConcurrentFlushState::slow_command);
+
+	Thread flusher;
+	flusher.start(&ConcurrentFlushState::flush_loop, &cfs);
+	while (!cfs.command_started.is_set()) {
+		OS::get_singleton()->delay_usec(100);
+	}
+
+	// The other thread is running the command, this flush must not return before it's done.
+	cfs.command_queue.flush_all();
+	CHECK(cfs.command_finished.is_set());
+
+	flusher.wait_to_finish();
+}
+
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
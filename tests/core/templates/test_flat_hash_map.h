@@ -0,0 +1,314 @@
+/**************************************************************************/
+/*  test_flat_hash_map.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FLAT_HASH_MAP_H
+#define TEST_FLAT_HASH_MAP_H
+
+#include "core/os/os.h"
+#include "core/templates/flat_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/oa_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFlatHashMap {
+
+TEST_CASE("[FlatHashMap] Insert element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+	CHECK(!map.has(43));
+	CHECK(!map.find(43));
+}
+
+TEST_CASE("[FlatHashMap] Overwrite element") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[FlatHashMap] Erase via element") {
+	FlatHashMap<int, int> map;
+	FlatHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[FlatHashMap] Erase via key") {
+	FlatHashMap<int, int> map;
+	map.insert(42, 84);
+	CHECK(map.erase(42));
+	CHECK(!map.erase(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[FlatHashMap] Many elements") {
+	FlatHashMap<int, int> map;
+	for (int i = 0; i < 10000; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.size() == 10000);
+
+	for (int i = 0; i < 10000; i += 2) {
+		CHECK(map.erase(i));
+	}
+	CHECK(map.size() == 5000);
+
+	bool all_found = true;
+	for (int i = 0; i < 10000; i++) {
+		const int *value = map.getptr(i);
+		if (i % 2 == 0) {
+			all_found = all_found && value == nullptr;
+		} else {
+			all_found = all_found && value != nullptr && *value == i * 2;
+		}
+	}
+	CHECK(all_found);
+
+	int count = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key % 2 == 1);
+		count++;
+	}
+	CHECK(count == 5000);
+
+	// Reinsert into the deleted slots.
+	for (int i = 0; i < 10000; i += 2) {
+		map[i] = -i;
+	}
+	CHECK(map.size() == 10000);
+	CHECK(map[9998] == -9998);
+	CHECK(map[9999] == 9999 * 2);
+}
+
+TEST_CASE("[FlatHashMap] Churn") {
+	// Keep a small working set while inserting and erasing many distinct
+	// keys, which fills the table with deleted slots.
+	FlatHashMap<int, int> map;
+	bool all_erased = true;
+	for (int i = 0; i < 100000; i++) {
+		map.insert(i, i);
+		if (i >= 8) {
+			all_erased = map.erase(i - 8) && all_erased;
+		}
+	}
+	CHECK(all_erased);
+	CHECK(map.size() == 8);
+	CHECK(map.get_capacity() <= 64);
+	for (int i = 100000 - 8; i < 100000; i++) {
+		CHECK(map.has(i));
+	}
+}
+
+TEST_CASE("[FlatHashMap] String keys") {
+	FlatHashMap<String, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(itos(i), i);
+	}
+	CHECK(map.has("999"));
+	CHECK(map["500"] == 500);
+	map.erase("500");
+	CHECK(!map.has("500"));
+
+	FlatHashMap<String, int> copy = map;
+	CHECK(copy.size() == 999);
+	CHECK(copy["998"] == 998);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has("1"));
+	CHECK(copy.has("1"));
+}
+
+TEST_CASE("[FlatHashMap] Insert values from the map itself") {
+	// Every growth moves the entries the arguments point to.
+	FlatHashMap<String, String> map;
+	map.insert("0", "value");
+	bool values_match = true;
+	for (int i = 1; i < 1000; i++) {
+		map.insert(itos(i), map[itos(i - 1)]);
+		values_match = values_match && map[itos(i)] == "value";
+	}
+	CHECK(values_match);
+	CHECK(map.size() == 1000);
+}
+
+TEST_CASE("[FlatHashMap] Reserve") {
+	FlatHashMap<int, int> map;
+	map.reserve(1000);
+	const uint32_t capacity = map.get_capacity();
+	CHECK(capacity >= 1000);
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i);
+	}
+	CHECK(map.get_capacity() == capacity);
+}
+
+TEST_CASE("[FlatHashMap] Ordered iteration") {
+	OrderedFlatHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		++idx;
+	}
+	CHECK(idx == 4);
+
+	map.erase(123);
+	map.erase(42);
+	expected.remove_at(1);
+	expected.remove_at(0);
+	map.insert(7, 7);
+	expected.push_back(Pair<int, int>(7, 7));
+
+	const OrderedFlatHashMap<int, int> const_map = map;
+	idx = 0;
+	for (const KeyValue<int, int> &E : const_map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		++idx;
+	}
+	CHECK(idx == 3);
+	CHECK(const_map.last()->key == 7);
+}
+
+TEST_CASE("[FlatHashMap] Ordered mode keeps order through rehashes") {
+	OrderedFlatHashMap<int, int> map;
+	for (int i = 0; i < 5000; i++) {
+		map.insert(i, i);
+	}
+	for (int i = 0; i < 5000; i += 3) {
+		map.erase(i);
+	}
+	for (int i = 5000; i < 10000; i++) {
+		map.insert(i, i);
+	}
+
+	int previous = -1;
+	bool in_order = true;
+	uint32_t count = 0;
+	for (const KeyValue<int, int> &E : map) {
+		in_order = in_order && E.key > previous && (E.key >= 5000 || E.key % 3 != 0);
+		previous = E.key;
+		count++;
+	}
+	CHECK(in_order);
+	CHECK(count == map.size());
+}
+
+template <typename M>
+static uint64_t benchmark_insert(M &r_map, const LocalVector<uint32_t> &p_keys) {
+	const BenchmarkTimer timer;
+	for (uint32_t key : p_keys) {
+		r_map.insert(key, key);
+	}
+	return timer.get_elapsed_usec();
+}
+
+template <typename M>
+static uint64_t benchmark_lookup(const M &p_map, const LocalVector<uint32_t> &p_keys, uint64_t &r_sum) {
+	const BenchmarkTimer timer;
+	for (int pass = 0; pass < 4; pass++) {
+		for (uint32_t key : p_keys) {
+			const uint32_t *value = p_map.getptr(key);
+			r_sum += value ? *value : 1;
+		}
+	}
+	return timer.get_elapsed_usec();
+}
+
+// OAHashMap has a different lookup API.
+static uint64_t benchmark_lookup(const OAHashMap<uint32_t, uint32_t> &p_map, const LocalVector<uint32_t> &p_keys, uint64_t &r_sum) {
+	const BenchmarkTimer timer;
+	for (int pass = 0; pass < 4; pass++) {
+		for (uint32_t key : p_keys) {
+			uint32_t value = 1;
+			p_map.lookup(key, value);
+			r_sum += value;
+		}
+	}
+	return timer.get_elapsed_usec();
+}
+
+template <typename M>
+static void benchmark_map(const char *p_name, const LocalVector<uint32_t> &p_keys, const LocalVector<uint32_t> &p_missing_keys, uint64_t &r_sum) {
+	M map;
+	const uint64_t insert_usec = benchmark_insert(map, p_keys);
+	const uint64_t hit_usec = benchmark_lookup(map, p_keys, r_sum);
+	const uint64_t miss_usec = benchmark_lookup(map, p_missing_keys, r_sum);
+	BENCHMARK_MESSAGE("%s: %d elements, insert %d usec, 4x hit %d usec, 4x miss %d usec.", p_name, p_keys.size(), insert_usec, hit_usec, miss_usec);
+}
+
+TEST_CASE("[FlatHashMap][Benchmark] Compare with HashMap and OAHashMap") {
+	const uint32_t count = 200000;
+	LocalVector<uint32_t> keys;
+	LocalVector<uint32_t> missing_keys;
+	keys.resize(count);
+	missing_keys.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		keys[i] = hash_murmur3_one_32(i);
+		missing_keys[i] = hash_murmur3_one_32(i + count);
+	}
+
+	uint64_t sums[3] = {};
+	benchmark_map<HashMap<uint32_t, uint32_t>>("HashMap", keys, missing_keys, sums[0]);
+	benchmark_map<OAHashMap<uint32_t, uint32_t>>("OAHashMap", keys, missing_keys, sums[1]);
+	benchmark_map<FlatHashMap<uint32_t, uint32_t>>("FlatHashMap", keys, missing_keys, sums[2]);
+
+	// All maps must have found the same values.
+	CHECK(sums[0] == sums[1]);
+	CHECK(sums[0] == sums[2]);
+}
+
+} // namespace TestFlatHashMap
+
+#endif // TEST_FLAT_HASH_MAP_H
@@ -462,6 +462,43 @@ TEST_CASE("[Vector] Size, resize, reserve") {
 	CHECK(vector.size() == 4);
 }
 
+TEST_CASE("[Vector] Resize shared") {
+	Vector<String> vector;
+	vector.push_back("a");
+	vector.push_back("b");
+	vector.push_back("c");
+
+	Vector<String> grown = vector;
+	grown.resize(5);
+	CHECK(grown.size() == 5);
+	CHECK(grown[0] == "a");
+	CHECK(grown[2] == "c");
+	CHECK(grown[3].is_empty());
+	CHECK(grown[4].is_empty());
+	grown.write[0] = "x";
+
+	Vector<String> shrunk = vector;
+	shrunk.resize(1);
+	CHECK(shrunk.size() == 1);
+	CHECK(shrunk[0] == "a");
+
+	// The original buffer must be untouched by either copy.
+	CHECK(vector.size() == 3);
+	CHECK(vector[0] == "a");
+	CHECK(vector[1] == "b");
+	CHECK(vector[2] == "c");
+
+	Vector<uint8_t> bytes;
+	bytes.push_back(1);
+	bytes.push_back(2);
+	Vector<uint8_t> bytes_copy = bytes;
+	bytes_copy.resize_zeroed(4);
+	CHECK(bytes_copy.size() == 4);
+	CHECK(bytes_copy[1] == 2);
+	CHECK(bytes_copy[3] == 0);
+	CHECK(bytes.size() == 2);
+}
+
 TEST_CASE("[Vector] Sort") {
 	Vector<int> vector;
 	vector.push_back(2);
@@ -173,6 +173,183 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static SafeNumeric<int> dependency_step;
+static LocalVector<int> dependency_order;
+
+static void static_dependency_chain_test(void *p_arg) {
+	dependency_order[(uintptr_t)p_arg] = dependency_step.postincrement();
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks with dependencies run after their dependencies") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(1.0f, 6.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		dependency_step.set(0);
+		dependency_order.clear();
+		dependency_order.resize(count);
+
+		LocalVector<WorkerThreadPool::TaskID> chain;
+		for (int i = 0; i < count; i++) {
+			Vector<WorkerThreadPool::TaskID> dependencies;
+			if (i > 0) {
+				dependencies.push_back(chain[i - 1]);
+			}
+			chain.push_back(WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_dependency_chain_test, (void *)(uintptr_t)i, dependencies, !low_priority));
+		}
+		for (int i = count - 1; i >= 0; i--) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(chain[i]);
+		}
+
+		bool in_order = true;
+		for (int i = 0; i < count; i++) {
+			in_order &= dependency_order[i] == i;
+		}
+		CHECK_MESSAGE(in_order, "Chained tasks should run in dependency order.");
+	}
+}
+
+static void static_dependency_group_test(void *p_arg, uint32_t p_index) {
+	counter[p_index].increment();
+}
+
+static void static_dependency_join_test(void *p_arg) {
+	bool all_done = true;
+	for (uint32_t i = 0; i < counter.size(); i++) {
+		all_done &= counter[i].get() == 1;
+	}
+	*((bool *)p_arg) = all_done;
+}
+
+TEST_CASE("[WorkerThreadPool] Group tasks as dependencies and dependents") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 8.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(count);
+		exit.clear();
+
+		// A task gating a group, which in turn gates a join task.
+		WorkerThreadPool::TaskID gate = WorkerThreadPool::get_singleton()->add_native_task(static_busy_task, nullptr, true);
+		Vector<WorkerThreadPool::TaskID> group_dependencies;
+		group_dependencies.push_back(gate);
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_dependency_group_test, nullptr, count, group_dependencies, -1, !low_priority);
+
+		bool join_saw_group_done = false;
+		Vector<WorkerThreadPool::TaskID> join_dependencies;
+		join_dependencies.push_back(group);
+		WorkerThreadPool::TaskID join = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_dependency_join_test, &join_saw_group_done, join_dependencies, !low_priority);
+
+		CHECK_FALSE(WorkerThreadPool::get_singleton()->is_group_task_completed(group));
+		CHECK(WorkerThreadPool::get_singleton()->get_group_processed_element_count(group) == 0);
+
+		// Release the gate.
+		exit.set();
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(gate);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(join);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		exit.clear();
+
+		CHECK_MESSAGE(join_saw_group_done, "The join task should only run once the whole group is done.");
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Empty group tasks wait for their dependencies") {
+	exit.clear();
+
+	WorkerThreadPool::TaskID gate = WorkerThreadPool::get_singleton()->add_native_task(static_busy_task, nullptr, true);
+	Vector<WorkerThreadPool::TaskID> group_dependencies;
+	group_dependencies.push_back(gate);
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task_with_dependencies(static_dependency_group_test, nullptr, 0, group_dependencies, -1, true);
+	CHECK_FALSE(WorkerThreadPool::get_singleton()->is_group_task_completed(group));
+
+	// Release the gate.
+	exit.set();
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(gate);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	exit.clear();
+}
+
+TEST_CASE("[WorkerThreadPool] Dependencies that were already completed are satisfied") {
+	counter.clear();
+	counter.resize(1);
+
+	WorkerThreadPool::TaskID first = WorkerThreadPool::get_singleton()->add_native_task(static_test, (void *)(uintptr_t)0, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(first);
+
+	Vector<WorkerThreadPool::TaskID> dependencies;
+	dependencies.push_back(first); // Already awaited and disposed of.
+	WorkerThreadPool::TaskID second = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_test, (void *)(uintptr_t)0, dependencies, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(second);
+
+	CHECK(counter[0].get() == 6);
+}
+
+static void static_stress_leaf(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_stress_spawner(void *p_arg) {
+	// Post a small task graph from within a pool thread, to stress submissions from many threads at once.
+	const int leaves = (int)(uintptr_t)p_arg;
+	Vector<WorkerThreadPool::TaskID> leaf_ids;
+	for (int i = 0; i < leaves; i++) {
+		leaf_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_stress_leaf, nullptr, true));
+	}
+	WorkerThreadPool::TaskID join = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_stress_leaf, nullptr, leaf_ids, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(join);
+	for (int i = 0; i < leaves; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(leaf_ids[i]);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Many threads posting dependent tasks concurrently") {
+	counter.clear();
+	counter.resize(1);
+
+	const int spawners = WorkerThreadPool::get_singleton()->get_thread_count() * 4;
+	const int leaves = 64;
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	LocalVector<WorkerThreadPool::TaskID> spawner_ids;
+	for (int i = 0; i < spawners; i++) {
+		spawner_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(static_stress_spawner, (void *)(uintptr_t)leaves, true));
+	}
+	for (uint32_t i = 0; i < spawner_ids.size(); i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(spawner_ids[i]);
+	}
+	uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+	MESSAGE(vformat("%d tasks posted from %d pool threads in %d usec.", spawners * (leaves + 1), spawners, elapsed));
+
+	CHECK(counter[0].get() == spawners * (leaves + 1));
+}
+
+static void static_depend_on_group(void *p_arg) {
+	// Races with the main thread disposing of the group it depends on.
+	Vector<WorkerThreadPool::TaskID> dependencies;
+	dependencies.push_back(*(WorkerThreadPool::GroupID *)p_arg);
+	WorkerThreadPool::TaskID task = WorkerThreadPool::get_singleton()->add_native_task_with_dependencies(static_stress_leaf, nullptr, dependencies, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+}
+
+TEST_CASE("[WorkerThreadPool] Depending on a group while it is being disposed of") {
+	counter.clear();
+	counter.resize(1);
+
+	const int iterations = 500;
+	for (int i = 0; i < iterations; i++) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_dependency_group_test, nullptr, 1, -1, true);
+		Thread thread;
+		thread.start(static_depend_on_group, &group);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		thread.wait_to_finish();
+	}
+
+	// The group tasks also count in counter[0].
+	CHECK(counter[0].get() == iterations * 2);
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
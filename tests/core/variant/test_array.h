@@ -597,6 +597,90 @@ TEST_CASE("[Array] Iteration and modification") {
 	a4.clear();
 }
 
+TEST_CASE("[Array] Packed typed arrays") {
+	Array untyped = build_array(Vector3(1, 2, 3), Vector3(4, 5, 6));
+	Array vectors;
+	vectors.set_typed(Variant::VECTOR3, StringName(), Variant());
+	CHECK(vectors.is_packed());
+
+	vectors.push_back(Vector3(1, 2, 3));
+	vectors.push_back(Vector3(4, 5, 6));
+	CHECK(vectors.is_packed());
+	CHECK_EQ(vectors.size(), 2);
+	CHECK_EQ(vectors.get_value(1), Variant(Vector3(4, 5, 6)));
+	CHECK_EQ(vectors, untyped);
+	CHECK_EQ(vectors.hash(), untyped.hash());
+	CHECK_EQ(vectors.find(Vector3(4, 5, 6)), 1);
+
+	vectors.insert(0, Vector3(7, 8, 9));
+	vectors.remove_at(1);
+	CHECK_EQ(vectors.front(), Variant(Vector3(7, 8, 9)));
+	CHECK_EQ(vectors.pop_back(), Variant(Vector3(4, 5, 6)));
+	CHECK_EQ(vectors.size(), 1);
+	CHECK(vectors.is_packed());
+
+	Array vectors_copy = vectors.duplicate();
+	CHECK(vectors_copy.is_packed());
+	CHECK_EQ(vectors_copy, vectors);
+
+	// Int values are validated into floats before being packed.
+	Array floats;
+	floats.set_typed(Variant::FLOAT, StringName(), Variant());
+	floats.push_back(3);
+	floats.push_back(1.5);
+	floats.sort();
+	CHECK(floats.is_packed());
+	CHECK_EQ(floats.get_value(0).get_type(), Variant::FLOAT);
+	CHECK_EQ(double(floats.get_value(0)), 1.5);
+	CHECK_EQ(double(floats.get_value(1)), 3.0);
+
+	// New elements get the default value of the type, which is not always zero.
+	Array colors;
+	colors.set_typed(Variant::COLOR, StringName(), Variant());
+	colors.resize(2);
+	CHECK(colors.is_packed());
+	CHECK_EQ(colors.get_value(1), Variant(Color()));
+	colors.set(0, Color(1, 0, 0));
+	CHECK_EQ(colors.get_value(0), Variant(Color(1, 0, 0)));
+
+	PackedColorArray packed_colors = Variant(colors);
+	CHECK_EQ(packed_colors.size(), 2);
+	CHECK_EQ(packed_colors[0], Color(1, 0, 0));
+
+	// Taking a reference to an element unpacks the array, without changing its contents.
+	colors[1] = Color(0, 1, 0);
+	CHECK_FALSE(colors.is_packed());
+	CHECK_EQ(colors.get_value(0), Variant(Color(1, 0, 0)));
+	CHECK_EQ(colors.get_value(1), Variant(Color(0, 1, 0)));
+
+	// Clearing packs it again.
+	colors.clear();
+	CHECK(colors.is_packed());
+
+	// Const reads leave it packed, since other threads may be reading it too.
+	colors.push_back(Color(0, 0, 1));
+	colors.push_back(Color(1, 1, 0));
+	const Array &const_colors = colors;
+	const Variant &first = const_colors[0];
+	const Variant &second = const_colors[1];
+	CHECK_EQ(first, Variant(Color(0, 0, 1)));
+	CHECK_EQ(second, Variant(Color(1, 1, 0)));
+	int count = 0;
+	for (const Variant &color : const_colors) {
+		CHECK_EQ(color, colors.get_value(count));
+		count++;
+	}
+	CHECK_EQ(count, 2);
+	CHECK(colors.is_packed());
+	CHECK(colors.get_packed_data(Variant::COLOR, sizeof(Color)) != nullptr);
+
+	// Types that are not plain values are never packed.
+	Array strings;
+	strings.set_typed(Variant::STRING, StringName(), Variant());
+	CHECK_FALSE(strings.is_packed());
+	CHECK_FALSE(untyped.is_packed());
+}
+
 } // namespace TestArray
 
 #endif // TEST_ARRAY_H
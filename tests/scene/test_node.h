@@ -55,6 +55,10 @@ protected:
 			} break;
 			case NOTIFICATION_PROCESS: {
 				process_counter++;
+				processed_in_main_thread = Thread::is_main_thread();
+				if (!process_node_path.is_empty()) {
+					get_node_or_null(process_node_path);
+				}
 				push_self();
 			} break;
 			case NOTIFICATION_PHYSICS_PROCESS: {
@@ -82,6 +86,8 @@ public:
 	int internal_physics_process_counter = 0;
 	int process_counter = 0;
 	int physics_process_counter = 0;
+	bool processed_in_main_thread = false;
+	NodePath process_node_path; // Looked up on each process, to test thread partitioning.
 
 	Node *exported_node = nullptr;
 
@@ -422,6 +428,40 @@ TEST_CASE("[SceneTree][Node] Testing node operations with a more complex simple
 		CHECK_EQ(E->get(), node1_1);
 	}
 
+	SUBCASE("Group snapshots should stay sorted and stable") {
+		SceneTree *tree = SceneTree::get_singleton();
+		CHECK_EQ(tree->get_group_version("nodes"), 0u);
+
+		// Added out of order, inserted in scene hierarchy order.
+		node2->add_to_group("nodes");
+		node1_1->add_to_group("nodes");
+		node1->add_to_group("nodes");
+
+		SceneTree::GroupSnapshot snapshot = tree->get_group_snapshot("nodes");
+		REQUIRE_EQ(snapshot.nodes.size(), 3);
+		CHECK_EQ(snapshot.nodes[0], node1);
+		CHECK_EQ(snapshot.nodes[1], node1_1);
+		CHECK_EQ(snapshot.nodes[2], node2);
+		CHECK_EQ(snapshot.version, tree->get_group_version("nodes"));
+
+		TypedArray<Node> array = tree->call("get_group_snapshot", "nodes");
+		CHECK(array.is_read_only());
+		CHECK_EQ(array.size(), 3);
+		TypedArray<Node> same_array = tree->call("get_group_snapshot", "nodes");
+		CHECK_EQ(array.id(), same_array.id());
+
+		node1->remove_from_group("nodes");
+		CHECK_NE(snapshot.version, tree->get_group_version("nodes"));
+		CHECK_EQ(snapshot.nodes.size(), 3);
+		CHECK_EQ(array.size(), 3);
+
+		TypedArray<Node> new_array = tree->call("get_group_snapshot", "nodes");
+		CHECK_NE(array.id(), new_array.id());
+		REQUIRE_EQ(new_array.size(), 2);
+		CHECK_EQ(Object::cast_to<Node>(new_array[0]), node1_1);
+		CHECK_EQ(Object::cast_to<Node>(new_array[1]), node2);
+	}
+
 	SUBCASE("Nodes added as siblings of another node should be right next to it") {
 		node1->remove_child(node1_1);
 
@@ -835,6 +875,194 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 	memdelete(node4);
 }
 
+TEST_CASE("[SceneTree][Node] Automatic thread partitioning") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *scene = memnew(Node);
+	tree->get_root()->add_child(scene);
+	tree->set_current_scene(scene);
+
+	TestNode *node_a = memnew(TestNode);
+	node_a->set_name("A");
+	scene->add_child(node_a);
+	TestNode *node_b = memnew(TestNode);
+	node_b->set_name("B");
+	scene->add_child(node_b);
+	TestNode *node_c = memnew(TestNode);
+	node_c->set_name("C");
+	scene->add_child(node_c);
+	node_a->set_process(true);
+	node_b->set_process(true);
+	node_c->set_process(true);
+
+	tree->set_auto_thread_partitioning_enabled(true);
+
+	SUBCASE("Independent subtrees are processed in threads") {
+		tree->process(0);
+
+		CHECK_EQ(1, node_a->process_counter);
+		CHECK_EQ(1, node_b->process_counter);
+		CHECK_FALSE(node_a->processed_in_main_thread);
+		CHECK_FALSE(node_b->processed_in_main_thread);
+	}
+
+	SUBCASE("Subtrees connected by signals stay in the main thread") {
+		node_a->connect(SNAME("renamed"), callable_mp((Node *)node_b, &Node::update_configuration_warnings));
+		tree->process(0);
+
+		CHECK_EQ(1, node_a->process_counter);
+		CHECK(node_a->processed_in_main_thread);
+		CHECK(node_b->processed_in_main_thread);
+		CHECK_FALSE(node_c->processed_in_main_thread);
+	}
+
+	SUBCASE("Connections made after partitioning update the partitions") {
+		tree->process(0);
+		CHECK_FALSE(node_a->processed_in_main_thread);
+		CHECK_FALSE(node_b->processed_in_main_thread);
+
+		const Callable callable = callable_mp((Node *)node_b, &Node::update_configuration_warnings);
+		node_a->connect(SNAME("renamed"), callable);
+		tree->process(0);
+		CHECK(node_a->processed_in_main_thread);
+		CHECK(node_b->processed_in_main_thread);
+		CHECK_FALSE(node_c->processed_in_main_thread);
+
+		node_a->disconnect(SNAME("renamed"), callable);
+		tree->process(0);
+		CHECK_FALSE(node_a->processed_in_main_thread);
+		CHECK_FALSE(node_b->processed_in_main_thread);
+		CHECK_EQ(3, node_a->process_counter);
+	}
+
+	SUBCASE("Accesses to other subtrees are reported") {
+		node_c->process_node_path = NodePath("../A");
+		tree->process(0);
+		CHECK_FALSE(node_c->processed_in_main_thread);
+
+		// The report is for the last frame, and the subtree moves to the main thread.
+		tree->process(0);
+		CHECK(node_c->processed_in_main_thread);
+		CHECK_FALSE(node_a->processed_in_main_thread);
+		TypedArray<Dictionary> report = tree->get_auto_thread_partition_report();
+		REQUIRE_EQ(report.size(), 1);
+		Dictionary entry = report[0];
+		CHECK_EQ(NodePath(entry["partition"]), node_c->get_path());
+		CHECK_EQ(NodePath(entry["node"]), node_a->get_path());
+		CHECK_EQ(String(entry["access"]), "get_node");
+
+		tree->process(0);
+		CHECK(tree->get_auto_thread_partition_report().is_empty());
+		CHECK_EQ(3, node_a->process_counter);
+	}
+
+	tree->set_auto_thread_partitioning_enabled(false);
+	memdelete(scene);
+}
+
+TEST_CASE("[SceneTree][Node][Benchmark] Automatic thread partitioning") {
+	// 100k processing nodes, spread over independent subtrees of the current scene.
+	const int subtree_count = 64;
+	const int node_count = 100000;
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *scene = memnew(Node);
+	tree->get_root()->add_child(scene);
+	tree->set_current_scene(scene);
+	LocalVector<Node *> subtrees;
+	for (int i = 0; i < subtree_count; i++) {
+		Node *subtree = memnew(Node);
+		scene->add_child(subtree);
+		subtrees.push_back(subtree);
+	}
+	for (int i = 0; i < node_count; i++) {
+		TestNode *node = memnew(TestNode);
+		node->set_process(true);
+		subtrees[i % subtree_count]->add_child(node);
+	}
+
+	const int frames = 10;
+	uint64_t usec[2];
+	for (int i = 0; i < 2; i++) {
+		tree->set_auto_thread_partitioning_enabled(i == 1);
+		const BenchmarkTimer timer;
+		for (int j = 0; j < frames; j++) {
+			tree->process(0);
+		}
+		usec[i] = timer.get_elapsed_usec();
+	}
+	CHECK(tree->get_auto_thread_partition_report().is_empty());
+	CHECK_EQ(Object::cast_to<TestNode>(subtrees[0]->get_child(0))->process_counter, frames * 2);
+
+	// A node entering and leaving one subtree each frame only rechecks that subtree's partition.
+	const BenchmarkTimer timer;
+	for (int j = 0; j < frames; j++) {
+		TestNode *node = memnew(TestNode);
+		node->set_process(true);
+		subtrees[j % subtree_count]->add_child(node);
+		tree->process(0);
+		memdelete(node);
+	}
+	const uint64_t churn_usec = timer.get_elapsed_usec();
+	tree->set_auto_thread_partitioning_enabled(false);
+
+	BENCHMARK_MESSAGE("Processing %d nodes in the main thread: %.2f msec/frame.", node_count, usec[0] / 1000.0 / frames);
+	BENCHMARK_MESSAGE("Processing %d nodes with automatic thread partitioning: %.2f msec/frame.", node_count, usec[1] / 1000.0 / frames);
+	BENCHMARK_MESSAGE("Adding and removing a node every frame with automatic thread partitioning: %.2f msec/frame.", churn_usec / 1000.0 / frames);
+
+	memdelete(scene);
+}
+
+TEST_CASE("[SceneTree][Node][Benchmark] Group calls under churn") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *scene = memnew(Node);
+	tree->get_root()->add_child(scene);
+
+	const int node_count = 5000;
+	LocalVector<Node *> nodes;
+	for (int i = 0; i < node_count; i++) {
+		Node *node = memnew(Node);
+		scene->add_child(node);
+		node->add_to_group("churn");
+		nodes.push_back(node);
+	}
+
+	const int iterations = 200;
+	uint64_t usec[2];
+	for (int pass = 0; pass < 2; pass++) {
+		const bool resort = pass == 0;
+		const BenchmarkTimer timer;
+		for (int i = 0; i < iterations; i++) {
+			Node *node = nodes[(i * 7919) % node_count];
+			node->remove_from_group("churn");
+			node->add_to_group("churn");
+			if (resort) {
+				// What group calls used to do after a change: copy the group and sort all of it.
+				Vector<Node *> nodes_copy = tree->get_group_snapshot("churn").nodes;
+				Node **gr_nodes = nodes_copy.ptrw();
+				SortArray<Node *, Node::Comparator> node_sort;
+				node_sort.sort(gr_nodes, nodes_copy.size());
+				for (int j = 0; j < nodes_copy.size(); j++) {
+					gr_nodes[j]->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+				}
+			} else {
+				tree->notify_group("churn", Node::NOTIFICATION_INTERNAL_PROCESS);
+			}
+		}
+		usec[pass] = timer.get_elapsed_usec();
+
+		SceneTree::GroupSnapshot snapshot = tree->get_group_snapshot("churn");
+		REQUIRE_EQ(snapshot.nodes.size(), node_count);
+		bool sorted = true;
+		for (int i = 0; i < node_count; i++) {
+			sorted = sorted && snapshot.nodes[i] == nodes[i];
+		}
+		CHECK(sorted);
+	}
+
+	BENCHMARK_MESSAGE("Group calls on %d nodes under churn: resorting %.2f msec, incremental %.2f msec (%.1fx).", node_count, usec[0] / 1000.0, usec[1] / 1000.0, double(usec[0]) / usec[1]);
+
+	memdelete(scene);
+}
+
 } // namespace TestNode
 
 #endif // TEST_NODE_H
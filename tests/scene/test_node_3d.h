@@ -0,0 +1,204 @@
+/**************************************************************************/
+/*  test_node_3d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NODE_3D_H
+#define TEST_NODE_3D_H
+
+#include "scene/3d/node_3d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNode3D {
+
+class NotifiedNode3D : public Node3D {
+	GDCLASS(NotifiedNode3D, Node3D);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_TRANSFORM_CHANGED) {
+			notification_count++;
+			notified_origin = get_global_transform().origin;
+			if (notified_list) {
+				notified_list->push_back(this);
+			}
+		}
+	}
+
+public:
+	int notification_count = 0;
+	Vector3 notified_origin;
+	LocalVector<Node3D *> *notified_list = nullptr;
+
+	NotifiedNode3D() {
+		set_notify_transform(true);
+	}
+};
+
+TEST_CASE("[SceneTree][Node3D] Transform notifications") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node3D *parent = memnew(Node3D);
+	tree->get_root()->add_child(parent);
+	Node3D *middle = memnew(Node3D);
+	parent->add_child(middle);
+
+	// Enough nodes in one level to update their global transforms in threads.
+	const int child_count = 3000;
+	LocalVector<NotifiedNode3D *> children;
+	for (int i = 0; i < child_count; i++) {
+		NotifiedNode3D *child = memnew(NotifiedNode3D);
+		child->set_position(Vector3(0, i, 0));
+		middle->add_child(child);
+		children.push_back(child);
+	}
+	NotifiedNode3D *grandchild = memnew(NotifiedNode3D);
+	children[0]->add_child(grandchild);
+	NotifiedNode3D *top_level = memnew(NotifiedNode3D);
+	top_level->set_as_top_level(true);
+	middle->add_child(top_level);
+
+	tree->flush_transform_notifications();
+	for (NotifiedNode3D *child : children) {
+		child->notification_count = 0;
+	}
+	grandchild->notification_count = 0;
+	top_level->notification_count = 0;
+
+	parent->set_position(Vector3(1, 2, 3));
+	middle->set_position(Vector3(0, 0, 10));
+	tree->flush_transform_notifications();
+
+	bool all_notified = true;
+	bool all_updated = true;
+	for (int i = 0; i < child_count; i++) {
+		all_notified = all_notified && children[i]->notification_count == 1;
+		all_updated = all_updated && children[i]->notified_origin.is_equal_approx(Vector3(1, 2 + i, 13));
+	}
+	CHECK(all_notified);
+	CHECK(all_updated);
+	CHECK_EQ(grandchild->notification_count, 1);
+	CHECK(grandchild->notified_origin.is_equal_approx(Vector3(1, 2, 13)));
+	CHECK_EQ(top_level->notification_count, 0);
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Node3D] Transform notifications are sent to children first") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node3D *parent = memnew(Node3D);
+	tree->get_root()->add_child(parent);
+	NotifiedNode3D *first = memnew(NotifiedNode3D);
+	parent->add_child(first);
+	NotifiedNode3D *first_child = memnew(NotifiedNode3D);
+	first->add_child(first_child);
+	NotifiedNode3D *second = memnew(NotifiedNode3D);
+	parent->add_child(second);
+	tree->flush_transform_notifications();
+
+	LocalVector<Node3D *> notified;
+	first->notified_list = &notified;
+	first_child->notified_list = &notified;
+	second->notified_list = &notified;
+	parent->set_position(Vector3(1, 0, 0));
+	tree->flush_transform_notifications();
+
+	// Same order as when the changes were propagated recursively.
+	REQUIRE_EQ(notified.size(), 3u);
+	CHECK_EQ(notified[0], first_child);
+	CHECK_EQ(notified[1], first);
+	CHECK_EQ(notified[2], second);
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Node3D][Benchmark] Moving 200k nodes") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node3D *scene = memnew(Node3D);
+	tree->get_root()->add_child(scene);
+
+	const int parent_count = 1000;
+	const int children_per_parent = 200;
+	LocalVector<Node3D *> parents;
+	LocalVector<NotifiedNode3D *> children;
+	for (int i = 0; i < parent_count; i++) {
+		Node3D *parent = memnew(Node3D);
+		scene->add_child(parent);
+		parents.push_back(parent);
+		for (int j = 0; j < children_per_parent; j++) {
+			NotifiedNode3D *child = memnew(NotifiedNode3D);
+			child->set_position(Vector3(j, 0, 0));
+			parent->add_child(child);
+			children.push_back(child);
+		}
+	}
+	tree->flush_transform_notifications();
+	NotifiedNode3D *last = children[children.size() - 1];
+
+	// Baseline, what flushing did before the batched update: notify each node in turn, and let it
+	// compute its global transform lazily from its handler.
+	for (NotifiedNode3D *child : children) {
+		child->set_notify_transform(false);
+	}
+	const int frames = 10;
+	BenchmarkTimer timer;
+	for (int i = 0; i < frames; i++) {
+		for (Node3D *parent : parents) {
+			parent->set_position(Vector3(0, i, 0));
+		}
+		for (NotifiedNode3D *child : children) {
+			child->notification(Node3D::NOTIFICATION_TRANSFORM_CHANGED);
+		}
+	}
+	const uint64_t lazy_usec = timer.get_elapsed_usec();
+	CHECK(last->notified_origin.is_equal_approx(Vector3(children_per_parent - 1, frames - 1, 0)));
+
+	for (NotifiedNode3D *child : children) {
+		child->set_notify_transform(true);
+	}
+	tree->flush_transform_notifications();
+	timer.restart();
+	for (int i = 0; i < frames; i++) {
+		for (Node3D *parent : parents) {
+			parent->set_position(Vector3(0, frames + i, 0));
+		}
+		tree->flush_transform_notifications();
+	}
+	const uint64_t batched_usec = timer.get_elapsed_usec();
+	CHECK(last->notified_origin.is_equal_approx(Vector3(children_per_parent - 1, 2 * frames - 1, 0)));
+
+	BENCHMARK_MESSAGE("Moving %d notified nodes: %.2f msec/frame notifying one by one, %.2f msec/frame with flush_transform_notifications() (%.2fx).",
+			parent_count * children_per_parent, lazy_usec / 1000.0 / frames, batched_usec / 1000.0 / frames, double(lazy_usec) / batched_usec);
+
+	memdelete(scene);
+}
+
+} // namespace TestNode3D
+
+#endif // TEST_NODE_3D_H
@@ -31,6 +31,9 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "scene/2d/node_2d.h"
+#include "scene/gui/control.h"
+#include "scene/main/timer.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
@@ -215,6 +218,149 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+// Timers don't use servers, so they can be instantiated on any thread in tests.
+static Ref<PackedScene> create_timer_scene(int p_child_count) {
+	Node *scene = memnew(Node);
+	scene->set_name("TestScene");
+	for (int i = 0; i < p_child_count; i++) {
+		Timer *child = memnew(Timer);
+		child->set_wait_time(i + 1);
+		child->set_one_shot(true);
+		child->set_timer_process_callback(Timer::TIMER_PROCESS_PHYSICS);
+		child->set_process_priority(i % 7);
+		child->set_editor_description("Timer");
+		scene->add_child(child);
+		child->set_owner(scene);
+	}
+
+	Ref<PackedScene> packed_scene;
+	packed_scene.instantiate();
+	packed_scene->pack(scene);
+	memdelete(scene);
+	return packed_scene;
+}
+
+TEST_CASE("[SceneTree][PackedScene] Instantiation program sets the same properties") {
+	Control *scene = memnew(Control);
+	scene->set_name("TestScene");
+	scene->set_offset(SIDE_LEFT, 12); // Indexed property.
+	Node2D *child = memnew(Node2D);
+	child->set_position(Vector2(1, 2));
+	child->set_z_index(3);
+	child->set_meta("tag", 4);
+	scene->add_child(child);
+	child->set_owner(scene);
+
+	PackedScene packed_scene;
+	packed_scene.pack(scene);
+	memdelete(scene);
+
+	// Values stored as integers must still be converted for float setters.
+	Ref<SceneState> state = packed_scene.get_state();
+	state->add_node_property(1, state->add_name("rotation"), state->add_value(1));
+
+	for (int pass = 0; pass < 2; pass++) {
+		SceneState::set_use_instantiation_program(pass == 0);
+		Control *instance = Object::cast_to<Control>(packed_scene.instantiate());
+		REQUIRE(instance);
+		Node2D *instance_child = Object::cast_to<Node2D>(instance->get_child(0));
+		REQUIRE(instance_child);
+
+		CHECK_EQ(instance->get_offset(SIDE_LEFT), 12);
+		CHECK_EQ(instance_child->get_position(), Vector2(1, 2));
+		CHECK_EQ(instance_child->get_z_index(), 3);
+		CHECK_EQ(instance_child->get_rotation(), 1.0);
+		CHECK_EQ(int(instance_child->get_meta("tag")), 4);
+
+		memdelete(instance);
+	}
+	SceneState::set_use_instantiation_program(true);
+}
+
+TEST_CASE("[PackedScene] Batch instantiation") {
+	Ref<PackedScene> packed_scene = create_timer_scene(3);
+
+	SUBCASE("Time sliced") {
+		Ref<PackedSceneBatch> batch = packed_scene->instantiate_batch(10, false);
+		CHECK_FALSE(batch->is_finished());
+
+		// At least one instance is built per call, even without budget.
+		CHECK_FALSE(batch->process(0));
+		CHECK_EQ(batch->get_instantiated_count(), 1);
+
+		TypedArray<Node> instances = batch->take_instances();
+		REQUIRE_EQ(instances.size(), 1);
+		Node *instance = Object::cast_to<Node>(instances[0]);
+		CHECK_EQ(instance->get_child_count(), 3);
+		memdelete(instance);
+
+		batch->wait();
+		CHECK(batch->is_finished());
+		CHECK_EQ(batch->get_instantiated_count(), 10);
+
+		instances = batch->take_instances(4);
+		CHECK_EQ(instances.size(), 4);
+		for (int i = 0; i < instances.size(); i++) {
+			memdelete(Object::cast_to<Node>(instances[i]));
+		}
+		// The remaining instances are freed with the batch.
+	}
+
+	SUBCASE("Threaded") {
+		Ref<PackedSceneBatch> batch = packed_scene->instantiate_batch(20);
+		batch->wait();
+		CHECK(batch->is_finished());
+		CHECK(batch->process(0));
+
+		TypedArray<Node> instances = batch->take_instances();
+		REQUIRE_EQ(instances.size(), 20);
+		for (int i = 0; i < instances.size(); i++) {
+			Node *instance = Object::cast_to<Node>(instances[i]);
+			REQUIRE(instance);
+			REQUIRE_EQ(instance->get_child_count(), 3);
+			Timer *timer = Object::cast_to<Timer>(instance->get_child(2));
+			REQUIRE(timer);
+			CHECK_EQ(timer->get_wait_time(), 3.0);
+			CHECK(timer->is_one_shot());
+			memdelete(instance);
+		}
+		CHECK(batch->take_instances().is_empty());
+	}
+}
+
+TEST_CASE("[PackedScene][Benchmark] Instantiating 500 scenes") {
+	const int count = 500;
+	Ref<PackedScene> packed_scene = create_timer_scene(20);
+
+	uint64_t usec[3];
+	for (int pass = 0; pass < 3; pass++) {
+		SceneState::set_use_instantiation_program(pass > 0);
+		LocalVector<Node *> instances;
+		const BenchmarkTimer timer;
+		if (pass < 2) {
+			for (int i = 0; i < count; i++) {
+				instances.push_back(packed_scene->instantiate());
+			}
+		} else {
+			Ref<PackedSceneBatch> batch = packed_scene->instantiate_batch(count);
+			batch->wait();
+			TypedArray<Node> taken = batch->take_instances();
+			for (int i = 0; i < taken.size(); i++) {
+				instances.push_back(Object::cast_to<Node>(taken[i]));
+			}
+		}
+		usec[pass] = timer.get_elapsed_usec();
+
+		CHECK_EQ(instances.size(), (uint32_t)count);
+		for (Node *instance : instances) {
+			memdelete(instance);
+		}
+	}
+	SceneState::set_use_instantiation_program(true);
+
+	BENCHMARK_MESSAGE("Instantiating %d scenes of 21 nodes: Object::set() %.2f msec, resolved setters %.2f msec, worker threads %.2f msec.", count, usec[0] / 1000.0, usec[1] / 1000.0, usec[2] / 1000.0);
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H
@@ -31,6 +31,8 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
+#include "core/math/random_number_generator.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -51,6 +53,64 @@ public:
 	Variant function1_latest_arg0{};
 };
 
+// Square grid of 1x1 quads on the XZ plane, starting at the origin.
+static Ref<NavigationMesh> create_grid_navigation_mesh(int p_size) {
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_size; z++) {
+		for (int x = 0; x <= p_size; x++) {
+			vertices.push_back(Vector3(x, 0, z));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+	for (int z = 0; z < p_size; z++) {
+		for (int x = 0; x < p_size; x++) {
+			int i = z * (p_size + 1) + x;
+			Vector<int> polygon = { i, i + 1, i + p_size + 2, i + p_size + 1 };
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+	return navigation_mesh;
+}
+
+static Vector3 get_closest_point_brute_force(const Ref<NavigationMesh> &p_navigation_mesh, const Vector3 &p_point) {
+	const Vector<Vector3> vertices = p_navigation_mesh->get_vertices();
+	Vector3 closest;
+	real_t closest_distance = FLT_MAX;
+	for (int i = 0; i < p_navigation_mesh->get_polygon_count(); i++) {
+		const Vector<int> polygon = p_navigation_mesh->get_polygon(i);
+		for (int j = 2; j < polygon.size(); j++) {
+			const Face3 face(vertices[polygon[0]], vertices[polygon[j - 1]], vertices[polygon[j]]);
+			const Vector3 point = face.get_closest_point_to(p_point);
+			if (point.distance_squared_to(p_point) < closest_distance) {
+				closest = point;
+				closest_distance = point.distance_squared_to(p_point);
+			}
+		}
+	}
+	return closest;
+}
+
+// A square ground of p_size with a box obstacle every 8 units, the first box is moved by p_first_box_offset.
+static Ref<NavigationMeshSourceGeometryData3D> create_boxes_source_geometry(int p_size, const Vector3 &p_first_box_offset = Vector3()) {
+	Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+	Array arr;
+	arr.resize(RS::ARRAY_MAX);
+	BoxMesh::create_mesh_array(arr, Vector3(p_size, 0.001, p_size));
+	source_geometry->add_mesh_array(arr, Transform3D(Basis(), Vector3(p_size, 0, p_size) * 0.5));
+
+	arr.clear();
+	arr.resize(RS::ARRAY_MAX);
+	BoxMesh::create_mesh_array(arr, Vector3(2.0, 2.0, 2.0));
+	for (int z = 4; z < p_size; z += 8) {
+		for (int x = 4; x < p_size; x += 8) {
+			const Vector3 offset = (x == 4 && z == 4) ? p_first_box_offset : Vector3();
+			source_geometry->add_mesh_array(arr, Transform3D(Basis(), Vector3(x, 1.0, z) + offset));
+		}
+	}
+	return source_geometry;
+}
+
 static inline Array build_array() {
 	return Array();
 }
@@ -427,6 +487,123 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->free(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Multithreaded avoidance should match single threaded avoidance") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		// Enough agents to also build the agent trees in parallel.
+		const int agent_count = 2000;
+
+		const Variant use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", false);
+		RID single_threaded_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", true);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", use_multiple_threads);
+		navigation_server->map_set_active(single_threaded_map, true);
+		navigation_server->map_set_active(map, true);
+
+		LocalVector<RID> agents;
+		LocalVector<CallableMock *> callback_mocks;
+		for (const RID &agent_map : { single_threaded_map, map }) {
+			for (int i = 0; i < agent_count; i++) {
+				// A crowd on a grid, everyone heading to its center.
+				const Vector3 position = Vector3(i % 50, 0, i / 50) * 3.0;
+				RID agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(agent, agent_map);
+				navigation_server->agent_set_avoidance_enabled(agent, true);
+				navigation_server->agent_set_position(agent, position);
+				navigation_server->agent_set_radius(agent, 1);
+				navigation_server->agent_set_velocity(agent, (Vector3(75, 0, 60) - position).normalized());
+				CallableMock *callback_mock = memnew(CallableMock);
+				navigation_server->agent_set_avoidance_callback(agent, callable_mp(callback_mock, &CallableMock::function1));
+				agents.push_back(agent);
+				callback_mocks.push_back(callback_mock);
+			}
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		int mismatches = 0;
+		for (int i = 0; i < agent_count; i++) {
+			CHECK_EQ(callback_mocks[i]->function1_calls, 1);
+			CHECK_EQ(callback_mocks[agent_count + i]->function1_calls, 1);
+			if (callback_mocks[i]->function1_latest_arg0 != callback_mocks[agent_count + i]->function1_latest_arg0) {
+				mismatches++;
+			}
+		}
+		CHECK_EQ(mismatches, 0);
+
+		for (const RID &agent : agents) {
+			navigation_server->free(agent);
+		}
+		for (CallableMock *callback_mock : callback_mocks) {
+			memdelete(callback_mock);
+		}
+		navigation_server->free(map);
+		navigation_server->free(single_threaded_map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Avoidance with 10000 agents") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int agent_count = 10000;
+		const int frame_count = 10;
+
+		const Variant use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", false);
+		RID single_threaded_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", true);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/avoidance/thread_model/avoidance_use_multiple_threads", use_multiple_threads);
+
+		LocalVector<RID> agents;
+		LocalVector<Vector3> positions;
+		RandomNumberGenerator rng;
+		rng.set_seed(23);
+		for (int i = 0; i < agent_count; i++) {
+			positions.push_back(Vector3(rng.randf_range(0, 400), 0, rng.randf_range(0, 400)));
+		}
+		for (const RID &agent_map : { single_threaded_map, map }) {
+			for (int i = 0; i < agent_count; i++) {
+				RID agent = navigation_server->agent_create();
+				navigation_server->agent_set_map(agent, agent_map);
+				navigation_server->agent_set_avoidance_enabled(agent, true);
+				navigation_server->agent_set_radius(agent, 0.5);
+				navigation_server->agent_set_neighbor_distance(agent, 10.0);
+				navigation_server->agent_set_velocity(agent, Vector3(rng.randf_range(-1, 1), 0, rng.randf_range(-1, 1)));
+				agents.push_back(agent);
+			}
+		}
+
+		uint64_t usec[2] = {};
+		int map_index = 0;
+		for (const RID &agent_map : { single_threaded_map, map }) {
+			navigation_server->map_set_active(agent_map, true);
+			for (int frame = 0; frame <= frame_count; frame++) {
+				// Agents move every frame so the agent trees are rebuilt.
+				for (int i = 0; i < agent_count; i++) {
+					navigation_server->agent_set_position(agents[map_index * agent_count + i], positions[i] + Vector3(frame * 0.1, 0, 0));
+				}
+				const BenchmarkTimer timer;
+				navigation_server->process(1.0 / 60.0);
+				// The first frame also adds the agents.
+				if (frame > 0) {
+					usec[map_index] += timer.get_elapsed_usec();
+				}
+			}
+			navigation_server->map_set_active(agent_map, false);
+			map_index++;
+		}
+		CHECK_GT(usec[1], 0u);
+
+		BENCHMARK_MESSAGE("%d agents: %.2f msec per frame on one thread, %.2f msec per frame on %d threads (%.1fx).", agent_count, usec[0] / 1000.0 / frame_count, usec[1] / 1000.0 / frame_count, WorkerThreadPool::get_singleton()->get_thread_count(), double(usec[0]) / usec[1]);
+
+		for (const RID &agent : agents) {
+			navigation_server->free(agent);
+		}
+		navigation_server->free(map);
+		navigation_server->free(single_threaded_map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should make agents avoid dynamic obstacles when avoidance enabled") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 
@@ -768,6 +945,506 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Closest point queries should match testing every polygon") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(40);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		RandomNumberGenerator rng;
+		rng.set_seed(42);
+		bool all_match = true;
+		for (int i = 0; i < 500; i++) {
+			const Vector3 point(rng.randf_range(-10, 50), rng.randf_range(-5, 5), rng.randf_range(-10, 50));
+			const Vector3 expected = get_closest_point_brute_force(navigation_mesh, point);
+			const Vector3 closest = navigation_server->map_get_closest_point(map, point);
+			all_match = all_match && closest.is_equal_approx(expected);
+		}
+		CHECK(all_match);
+
+		SUBCASE("Moving the region should update the queries") {
+			navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(100, 0, 0)));
+			navigation_server->process(0.0);
+			CHECK(navigation_server->map_get_closest_point(map, Vector3(0, 0, 0)).is_equal_approx(Vector3(100, 0, 0)));
+		}
+
+		SUBCASE("Paths should only start in regions with compatible layers") {
+			RID other_region = navigation_server->region_create();
+			navigation_server->region_set_map(other_region, map);
+			navigation_server->region_set_navigation_mesh(other_region, navigation_mesh);
+			navigation_server->region_set_transform(other_region, Transform3D(Basis(), Vector3(0, 0, -100)));
+			navigation_server->region_set_navigation_layers(other_region, 2);
+			navigation_server->process(0.0);
+
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(20, 0, -80), Vector3(20, 0, 20), true, 1);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[0].is_equal_approx(Vector3(20, 0, 0)));
+			path = navigation_server->map_get_path(map, Vector3(20, 0, -80), Vector3(20, 0, -70), true, 2);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[0].is_equal_approx(Vector3(20, 0, -80)));
+
+			navigation_server->free(other_region);
+		}
+
+		SUBCASE("Links should connect to polygons exactly at the connection radius") {
+			RID other_region = navigation_server->region_create();
+			navigation_server->region_set_map(other_region, map);
+			navigation_server->region_set_navigation_mesh(other_region, navigation_mesh);
+			navigation_server->region_set_transform(other_region, Transform3D(Basis(), Vector3(100, 0, 0)));
+			navigation_server->map_set_link_connection_radius(map, 1.0);
+			RID link = navigation_server->link_create();
+			navigation_server->link_set_map(link, map);
+			navigation_server->link_set_start_position(link, Vector3(5, 1, 5));
+			navigation_server->link_set_end_position(link, Vector3(105, 1, 5));
+			navigation_server->process(0.0);
+
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(5, 0, 5), Vector3(105, 0, 5), true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(105, 0, 5)));
+
+			navigation_server->free(link);
+			navigation_server->free(other_region);
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Path queries on a large map") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 200;
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(size);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const int query_count = 2000;
+		LocalVector<Vector3> points;
+		RandomNumberGenerator rng;
+		rng.set_seed(7);
+		for (int i = 0; i < query_count * 2; i++) {
+			points.push_back(Vector3(rng.randf_range(0, size), 0.5, rng.randf_range(0, size)));
+		}
+
+		// What finding the two path endpoints used to cost, testing every polygon.
+		BenchmarkTimer timer;
+		Vector3 checksum;
+		for (int i = 0; i < 200; i++) {
+			checksum += get_closest_point_brute_force(navigation_mesh, points[i]);
+		}
+		const uint64_t brute_force_usec = timer.get_elapsed_usec() * 2 * query_count / 200;
+
+		timer.restart();
+		for (uint32_t i = 0; i < points.size(); i++) {
+			checksum += navigation_server->map_get_closest_point(map, points[i]);
+		}
+		const uint64_t closest_usec = timer.get_elapsed_usec();
+
+		// Short paths, as agents mostly repath near where they are.
+		timer.restart();
+		int empty_paths = 0;
+		for (int i = 0; i < query_count; i++) {
+			const Vector3 from = points[i];
+			const Vector3 to = from + Vector3(rng.randf_range(-5, 5), 0, rng.randf_range(-5, 5));
+			empty_paths += navigation_server->map_get_path(map, from, to, true).is_empty() ? 1 : 0;
+		}
+		const uint64_t path_usec = timer.get_elapsed_usec();
+		CHECK_EQ(empty_paths, 0);
+		CHECK(checksum.is_finite());
+
+		BENCHMARK_MESSAGE("%d polygons: endpoints of %d paths %.2f msec testing every polygon (estimated), %.2f msec with the BVH. %d short paths: %.2f msec.", size * size, query_count, brute_force_usec / 1000.0, closest_usec / 1000.0, query_count, path_usec / 1000.0);
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Batched path queries should match single queries") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(30);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		RandomNumberGenerator rng;
+		rng.set_seed(3);
+		TypedArray<NavigationPathQueryParameters3D> parameters;
+		TypedArray<NavigationPathQueryResult3D> results;
+		for (int i = 0; i < 64; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters;
+			query_parameters.instantiate();
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(rng.randf_range(0, 30), 0, rng.randf_range(0, 30)));
+			query_parameters->set_target_position(Vector3(rng.randf_range(0, 30), 0, rng.randf_range(0, 30)));
+			parameters.push_back(query_parameters);
+			results.push_back(memnew(NavigationPathQueryResult3D));
+		}
+
+		CallableMock callback_mock;
+		Ref<NavigationPathQueryBatch3D> batch = navigation_server->query_path_batch(parameters, results, callable_mp(&callback_mock, &CallableMock::function1).bind(7));
+		REQUIRE(batch.is_valid());
+		CHECK_EQ(batch->get_count(), 64);
+		batch->wait();
+		CHECK(batch->is_finished());
+		CHECK_EQ(batch->get_finished_count(), 64);
+		CHECK_EQ(callback_mock.function1_calls, 0);
+
+		bool all_match = true;
+		Ref<NavigationPathQueryResult3D> result;
+		result.instantiate();
+		for (int i = 0; i < parameters.size(); i++) {
+			navigation_server->query_path(parameters[i], result);
+			const Ref<NavigationPathQueryResult3D> batch_result = results[i];
+			all_match = all_match && !result->get_path().is_empty() && batch_result->get_path() == result->get_path() && batch_result->get_path_rids() == result->get_path_rids();
+		}
+		CHECK(all_match);
+
+		// The callback waits for the next frame, in the main thread.
+		navigation_server->process(0.0);
+		CHECK_EQ(callback_mock.function1_calls, 1);
+		CHECK_EQ(callback_mock.function1_latest_arg0, Variant(7));
+		navigation_server->process(0.0);
+		CHECK_EQ(callback_mock.function1_calls, 1);
+
+		SUBCASE("Freeing the map should wait for the running queries") {
+			batch = navigation_server->query_path_batch(parameters, results);
+			navigation_server->free(map);
+			navigation_server->process(0.0);
+			CHECK(batch->is_finished());
+			map = RID();
+		}
+
+		SUBCASE("Freeing a region should wait for the running queries") {
+			batch = navigation_server->query_path_batch(parameters, results);
+			navigation_server->free(region);
+			navigation_server->process(0.0);
+			CHECK(batch->is_finished());
+			bool all_found = true;
+			for (int i = 0; i < results.size(); i++) {
+				const Ref<NavigationPathQueryResult3D> batch_result = results[i];
+				all_found = all_found && !batch_result->get_path().is_empty() && batch_result->get_path_rids().has(region);
+			}
+			CHECK(all_found);
+			region = RID();
+		}
+
+		if (region.is_valid()) {
+			navigation_server->free(region);
+		}
+		if (map.is_valid()) {
+			navigation_server->free(map);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Repathing 5000 agents") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 100;
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(size);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const int agent_count = 5000;
+		RandomNumberGenerator rng;
+		rng.set_seed(11);
+		TypedArray<NavigationPathQueryParameters3D> parameters;
+		TypedArray<NavigationPathQueryResult3D> results;
+		for (int i = 0; i < agent_count; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters;
+			query_parameters.instantiate();
+			query_parameters->set_map(map);
+			const Vector3 start(rng.randf_range(0, size), 0, rng.randf_range(0, size));
+			query_parameters->set_start_position(start);
+			query_parameters->set_target_position(start + Vector3(rng.randf_range(-10, 10), 0, rng.randf_range(-10, 10)));
+			parameters.push_back(query_parameters);
+			results.push_back(memnew(NavigationPathQueryResult3D));
+		}
+
+		BenchmarkTimer timer;
+		for (int i = 0; i < agent_count; i++) {
+			navigation_server->query_path(parameters[i], results[i]);
+		}
+		const uint64_t single_usec = timer.get_elapsed_usec();
+
+		timer.restart();
+		Ref<NavigationPathQueryBatch3D> batch = navigation_server->query_path_batch(parameters, results);
+		const uint64_t submit_usec = timer.get_elapsed_usec();
+		batch->wait();
+		const uint64_t batch_usec = timer.get_elapsed_usec();
+
+		int empty_paths = 0;
+		for (int i = 0; i < agent_count; i++) {
+			const Ref<NavigationPathQueryResult3D> result = results[i];
+			empty_paths += result->get_path().is_empty() ? 1 : 0;
+		}
+		CHECK_EQ(empty_paths, 0);
+
+		BENCHMARK_MESSAGE("%d path queries: %.2f msec one at a time, %.2f msec batched on %d threads (%.2f msec blocking the caller).", agent_count, single_usec / 1000.0, batch_usec / 1000.0, WorkerThreadPool::get_singleton()->get_thread_count(), submit_usec / 1000.0);
+
+		navigation_server->process(0.0);
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Hierarchical pathfinding should find paths across regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(10);
+
+		// A row of regions sharing their borders.
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+		LocalVector<RID> regions;
+		for (int i = 0; i < 4; i++) {
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(i * 10, 0, 0)));
+			regions.push_back(region);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(39, 0, 5), true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[0].is_equal_approx(Vector3(1, 0, 5)));
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(39, 0, 5)));
+		CHECK_EQ(path.size(), 2);
+
+		SUBCASE("Paths should reach the same points as without it") {
+			RandomNumberGenerator rng;
+			rng.set_seed(5);
+			bool all_match = true;
+			for (int i = 0; i < 50; i++) {
+				const Vector3 from(rng.randf_range(0, 40), 0, rng.randf_range(0, 10));
+				const Vector3 to(rng.randf_range(0, 40), 0, rng.randf_range(0, 10));
+				navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+				navigation_server->process(0.0);
+				const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(map, from, to, true);
+				navigation_server->map_set_use_hierarchical_pathfinding(map, false);
+				navigation_server->process(0.0);
+				const Vector<Vector3> flat_path = navigation_server->map_get_path(map, from, to, true);
+				REQUIRE_FALSE(hierarchical_path.is_empty());
+				REQUIRE_FALSE(flat_path.is_empty());
+				real_t hierarchical_length = 0.0;
+				real_t flat_length = 0.0;
+				for (int j = 1; j < hierarchical_path.size(); j++) {
+					hierarchical_length += hierarchical_path[j - 1].distance_to(hierarchical_path[j]);
+				}
+				for (int j = 1; j < flat_path.size(); j++) {
+					flat_length += flat_path[j - 1].distance_to(flat_path[j]);
+				}
+				all_match = all_match && hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(flat_path[flat_path.size() - 1]);
+				all_match = all_match && hierarchical_length <= flat_length * 1.05 + 0.01;
+			}
+			CHECK(all_match);
+		}
+
+		SUBCASE("Changed regions should not be crossed with outdated distances") {
+			// Cut the row in two, then move the region back.
+			navigation_server->region_set_transform(regions[2], Transform3D(Basis(), Vector3(20, 0, 100)));
+			navigation_server->process(0.0);
+			path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(39, 0, 5), true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(20, 0, 5)));
+
+			navigation_server->region_set_transform(regions[2], Transform3D(Basis(), Vector3(20, 0, 0)));
+			navigation_server->process(0.0);
+			path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(39, 0, 5), true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(39, 0, 5)));
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Long paths across many regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int region_size = 10;
+		const int regions_per_side = 8;
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(region_size);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		LocalVector<RID> regions;
+		for (int z = 0; z < regions_per_side; z++) {
+			for (int x = 0; x < regions_per_side; x++) {
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, map);
+				navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+				navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(x, 0, z) * region_size));
+				regions.push_back(region);
+			}
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const int query_count = 50;
+		const real_t map_size = region_size * regions_per_side;
+		LocalVector<Vector3> points;
+		RandomNumberGenerator rng;
+		rng.set_seed(13);
+		for (int i = 0; i < query_count; i++) {
+			// From one corner of the map to the opposite one.
+			points.push_back(Vector3(rng.randf_range(0, region_size), 0, rng.randf_range(0, region_size)));
+			points.push_back(Vector3(map_size - rng.randf_range(0, region_size), 0, map_size - rng.randf_range(0, region_size)));
+		}
+
+		BenchmarkTimer timer;
+		real_t flat_length = 0.0;
+		for (int i = 0; i < query_count; i++) {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, points[i * 2], points[i * 2 + 1], true);
+			for (int j = 1; j < path.size(); j++) {
+				flat_length += path[j - 1].distance_to(path[j]);
+			}
+		}
+		const uint64_t flat_usec = timer.get_elapsed_usec();
+
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->process(0.0);
+
+		// The first queries also fill the distances cached in the regions.
+		timer.restart();
+		for (int i = 0; i < query_count; i++) {
+			navigation_server->map_get_path(map, points[i * 2], points[i * 2 + 1], true);
+		}
+		const uint64_t first_usec = timer.get_elapsed_usec();
+
+		timer.restart();
+		real_t hierarchical_length = 0.0;
+		for (int i = 0; i < query_count; i++) {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, points[i * 2], points[i * 2 + 1], true);
+			for (int j = 1; j < path.size(); j++) {
+				hierarchical_length += path[j - 1].distance_to(path[j]);
+			}
+		}
+		const uint64_t hierarchical_usec = timer.get_elapsed_usec();
+		CHECK(hierarchical_length > 0.0);
+		CHECK(hierarchical_length < flat_length * 1.1);
+
+		BENCHMARK_MESSAGE("%d long paths over %d regions: %.2f msec searching every polygon, %.2f msec hierarchical (%.2f msec while caching). Path length +%.1f%%.", query_count, regions_per_side * regions_per_side, flat_usec / 1000.0, hierarchical_usec / 1000.0, first_usec / 1000.0, (hierarchical_length / flat_length - 1.0) * 100.0);
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Tiled baking should connect the tiles and keep unchanged tiles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(10.0);
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, create_boxes_source_geometry(40), Callable());
+		CHECK_GT(navigation_mesh->get_polygon_count(), 16);
+
+		// Merging the tile vertices doesn't leave repeated vertices or degenerate polygons.
+		bool valid_polygons = true;
+		for (int i = 0; i < navigation_mesh->get_polygon_count(); i++) {
+			const Vector<int> polygon = navigation_mesh->get_polygon(i);
+			valid_polygons = valid_polygons && polygon.size() >= 3;
+			for (int j = 0; j < polygon.size(); j++) {
+				valid_polygons = valid_polygons && polygon[j] != polygon[(j + 1) % polygon.size()];
+			}
+		}
+		CHECK(valid_polygons);
+
+		Ref<NavigationMesh> full_navigation_mesh = memnew(NavigationMesh);
+		navigation_server->bake_from_source_geometry_data(full_navigation_mesh, create_boxes_source_geometry(40), Callable());
+
+		RandomNumberGenerator rng;
+		rng.set_seed(17);
+		for (int i = 0; i < 100; i++) {
+			// Tiles cover the same area as a single bake.
+			const Vector3 point = Vector3(rng.randf_range(0, 40), 0, rng.randf_range(0, 40));
+			const Vector3 tiled_closest = get_closest_point_brute_force(navigation_mesh, point);
+			const Vector3 full_closest = get_closest_point_brute_force(full_navigation_mesh, point);
+			CHECK(Vector2(tiled_closest.x, tiled_closest.z).distance_to(Vector2(full_closest.x, full_closest.z)) < 0.5);
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Paths go through the tile edges.
+		const Vector3 end = Vector3(38.0, 0, 38.0);
+		const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(2.0, 0, 2.0), end, true);
+		REQUIRE_GT(path.size(), 1);
+		CHECK(Vector2(path[path.size() - 1].x, path[path.size() - 1].z).distance_to(Vector2(end.x, end.z)) < 0.5);
+
+		SUBCASE("Unchanged geometry should give the same navigation mesh") {
+			const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			const int polygon_count = navigation_mesh->get_polygon_count();
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, create_boxes_source_geometry(40), Callable());
+			CHECK_EQ(navigation_mesh->get_vertices(), vertices);
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+
+		SUBCASE("Changed geometry should update the navigation mesh") {
+			// Move the first box out of the way so its place becomes walkable.
+			const Vector3 point = Vector3(4.0, 0, 4.0);
+			CHECK(get_closest_point_brute_force(navigation_mesh, point).distance_to(point) > 1.0);
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, create_boxes_source_geometry(40, Vector3(0, 10.0, 0)), Callable());
+			CHECK(get_closest_point_brute_force(navigation_mesh, point).distance_to(point) < 0.5);
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D][Benchmark] Rebaking a large navigation mesh after a local change") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		const int size = 160;
+		const Ref<NavigationMeshSourceGeometryData3D> source_geometry = create_boxes_source_geometry(size);
+		const Ref<NavigationMeshSourceGeometryData3D> changed_source_geometry = create_boxes_source_geometry(size, Vector3(1.0, 0, 1.0));
+
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		BenchmarkTimer timer;
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, changed_source_geometry, Callable());
+		const uint64_t full_usec = timer.get_elapsed_usec();
+		CHECK_GT(navigation_mesh->get_polygon_count(), 0);
+
+		Ref<NavigationMesh> tiled_navigation_mesh = memnew(NavigationMesh);
+		tiled_navigation_mesh->set_tile_size(16.0);
+		timer.restart();
+		navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, source_geometry, Callable());
+		const uint64_t tiled_usec = timer.get_elapsed_usec();
+
+		timer.restart();
+		navigation_server->bake_from_source_geometry_data(tiled_navigation_mesh, changed_source_geometry, Callable());
+		const uint64_t rebake_usec = timer.get_elapsed_usec();
+		CHECK_GT(tiled_navigation_mesh->get_polygon_count(), 0);
+
+		BENCHMARK_MESSAGE("%dx%d navigation mesh: %.2f msec single bake, %.2f msec tiled bake, %.2f msec tiled rebake after moving one box.", size, size, full_usec / 1000.0, tiled_usec / 1000.0, rebake_usec / 1000.0);
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
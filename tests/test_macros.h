@@ -36,6 +36,7 @@
 #include "core/core_globals.h"
 #include "core/input/input_map.h"
 #include "core/object/message_queue.h"
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 
 // See documentation for doctest at:
@@ -48,6 +49,21 @@
 // The test case is marked as failed, but does not fail the entire test run.
 #define TEST_CASE_MAY_FAIL(name) TEST_CASE(name *doctest::may_fail())
 
+// Test cases tagged with [Benchmark] are skipped, run them with `--test --benchmark`.
+// They time their work with BenchmarkTimer and report it with BENCHMARK_MESSAGE.
+class BenchmarkTimer {
+	uint64_t start_usec = 0;
+
+public:
+	void restart() { start_usec = OS::get_singleton()->get_ticks_usec(); }
+	// Never 0, so it's safe to divide by.
+	uint64_t get_elapsed_usec() const { return MAX(OS::get_singleton()->get_ticks_usec() - start_usec, (uint64_t)1); }
+
+	BenchmarkTimer() { restart(); }
+};
+
+#define BENCHMARK_MESSAGE(...) MESSAGE(vformat(__VA_ARGS__))
+
 // Provide aliases to conform with Godot naming conventions (see error macros).
 #define TEST_COND(cond, ...) DOCTEST_CHECK_FALSE_MESSAGE(cond, __VA_ARGS__)
 #define TEST_FAIL(cond, ...) DOCTEST_FAIL(cond, __VA_ARGS__)
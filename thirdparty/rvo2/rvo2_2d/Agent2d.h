@@ -71,6 +71,15 @@ namespace RVO2D {
 		 */
 		void insertAgentNeighbor(const Agent2D *agent, float &rangeSq);
 
+		/**
+		 * \brief      Inserts an agent neighbor that already passed the
+		 *             layers, elevation, priority and range checks.
+		 * \param      agent           A pointer to the agent to be inserted.
+		 * \param      distSq          The squared distance between both agents.
+		 * \param      rangeSq         The squared range around this agent.
+		 */
+		void insertAgentNeighbor(const Agent2D *agent, float distSq, float &rangeSq);
+
 		/**
 		 * \brief      Inserts a static obstacle neighbor into the set of neighbors
 		 *             of this agent.
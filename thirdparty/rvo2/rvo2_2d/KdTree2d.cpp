@@ -32,6 +32,8 @@
 
 #include "KdTree2d.h"
 
+#include <utility>
+
 #include "Agent2d.h"
 #include "RVOSimulator2d.h"
 #include "Obstacle2d.h"
@@ -45,27 +47,62 @@ namespace RVO2D {
 	}
 
 	void KdTree2D::buildAgentTree(std::vector<Agent2D *> agents)
+	{
+		std::vector<AgentSubtree> subtrees;
+		buildAgentTree(std::move(agents), 0, subtrees);
+
+		for (size_t i = 0; i < subtrees.size(); ++i) {
+			buildAgentTreeRecursive(subtrees[i].begin, subtrees[i].end, subtrees[i].node);
+		}
+	}
+
+	void KdTree2D::buildAgentTree(std::vector<Agent2D *> agents, size_t splitDepth, std::vector<AgentSubtree> &subtrees)
 	{
 		agents_.swap(agents);
 
+		agentPositions_.resize(agents_.size());
+		agentLayers_.resize(agents_.size());
+		agentPriorities_.resize(agents_.size());
+		agentElevations_.resize(agents_.size());
+		agentHeights_.resize(agents_.size());
+
+		for (size_t i = 0; i < agents_.size(); ++i) {
+			agentPositions_[i] = agents_[i]->position_;
+			agentLayers_[i] = agents_[i]->avoidance_layers_;
+			agentPriorities_[i] = agents_[i]->avoidance_priority_;
+			agentElevations_[i] = agents_[i]->elevation_;
+			agentHeights_[i] = agents_[i]->height_;
+		}
+
 		if (!agents_.empty()) {
 			agentTree_.resize(2 * agents_.size() - 1);
-			buildAgentTreeRecursive(0, agents_.size(), 0);
+			buildAgentTreeRecursive(0, agents_.size(), 0, splitDepth, &subtrees);
 		}
 	}
 
 	void KdTree2D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
 	{
+		buildAgentTreeRecursive(begin, end, node, 0, NULL);
+	}
+
+	void KdTree2D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t splitDepth, std::vector<AgentSubtree> *subtrees)
+	{
+		if (subtrees != NULL && splitDepth == 0) {
+			AgentSubtree subtree = { begin, end, node };
+			subtrees->push_back(subtree);
+			return;
+		}
+
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
-		agentTree_[node].minX = agentTree_[node].maxX = agents_[begin]->position_.x();
-		agentTree_[node].minY = agentTree_[node].maxY = agents_[begin]->position_.y();
+		agentTree_[node].minX = agentTree_[node].maxX = agentPositions_[begin].x();
+		agentTree_[node].minY = agentTree_[node].maxY = agentPositions_[begin].y();
 
 		for (size_t i = begin + 1; i < end; ++i) {
-			agentTree_[node].maxX = std::max(agentTree_[node].maxX, agents_[i]->position_.x());
-			agentTree_[node].minX = std::min(agentTree_[node].minX, agents_[i]->position_.x());
-			agentTree_[node].maxY = std::max(agentTree_[node].maxY, agents_[i]->position_.y());
-			agentTree_[node].minY = std::min(agentTree_[node].minY, agents_[i]->position_.y());
+			agentTree_[node].maxX = std::max(agentTree_[node].maxX, agentPositions_[i].x());
+			agentTree_[node].minX = std::min(agentTree_[node].minX, agentPositions_[i].x());
+			agentTree_[node].maxY = std::max(agentTree_[node].maxY, agentPositions_[i].y());
+			agentTree_[node].minY = std::min(agentTree_[node].minY, agentPositions_[i].y());
 		}
 
 		if (end - begin > MAX_LEAF_SIZE) {
@@ -77,16 +114,16 @@ namespace RVO2D {
 			size_t right = end;
 
 			while (left < right) {
-				while (left < right && (isVertical ? agents_[left]->position_.x() : agents_[left]->position_.y()) < splitValue) {
+				while (left < right && (isVertical ? agentPositions_[left].x() : agentPositions_[left].y()) < splitValue) {
 					++left;
 				}
 
-				while (right > left && (isVertical ? agents_[right - 1]->position_.x() : agents_[right - 1]->position_.y()) >= splitValue) {
+				while (right > left && (isVertical ? agentPositions_[right - 1].x() : agentPositions_[right - 1].y()) >= splitValue) {
 					--right;
 				}
 
 				if (left < right) {
-					std::swap(agents_[left], agents_[right - 1]);
+					swapAgents(left, right - 1);
 					++left;
 					--right;
 				}
@@ -100,11 +137,28 @@ namespace RVO2D {
 			agentTree_[node].left = node + 1;
 			agentTree_[node].right = node + 2 * (left - begin);
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left, splitDepth - 1, subtrees);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right, splitDepth - 1, subtrees);
+		}
+	}
+
+	void KdTree2D::updateAgentPositions()
+	{
+		for (size_t i = 0; i < agents_.size(); ++i) {
+			agentPositions_[i] = agents_[i]->position_;
 		}
 	}
 
+	void KdTree2D::swapAgents(size_t i, size_t j)
+	{
+		std::swap(agents_[i], agents_[j]);
+		std::swap(agentPositions_[i], agentPositions_[j]);
+		std::swap(agentLayers_[i], agentLayers_[j]);
+		std::swap(agentPriorities_[i], agentPriorities_[j]);
+		std::swap(agentElevations_[i], agentElevations_[j]);
+		std::swap(agentHeights_[i], agentHeights_[j]);
+	}
+
 	void KdTree2D::buildObstacleTree(std::vector<Obstacle2D *> obstacles)
 	{
 		deleteObstacleTree(obstacleTree_);
@@ -256,7 +310,22 @@ namespace RVO2D {
 	{
 		if (agentTree_[node].end - agentTree_[node].begin <= MAX_LEAF_SIZE) {
 			for (size_t i = agentTree_[node].begin; i < agentTree_[node].end; ++i) {
-				agent->insertAgentNeighbor(agents_[i], rangeSq);
+				// Filter with the tree data before touching the other agent.
+				if (agents_[i] == agent || (agent->avoidance_mask_ & agentLayers_[i]) == 0) {
+					continue;
+				}
+				if ((agent->elevation_ > agentElevations_[i] + agentHeights_[i]) || (agent->elevation_ + agent->height_ < agentElevations_[i])) {
+					continue;
+				}
+				if (agent->avoidance_priority_ > agentPriorities_[i]) {
+					continue;
+				}
+
+				const float distSq = absSq(agent->position_ - agentPositions_[i]);
+
+				if (distSq < rangeSq) {
+					agent->insertAgentNeighbor(agents_[i], distSq, rangeSq);
+				}
 			}
 		}
 		else {
@@ -93,6 +93,15 @@ namespace RVO2D {
 			size_t right;
 		};
 
+		/**
+		 * \brief      A subtree left to build by buildAgentTreeRecursive().
+		 */
+		struct AgentSubtree {
+			size_t begin;
+			size_t end;
+			size_t node;
+		};
+
 		/**
 		 * \brief      Defines an obstacle <i>k</i>d-tree node.
 		 */
@@ -130,8 +139,32 @@ namespace RVO2D {
 		 */
 		void buildAgentTree(std::vector<Agent2D *> agents);
 
+		/**
+		 * \brief      Builds the first levels of an agent <i>k</i>d-tree.
+		 * \param      splitDepth      The number of levels to build.
+		 * \param      subtrees        Receives the subtrees below these levels.
+		 *                             They do not share agents nor nodes and can
+		 *                             be built concurrently with
+		 *                             buildAgentTreeRecursive().
+		 */
+		void buildAgentTree(std::vector<Agent2D *> agents, size_t splitDepth,
+							std::vector<AgentSubtree> &subtrees);
+
 		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node);
 
+		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node,
+									 size_t splitDepth,
+									 std::vector<AgentSubtree> *subtrees);
+
+		void swapAgents(size_t i, size_t j);
+
+		/**
+		 * \brief      Copies the current agent positions into the tree data.
+		 *             Agents move in Agent2D::update() without the tree being
+		 *             rebuilt.
+		 */
+		void updateAgentPositions();
+
 		/**
 		 * \brief      Builds an obstacle <i>k</i>d-tree.
 		 */
@@ -189,6 +222,14 @@ namespace RVO2D {
 									  const ObstacleTreeNode *node) const;
 
 		std::vector<Agent2D *> agents_;
+
+		/* The agent data read by the queries, stored in tree order next to agents_. */
+		std::vector<Vector2> agentPositions_;
+		std::vector<uint32_t> agentLayers_;
+		std::vector<float> agentPriorities_;
+		std::vector<float> agentElevations_;
+		std::vector<float> agentHeights_;
+
 		std::vector<AgentTreeNode> agentTree_;
 		ObstacleTreeNode *obstacleTree_;
 		RVOSimulator2D *sim_;
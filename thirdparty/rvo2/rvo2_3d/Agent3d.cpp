@@ -208,22 +208,27 @@ namespace RVO3D {
 		const float distSq = absSq(position_ - agent->position_);
 
 		if (distSq < rangeSq) {
-			if (agentNeighbors_.size() < maxNeighbors_) {
-				agentNeighbors_.push_back(std::make_pair(distSq, agent));
-			}
+			insertAgentNeighbor(agent, distSq, rangeSq);
+		}
+	}
 
-			size_t i = agentNeighbors_.size() - 1;
+	void Agent3D::insertAgentNeighbor(const Agent3D *agent, float distSq, float &rangeSq)
+	{
+		if (agentNeighbors_.size() < maxNeighbors_) {
+			agentNeighbors_.push_back(std::make_pair(distSq, agent));
+		}
 
-			while (i != 0 && distSq < agentNeighbors_[i - 1].first) {
-				agentNeighbors_[i] = agentNeighbors_[i - 1];
-				--i;
-			}
+		size_t i = agentNeighbors_.size() - 1;
+
+		while (i != 0 && distSq < agentNeighbors_[i - 1].first) {
+			agentNeighbors_[i] = agentNeighbors_[i - 1];
+			--i;
+		}
 
-			agentNeighbors_[i] = std::make_pair(distSq, agent);
+		agentNeighbors_[i] = std::make_pair(distSq, agent);
 
-			if (agentNeighbors_.size() == maxNeighbors_) {
-				rangeSq = agentNeighbors_.back().first;
-			}
+		if (agentNeighbors_.size() == maxNeighbors_) {
+			rangeSq = agentNeighbors_.back().first;
 		}
 	}
 
@@ -74,6 +74,14 @@ namespace RVO3D {
 		 */
 		void insertAgentNeighbor(const Agent3D *agent, float &rangeSq);
 
+		/**
+		 * \brief   Inserts an agent neighbor that already passed the layers, priority and range checks.
+		 * \param   agent    A pointer to the agent to be inserted.
+		 * \param   distSq   The squared distance between both agents.
+		 * \param   rangeSq  The squared range around this agent.
+		 */
+		void insertAgentNeighbor(const Agent3D *agent, float distSq, float &rangeSq);
+
 		/**
 		 * \brief   Updates the three-dimensional position and three-dimensional velocity of this agent.
 		 */
@@ -33,6 +33,7 @@
 #include "KdTree3d.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "Agent3d.h"
 #include "Definitions.h"
@@ -44,29 +45,60 @@ namespace RVO3D {
 	KdTree3D::KdTree3D(RVOSimulator3D *sim) : sim_(sim) { }
 
 	void KdTree3D::buildAgentTree(std::vector<Agent3D *> agents)
+	{
+		std::vector<AgentSubtree3D> subtrees;
+		buildAgentTree(std::move(agents), 0, subtrees);
+
+		for (size_t i = 0; i < subtrees.size(); ++i) {
+			buildAgentTreeRecursive(subtrees[i].begin, subtrees[i].end, subtrees[i].node);
+		}
+	}
+
+	void KdTree3D::buildAgentTree(std::vector<Agent3D *> agents, size_t splitDepth, std::vector<AgentSubtree3D> &subtrees)
 	{
 		agents_.swap(agents);
 
+		agentPositions_.resize(agents_.size());
+		agentLayers_.resize(agents_.size());
+		agentPriorities_.resize(agents_.size());
+
+		for (size_t i = 0; i < agents_.size(); ++i) {
+			agentPositions_[i] = agents_[i]->position_;
+			agentLayers_[i] = agents_[i]->avoidance_layers_;
+			agentPriorities_[i] = agents_[i]->avoidance_priority_;
+		}
+
 		if (!agents_.empty()) {
 			agentTree_.resize(2 * agents_.size() - 1);
-			buildAgentTreeRecursive(0, agents_.size(), 0);
+			buildAgentTreeRecursive(0, agents_.size(), 0, splitDepth, &subtrees);
 		}
 	}
 
 	void KdTree3D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node)
 	{
+		buildAgentTreeRecursive(begin, end, node, 0, NULL);
+	}
+
+	void KdTree3D::buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t splitDepth, std::vector<AgentSubtree3D> *subtrees)
+	{
+		if (subtrees != NULL && splitDepth == 0) {
+			AgentSubtree3D subtree = { begin, end, node };
+			subtrees->push_back(subtree);
+			return;
+		}
+
 		agentTree_[node].begin = begin;
 		agentTree_[node].end = end;
-		agentTree_[node].minCoord = agents_[begin]->position_;
-		agentTree_[node].maxCoord = agents_[begin]->position_;
+		agentTree_[node].minCoord = agentPositions_[begin];
+		agentTree_[node].maxCoord = agentPositions_[begin];
 
 		for (size_t i = begin + 1; i < end; ++i) {
-			agentTree_[node].maxCoord[0] = std::max(agentTree_[node].maxCoord[0], agents_[i]->position_.x());
-			agentTree_[node].minCoord[0] = std::min(agentTree_[node].minCoord[0], agents_[i]->position_.x());
-			agentTree_[node].maxCoord[1] = std::max(agentTree_[node].maxCoord[1], agents_[i]->position_.y());
-			agentTree_[node].minCoord[1] = std::min(agentTree_[node].minCoord[1], agents_[i]->position_.y());
-			agentTree_[node].maxCoord[2] = std::max(agentTree_[node].maxCoord[2], agents_[i]->position_.z());
-			agentTree_[node].minCoord[2] = std::min(agentTree_[node].minCoord[2], agents_[i]->position_.z());
+			agentTree_[node].maxCoord[0] = std::max(agentTree_[node].maxCoord[0], agentPositions_[i].x());
+			agentTree_[node].minCoord[0] = std::min(agentTree_[node].minCoord[0], agentPositions_[i].x());
+			agentTree_[node].maxCoord[1] = std::max(agentTree_[node].maxCoord[1], agentPositions_[i].y());
+			agentTree_[node].minCoord[1] = std::min(agentTree_[node].minCoord[1], agentPositions_[i].y());
+			agentTree_[node].maxCoord[2] = std::max(agentTree_[node].maxCoord[2], agentPositions_[i].z());
+			agentTree_[node].minCoord[2] = std::min(agentTree_[node].minCoord[2], agentPositions_[i].z());
 		}
 
 		if (end - begin > RVO3D_MAX_LEAF_SIZE) {
@@ -90,16 +122,16 @@ namespace RVO3D {
 			size_t right = end;
 
 			while (left < right) {
-				while (left < right && agents_[left]->position_[coord] < splitValue) {
+				while (left < right && agentPositions_[left][coord] < splitValue) {
 					++left;
 				}
 
-				while (right > left && agents_[right - 1]->position_[coord] >= splitValue) {
+				while (right > left && agentPositions_[right - 1][coord] >= splitValue) {
 					--right;
 				}
 
 				if (left < right) {
-					std::swap(agents_[left], agents_[right - 1]);
+					swapAgents(left, right - 1);
 					++left;
 					--right;
 				}
@@ -116,11 +148,26 @@ namespace RVO3D {
 			agentTree_[node].left = node + 1;
 			agentTree_[node].right = node + 2 * leftSize;
 
-			buildAgentTreeRecursive(begin, left, agentTree_[node].left);
-			buildAgentTreeRecursive(left, end, agentTree_[node].right);
+			buildAgentTreeRecursive(begin, left, agentTree_[node].left, splitDepth - 1, subtrees);
+			buildAgentTreeRecursive(left, end, agentTree_[node].right, splitDepth - 1, subtrees);
+		}
+	}
+
+	void KdTree3D::updateAgentPositions()
+	{
+		for (size_t i = 0; i < agents_.size(); ++i) {
+			agentPositions_[i] = agents_[i]->position_;
 		}
 	}
 
+	void KdTree3D::swapAgents(size_t i, size_t j)
+	{
+		std::swap(agents_[i], agents_[j]);
+		std::swap(agentPositions_[i], agentPositions_[j]);
+		std::swap(agentLayers_[i], agentLayers_[j]);
+		std::swap(agentPriorities_[i], agentPriorities_[j]);
+	}
+
 	void KdTree3D::computeAgentNeighbors(Agent3D *agent, float rangeSq) const
 	{
 		queryAgentTreeRecursive(agent, rangeSq, 0);
@@ -130,7 +177,16 @@ namespace RVO3D {
 	{
 		if (agentTree_[node].end - agentTree_[node].begin <= RVO3D_MAX_LEAF_SIZE) {
 			for (size_t i = agentTree_[node].begin; i < agentTree_[node].end; ++i) {
-				agent->insertAgentNeighbor(agents_[i], rangeSq);
+				// Filter with the tree data before touching the other agent.
+				if (agents_[i] == agent || (agent->avoidance_mask_ & agentLayers_[i]) == 0 || agent->avoidance_priority_ > agentPriorities_[i]) {
+					continue;
+				}
+
+				const float distSq = absSq(agent->position_ - agentPositions_[i]);
+
+				if (distSq < rangeSq) {
+					agent->insertAgentNeighbor(agents_[i], distSq, rangeSq);
+				}
 			}
 		}
 		else {
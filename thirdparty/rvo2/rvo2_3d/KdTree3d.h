@@ -37,6 +37,7 @@
 #define RVO3D_KD_TREE_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 #include "Vector3.h"
@@ -86,6 +87,15 @@ namespace RVO3D {
 			Vector3 minCoord;
 		};
 
+		/**
+		 * \brief   A subtree left to build by buildAgentTreeRecursive().
+		 */
+		struct AgentSubtree3D {
+			size_t begin;
+			size_t end;
+			size_t node;
+		};
+
 		/**
 		 * \brief   Constructs a <i>k</i>d-tree instance.
 		 * \param   sim  The simulator instance.
@@ -97,8 +107,26 @@ namespace RVO3D {
 		 */
 		void buildAgentTree(std::vector<Agent3D *> agents);
 
+		/**
+		 * \brief   Builds the first levels of an agent <i>k</i>d-tree.
+		 * \param   splitDepth  The number of levels to build.
+		 * \param   subtrees    Receives the subtrees below these levels. They do not share agents nor nodes
+		 *                      and can be built concurrently with buildAgentTreeRecursive().
+		 */
+		void buildAgentTree(std::vector<Agent3D *> agents, size_t splitDepth, std::vector<AgentSubtree3D> &subtrees);
+
 		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node);
 
+		void buildAgentTreeRecursive(size_t begin, size_t end, size_t node, size_t splitDepth, std::vector<AgentSubtree3D> *subtrees);
+
+		void swapAgents(size_t i, size_t j);
+
+		/**
+		 * \brief   Copies the current agent positions into the tree data. Agents
+		 *          move in Agent3D::update() without the tree being rebuilt.
+		 */
+		void updateAgentPositions();
+
 		/**
 		 * \brief   Computes the agent neighbors of the specified agent.
 		 * \param   agent    A pointer to the agent for which agent neighbors are to be computed.
@@ -109,6 +137,12 @@ namespace RVO3D {
 		void queryAgentTreeRecursive(Agent3D *agent, float &rangeSq, size_t node) const;
 
 		std::vector<Agent3D *> agents_;
+
+		/* The agent data read by the queries, stored in tree order next to agents_. */
+		std::vector<Vector3> agentPositions_;
+		std::vector<uint32_t> agentLayers_;
+		std::vector<float> agentPriorities_;
+
 		std::vector<AgentTreeNode3D> agentTree_;
 		RVOSimulator3D *sim_;
 